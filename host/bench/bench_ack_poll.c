@@ -0,0 +1,132 @@
+/******************************************************************************
+* File Name:  bench_ack_poll.c
+*
+* Description:  Host benchmark of acknowledge polling against the fixed write
+*               cycle delay, for several write cycle times.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Write cycle time range of the simulated device */
+typedef struct
+{
+    const char *name;
+    uint32_t minUs;
+    uint32_t maxUs;
+} bench_cycle_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const bench_cycle_t benchCycles[] =
+{
+    { "1.5 ms",       1500UL, 1500UL },
+    { "3 ms",         3000UL, 3000UL },
+    { "1.5-5 ms",     1500UL, 5000UL },
+    { "5 ms (worst)", 5000UL, 5000UL },
+};
+
+static uint8_t image[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchProgram
+********************************************************************************
+* Summary:
+*  Programs the whole array one page at a time and returns the elapsed time.
+*  Each page is followed by the fixed worst-case delay of the original
+*  example, or by acknowledge polling.
+*
+*******************************************************************************/
+static uint64_t BenchProgram(bool poll)
+{
+    uint64_t startNs = sim_time_ns();
+
+    for (uint32_t addr = 0UL; addr < EEPROM_SIZE; addr += EEPROM_PAGE_SIZE)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, &image[addr], EEPROM_PAGE_SIZE));
+        if (poll)
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        }
+        else
+        {
+            Cy_SysLib_Delay(EEPROM_WRITE_CYCLE_MS);
+        }
+    }
+    return sim_time_ns() - startNs;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Compares programming the whole array with a fixed 5-ms delay after each
+*  page against acknowledge polling, for several write cycle times, at
+*  400 kHz.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    test_fill(image, sizeof(image), 3UL);
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+
+    printf("bench_ack_poll: %u pages at 400 kHz\n", (unsigned)(EEPROM_SIZE / EEPROM_PAGE_SIZE));
+    printf(" tWR           fixed 5 ms   ack poll    saved\n");
+    for (uint32_t c = 0UL; c < (sizeof(benchCycles) / sizeof(benchCycles[0])); c++)
+    {
+        uint64_t fixedNs;
+        uint64_t pollNs;
+
+        sim_eeprom_set_write_cycle(benchCycles[c].minUs, benchCycles[c].maxUs);
+        fixedNs = BenchProgram(false);
+        pollNs = BenchProgram(true);
+
+        printf(" %-12s %8.0f ms %7.0f ms %7.0f%%\n", benchCycles[c].name, (double)fixedNs / 1e6,
+               (double)pollNs / 1e6, 100.0 - ((100.0 * (double)pollNs) / (double)fixedNs));
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
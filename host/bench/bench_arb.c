@@ -0,0 +1,280 @@
+/******************************************************************************
+* File Name:  bench_arb.c
+*
+* Description:  Goodput of each transfer type against a second master on the
+*               bus, at increasing contention.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_arb.h"
+#include "eeprom_fifo.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Span of every workload, and the span of each interrupt-driven read, which
+ * is repeated as a whole after a lost arbitration */
+#define BENCH_LEN               (4096UL)
+#define BENCH_PIECE             (256UL)
+
+#define BENCH_RATE_HZ           (400000UL)
+
+/* Workloads */
+#define BENCH_LL_WRITE          (0UL)
+#define BENCH_LL_READ           (1UL)
+#define BENCH_READ              (2UL)
+#define BENCH_STREAM            (3UL)
+#define BENCH_FIFO_WRITE        (4UL)
+#define BENCH_FIFO_READ         (5UL)
+#define BENCH_RESTART_READ      (6UL)
+#define BENCH_WORKLOADS         (7UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* One level of contention from the other master */
+typedef struct
+{
+    const char *name;
+    sim_i2c_master_t master;
+} bench_level_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const bench_level_t benchLevels[] =
+{
+    { "none",     {   0u,   0u, 0u,   0u } },
+    { "light",    {   5u,  50u, 1u, 200u } },
+    { "moderate", {  20u, 200u, 2u, 200u } },
+    { "heavy",    { 100u, 400u, 5u, 500u } },
+};
+
+static uint8_t src[BENCH_LEN];
+static uint8_t dst[BENCH_LEN];
+static uint32_t streamLen;
+
+/* Set while a lost arbitration ends the transfer, see __wrap_eeprom_arb_retry() */
+static bool benchRestart = false;
+
+/*******************************************************************************
+* Function Name: __wrap_eeprom_arb_retry
+********************************************************************************
+* Summary:
+*  The Makefile links this program with eeprom_arb_retry() wrapped. While
+*  benchRestart is set a lost arbitration ends the transfer, so BenchRestart()
+*  can start it over from the first byte instead of resuming.
+*
+*******************************************************************************/
+bool __real_eeprom_arb_retry(uint32_t *attempt, uint32_t doneBytes);
+
+bool __wrap_eeprom_arb_retry(uint32_t *attempt, uint32_t doneBytes)
+{
+    return benchRestart ? false : __real_eeprom_arb_retry(attempt, doneBytes);
+}
+
+/*******************************************************************************
+* Function Name: BenchConsume
+********************************************************************************
+* Summary:
+*  Consumer of the streaming read, appends the data to dst.
+*
+*******************************************************************************/
+static void BenchConsume(const uint8_t *data, uint32_t len)
+{
+    (void)memcpy(&dst[streamLen], data, len);
+    streamLen += len;
+}
+
+/*******************************************************************************
+* Function Name: BenchRestart
+********************************************************************************
+* Summary:
+*  Reads BENCH_LEN bytes with the low-level read and starts over from the
+*  first byte after every lost arbitration, with the same backoff and limit
+*  as the driver. A restart never makes progress, so the read gives up after
+*  EEPROM_ARB_RETRY_MAX restarts.
+*
+*******************************************************************************/
+static uint8_t BenchRestart(void)
+{
+    uint8_t status = ARB_LOST_ERROR;
+
+    benchRestart = true;
+    for (uint32_t attempt = 0UL; (status == ARB_LOST_ERROR) && (attempt <= EEPROM_ARB_RETRY_MAX); attempt++)
+    {
+        if (attempt > 0UL)
+        {
+            Cy_SysLib_DelayUs((uint16_t)eeprom_arb_backoff_us(attempt - 1UL));
+        }
+        status = eeprom_dev_read(&eeprom_default_dev, 0u, dst, BENCH_LEN);
+    }
+    benchRestart = false;
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: BenchRun
+********************************************************************************
+* Summary:
+*  Runs one workload over BENCH_LEN bytes and returns the goodput in bytes/s,
+*  or 0 if the transfer gave up. The data is checked.
+*
+*******************************************************************************/
+static double BenchRun(uint32_t workload)
+{
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    uint8_t status = TRANSFER_CMPLT;
+    uint64_t startUs;
+    uint64_t tookUs;
+
+#if !EEPROM_FIFO_ENABLE
+    if ((workload == BENCH_FIFO_WRITE) || (workload == BENCH_FIFO_READ))
+    {
+        /* The FIFO-level path is not built, its columns stay 0 */
+        return 0.0;
+    }
+#endif
+
+    (void)memset(dst, 0, sizeof(dst));
+    if ((workload == BENCH_LL_WRITE) || (workload == BENCH_FIFO_WRITE))
+    {
+        (void)memset(mem, 0xFF, BENCH_LEN);
+    }
+
+    startUs = sim_time_us();
+    switch (workload)
+    {
+        case BENCH_LL_WRITE:
+            status = eeprom_dev_write(&eeprom_default_dev, 0u, src, BENCH_LEN);
+            break;
+        case BENCH_LL_READ:
+            status = eeprom_dev_read(&eeprom_default_dev, 0u, dst, BENCH_LEN);
+            break;
+        case BENCH_READ:
+            for (uint32_t addr = 0UL; (addr < BENCH_LEN) && (status == TRANSFER_CMPLT); addr += BENCH_PIECE)
+            {
+                status = eeprom_read((eeprom_addr_t)addr, &dst[addr], BENCH_PIECE);
+            }
+            break;
+        case BENCH_STREAM:
+            streamLen = 0UL;
+            status = eeprom_read_stream(0u, BENCH_LEN, &BenchConsume);
+            break;
+#if EEPROM_FIFO_ENABLE
+        case BENCH_FIFO_WRITE:
+            status = eeprom_fifo_write(0u, src, BENCH_LEN);
+            break;
+        case BENCH_FIFO_READ:
+            status = eeprom_fifo_read(0u, dst, BENCH_LEN);
+            break;
+#endif
+        default:
+            status = BenchRestart();
+            break;
+    }
+    if ((status == TRANSFER_CMPLT) &&
+        ((workload == BENCH_LL_WRITE) || (workload == BENCH_FIFO_WRITE)))
+    {
+        status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+    }
+    tookUs = sim_time_us() - startUs;
+
+    if (status != TRANSFER_CMPLT)
+    {
+        TEST_ASSERT_EQUAL(ARB_LOST_ERROR, status);
+        return 0.0;
+    }
+    if ((workload == BENCH_LL_WRITE) || (workload == BENCH_FIFO_WRITE))
+    {
+        TEST_ASSERT(memcmp(mem, src, BENCH_LEN) == 0);
+    }
+    else
+    {
+        TEST_ASSERT(memcmp(dst, src, BENCH_LEN) == 0);
+    }
+    return ((double)BENCH_LEN * 1000000.0) / (double)tookUs;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Measures the goodput of each transfer type against a second master at
+*  increasing levels of contention. Every transfer but the interrupt-driven
+*  read resumes behind the bytes done before a lost arbitration; the last
+*  column restarts the low-level read from the first byte for comparison.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(BENCH_RATE_HZ));
+    test_fill(src, sizeof(src), 3UL);
+    (void)memcpy(sim_eeprom_mem(EEPROM_SLAVE_ADDR), src, sizeof(src));
+
+    printf("bench_arb: %lu bytes at %lu kHz, goodput in bytes/s, 0 = gave up, lost on the bus\n",
+           BENCH_LEN, BENCH_RATE_HZ / 1000UL);
+    printf(" contention  llwrite   llread     read   stream   fifowr   fiford  restart   lost\n");
+    for (uint32_t l = 0UL; l < (sizeof(benchLevels) / sizeof(benchLevels[0])); l++)
+    {
+        double goodput[BENCH_WORKLOADS];
+        sim_i2c_stats_t stats;
+
+        sim_i2c_reset_stats();
+        sim_i2c_set_master(&benchLevels[l].master);
+        for (uint32_t w = 0UL; w < BENCH_WORKLOADS; w++)
+        {
+            goodput[w] = BenchRun(w);
+        }
+        sim_i2c_set_master(NULL);
+        sim_i2c_get_stats(&stats);
+
+        printf(" %-10s %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f %6lu\n", benchLevels[l].name,
+               goodput[BENCH_LL_WRITE], goodput[BENCH_LL_READ], goodput[BENCH_READ],
+               goodput[BENCH_STREAM], goodput[BENCH_FIFO_WRITE], goodput[BENCH_FIFO_READ],
+               goodput[BENCH_RESTART_READ], (unsigned long)stats.arbLost);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,183 @@
+/******************************************************************************
+* File Name:  bench_async.c
+*
+* Description:  Host benchmark of transfer completion latency: the original
+*               status poll loop against the blocking wrapper and the
+*               completion callback.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_RUNS              (50UL)
+
+/* Random read of the benchmark */
+#define BENCH_ADDR              (0x100U)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern cy_stc_scb_i2c_context_t CYBSP_I2C_context;
+
+static const uint32_t benchSizes[] = { 1UL, 8UL, 64UL, 256UL };
+
+static volatile uint64_t doneNs;
+
+/*******************************************************************************
+* Function Name: Done
+********************************************************************************
+* Summary:
+*  Completion callback, takes the time the interrupt reported completion.
+*
+*******************************************************************************/
+static void Done(uint8_t status)
+{
+    (void)status;
+    doneNs = sim_time_ns();
+}
+
+/*******************************************************************************
+* Function Name: BenchPollLoop
+********************************************************************************
+* Summary:
+*  Random read completed by the loop of the original example: the status is
+*  read every CY_SCB_WAIT_1_UNIT milliseconds until the driver is idle.
+*  Returns the time from the start to the return.
+*
+*******************************************************************************/
+static uint64_t BenchPollLoop(uint8_t *dst, uint32_t len)
+{
+    uint64_t startNs = sim_time_ns();
+
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_read_at_async(BENCH_ADDR, dst, len, NULL));
+    while (0UL != (CY_SCB_I2C_MASTER_BUSY & Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context)))
+    {
+        Cy_SysLib_Delay(CY_SCB_WAIT_1_UNIT);
+    }
+    return sim_time_ns() - startNs;
+}
+
+/*******************************************************************************
+* Function Name: BenchBlocking
+********************************************************************************
+* Summary:
+*  Random read with the blocking wrapper, which sleeps until the completion
+*  interrupt.
+*
+*******************************************************************************/
+static uint64_t BenchBlocking(uint8_t *dst, uint32_t len)
+{
+    uint64_t startNs = sim_time_ns();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(BENCH_ADDR, dst, len));
+    return sim_time_ns() - startNs;
+}
+
+/*******************************************************************************
+* Function Name: BenchCallback
+********************************************************************************
+* Summary:
+*  Random read completed by the callback. Returns the time from the start to
+*  the callback, while the caller does other work.
+*
+*******************************************************************************/
+static uint64_t BenchCallback(uint8_t *dst, uint32_t len)
+{
+    uint64_t startNs = sim_time_ns();
+
+    doneNs = 0ULL;
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_read_at_async(BENCH_ADDR, dst, len, &Done));
+    while (eeprom_is_busy())
+    {
+        Cy_SysLib_DelayUs(10u);
+    }
+    return doneNs - startNs;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Measures the completion latency of a random read with the original poll
+*  loop, the blocking wrapper and the completion callback, against the bus
+*  time of the transfer, at 400 kHz.
+*
+*******************************************************************************/
+int main(void)
+{
+    static uint8_t dst[256];
+
+    test_init();
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+
+    printf("bench_async: random read at 400 kHz, average of %lu runs\n", BENCH_RUNS);
+    printf(" bytes   bus us  poll loop us  blocking us  callback us\n");
+    for (uint32_t s = 0UL; s < (sizeof(benchSizes) / sizeof(benchSizes[0])); s++)
+    {
+        uint64_t pollNs = 0ULL;
+        uint64_t blockNs = 0ULL;
+        uint64_t callbackNs = 0ULL;
+        sim_i2c_stats_t bus;
+
+        sim_i2c_reset_stats();
+        for (uint32_t run = 0UL; run < BENCH_RUNS; run++)
+        {
+            /* Start at a random phase of the SysTick period */
+            sim_run_us(sim_random() % 1000ULL);
+            pollNs += BenchPollLoop(dst, benchSizes[s]);
+            sim_run_us(sim_random() % 1000ULL);
+            blockNs += BenchBlocking(dst, benchSizes[s]);
+            sim_run_us(sim_random() % 1000ULL);
+            callbackNs += BenchCallback(dst, benchSizes[s]);
+        }
+        sim_i2c_get_stats(&bus);
+
+        printf(" %5u %8.1f %13.1f %12.1f %12.1f\n", (unsigned)benchSizes[s],
+               (double)bus.busyNs / (3000.0 * BENCH_RUNS),
+               (double)pollNs / (1000.0 * BENCH_RUNS), (double)blockNs / (1000.0 * BENCH_RUNS),
+               (double)callbackNs / (1000.0 * BENCH_RUNS));
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
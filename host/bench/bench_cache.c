@@ -0,0 +1,190 @@
+/******************************************************************************
+* File Name:  bench_cache.c
+*
+* Description:  Host benchmark of the write-back page cache: hit rate, page
+*               writes and bytes saved for scattered field updates.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_cache.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Field updates of each workload, and the time between two of them */
+#define BENCH_UPDATES           (1000UL)
+#define BENCH_UPDATE_PERIOD_MS  (2UL)
+
+/* Size of one field */
+#define BENCH_FIELD_SIZE        (4UL)
+
+/* First page of the fields */
+#define BENCH_FIRST_PAGE        (64UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Number of pages the fields are spread over */
+static const uint32_t benchPages[] = { 1UL, 2UL, EEPROM_CACHE_PAGES, 2UL * EEPROM_CACHE_PAGES, 32UL };
+
+/*******************************************************************************
+* Function Name: BenchField
+********************************************************************************
+* Summary:
+*  Returns the address of a random field on one of pages pages.
+*
+*******************************************************************************/
+static eeprom_addr_t BenchField(uint32_t pages)
+{
+    uint32_t page = BENCH_FIRST_PAGE + (uint32_t)(sim_random() % pages);
+    uint32_t field = (uint32_t)(sim_random() % (EEPROM_PAGE_SIZE / BENCH_FIELD_SIZE));
+
+    return (eeprom_addr_t)((page * EEPROM_PAGE_SIZE) + (field * BENCH_FIELD_SIZE));
+}
+
+/*******************************************************************************
+* Function Name: BenchDirect
+********************************************************************************
+* Summary:
+*  Writes each field update to the EEPROM as it happens. Returns the time
+*  spent in the driver.
+*
+*******************************************************************************/
+static uint64_t BenchDirect(uint32_t pages)
+{
+    uint64_t busyNs = 0ULL;
+
+    for (uint32_t i = 0UL; i < BENCH_UPDATES; i++)
+    {
+        uint8_t value[BENCH_FIELD_SIZE];
+        uint64_t startNs = sim_time_ns();
+
+        test_fill(value, sizeof(value), i);
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write(BenchField(pages), value, sizeof(value)));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        busyNs += sim_time_ns() - startNs;
+        Cy_SysLib_Delay(BENCH_UPDATE_PERIOD_MS);
+    }
+    return busyNs;
+}
+
+/*******************************************************************************
+* Function Name: BenchCached
+********************************************************************************
+* Summary:
+*  Writes each field update to the cache, with the idle flush serviced from
+*  the loop and a final flush. Returns the time spent in the driver.
+*
+*******************************************************************************/
+static uint64_t BenchCached(uint32_t pages)
+{
+    uint64_t busyNs = 0ULL;
+    uint64_t startNs;
+
+    for (uint32_t i = 0UL; i < BENCH_UPDATES; i++)
+    {
+        uint8_t value[BENCH_FIELD_SIZE];
+
+        test_fill(value, sizeof(value), i);
+        startNs = sim_time_ns();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_write(BenchField(pages), value, sizeof(value)));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_service(BENCH_UPDATE_PERIOD_MS));
+        busyNs += sim_time_ns() - startNs;
+        Cy_SysLib_Delay(BENCH_UPDATE_PERIOD_MS);
+    }
+    startNs = sim_time_ns();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_flush());
+    return busyNs + (sim_time_ns() - startNs);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Updates 4-byte fields spread over a growing number of pages every 2 ms,
+*  written directly or through the cache, at 400 kHz. Reports the hit rate,
+*  the page writes and bytes that reach the EEPROM, and the time spent in
+*  the driver.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+
+    printf("bench_cache: %lu updates of %lu-byte fields, %u-page cache, 400 kHz, tWR %lu us\n",
+           BENCH_UPDATES, BENCH_FIELD_SIZE, (unsigned)EEPROM_CACHE_PAGES, SIM_EEPROM_WRITE_CYCLE_US);
+    printf("                                 page writes        bytes         driver ms\n");
+    printf(" pages  hit rate  coalesced  direct  cached    app  flushed   direct  cached\n");
+    for (uint32_t p = 0UL; p < (sizeof(benchPages) / sizeof(benchPages[0])); p++)
+    {
+        eeprom_cache_stats_t before;
+        eeprom_cache_stats_t after;
+        sim_eeprom_stats_t direct;
+        sim_eeprom_stats_t cached;
+        uint64_t directNs;
+        uint64_t cachedNs;
+        uint32_t hits;
+        uint32_t misses;
+
+        sim_eeprom_reset_stats();
+        directNs = BenchDirect(benchPages[p]);
+        sim_eeprom_get_stats(&direct);
+
+        eeprom_cache_get_stats(&before);
+        sim_eeprom_reset_stats();
+        cachedNs = BenchCached(benchPages[p]);
+        sim_eeprom_get_stats(&cached);
+        eeprom_cache_get_stats(&after);
+
+        hits = after.hits - before.hits;
+        misses = after.misses - before.misses;
+        printf(" %5u %8.1f%% %10u %7u %7u %6u %8u %8.0f %7.0f\n", (unsigned)benchPages[p],
+               (100.0 * hits) / (double)(hits + misses), (unsigned)(after.coalesced - before.coalesced),
+               (unsigned)direct.writeCycles, (unsigned)cached.writeCycles,
+               (unsigned)(after.bytesWritten - before.bytesWritten),
+               (unsigned)(after.bytesFlushed - before.bytesFlushed),
+               (double)directNs / 1e6, (double)cachedNs / 1e6);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
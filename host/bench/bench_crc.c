@@ -0,0 +1,136 @@
+/******************************************************************************
+* File Name:  bench_crc.c
+*
+* Description:  Host benchmark of the CRC-32 kernel: time per byte on the host
+*               CPU.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_crc.h"
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC           (1u)
+#else
+#define BENCH_HAS_TSC           (0u)
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Data processed per run, and runs; the fastest run counts */
+#define BENCH_BUFFER_SIZE       (64UL * 1024UL)
+#define BENCH_PASSES            (256UL)
+#define BENCH_RUNS              (5UL)
+
+/*******************************************************************************
+* Function Name: BenchNowNs
+********************************************************************************
+* Summary:
+*  Returns the host monotonic time. This benchmark measures the host CPU, not
+*  the simulation.
+*
+*******************************************************************************/
+static uint64_t BenchNowNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Times eeprom_crc32_update() on the host in chunks of the streaming read
+*  and prints nanoseconds and time-stamp counter ticks per byte.
+*
+*******************************************************************************/
+int main(void)
+{
+    static uint8_t buffer[BENCH_BUFFER_SIZE];
+    static const uint32_t chunks[] = { 16UL, 64UL, BENCH_BUFFER_SIZE };
+    volatile uint32_t sink = 0UL;
+
+    test_fill(buffer, sizeof(buffer), 1UL);
+
+    printf("bench_crc: eeprom_crc32_update() on the host CPU, %lu MB per run, best of %lu\n",
+           (BENCH_BUFFER_SIZE * BENCH_PASSES) >> 20u, BENCH_RUNS);
+    printf(" chunk B   ns/byte  TSC ticks/byte\n");
+    for (uint32_t c = 0UL; c < (sizeof(chunks) / sizeof(chunks[0])); c++)
+    {
+        uint64_t bestNs = UINT64_MAX;
+        uint64_t bestTicks = UINT64_MAX;
+
+        for (uint32_t run = 0UL; run < BENCH_RUNS; run++)
+        {
+            uint32_t crc = EEPROM_CRC32_INIT;
+            uint64_t startNs = BenchNowNs();
+            uint64_t ticks = 0ULL;
+#if BENCH_HAS_TSC
+            uint64_t startTicks = __rdtsc();
+#endif
+
+            for (uint32_t pass = 0UL; pass < BENCH_PASSES; pass++)
+            {
+                for (uint32_t offset = 0UL; offset < BENCH_BUFFER_SIZE; offset += chunks[c])
+                {
+                    crc = eeprom_crc32_update(crc, &buffer[offset], chunks[c]);
+                }
+            }
+#if BENCH_HAS_TSC
+            ticks = __rdtsc() - startTicks;
+#endif
+            startNs = BenchNowNs() - startNs;
+            sink ^= crc;
+            bestNs = (startNs < bestNs) ? startNs : bestNs;
+            bestTicks = (ticks < bestTicks) ? ticks : bestTicks;
+        }
+
+        printf(" %7u %9.3f %15.2f\n", (unsigned)chunks[c],
+               (double)bestNs / (double)(BENCH_BUFFER_SIZE * BENCH_PASSES),
+               (double)bestTicks / (double)(BENCH_BUFFER_SIZE * BENCH_PASSES));
+    }
+
+    (void)sink;
+    return 0;
+}
+
+/* [] END OF FILE */
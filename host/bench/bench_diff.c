@@ -0,0 +1,158 @@
+/******************************************************************************
+* File Name:  bench_diff.c
+*
+* Description:  Differential programming against plain page writes.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_diff.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_PAGES             (EEPROM_SIZE / EEPROM_PAGE_SIZE)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Percentage of the pages that differ between the old and the new image */
+static const uint32_t benchChanged[] = { 0UL, 1UL, 10UL, 25UL, 50UL, 100UL };
+
+static uint8_t oldImage[EEPROM_SIZE];
+static uint8_t newImage[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: MakeImage
+********************************************************************************
+* Summary:
+*  Builds the new image from the old one with percent of the pages changed,
+*  each in a run of random position and length.
+*
+*******************************************************************************/
+static void MakeImage(uint32_t percent)
+{
+    uint32_t changed = (BENCH_PAGES * percent) / 100UL;
+
+    (void)memcpy(newImage, oldImage, EEPROM_SIZE);
+    for (uint32_t i = 0UL; i < changed; i++)
+    {
+        uint32_t page = (i * 100UL) / percent;
+        uint32_t first = (uint32_t)(sim_random() % EEPROM_PAGE_SIZE);
+        uint32_t len = 1UL + (uint32_t)(sim_random() % (EEPROM_PAGE_SIZE - first));
+
+        for (uint32_t j = 0UL; j < len; j++)
+        {
+            newImage[(page * EEPROM_PAGE_SIZE) + first + j] ^= 0xA5u;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Program
+********************************************************************************
+* Summary:
+*  Loads the old image into the array, reprograms it with the new image with
+*  eeprom_write_diff() or eeprom_write(), and returns the time it took in
+*  nanoseconds.
+*
+*******************************************************************************/
+static uint64_t Program(bool diff, uint32_t *cycles)
+{
+    uint64_t startNs;
+    sim_eeprom_stats_t stats;
+
+    (void)memcpy(sim_eeprom_mem(EEPROM_SLAVE_ADDR), oldImage, EEPROM_SIZE);
+    sim_eeprom_reset_stats();
+    startNs = sim_time_ns();
+    if (diff)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write_diff(0U, newImage, EEPROM_SIZE));
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write(0U, newImage, EEPROM_SIZE));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    }
+    startNs = sim_time_ns() - startNs;
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), newImage, EEPROM_SIZE) == 0);
+
+    sim_eeprom_get_stats(&stats);
+    *cycles = stats.writeCycles;
+    return startNs;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Reprograms the whole array with a share of its pages changed, once with
+*  eeprom_write_diff() and once with eeprom_write(), at 400 kHz with the
+*  simulated 3-ms write cycle, and prints the time and write cycles of each.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+    test_fill(oldImage, EEPROM_SIZE, 5UL);
+
+    printf("bench_diff: %lu pages, 400 kHz, tWR %lu us\n", BENCH_PAGES, SIM_EEPROM_WRITE_CYCLE_US);
+    printf(" changed  write ms  write cycles  diff ms  diff cycles\n");
+    for (uint32_t c = 0UL; c < (sizeof(benchChanged) / sizeof(benchChanged[0])); c++)
+    {
+        uint32_t writeCycles;
+        uint32_t diffCycles;
+        uint64_t writeNs;
+        uint64_t diffNs;
+
+        MakeImage(benchChanged[c]);
+        writeNs = Program(false, &writeCycles);
+        diffNs = Program(true, &diffCycles);
+
+        printf(" %6u%% %9.1f %13u %8.1f %12u\n", (unsigned)benchChanged[c],
+               (double)writeNs / 1e6, (unsigned)writeCycles, (double)diffNs / 1e6, (unsigned)diffCycles);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,346 @@
+/******************************************************************************
+* File Name:  bench_eeprom.c
+*
+* Description:  Host benchmark suite: throughput, per-call latency and
+*               simulated bus time of the write, read and verify paths at each
+*               bus clock, and the firmware benchmark on the simulated kit.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sim.h"
+#include "I2CMaster.h"
+#include "eeprom_bench.h"
+#include "eeprom_bus.h"
+#include "eeprom_crc.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Transfer size of the write workload, and of the read and verify workloads */
+#define BENCH_WRITE_SIZE        (EEPROM_PAGE_SIZE)
+#define BENCH_READ_SIZE         (EEPROM_BENCH_BLOCK_SIZE)
+
+/* Workloads of this file */
+#define BENCH_WRITE             (0u)
+#define BENCH_READ              (1u)
+#define BENCH_VERIFY            (2u)
+#define BENCH_COUNT             (3u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Result of one workload, measured on the simulation */
+typedef struct
+{
+    uint32_t bytes;         /* Data bytes transferred */
+    uint32_t transactions;  /* Driver calls */
+    uint64_t totalNs;       /* Elapsed time */
+    uint64_t minNs;         /* Fastest driver call */
+    uint64_t maxNs;         /* Slowest driver call */
+    uint64_t busNs;         /* Time this master drove the bus */
+    uint64_t cycleUs;       /* EEPROM write cycle time */
+} bench_result_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint32_t benchRates[] = { 100000UL, 400000UL, 1000000UL };
+
+static const char * const benchNames[BENCH_COUNT] = { "write", "read", "verify" };
+
+static uint8_t benchData[EEPROM_BENCH_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchStart
+********************************************************************************
+* Summary:
+*  Clears the bus and EEPROM model counters before a workload.
+*
+*******************************************************************************/
+static void BenchStart(bench_result_t *result)
+{
+    (void)memset(result, 0, sizeof(*result));
+    result->minNs = SIM_NEVER;
+    sim_i2c_reset_stats();
+    sim_eeprom_reset_stats();
+}
+
+/*******************************************************************************
+* Function Name: BenchTransaction
+********************************************************************************
+* Summary:
+*  Adds one driver call that started at startNs.
+*
+*******************************************************************************/
+static void BenchTransaction(bench_result_t *result, uint64_t startNs, uint32_t bytes)
+{
+    uint64_t ns = sim_time_ns() - startNs;
+
+    result->transactions++;
+    result->bytes += bytes;
+    result->totalNs += ns;
+    result->minNs = (ns < result->minNs) ? ns : result->minNs;
+    result->maxNs = (ns > result->maxNs) ? ns : result->maxNs;
+}
+
+/*******************************************************************************
+* Function Name: BenchEnd
+********************************************************************************
+* Summary:
+*  Reads the bus and EEPROM model counters after a workload.
+*
+*******************************************************************************/
+static void BenchEnd(bench_result_t *result)
+{
+    sim_i2c_stats_t bus;
+    sim_eeprom_stats_t eeprom;
+
+    sim_i2c_get_stats(&bus);
+    sim_eeprom_get_stats(&eeprom);
+    result->busNs = bus.busyNs;
+    result->cycleUs = eeprom.busyUs;
+}
+
+/*******************************************************************************
+* Function Name: BenchWrite
+********************************************************************************
+* Summary:
+*  Writes the benchmark region one page at a time. A transaction is the page
+*  write and the acknowledge polling until the write cycle ends.
+*
+*******************************************************************************/
+static uint8_t BenchWrite(bench_result_t *result)
+{
+    uint8_t status = TRANSFER_CMPLT;
+
+    BenchStart(result);
+    for (uint32_t offset = 0UL; (offset < EEPROM_BENCH_SIZE) && (status == TRANSFER_CMPLT);
+         offset += BENCH_WRITE_SIZE)
+    {
+        uint64_t startNs = sim_time_ns();
+
+        status = eeprom_write((eeprom_addr_t)(EEPROM_BENCH_START + offset), &benchData[offset],
+                              BENCH_WRITE_SIZE);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+        BenchTransaction(result, startNs, BENCH_WRITE_SIZE);
+    }
+    BenchEnd(result);
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: BenchRead
+********************************************************************************
+* Summary:
+*  Reads the benchmark region in blocks and checks the data.
+*
+*******************************************************************************/
+static uint8_t BenchRead(bench_result_t *result)
+{
+    static uint8_t block[BENCH_READ_SIZE];
+    uint8_t status = TRANSFER_CMPLT;
+
+    BenchStart(result);
+    for (uint32_t offset = 0UL; (offset < EEPROM_BENCH_SIZE) && (status == TRANSFER_CMPLT);
+         offset += BENCH_READ_SIZE)
+    {
+        uint64_t startNs = sim_time_ns();
+
+        status = eeprom_read((eeprom_addr_t)(EEPROM_BENCH_START + offset), block, BENCH_READ_SIZE);
+        BenchTransaction(result, startNs, BENCH_READ_SIZE);
+        if ((status == TRANSFER_CMPLT) && (memcmp(block, &benchData[offset], BENCH_READ_SIZE) != 0))
+        {
+            status = INVALID_DATA_ERROR;
+        }
+    }
+    BenchEnd(result);
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: BenchVerify
+********************************************************************************
+* Summary:
+*  Verifies the benchmark region in blocks against checksums computed on the
+*  host, with the streaming CRC-32 read of the driver.
+*
+*******************************************************************************/
+static uint8_t BenchVerify(bench_result_t *result)
+{
+    uint8_t status = TRANSFER_CMPLT;
+
+    BenchStart(result);
+    for (uint32_t offset = 0UL; (offset < EEPROM_BENCH_SIZE) && (status == TRANSFER_CMPLT);
+         offset += BENCH_READ_SIZE)
+    {
+        uint32_t crc = eeprom_crc32_update(EEPROM_CRC32_INIT, &benchData[offset], BENCH_READ_SIZE) ^
+                       EEPROM_CRC32_INIT;
+        uint64_t startNs = sim_time_ns();
+
+        status = eeprom_crc_verify((eeprom_addr_t)(EEPROM_BENCH_START + offset), BENCH_READ_SIZE, crc);
+        BenchTransaction(result, startNs, BENCH_READ_SIZE);
+    }
+    BenchEnd(result);
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: BenchPrint
+********************************************************************************
+* Summary:
+*  Prints one workload: data throughput, latency of one driver call, and the
+*  simulated bus and write cycle time.
+*
+*******************************************************************************/
+static void BenchPrint(uint32_t rateHz, const char *name, const bench_result_t *result)
+{
+    uint64_t bytesPerSec = (result->totalNs > 0ULL) ?
+                           ((uint64_t)result->bytes * 1000000000ULL) / result->totalNs : 0ULL;
+
+    printf(" %7" PRIu32 " %-7s %8" PRIu64 " %6" PRIu32 " %8.1f %8.1f %8.1f %9.1f %5.1f%% %9" PRIu64 "\n",
+           rateHz / 1000u, name, bytesPerSec, result->transactions,
+           (double)result->minNs / 1000.0,
+           (double)result->totalNs / (1000.0 * (double)result->transactions),
+           (double)result->maxNs / 1000.0,
+           (double)result->busNs / 1000.0,
+           (100.0 * (double)result->busNs) / (double)result->totalNs,
+           result->cycleUs);
+}
+
+/*******************************************************************************
+* Function Name: BenchPrintFirmware
+********************************************************************************
+* Summary:
+*  Prints the results of eeprom_bench_run(), the benchmark main() runs on the
+*  kit with BENCHMARK_ENABLE, in the same layout.
+*
+*******************************************************************************/
+static void BenchPrintFirmware(uint32_t rateHz, const eeprom_bench_result_t *results)
+{
+    printf("\n eeprom_bench_run() at %" PRIu32 " kHz\n", rateHz / 1000u);
+    printf("workload       bytes/s  EEPROM B     xfers    min us    max us  total us    bus us act us/KB    isr/KB\n");
+    for (uint32_t w = 0UL; w < EEPROM_BENCH_COUNT; w++)
+    {
+        printf("%-11s %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32 " %9" PRIu32
+               " %9" PRIu32 " %9" PRIu32 "\n",
+               eeprom_bench_name(w), results[w].bytesPerSec, results[w].eepromBytes, results[w].transactions,
+               results[w].minUs, results[w].maxUs, results[w].totalUs, results[w].busUs,
+               results[w].activeUsPerKB, results[w].isrPerKB);
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the write, read and verify workloads and then eeprom_bench_run() at
+*  each bus clock the driver accepts. Times are simulated: bus clocks and
+*  write cycles are modeled, CPU time only as a fixed cost per interrupt and
+*  per polled register read, see sim.h.
+*
+*******************************************************************************/
+int main(void)
+{
+    static eeprom_bench_result_t firmware[(sizeof(benchRates) / sizeof(benchRates[0]))][EEPROM_BENCH_COUNT];
+    bench_result_t result;
+    uint8_t status = TRANSFER_CMPLT;
+
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+    __enable_irq();
+    if (initI2CMaster() != I2C_SUCCESS)
+    {
+        printf("bench_eeprom: init failed\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0UL; i < EEPROM_BENCH_SIZE; i++)
+    {
+        benchData[i] = (uint8_t)((i * 7UL) + (i >> 8u));
+    }
+
+    printf("bench_eeprom: %u-byte region, tWR %lu us, driver calls of %lu/%lu bytes\n",
+           (unsigned)EEPROM_BENCH_SIZE, SIM_EEPROM_WRITE_CYCLE_US,
+           (unsigned long)BENCH_WRITE_SIZE, (unsigned long)BENCH_READ_SIZE);
+    printf("     kHz workload bytes/s  xfers   min us   avg us   max us    bus us   bus%%    tWR us\n");
+
+    for (uint32_t r = 0UL; r < (sizeof(benchRates) / sizeof(benchRates[0])); r++)
+    {
+        if (eeprom_bus_set_speed(benchRates[r]) != I2C_SUCCESS)
+        {
+            printf(" %7" PRIu32 " not accepted by the driver\n", benchRates[r] / 1000u);
+            continue;
+        }
+
+        for (uint32_t w = 0UL; (w < BENCH_COUNT) && (status == TRANSFER_CMPLT); w++)
+        {
+            status = (w == BENCH_WRITE) ? BenchWrite(&result) :
+                     (w == BENCH_READ)  ? BenchRead(&result) : BenchVerify(&result);
+            BenchPrint(benchRates[r], benchNames[w], &result);
+        }
+        if (status != TRANSFER_CMPLT)
+        {
+            printf("bench_eeprom: workload failed with 0x%02X\n", status);
+            return 1;
+        }
+    }
+
+    for (uint32_t r = 0UL; r < (sizeof(benchRates) / sizeof(benchRates[0])); r++)
+    {
+        if (eeprom_bus_set_speed(benchRates[r]) != I2C_SUCCESS)
+        {
+            continue;
+        }
+        status = eeprom_bench_run(firmware[r]);
+        if (status != TRANSFER_CMPLT)
+        {
+            printf("bench_eeprom: eeprom_bench_run() failed with 0x%02X\n", status);
+            return 1;
+        }
+        BenchPrintFirmware(benchRates[r], firmware[r]);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
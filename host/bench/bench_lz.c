@@ -0,0 +1,390 @@
+/******************************************************************************
+* File Name:  bench_lz.c
+*
+* Description:  Benchmark of the LZ block storage: compression ratio,
+*               simulated write and read time against page writes, and host
+*               CPU time.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_lz.h"
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC           (1u)
+#else
+#define BENCH_HAS_TSC           (0u)
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Log text stored by the end-to-end workloads, as blocks of BENCH_BLOCK_LEN
+ * bytes in slots of BENCH_SLOT_SIZE, as the eeprom_bench_run() workloads */
+#define BENCH_BYTES             (4096UL)
+#define BENCH_SLOT_SIZE         (256UL)
+#define BENCH_BLOCK_LEN         (BENCH_SLOT_SIZE - EEPROM_LZ_HEADER_SIZE)
+#define BENCH_BLOCKS            (BENCH_BYTES / BENCH_BLOCK_LEN)
+
+/* Passes over the log text per run of the codec measurement, and runs; the
+ * fastest run counts */
+#define BENCH_PASSES            (200UL)
+#define BENCH_RUNS              (5UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Simulated cost of a workload */
+typedef struct
+{
+    uint64_t us;
+    uint32_t eepromBytes;
+    uint32_t writeCycles;
+} bench_sim_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t text[BENCH_BYTES];
+static uint8_t dst[BENCH_BYTES];
+static uint32_t streamLen;
+
+/* EEPROM of the codec measurement, see __wrap_eeprom_write() */
+static bool benchRam = false;
+static uint8_t ram[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchNowNs
+********************************************************************************
+* Summary:
+*  Returns the host monotonic time.
+*
+*******************************************************************************/
+static uint64_t BenchNowNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: BenchTicks
+********************************************************************************
+* Summary:
+*  Returns the time-stamp counter, or 0 without one.
+*
+*******************************************************************************/
+static uint64_t BenchTicks(void)
+{
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0ULL;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: BenchConsumer
+********************************************************************************
+* Summary:
+*  Stream consumer of the decompression workload, collects the data.
+*
+*******************************************************************************/
+static void BenchConsumer(const uint8_t *data, uint32_t len)
+{
+    (void)memcpy(&dst[streamLen], data, len);
+    streamLen += len;
+}
+
+/*******************************************************************************
+* Function Name: BenchRatio
+********************************************************************************
+* Summary:
+*  Prints the EEPROM bytes of one block of each kind of data.
+*
+*******************************************************************************/
+static void BenchRatio(const char *name, uint32_t len)
+{
+    uint32_t stored = 0UL;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write(0u, EEPROM_SIZE, text, len, &stored));
+    printf(" %-20s %6lu %8lu %7.1f%%\n", name, (unsigned long)len, (unsigned long)stored,
+           (100.0 * (double)stored) / (double)len);
+}
+
+/*******************************************************************************
+* Function Name: BenchWrite
+********************************************************************************
+* Summary:
+*  Writes the log text as compressed blocks, or page by page as
+*  WriteToEEPROM() does, and returns the simulated cost.
+*
+*******************************************************************************/
+static bench_sim_t BenchWrite(bool compressed)
+{
+    bench_sim_t result = { 0ULL, 0UL, 0UL };
+    sim_eeprom_stats_t stats;
+    uint64_t startUs = sim_time_us();
+    uint32_t stored;
+
+    sim_eeprom_reset_stats();
+    for (uint32_t b = 0UL; b < BENCH_BLOCKS; b++)
+    {
+        if (compressed)
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write((eeprom_addr_t)(b * BENCH_SLOT_SIZE), BENCH_SLOT_SIZE,
+                                                              &text[b * BENCH_BLOCK_LEN], BENCH_BLOCK_LEN, &stored));
+            result.eepromBytes += stored;
+        }
+        else
+        {
+            for (uint32_t offset = 0UL; offset < BENCH_SLOT_SIZE; offset += EEPROM_PAGE_SIZE)
+            {
+                uint32_t len = (offset + EEPROM_PAGE_SIZE <= BENCH_BLOCK_LEN) ? EEPROM_PAGE_SIZE :
+                               (BENCH_BLOCK_LEN - offset);
+
+                TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)((b * BENCH_SLOT_SIZE) + offset),
+                                                               &text[(b * BENCH_BLOCK_LEN) + offset], len));
+                TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+                result.eepromBytes += len;
+            }
+        }
+    }
+    result.us = sim_time_us() - startUs;
+    sim_eeprom_get_stats(&stats);
+    result.writeCycles = stats.writeCycles;
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: BenchRead
+********************************************************************************
+* Summary:
+*  Reads the blocks written by BenchWrite() back into dst and returns the
+*  simulated time.
+*
+*******************************************************************************/
+static uint64_t BenchRead(bool compressed)
+{
+    uint64_t startUs = sim_time_us();
+
+    streamLen = 0UL;
+    for (uint32_t b = 0UL; b < BENCH_BLOCKS; b++)
+    {
+        if (compressed)
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_read_stream((eeprom_addr_t)(b * BENCH_SLOT_SIZE),
+                                                                    &BenchConsumer));
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)(b * BENCH_SLOT_SIZE),
+                                                          &dst[b * BENCH_BLOCK_LEN], BENCH_BLOCK_LEN));
+        }
+    }
+    TEST_ASSERT(memcmp(dst, text, BENCH_BLOCKS * BENCH_BLOCK_LEN) == 0);
+    return sim_time_us() - startUs;
+}
+
+/*******************************************************************************
+* Function Name: __wrap_eeprom_write, __wrap_eeprom_wait_ready,
+*                __wrap_eeprom_read, __wrap_eeprom_read_stream
+********************************************************************************
+* Summary:
+*  The Makefile links this program with the EEPROM calls of the codec
+*  wrapped. While benchRam is set they work on ram instead of the simulated
+*  bus, so the host CPU time of the codec can be measured on its own.
+*
+*******************************************************************************/
+uint8_t __real_eeprom_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+uint8_t __real_eeprom_wait_ready(uint32_t timeoutMs);
+uint8_t __real_eeprom_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len);
+uint8_t __real_eeprom_read_stream(eeprom_addr_t addr, uint32_t len, eeprom_stream_callback_t consumer);
+
+uint8_t __wrap_eeprom_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    if (!benchRam)
+    {
+        return __real_eeprom_write(addr, src, len);
+    }
+    (void)memcpy(&ram[addr], src, len);
+    return TRANSFER_CMPLT;
+}
+
+uint8_t __wrap_eeprom_wait_ready(uint32_t timeoutMs)
+{
+    return benchRam ? TRANSFER_CMPLT : __real_eeprom_wait_ready(timeoutMs);
+}
+
+uint8_t __wrap_eeprom_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    if (!benchRam)
+    {
+        return __real_eeprom_read(addr, dst, len);
+    }
+    (void)memcpy(dst, &ram[addr], len);
+    return TRANSFER_CMPLT;
+}
+
+uint8_t __wrap_eeprom_read_stream(eeprom_addr_t addr, uint32_t len, eeprom_stream_callback_t consumer)
+{
+    if (!benchRam)
+    {
+        return __real_eeprom_read_stream(addr, len, consumer);
+    }
+    for (uint32_t offset = 0UL; offset < len; offset += EEPROM_STREAM_CHUNK_SIZE)
+    {
+        consumer(&ram[addr + offset], ((len - offset) < EEPROM_STREAM_CHUNK_SIZE) ? (len - offset) :
+                                      EEPROM_STREAM_CHUNK_SIZE);
+    }
+    return TRANSFER_CMPLT;
+}
+
+/*******************************************************************************
+* Function Name: BenchCodec
+********************************************************************************
+* Summary:
+*  Prints the host CPU time per byte of log text of the encoder and of the
+*  decoder, with the EEPROM in RAM.
+*
+*******************************************************************************/
+static void BenchCodec(void)
+{
+    const double bytes = (double)(BENCH_BLOCKS * BENCH_BLOCK_LEN * BENCH_PASSES);
+    uint64_t bestNs[2] = { UINT64_MAX, UINT64_MAX };
+    uint64_t bestTicks[2] = { UINT64_MAX, UINT64_MAX };
+    uint32_t stored;
+
+    benchRam = true;
+    for (uint32_t run = 0UL; run < BENCH_RUNS; run++)
+    {
+        for (uint32_t step = 0UL; step < 2UL; step++)
+        {
+            uint64_t startNs = BenchNowNs();
+            uint64_t startTicks = BenchTicks();
+
+            for (uint32_t pass = 0UL; pass < BENCH_PASSES; pass++)
+            {
+                for (uint32_t b = 0UL; b < BENCH_BLOCKS; b++)
+                {
+                    if (step == 0UL)
+                    {
+                        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write((eeprom_addr_t)(b * BENCH_SLOT_SIZE),
+                                                                          BENCH_SLOT_SIZE, &text[b * BENCH_BLOCK_LEN],
+                                                                          BENCH_BLOCK_LEN, &stored));
+                    }
+                    else
+                    {
+                        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_read_stream((eeprom_addr_t)(b * BENCH_SLOT_SIZE),
+                                                                                &BenchConsumer));
+                    }
+                }
+                streamLen = 0UL;
+            }
+            startTicks = BenchTicks() - startTicks;
+            startNs = BenchNowNs() - startNs;
+            bestNs[step] = (startNs < bestNs[step]) ? startNs : bestNs[step];
+            bestTicks[step] = (startTicks < bestTicks[step]) ? startTicks : bestTicks[step];
+        }
+    }
+    benchRam = false;
+
+    printf(" %-20s %9.2f %15.1f\n", "encode", (double)bestNs[0] / bytes, (double)bestTicks[0] / bytes);
+    printf(" %-20s %9.2f %15.1f\n", "decode", (double)bestNs[1] / bytes, (double)bestTicks[1] / bytes);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Prints the compression ratio of several kinds of data, the simulated time
+*  of storing log text compressed and as plain page writes, and the host CPU
+*  time of both.
+*
+*******************************************************************************/
+int main(void)
+{
+    bench_sim_t plain;
+    bench_sim_t lz;
+    uint64_t plainReadUs;
+    uint64_t lzReadUs;
+
+    test_init();
+
+    printf("bench_lz: window %lu B, hash %u bits\n", EEPROM_LZ_WINDOW_SIZE, (unsigned)EEPROM_LZ_HASH_BITS);
+    printf(" data                  bytes   stored   ratio\n");
+    test_log_text(text, BENCH_BYTES, 0UL);
+    BenchRatio("log text", BENCH_BLOCK_LEN);
+    BenchRatio("log text", BENCH_BYTES);
+    test_fill(text, BENCH_BYTES, 1UL);
+    BenchRatio("test pattern", BENCH_BYTES);
+    for (uint32_t i = 0UL; i < BENCH_BYTES; i++)
+    {
+        text[i] = (uint8_t)sim_random();
+    }
+    BenchRatio("random", BENCH_BYTES);
+
+    test_log_text(text, BENCH_BYTES, 0UL);
+    plain = BenchWrite(false);
+    plainReadUs = BenchRead(false);
+    lz = BenchWrite(true);
+    lzReadUs = BenchRead(true);
+
+    printf("\n%lu blocks of %lu B of log text, tWR %lu us\n", BENCH_BLOCKS, BENCH_BLOCK_LEN,
+           SIM_EEPROM_WRITE_CYCLE_US);
+    printf(" workload          EEPROM B  cycles   write ms  write B/s    read ms   read B/s\n");
+    printf(" page writes       %8lu %7lu %10.1f %10.0f %10.1f %10.0f\n", (unsigned long)plain.eepromBytes,
+           (unsigned long)plain.writeCycles, (double)plain.us / 1000.0,
+           (double)(BENCH_BLOCKS * BENCH_BLOCK_LEN) * 1e6 / (double)plain.us, (double)plainReadUs / 1000.0,
+           (double)(BENCH_BLOCKS * BENCH_BLOCK_LEN) * 1e6 / (double)plainReadUs);
+    printf(" LZ blocks         %8lu %7lu %10.1f %10.0f %10.1f %10.0f\n", (unsigned long)lz.eepromBytes,
+           (unsigned long)lz.writeCycles, (double)lz.us / 1000.0,
+           (double)(BENCH_BLOCKS * BENCH_BLOCK_LEN) * 1e6 / (double)lz.us, (double)lzReadUs / 1000.0,
+           (double)(BENCH_BLOCKS * BENCH_BLOCK_LEN) * 1e6 / (double)lzReadUs);
+
+    printf("\nhost CPU per byte of log text, EEPROM in RAM, best of %lu\n", BENCH_RUNS);
+    printf(" codec                  ns/byte  TSC ticks/byte\n");
+    BenchCodec();
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name:  bench_power.c
+*
+* Description:  Benchmark of CPU active time per KB, with and without sleep in
+*               the wait paths.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_power.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Data moved by each workload */
+#define BENCH_BYTES             (4096UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t image[BENCH_BYTES];
+
+/*******************************************************************************
+* Function Name: BenchReport
+********************************************************************************
+* Summary:
+*  Prints the wall time, the CPU active time and the sleeps since the last
+*  eeprom_power_reset(), per KB of data.
+*
+*******************************************************************************/
+static void BenchReport(const char *name)
+{
+    eeprom_power_stats_t stats;
+
+    eeprom_power_get(&stats);
+    printf(" %-16s %9u %9u %12u %7u\n", name, (unsigned)stats.elapsedUs, (unsigned)stats.activeUs,
+           (unsigned)((stats.activeUs * 1024ULL) / BENCH_BYTES), (unsigned)stats.sleeps);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Measures the CPU active time of page writes and reads at 400 kHz. The
+*  Makefile builds this program twice: bench_power with the default
+*  EEPROM_POWER_SLEEP_ENABLE and bench_power_busy with the busy-wait loops.
+*
+*******************************************************************************/
+int main(void)
+{
+    static uint8_t dst[BENCH_BYTES];
+
+    test_init();
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+    test_fill(image, sizeof(image), 5UL);
+
+    printf("bench_power: %lu bytes at 400 kHz, tWR %lu us, EEPROM_POWER_SLEEP_ENABLE %u\n", BENCH_BYTES,
+           SIM_EEPROM_WRITE_CYCLE_US, (unsigned)EEPROM_POWER_SLEEP_ENABLE);
+    printf(" workload            wall us active us active us/KB  sleeps\n");
+
+    eeprom_power_reset();
+    for (uint32_t addr = 0UL; addr < BENCH_BYTES; addr += EEPROM_PAGE_SIZE)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, &image[addr], EEPROM_PAGE_SIZE));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    }
+    BenchReport("page write");
+
+    eeprom_power_reset();
+    for (uint32_t addr = 0UL; addr < BENCH_BYTES; addr += EEPROM_PAGE_SIZE)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)addr, &dst[addr], EEPROM_PAGE_SIZE));
+    }
+    BenchReport("64 B reads");
+    TEST_ASSERT(memcmp(dst, image, sizeof(image)) == 0);
+
+    eeprom_power_reset();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0u, dst, BENCH_BYTES));
+    BenchReport("4 KB read");
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,186 @@
+/******************************************************************************
+* File Name:  bench_queue.c
+*
+* Description:  Host benchmark of the transaction queue: throughput at several
+*               queue depths against the blocking functions.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_queue.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Region of the benchmark, and the size of its small reads */
+#define BENCH_SIZE              (4096UL)
+#define BENCH_RECORD_SIZE       (16UL)
+
+/* CPU time the producer spends preparing each transaction in the second run */
+#define BENCH_WORK_US           (300u)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint32_t benchDepths[] = { 1UL, 2UL, 4UL, EEPROM_QUEUE_DEPTH };
+
+static uint8_t benchData[BENCH_SIZE];
+static uint8_t benchBack[BENCH_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchQueue
+********************************************************************************
+* Summary:
+*  Submits the region as transactions of size bytes, with at most depth of
+*  them outstanding, spending workUs before each, and returns the elapsed
+*  time.
+*
+*******************************************************************************/
+static uint64_t BenchQueue(uint8_t op, uint32_t size, uint32_t depth, uint16_t workUs)
+{
+    uint64_t startNs = sim_time_ns();
+
+    for (uint32_t offset = 0UL; offset < BENCH_SIZE; offset += size)
+    {
+        Cy_SysLib_DelayUs(workUs);
+        while (eeprom_queue_pending() >= depth)
+        {
+            Cy_SysLib_DelayUs(5u);
+        }
+        TEST_ASSERT_EQUAL(TRANSFER_STARTED, (op == EEPROM_OP_WRITE) ?
+                          eeprom_queue_write((eeprom_addr_t)offset, &benchData[offset], size, NULL) :
+                          eeprom_queue_read((eeprom_addr_t)offset, &benchBack[offset], size, NULL));
+    }
+    while (eeprom_queue_pending() > 0UL)
+    {
+        Cy_SysLib_DelayUs(5u);
+    }
+    return sim_time_ns() - startNs;
+}
+
+/*******************************************************************************
+* Function Name: BenchBlocking
+********************************************************************************
+* Summary:
+*  Transfers the region with the blocking functions, one call at a time,
+*  spending workUs before each.
+*
+*******************************************************************************/
+static uint64_t BenchBlocking(uint8_t op, uint32_t size, uint16_t workUs)
+{
+    uint64_t startNs = sim_time_ns();
+
+    for (uint32_t offset = 0UL; offset < BENCH_SIZE; offset += size)
+    {
+        Cy_SysLib_DelayUs(workUs);
+        if (op == EEPROM_OP_WRITE)
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)offset, &benchData[offset], size));
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)offset, &benchBack[offset], size));
+        }
+    }
+    return sim_time_ns() - startNs;
+}
+
+/*******************************************************************************
+* Function Name: BenchRun
+********************************************************************************
+* Summary:
+*  Runs one workload with the blocking functions (depth 0) or the queue, and
+*  returns the throughput.
+*
+*******************************************************************************/
+static double BenchRun(uint8_t op, uint32_t size, uint32_t depth, uint16_t workUs)
+{
+    uint64_t ns;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    ns = (depth == 0UL) ? BenchBlocking(op, size, workUs) : BenchQueue(op, size, depth, workUs);
+    return ((double)BENCH_SIZE * 1e9) / (double)ns;
+}
+
+/*******************************************************************************
+* Function Name: BenchOp
+********************************************************************************
+* Summary:
+*  Prints the throughput of one workload with the blocking functions and at
+*  each queue depth, without and with producer work.
+*
+*******************************************************************************/
+static void BenchOp(const char *name, uint8_t op, uint32_t size)
+{
+    printf(" %-17s blocking %10.0f %10.0f\n", name, BenchRun(op, size, 0UL, 0u),
+           BenchRun(op, size, 0UL, BENCH_WORK_US));
+
+    for (uint32_t d = 0UL; d < (sizeof(benchDepths) / sizeof(benchDepths[0])); d++)
+    {
+        printf(" %-17s %8u %10.0f %10.0f\n", name, (unsigned)benchDepths[d],
+               BenchRun(op, size, benchDepths[d], 0u), BenchRun(op, size, benchDepths[d], BENCH_WORK_US));
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Compares the blocking functions with the transaction queue at several
+*  queue depths, for page writes and small reads at 400 kHz. The second
+*  column adds producer work before each transaction, which the queue
+*  overlaps with the bus.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    test_fill(benchData, sizeof(benchData), 11UL);
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+
+    printf("bench_queue: %lu bytes at 400 kHz, tWR %lu us\n", BENCH_SIZE, SIM_EEPROM_WRITE_CYCLE_US);
+    printf(" workload             depth    bytes/s  bytes/s with %u us work\n", BENCH_WORK_US);
+    BenchOp("64 B page writes", EEPROM_OP_WRITE, EEPROM_PAGE_SIZE);
+    BenchOp("16 B reads", EEPROM_OP_READ, BENCH_RECORD_SIZE);
+
+    return 0;
+}
+
+/* [] END OF FILE */
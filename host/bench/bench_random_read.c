@@ -0,0 +1,179 @@
+/******************************************************************************
+* File Name:  bench_random_read.c
+*
+* Description:  Host benchmark of small random reads: the original address
+*               write and read pair against the single-transaction random
+*               read.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_RUNS              (200UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern cy_stc_scb_i2c_context_t CYBSP_I2C_context;
+
+static const uint32_t benchSizes[] = { 1UL, 4UL, 16UL, 64UL };
+
+/*******************************************************************************
+* Function Name: BaselineWait
+********************************************************************************
+* Summary:
+*  Status poll loop of the original example: one status read every
+*  CY_SCB_WAIT_1_UNIT milliseconds until the driver is idle.
+*
+*******************************************************************************/
+static uint32_t BaselineWait(void)
+{
+    uint32_t masterStatus;
+
+    do
+    {
+        masterStatus = Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context);
+        Cy_SysLib_Delay(CY_SCB_WAIT_1_UNIT);
+    } while (0UL != (masterStatus & CY_SCB_I2C_MASTER_BUSY));
+
+    return masterStatus;
+}
+
+/*******************************************************************************
+* Function Name: BaselineRead
+********************************************************************************
+* Summary:
+*  Random read as the original ReadFromEEPROM() did it: the address is sent
+*  as one blocking transfer without Stop, then the read is started and waited
+*  for on its own, each with the status poll loop.
+*
+*******************************************************************************/
+static void BaselineRead(uint32_t addr, uint8_t *dst, uint32_t len)
+{
+    uint8_t header[2] = { (uint8_t)(addr >> 8u), (uint8_t)addr };
+    cy_stc_scb_i2c_master_xfer_config_t xfer =
+    {
+        .slaveAddress = EEPROM_SLAVE_ADDR,
+        .buffer       = header,
+        .bufferSize   = sizeof(header),
+        .xferPending  = true
+    };
+
+    TEST_ASSERT_EQUAL(CY_SCB_I2C_SUCCESS, Cy_SCB_I2C_MasterWrite(CYBSP_I2C_HW, &xfer, &CYBSP_I2C_context));
+    TEST_ASSERT_EQUAL(0u, BaselineWait() & MASTER_ERROR_MASK);
+
+    xfer.buffer      = dst;
+    xfer.bufferSize  = len;
+    xfer.xferPending = false;
+    TEST_ASSERT_EQUAL(CY_SCB_I2C_SUCCESS, Cy_SCB_I2C_MasterRead(CYBSP_I2C_HW, &xfer, &CYBSP_I2C_context));
+    TEST_ASSERT_EQUAL(0u, BaselineWait() & MASTER_ERROR_MASK);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Compares the latency of small random reads of the original two-transfer
+*  sequence with eeprom_read(), at 400 kHz. Each read starts at a random
+*  address and a random phase of the SysTick period.
+*
+*******************************************************************************/
+int main(void)
+{
+    static uint8_t dst[64];
+    cy_cb_scb_i2c_handle_events_t driverEvents;
+
+    test_init();
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(400000UL));
+
+    printf("bench_random_read: 400 kHz, %lu reads each\n", BENCH_RUNS);
+    printf(" bytes  bus us  before avg us  before max us  after avg us  after max us\n");
+    for (uint32_t s = 0UL; s < (sizeof(benchSizes) / sizeof(benchSizes[0])); s++)
+    {
+        uint64_t beforeNs = 0ULL;
+        uint64_t beforeMaxNs = 0ULL;
+        uint64_t afterNs = 0ULL;
+        uint64_t afterMaxNs = 0ULL;
+        sim_i2c_stats_t bus;
+
+        /* The original example had no event handler */
+        driverEvents = CYBSP_I2C_context.cbEvents;
+        CYBSP_I2C_context.cbEvents = NULL;
+        for (uint32_t run = 0UL; run < BENCH_RUNS; run++)
+        {
+            uint32_t addr = (uint32_t)(sim_random() % (EEPROM_SIZE - benchSizes[s]));
+            uint64_t startNs;
+
+            sim_run_us(sim_random() % 1000ULL);
+            startNs = sim_time_ns();
+            BaselineRead(addr, dst, benchSizes[s]);
+            startNs = sim_time_ns() - startNs;
+            beforeNs += startNs;
+            beforeMaxNs = (startNs > beforeMaxNs) ? startNs : beforeMaxNs;
+        }
+        CYBSP_I2C_context.cbEvents = driverEvents;
+
+        sim_i2c_reset_stats();
+        for (uint32_t run = 0UL; run < BENCH_RUNS; run++)
+        {
+            uint32_t addr = (uint32_t)(sim_random() % (EEPROM_SIZE - benchSizes[s]));
+            uint64_t startNs;
+
+            sim_run_us(sim_random() % 1000ULL);
+            startNs = sim_time_ns();
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)addr, dst, benchSizes[s]));
+            startNs = sim_time_ns() - startNs;
+            afterNs += startNs;
+            afterMaxNs = (startNs > afterMaxNs) ? startNs : afterMaxNs;
+        }
+        sim_i2c_get_stats(&bus);
+
+        printf(" %5u %7.1f %14.1f %14.1f %13.1f %13.1f\n", (unsigned)benchSizes[s],
+               (double)bus.busyNs / (1000.0 * BENCH_RUNS),
+               (double)beforeNs / (1000.0 * BENCH_RUNS), (double)beforeMaxNs / 1000.0,
+               (double)afterNs / (1000.0 * BENCH_RUNS), (double)afterMaxNs / 1000.0);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
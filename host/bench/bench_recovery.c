@@ -0,0 +1,129 @@
+/******************************************************************************
+* File Name:  bench_recovery.c
+*
+* Description:  Benchmark of bus recovery latency with an injected stuck
+*               slave.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_recovery.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_RUNS              (20UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint32_t benchRates[] = { 100000UL, 400000UL };
+static const uint32_t benchLens[] = { 4UL, EEPROM_PAGE_SIZE };
+
+/*******************************************************************************
+* Function Name: BenchRead
+********************************************************************************
+* Summary:
+*  Returns the average time of eeprom_read() of len bytes, with a slave
+*  stuck on SDA for up to eight clocks before each read when stuck is set.
+*
+*******************************************************************************/
+static double BenchRead(uint32_t len, bool stuck)
+{
+    uint8_t dst[EEPROM_PAGE_SIZE];
+    uint64_t totalUs = 0ULL;
+
+    for (uint32_t i = 0UL; i < BENCH_RUNS; i++)
+    {
+        uint64_t startUs;
+
+        if (stuck)
+        {
+            sim_i2c_hold_sda(1UL + (uint32_t)(sim_random() % 8ULL));
+        }
+        startUs = sim_time_us();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0u, dst, len));
+        totalUs += sim_time_us() - startUs;
+    }
+    return ((double)totalUs / (double)BENCH_RUNS);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Measures the time to detect a stuck bus, to clear it, and the latency a
+*  stuck bus adds to a read, which includes the transfer timeout.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    printf("bench_recovery: slave stuck on SDA, %lu runs each\n", BENCH_RUNS);
+    printf("     kHz detect us  clear us  bytes  read us  stuck read us  timeout ms\n");
+    for (uint32_t r = 0UL; r < (sizeof(benchRates) / sizeof(benchRates[0])); r++)
+    {
+        uint64_t startUs;
+        uint64_t detectUs;
+        uint64_t clearUs;
+
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(benchRates[r]));
+
+        sim_i2c_hold_sda(8UL);
+        startUs = sim_time_us();
+        TEST_ASSERT(eeprom_recovery_bus_stuck());
+        detectUs = sim_time_us() - startUs;
+        startUs = sim_time_us();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_recovery_clear_bus());
+        clearUs = sim_time_us() - startUs;
+
+        for (uint32_t l = 0UL; l < (sizeof(benchLens) / sizeof(benchLens[0])); l++)
+        {
+            printf(" %7u %9u %9u %6u %8.0f %14.0f %11u\n", (unsigned)(benchRates[r] / 1000u),
+                   (unsigned)detectUs, (unsigned)clearUs, (unsigned)benchLens[l],
+                   BenchRead(benchLens[l], false), BenchRead(benchLens[l], true),
+                   (unsigned)eeprom_bus_timeout_ms(benchLens[l]));
+        }
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/******************************************************************************
+* File Name:  bench_stream.c
+*
+* Description:  Streaming read throughput against chunked reads.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint32_t benchRates[] = { 100000UL, 400000UL, 1000000UL };
+
+/* Bytes handed to the consumer */
+static uint32_t streamBytes;
+
+/*******************************************************************************
+* Function Name: StreamCount
+********************************************************************************
+* Summary:
+*  Stream consumer, counts the bytes it is given.
+*
+*******************************************************************************/
+static void StreamCount(const uint8_t *data, uint32_t len)
+{
+    (void)data;
+    streamBytes += len;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Reads the whole array through a EEPROM_STREAM_CHUNK_SIZE buffer, once
+*  with one eeprom_read() per chunk and once with eeprom_read_stream(), and
+*  prints the throughput of both next to the bus limit of 9 clocks per byte.
+*
+*******************************************************************************/
+int main(void)
+{
+    static uint8_t chunk[EEPROM_STREAM_CHUNK_SIZE];
+
+    test_init();
+
+    printf("bench_stream: %lu bytes, %lu byte chunks\n", EEPROM_SIZE, EEPROM_STREAM_CHUNK_SIZE);
+    printf("    rate  bus limit B/s  chunked B/s  stream B/s  chunked txns  stream txns\n");
+    for (uint32_t r = 0UL; r < (sizeof(benchRates) / sizeof(benchRates[0])); r++)
+    {
+        uint64_t chunkedNs;
+        uint64_t streamNs;
+        sim_i2c_stats_t chunkedBus;
+        sim_i2c_stats_t streamBus;
+
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(benchRates[r]));
+
+        sim_i2c_reset_stats();
+        chunkedNs = sim_time_ns();
+        for (uint32_t addr = 0UL; addr < EEPROM_SIZE; addr += EEPROM_STREAM_CHUNK_SIZE)
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)addr, chunk,
+                                                          EEPROM_STREAM_CHUNK_SIZE));
+        }
+        chunkedNs = sim_time_ns() - chunkedNs;
+        sim_i2c_get_stats(&chunkedBus);
+
+        streamBytes = 0UL;
+        sim_i2c_reset_stats();
+        streamNs = sim_time_ns();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read_stream(0U, EEPROM_SIZE, &StreamCount));
+        streamNs = sim_time_ns() - streamNs;
+        sim_i2c_get_stats(&streamBus);
+        TEST_ASSERT_EQUAL(EEPROM_SIZE, streamBytes);
+
+        printf(" %7lu %14lu %12.0f %11.0f %13lu %12lu\n", (unsigned long)benchRates[r],
+               (unsigned long)(benchRates[r] / 9UL),
+               (double)EEPROM_SIZE * 1e9 / (double)chunkedNs,
+               (double)EEPROM_SIZE * 1e9 / (double)streamNs,
+               (unsigned long)chunkedBus.stops, (unsigned long)streamBus.stops);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name:  bench_stripe.c
+*
+* Description:  Benchmark of striped programming over one to eight EEPROMs on
+*               the simulated bus.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_stripe.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Pages programmed in each run: the size of one 24LC128 */
+#define BENCH_PAGES             (EEPROM_SIZE / EEPROM_PAGE_SIZE)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern cy_stc_scb_i2c_context_t CYBSP_I2C_context;
+
+static const uint32_t benchRates[] = { 400000UL, 1000000UL };
+static const uint32_t benchCounts[] = { 1UL, 2UL, 3UL, 4UL, 8UL };
+static const uint32_t benchCycles[] = { SIM_EEPROM_WRITE_CYCLE_US, 5000UL };
+
+static eeprom_dev_t devices[EEPROM_STRIPE_MAX_DEVICES];
+static uint8_t image[BENCH_PAGES * EEPROM_PAGE_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchStripe
+********************************************************************************
+* Summary:
+*  Programs BENCH_PAGES pages striped over count devices and prints the data
+*  rate, the speed-up over one device and the share of time the bus is busy.
+*  Returns the data rate.
+*
+*******************************************************************************/
+static double BenchStripe(uint32_t rateHz, uint32_t cycleUs, uint32_t count, double singleRate)
+{
+    sim_i2c_stats_t bus;
+    uint64_t startNs;
+    uint64_t elapsedNs;
+    double rate;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_init(devices, count));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_wait_ready());
+    sim_i2c_reset_stats();
+    startNs = sim_time_ns();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_write(0UL, image, sizeof(image)));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_wait_ready());
+
+    elapsedNs = sim_time_ns() - startNs;
+    sim_i2c_get_stats(&bus);
+    rate = ((double)sizeof(image) * 1e9) / (double)elapsedNs;
+    printf(" %7u %7u %7u %9.0f %7.2f %6.1f%%\n", (unsigned)(rateHz / 1000u), (unsigned)cycleUs,
+           (unsigned)count, rate, (singleRate > 0.0) ? (rate / singleRate) : 1.0,
+           ((double)bus.busyNs * 100.0) / (double)elapsedNs);
+    return rate;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Measures eeprom_stripe_write() over one to eight devices on one bus, for
+*  the simulated write cycle and the 5 ms datasheet maximum.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    for (uint32_t i = 0UL; i < EEPROM_STRIPE_MAX_DEVICES; i++)
+    {
+        devices[i].base      = CYBSP_I2C_HW;
+        devices[i].context   = &CYBSP_I2C_context;
+        devices[i].slaveAddr = (uint8_t)(0x50u + i);
+        if (devices[i].slaveAddr != EEPROM_SLAVE_ADDR)
+        {
+            sim_eeprom_attach(devices[i].slaveAddr);
+        }
+    }
+    test_fill(image, sizeof(image), 21UL);
+
+    printf("bench_stripe: eeprom_stripe_write() of %u pages + eeprom_stripe_wait_ready()\n",
+           (unsigned)BENCH_PAGES);
+    printf("     kHz tWR us devices   bytes/s speedup   bus\n");
+    for (uint32_t r = 0UL; r < (sizeof(benchRates) / sizeof(benchRates[0])); r++)
+    {
+        if (eeprom_bus_set_speed(benchRates[r]) != I2C_SUCCESS)
+        {
+            printf(" %7u not accepted by the driver\n", (unsigned)(benchRates[r] / 1000u));
+            continue;
+        }
+        for (uint32_t c = 0UL; c < (sizeof(benchCycles) / sizeof(benchCycles[0])); c++)
+        {
+            double singleRate = 0.0;
+
+            sim_eeprom_set_write_cycle(benchCycles[c], benchCycles[c]);
+            for (uint32_t n = 0UL; n < (sizeof(benchCounts) / sizeof(benchCounts[0])); n++)
+            {
+                double rate = BenchStripe(benchRates[r], benchCycles[c], benchCounts[n], singleRate);
+
+                if (n == 0UL)
+                {
+                    singleRate = rate;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
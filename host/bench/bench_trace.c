@@ -0,0 +1,193 @@
+/******************************************************************************
+* File Name:  bench_trace.c
+*
+* Description:  Host CPU cost of one eeprom_trace() call against formatting
+*               the line with snprintf().
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_trace.h"
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC           (1u)
+#else
+#define BENCH_HAS_TSC           (0u)
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Messages that fit the ring at once, and rounds of them; the fastest run
+ * counts */
+#define BENCH_BATCH             (EEPROM_TRACE_DEPTH - 1UL)
+#define BENCH_ROUNDS            (2000UL)
+#define BENCH_RUNS              (5UL)
+
+/* Workloads */
+#define BENCH_QUEUED            (0u)    /* eeprom_trace() into a ring with room */
+#define BENCH_DROPPED           (1u)    /* eeprom_trace() into a full ring */
+#define BENCH_SPRINTF           (2u)    /* The old check_status() formatting */
+#define BENCH_COUNT             (3u)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_scb_uart_context_t uartContext;
+
+/*******************************************************************************
+* Function Name: BenchNowNs
+********************************************************************************
+* Summary:
+*  Returns the host monotonic time. This benchmark measures the host CPU, not
+*  the simulation.
+*
+*******************************************************************************/
+static uint64_t BenchNowNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: BenchBatch
+********************************************************************************
+* Summary:
+*  Runs one batch of a workload and returns its host time and time-stamp
+*  counter ticks. The ring is emptied outside of the measurement.
+*
+*******************************************************************************/
+static void BenchBatch(uint8_t workload, uint64_t *ns, uint64_t *ticks)
+{
+    static char buf[50];
+    volatile uint32_t sink = 0UL;
+    uint64_t startNs;
+    uint64_t startTicks = 0ULL;
+    uint32_t intState;
+
+    /* The UART interrupt must not drain the ring during the batch */
+    intState = Cy_SysLib_EnterCriticalSection();
+    if (workload == BENCH_DROPPED)
+    {
+        for (uint32_t i = 0UL; i < BENCH_BATCH; i++)
+        {
+            eeprom_trace(EEPROM_TRACE_MSG_WRITE_FAIL, i);
+        }
+    }
+
+    startNs = BenchNowNs();
+#if BENCH_HAS_TSC
+    startTicks = __rdtsc();
+#endif
+    for (uint32_t i = 0UL; i < BENCH_BATCH; i++)
+    {
+        if (workload == BENCH_SPRINTF)
+        {
+            sink += (uint32_t)snprintf(buf, sizeof(buf), "\r\n\n Writing to EEPROM failed, status 0x%08X\r\n",
+                                       (unsigned)i);
+        }
+        else
+        {
+            eeprom_trace(EEPROM_TRACE_MSG_WRITE_FAIL, i);
+        }
+    }
+#if BENCH_HAS_TSC
+    *ticks += __rdtsc() - startTicks;
+#else
+    (void)startTicks;
+#endif
+    *ns += BenchNowNs() - startNs;
+
+    eeprom_trace_flush();
+    Cy_SysLib_ExitCriticalSection(intState);
+    (void)sink;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Times eeprom_trace() on the host, with room in the ring and on a full ring,
+*  against formatting the same line with snprintf() as DEBUG_PRINT did, and
+*  prints nanoseconds and time-stamp counter ticks per call.
+*
+*******************************************************************************/
+int main(void)
+{
+    static const char *names[BENCH_COUNT] = { "eeprom_trace()", "eeprom_trace() full", "snprintf()" };
+
+    /* A fast line keeps the flush between the batches short */
+    sim_uart_set_baud(100000000UL);
+    __enable_irq();
+    (void)Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &uartContext);
+    Cy_SCB_UART_Enable(CYBSP_UART_HW);
+    TEST_ASSERT(eeprom_trace_init() == CY_SYSINT_SUCCESS);
+
+    printf("bench_trace: cost per message on the host CPU, %lu calls per run, best of %lu\n",
+           BENCH_BATCH * BENCH_ROUNDS, BENCH_RUNS);
+    printf(" call                    ns/call  TSC ticks/call\n");
+    for (uint8_t w = 0u; w < BENCH_COUNT; w++)
+    {
+        uint64_t bestNs = UINT64_MAX;
+        uint64_t bestTicks = UINT64_MAX;
+
+        for (uint32_t run = 0UL; run < BENCH_RUNS; run++)
+        {
+            uint64_t ns = 0ULL;
+            uint64_t ticks = 0ULL;
+
+            for (uint32_t round = 0UL; round < BENCH_ROUNDS; round++)
+            {
+                BenchBatch(w, &ns, &ticks);
+            }
+            bestNs = (ns < bestNs) ? ns : bestNs;
+            bestTicks = (ticks < bestTicks) ? ticks : bestTicks;
+        }
+
+        printf(" %-21s %9.1f %15.1f\n", names[w],
+               (double)bestNs / (double)(BENCH_BATCH * BENCH_ROUNDS),
+               (double)bestTicks / (double)(BENCH_BATCH * BENCH_ROUNDS));
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,123 @@
+/******************************************************************************
+* File Name:  bench_uart.c
+*
+* Description:  Benchmark of programming an image through the UART protocol.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "uart_host.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_WRITE_CYCLE_US    (5000UL)
+
+/* Bytes of a WRITE frame on the line, and bits of a byte */
+#define BENCH_WRITE_FRAME_SIZE  (1UL + EEPROM_UART_HEADER_SIZE + EEPROM_UART_CHUNK_SIZE + EEPROM_CRC32_SIZE)
+#define BENCH_BITS_PER_BYTE     (10ULL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t image[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchEeprom
+********************************************************************************
+* Summary:
+*  Returns the time to write the image one page after the other, waiting for
+*  each write cycle, without the UART.
+*
+*******************************************************************************/
+static uint64_t BenchEeprom(void)
+{
+    uint64_t startUs = sim_time_us();
+
+    for (uint32_t addr = 0UL; addr < EEPROM_SIZE; addr += EEPROM_PAGE_SIZE)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, &image[addr], EEPROM_PAGE_SIZE));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    }
+    return sim_time_us() - startUs;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Programs a full image through the UART protocol at several baud rates,
+*  and compares the time with the UART time alone, the EEPROM time alone,
+*  and their sum, which is what receiving a page and then writing it before
+*  asking for the next one would take.
+*
+*******************************************************************************/
+int main(void)
+{
+    static const uint32_t rates[] = { 115200UL, 460800UL, 921600UL };
+    const uint32_t frames = EEPROM_SIZE / EEPROM_UART_CHUNK_SIZE;
+    uint64_t eepromUs;
+
+    uart_host_init(rates[0]);
+    sim_eeprom_set_write_cycle(BENCH_WRITE_CYCLE_US, BENCH_WRITE_CYCLE_US);
+    test_fill(image, sizeof(image), 0UL);
+    eepromUs = BenchEeprom();
+
+    printf("bench_uart: %lu bytes, tWR %lu us, %lu frames in flight\n", (unsigned long)EEPROM_SIZE,
+           BENCH_WRITE_CYCLE_US, (unsigned long)UART_HOST_WINDOW);
+    printf("     baud  program ms     UART ms   EEPROM ms   serial ms\n");
+
+    for (uint32_t i = 0UL; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        uint64_t uartUs = (frames * BENCH_WRITE_FRAME_SIZE * BENCH_BITS_PER_BYTE * 1000000ULL) / rates[i];
+        uint64_t programUs;
+
+        sim_uart_set_baud(rates[i]);
+        test_fill(image, sizeof(image), i + 1UL);
+
+        programUs = uart_host_program(0UL, image, sizeof(image));
+        TEST_ASSERT_EQUAL(0u, uartHost.errors);
+        TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), image, sizeof(image)) == 0);
+
+        printf(" %8lu %11.1f %11.1f %11.1f %11.1f\n", (unsigned long)rates[i], (double)programUs / 1000.0,
+               (double)uartUs / 1000.0, (double)eepromUs / 1000.0, (double)(uartUs + eepromUs) / 1000.0);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/******************************************************************************
+* File Name:  bench_write.c
+*
+* Description:  Host benchmark of eeprom_write(): data rate and write cycles
+*               of whole-array and random-span programming at each bus clock.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint32_t benchRates[] = { 100000UL, 400000UL, 1000000UL };
+
+static uint8_t image[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: BenchSpans
+********************************************************************************
+* Summary:
+*  Writes spans of random length up to maxLen at random addresses, or the
+*  whole array from offset when maxLen is 0, and prints the data rate and
+*  the write cycles used against the least possible.
+*
+*******************************************************************************/
+static void BenchSpans(uint32_t rateHz, const char *name, uint32_t offset, uint32_t maxLen)
+{
+    uint32_t bytes = 0UL;
+    uint32_t minCycles = 0UL;
+    uint64_t startNs;
+    sim_eeprom_stats_t stats;
+
+    sim_eeprom_reset_stats();
+    startNs = sim_time_ns();
+
+    if (maxLen == 0UL)
+    {
+        bytes = EEPROM_SIZE - offset;
+        minCycles = (bytes + (offset % EEPROM_PAGE_SIZE) + EEPROM_PAGE_SIZE - 1UL) / EEPROM_PAGE_SIZE;
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)offset, image, bytes));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    }
+    else
+    {
+        while (bytes < EEPROM_SIZE)
+        {
+            uint32_t len = 1UL + (uint32_t)(sim_random() % maxLen);
+            uint32_t addr = (uint32_t)(sim_random() % (EEPROM_SIZE - len + 1UL));
+
+            minCycles += ((addr + len - 1UL) / EEPROM_PAGE_SIZE) - (addr / EEPROM_PAGE_SIZE) + 1UL;
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, image, len));
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+            bytes += len;
+        }
+    }
+
+    sim_eeprom_get_stats(&stats);
+    TEST_ASSERT_EQUAL(minCycles, stats.writeCycles);
+    printf(" %7u %-18s %6u %8u %10u %8.0f\n", (unsigned)(rateHz / 1000u), name, (unsigned)bytes,
+           (unsigned)stats.writeCycles, (unsigned)minCycles,
+           ((double)bytes * 1e9) / (double)(sim_time_ns() - startNs));
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Measures eeprom_write() programming the whole array and random spans, with
+*  the write cycles it needs. The simulated write cycle is 3 ms.
+*
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    test_fill(image, sizeof(image), 7UL);
+
+    printf("bench_write: eeprom_write() + eeprom_wait_ready(), tWR %lu us\n", SIM_EEPROM_WRITE_CYCLE_US);
+    printf("     kHz span                bytes   cycles least cyc  bytes/s\n");
+    for (uint32_t r = 0UL; r < (sizeof(benchRates) / sizeof(benchRates[0])); r++)
+    {
+        if (eeprom_bus_set_speed(benchRates[r]) != I2C_SUCCESS)
+        {
+            printf(" %7u not accepted by the driver\n", (unsigned)(benchRates[r] / 1000u));
+            continue;
+        }
+        BenchSpans(benchRates[r], "full array", 0UL, 0UL);
+        BenchSpans(benchRates[r], "array from 0x20", 0x20UL, 0UL);
+        BenchSpans(benchRates[r], "random 1-16 B", 0UL, 16UL);
+        BenchSpans(benchRates[r], "random 1-256 B", 0UL, 256UL);
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
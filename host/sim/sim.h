@@ -0,0 +1,213 @@
+/******************************************************************************
+* File Name:  sim.h
+*
+* Description:  Simulator of the PMG1 peripherals and the 24LCxx EEPROM the
+*               example runs against on the host.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include "cy_pdl.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* CPU clock of the simulated PMG1 */
+#define SIM_CPU_HZ                  (48000000UL)
+
+/* Software execution time is not simulated, except for these fixed costs:
+ * entry, body and exit of one interrupt, and one polled peripheral register
+ * read (status, SysTick or pin) */
+#define SIM_ISR_CYCLES              (100UL)
+#define SIM_POLL_CYCLES             (10UL)
+
+/* Time that never comes, returned when nothing is scheduled */
+#define SIM_NEVER                   (UINT64_MAX)
+
+/* Slave address of the first simulated EEPROM, chip-select pins A2..A0 add
+ * 0 to 7 */
+#define SIM_EEPROM_BASE_ADDR        (0x50u)
+#define SIM_EEPROM_MAX_DEVICES      (8u)
+
+/* 24LC128 write cycle time: at most 5 ms by the datasheet, typically less.
+ * The model uses this fixed time unless told otherwise. */
+#define SIM_EEPROM_WRITE_CYCLE_US   (3000UL)
+
+/* Depth of the SCB FIFOs in byte mode */
+#define SIM_SCB_FIFO_SIZE           (16UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Called whenever the application sleeps or delays, for tests that drive
+ * the application from the outside */
+typedef void (*sim_hook_t)(void);
+
+/* Called for each byte the simulated UART sends, at the time its stop bit
+ * ends */
+typedef void (*sim_uart_tx_hook_t)(uint8_t data, uint64_t timeUs);
+
+/* EEPROM model counters */
+typedef struct
+{
+    uint32_t writeCycles;   /* Page writes programmed */
+    uint32_t bytesWritten;  /* Bytes programmed by those page writes */
+    uint32_t bytesRead;     /* Bytes sent to the master */
+    uint32_t busyNaks;      /* Slave addresses NAKed during a write cycle */
+    uint32_t pageWraps;     /* Data bytes that wrapped to the start of the page */
+    uint64_t busyUs;        /* Total write cycle time */
+} sim_eeprom_stats_t;
+
+/* I2C bus model counters, for this master only */
+typedef struct
+{
+    uint64_t busyNs;        /* Time this master drove the bus */
+    uint32_t starts;        /* Start and repeated Start conditions */
+    uint32_t stops;         /* Stop conditions */
+    uint32_t bytes;         /* Bytes on the bus, including slave addresses */
+    uint32_t addrNaks;      /* Slave addresses not acknowledged */
+    uint32_t arbLost;       /* Arbitration lost to the other master */
+    uint32_t busyWaits;     /* Starts held while the other master had the bus */
+} sim_i2c_stats_t;
+
+/* A second master on the bus. Chances are in parts per thousand. */
+typedef struct
+{
+    uint32_t busyChance;    /* Per bus-busy check: the other master has just started */
+    uint32_t startChance;   /* Per Start: both masters start at once, and this one loses */
+    uint32_t dataChance;    /* Per data byte: both address the same slave, and this one loses */
+    uint32_t holdUs;        /* Length of one transaction of the other master */
+} sim_i2c_master_t;
+
+/* FIFOs and interrupt sources of one SCB block. The level sources follow
+ * the FIFO fill, the others are latched until cleared. */
+typedef struct
+{
+    uint8_t tx[SIM_SCB_FIFO_SIZE];
+    uint32_t txCount;
+    uint8_t rx[SIM_SCB_FIFO_SIZE];
+    uint32_t rxCount;
+    uint32_t txLevel;       /* TX level source: fewer than txLevel entries */
+    uint32_t rxLevel;       /* RX level source: more than rxLevel entries */
+    uint32_t txStatus;
+    uint32_t rxStatus;
+    uint32_t masterStatus;
+    uint32_t txMask;
+    uint32_t rxMask;
+    uint32_t masterMask;
+} sim_scb_t;
+
+/* UART model counters */
+typedef struct
+{
+    uint32_t rxBytes;       /* Bytes received into the RX FIFO */
+    uint32_t rxOverflows;   /* Bytes lost on a full RX FIFO */
+    uint32_t rxPeak;        /* Highest RX FIFO fill */
+    uint32_t txBytes;       /* Bytes sent */
+} sim_uart_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Time and interrupts, sim_system.c */
+uint64_t sim_time_ns(void);
+uint64_t sim_time_us(void);
+void sim_run_us(uint64_t us);
+void sim_spend_ns(uint64_t ns);
+void sim_poll(void);
+void sim_set_hook(sim_hook_t hook);
+uint32_t sim_isr_count(void);
+uint32_t sim_sleep_count(void);
+void sim_button_press(void);
+bool sim_led_on(void);
+uint32_t sim_led_edges(void);
+void sim_seed(uint64_t seed);
+
+/* EEPROM model, sim_eeprom.c */
+void sim_eeprom_attach(uint8_t slaveAddr);
+void sim_eeprom_detach(uint8_t slaveAddr);
+uint8_t *sim_eeprom_mem(uint8_t slaveAddr);
+void sim_eeprom_set_write_cycle(uint32_t minUs, uint32_t maxUs);
+void sim_eeprom_power_cut(uint32_t cycles, uint32_t programmedBytes);
+bool sim_eeprom_powered(void);
+void sim_eeprom_power_on(void);
+void sim_eeprom_get_stats(sim_eeprom_stats_t *stats);
+void sim_eeprom_reset_stats(void);
+
+/* Bus side of the EEPROM model, used by the SCB model */
+bool sim_eeprom_bus_start(uint8_t addrByte);
+bool sim_eeprom_bus_write(uint8_t data);
+uint8_t sim_eeprom_bus_read(void);
+void sim_eeprom_bus_stop(void);
+uint32_t sim_eeprom_bus_page_room(void);
+
+/* I2C bus model, sim_i2c.c */
+uint32_t sim_i2c_rate_hz(void);
+void sim_i2c_fail_above(uint32_t rateHz);
+void sim_i2c_hold_sda(uint32_t clocks);
+uint32_t sim_i2c_sda_held(void);
+void sim_i2c_set_master(const sim_i2c_master_t *master);
+void sim_i2c_stretch(uint32_t us);
+void sim_i2c_get_stats(sim_i2c_stats_t *stats);
+void sim_i2c_reset_stats(void);
+
+/* UART model, sim_uart.c */
+void sim_uart_set_baud(uint32_t baud);
+void sim_uart_send_at(uint64_t timeUs, const uint8_t *data, uint32_t len);
+void sim_uart_set_tx_hook(sim_uart_tx_hook_t hook);
+void sim_uart_get_stats(sim_uart_stats_t *stats);
+
+/* SCB FIFOs and interrupt sources, sim_scb.c */
+sim_scb_t *sim_scb_get(CySCB_Type const *base);
+void sim_scb_reset(sim_scb_t *scb);
+uint32_t sim_scb_tx_status(const sim_scb_t *scb);
+uint32_t sim_scb_rx_status(const sim_scb_t *scb);
+bool sim_scb_irq_pending(const sim_scb_t *scb);
+
+/* Engines stepped by the time base */
+uint64_t sim_i2c_step(uint64_t nowNs);
+bool sim_i2c_irq_pending(void);
+uint64_t sim_uart_step(uint64_t nowNs);
+bool sim_uart_irq_pending(void);
+bool sim_i2c_line_low(bool sda);
+void sim_i2c_scl_pulse(void);
+uint64_t sim_random(void);
+
+#endif /* HOST_SIM_H_ */
@@ -0,0 +1,343 @@
+/******************************************************************************
+* File Name:  sim_eeprom.c
+*
+* Description:  Simulated 24LCxx EEPROM: page buffer, write cycle with busy
+*               NAK, page and block roll-over, power cuts.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sim.h"
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Slave address bits that select the block instead of the device */
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+#define SIM_BLOCK_MASK          (1u << EEPROM_BLOCK_SELECT_BIT)
+#else
+#define SIM_BLOCK_MASK          (0u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* One device on the bus, of the profile selected by EEPROM_DEVICE */
+typedef struct
+{
+    bool attached;
+    uint8_t slaveAddr;
+    uint8_t mem[EEPROM_SIZE];
+    uint32_t pointer;       /* Internal address counter */
+    uint64_t readyNs;       /* End of the write cycle in progress */
+} sim_eeprom_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static sim_eeprom_t devices[SIM_EEPROM_MAX_DEVICES];
+
+/* Transaction in progress */
+static sim_eeprom_t *active = NULL;
+static bool activeRead = false;
+static uint32_t activeBlock = 0UL;
+static uint32_t addrBytes = 0UL;
+static uint32_t addrValue = 0UL;
+
+/* Page buffer: data received since the memory address, in order */
+static uint8_t pageData[EEPROM_PAGE_SIZE];
+static uint32_t pageLen = 0UL;
+static uint32_t pageStart = 0UL;
+
+/* Write cycle time range */
+static uint32_t cycleMinUs = SIM_EEPROM_WRITE_CYCLE_US;
+static uint32_t cycleMaxUs = SIM_EEPROM_WRITE_CYCLE_US;
+
+/* Power cut armed for a later write cycle, and supply state */
+static bool cutArmed = false;
+static uint32_t cutCycles = 0UL;
+static uint32_t cutBytes = 0UL;
+static bool powered = true;
+
+static sim_eeprom_stats_t stats;
+
+/*******************************************************************************
+* Function Name: EepromFind
+********************************************************************************
+* Summary:
+*  Returns the device that answers to a 7-bit slave address, or NULL.
+*
+*******************************************************************************/
+static sim_eeprom_t *EepromFind(uint8_t slaveAddr)
+{
+    for (uint32_t i = 0u; i < SIM_EEPROM_MAX_DEVICES; i++)
+    {
+        if (devices[i].attached &&
+            (devices[i].slaveAddr == (uint8_t)(slaveAddr & (uint8_t)~SIM_BLOCK_MASK)))
+        {
+            return &devices[i];
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: EepromCommit
+********************************************************************************
+* Summary:
+*  Starts the write cycle of the data in the page buffer. The page is
+*  programmed at once; a power cut during the cycle leaves the first bytes
+*  programmed, one byte undefined and the rest unchanged.
+*
+*******************************************************************************/
+static void EepromCommit(void)
+{
+    uint32_t pageBase = activeBlock + (pageStart & ~(EEPROM_PAGE_SIZE - 1UL));
+    uint32_t count = (pageLen < EEPROM_PAGE_SIZE) ? pageLen : EEPROM_PAGE_SIZE;
+    uint32_t first = (pageLen > EEPROM_PAGE_SIZE) ? (pageLen - EEPROM_PAGE_SIZE) : 0UL;
+    uint32_t cycleUs = cycleMinUs;
+
+    if (cycleMaxUs > cycleMinUs)
+    {
+        cycleUs += (uint32_t)(sim_random() % ((uint64_t)cycleMaxUs - cycleMinUs + 1ULL));
+    }
+
+    /* Bytes past a full page overwrite the first ones, in order received */
+    for (uint32_t i = 0UL; i < count; i++)
+    {
+        uint32_t offset = (pageStart + first + i) % EEPROM_PAGE_SIZE;
+
+        if (cutArmed && (cutCycles == 0UL) && (i == cutBytes))
+        {
+            active->mem[pageBase + offset] = (uint8_t)sim_random();
+            break;
+        }
+        active->mem[pageBase + offset] = pageData[(first + i) % EEPROM_PAGE_SIZE];
+    }
+
+    active->readyNs = sim_time_ns() + ((uint64_t)cycleUs * 1000ULL);
+    stats.writeCycles++;
+    stats.bytesWritten += count;
+    stats.busyUs += cycleUs;
+
+    if (cutArmed && (cutCycles > 0UL))
+    {
+        cutCycles--;
+    }
+    else if (cutArmed)
+    {
+        cutArmed = false;
+        powered = false;
+    }
+}
+
+/*******************************************************************************
+* Simulator API
+*******************************************************************************/
+void sim_eeprom_attach(uint8_t slaveAddr)
+{
+    for (uint32_t i = 0u; i < SIM_EEPROM_MAX_DEVICES; i++)
+    {
+        if (!devices[i].attached)
+        {
+            devices[i].attached  = true;
+            devices[i].slaveAddr = slaveAddr;
+            devices[i].pointer   = 0UL;
+            devices[i].readyNs   = 0ULL;
+            (void)memset(devices[i].mem, 0xFF, sizeof(devices[i].mem));
+            return;
+        }
+    }
+}
+
+void sim_eeprom_detach(uint8_t slaveAddr)
+{
+    sim_eeprom_t *dev = EepromFind(slaveAddr);
+
+    if (dev != NULL)
+    {
+        dev->attached = false;
+    }
+}
+
+uint8_t *sim_eeprom_mem(uint8_t slaveAddr)
+{
+    sim_eeprom_t *dev = EepromFind(slaveAddr);
+
+    return (dev != NULL) ? dev->mem : NULL;
+}
+
+void sim_eeprom_set_write_cycle(uint32_t minUs, uint32_t maxUs)
+{
+    cycleMinUs = minUs;
+    cycleMaxUs = (maxUs > minUs) ? maxUs : minUs;
+}
+
+void sim_eeprom_power_cut(uint32_t cycles, uint32_t programmedBytes)
+{
+    cutArmed = true;
+    cutCycles = cycles;
+    cutBytes = programmedBytes;
+}
+
+bool sim_eeprom_powered(void)
+{
+    return powered;
+}
+
+void sim_eeprom_power_on(void)
+{
+    cutArmed = false;
+    powered  = true;
+    active   = NULL;
+    for (uint32_t i = 0u; i < SIM_EEPROM_MAX_DEVICES; i++)
+    {
+        devices[i].readyNs = 0ULL;
+    }
+}
+
+void sim_eeprom_get_stats(sim_eeprom_stats_t *out)
+{
+    *out = stats;
+}
+
+void sim_eeprom_reset_stats(void)
+{
+    (void)memset(&stats, 0, sizeof(stats));
+}
+
+/*******************************************************************************
+* Bus side
+*******************************************************************************/
+bool sim_eeprom_bus_start(uint8_t addrByte)
+{
+    uint8_t slaveAddr = (uint8_t)(addrByte >> 1u);
+    sim_eeprom_t *dev = EepromFind(slaveAddr);
+
+    /* A Start or repeated Start ends the transaction without programming */
+    active  = NULL;
+    pageLen = 0UL;
+
+    if ((dev == NULL) || !powered)
+    {
+        return false;
+    }
+    if (sim_time_ns() < dev->readyNs)
+    {
+        /* No acknowledge during the write cycle */
+        stats.busyNaks++;
+        return false;
+    }
+
+    active      = dev;
+    activeRead  = (0u != (addrByte & 1u));
+    activeBlock = ((SIM_BLOCK_MASK != 0u) && (0u != (slaveAddr & SIM_BLOCK_MASK))) ?
+                  EEPROM_BLOCK_SIZE : 0UL;
+    addrBytes   = 0UL;
+    addrValue   = 0UL;
+    return true;
+}
+
+bool sim_eeprom_bus_write(uint8_t data)
+{
+    if ((active == NULL) || activeRead)
+    {
+        return false;
+    }
+
+    if (addrBytes < EEPROM_ADDR_SIZE)
+    {
+        addrValue = (addrValue << 8u) | data;
+        if (++addrBytes == EEPROM_ADDR_SIZE)
+        {
+            active->pointer = addrValue % EEPROM_BLOCK_SIZE;
+            pageStart = active->pointer;
+        }
+        return true;
+    }
+
+    /* The address counter rolls over within the page */
+    if (((pageStart % EEPROM_PAGE_SIZE) + pageLen) >= EEPROM_PAGE_SIZE)
+    {
+        stats.pageWraps++;
+    }
+    pageData[pageLen % EEPROM_PAGE_SIZE] = data;
+    pageLen++;
+    active->pointer = (pageStart & ~(EEPROM_PAGE_SIZE - 1UL)) |
+                      ((pageStart + pageLen) % EEPROM_PAGE_SIZE);
+    return true;
+}
+
+uint8_t sim_eeprom_bus_read(void)
+{
+    uint8_t data;
+
+    if ((active == NULL) || !activeRead)
+    {
+        /* Nobody drives SDA */
+        return 0xFFu;
+    }
+
+    /* A sequential read rolls over within the block */
+    data = active->mem[activeBlock + active->pointer];
+    active->pointer = (active->pointer + 1UL) % EEPROM_BLOCK_SIZE;
+    stats.bytesRead++;
+    return data;
+}
+
+void sim_eeprom_bus_stop(void)
+{
+    if ((active != NULL) && !activeRead && (pageLen > 0UL))
+    {
+        EepromCommit();
+    }
+    active  = NULL;
+    pageLen = 0UL;
+}
+
+uint32_t sim_eeprom_bus_page_room(void)
+{
+    if ((active == NULL) || activeRead || (addrBytes < EEPROM_ADDR_SIZE))
+    {
+        return 0UL;
+    }
+    return (pageLen < (EEPROM_PAGE_SIZE - (pageStart % EEPROM_PAGE_SIZE))) ?
+           (EEPROM_PAGE_SIZE - (pageStart % EEPROM_PAGE_SIZE) - pageLen) : 0UL;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,1123 @@
+/******************************************************************************
+* File Name:  sim_i2c.c
+*
+* Description:  Simulated SCB in I2C master mode at the configured bus clock,
+*               with the PDL master functions on top, a second master and a
+*               stuck bus.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sim.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Phases of the master, as seen on the bus */
+#define PHASE_IDLE              (0u)    /* Bus released */
+#define PHASE_WAIT              (1u)    /* Start requested, the bus is not free */
+#define PHASE_ADDRESS           (2u)    /* Start condition and slave address */
+#define PHASE_WRITE             (3u)    /* Data byte to the slave */
+#define PHASE_READ              (4u)    /* Data byte from the slave */
+#define PHASE_HOLD              (5u)    /* SCL stretched until software acts */
+#define PHASE_STOP              (6u)    /* Stop condition */
+
+/* Bit times of the bus conditions: a Start, or a Stop, and a byte with its
+ * acknowledge */
+#define BITS_START              (1UL)
+#define BITS_STOP               (1UL)
+#define BITS_BYTE               (9UL)
+
+/* Data bytes the other master writes after winning a race for the same
+ * slave, and the value it writes */
+#define OTHER_WRITE_LEN         (4UL)
+#define OTHER_WRITE_DATA        (0xEEu)
+
+/* Bus speed after reset */
+#define DEFAULT_RATE_HZ         (100000UL)
+
+/* States of the driver context */
+#define DRV_IDLE                (0UL)
+#define DRV_MASTER_TX           (1UL)
+#define DRV_MASTER_RX           (2UL)
+#define DRV_MASTER_WAIT_STOP    (3UL)
+#define DRV_MASTER_MANUAL       (4UL)
+
+/* Half of the FIFO, the burst of the driver */
+#define DRV_HALF_FIFO           (SIM_SCB_FIFO_SIZE / 2UL)
+
+/* Master interrupt sources the driver serves */
+#define DRV_MASTER_INTR         (CY_SCB_MASTER_INTR_I2C_ARB_LOST | CY_SCB_MASTER_INTR_I2C_NACK | \
+                                 CY_SCB_MASTER_INTR_I2C_STOP | CY_SCB_MASTER_INTR_I2C_BUS_ERROR)
+
+/* Master status bits that end a transfer with an error event */
+#define DRV_ERRORS              (CY_SCB_I2C_MASTER_DATA_NAK | CY_SCB_I2C_MASTER_ADDR_NAK | \
+                                 CY_SCB_I2C_MASTER_ARB_LOST | CY_SCB_I2C_MASTER_BUS_ERR)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+const cy_stc_scb_i2c_config_t CYBSP_I2C_config = { 0UL, true, true };
+
+/* SCB state */
+static bool enabled = false;
+static uint32_t rateHz = DEFAULT_RATE_HZ;
+
+/* Master state machine */
+static uint32_t phase = PHASE_IDLE;
+static uint64_t phaseEndNs = SIM_NEVER;
+static uint64_t ownedNs = 0ULL;         /* Start of the bus ownership */
+static uint8_t shiftByte = 0u;          /* Byte on the bus */
+static bool readDir = false;            /* Direction of the last slave address */
+static bool nakHold = false;            /* Holding the bus after a NAK */
+static bool addrNak = false;            /* The NAK was on the slave address */
+static bool ackPending = false;         /* Read byte waiting for ACK or NACK */
+static bool raceLost = false;           /* The Start in progress loses arbitration */
+static uint32_t dataBytes = 0UL;        /* Data bytes acknowledged or received */
+static uint32_t byteSeq = 0UL;          /* Bytes completed, for the manual functions */
+
+/* Bus faults */
+static uint32_t failAboveHz = 0UL;
+static uint32_t failCount = 0UL;
+static uint32_t stuckClocks = 0UL;
+
+/* The other master */
+static sim_i2c_master_t other;
+static uint64_t otherUntilNs = 0ULL;
+static uint64_t stretchUntilNs = 0ULL;
+
+/* Driver: registered callback, pause request of the transfer in progress */
+static cy_cb_scb_i2c_handle_events_t drvCallback = NULL;
+static bool drvPause = false;
+static uint32_t drvCtrl = 0UL;
+
+static sim_i2c_stats_t stats;
+
+/*******************************************************************************
+* Function Name: I2cScb
+********************************************************************************
+* Summary:
+*  Returns the FIFOs and interrupt sources of the I2C SCB.
+*
+*******************************************************************************/
+static sim_scb_t *I2cScb(void)
+{
+    return sim_scb_get(&sim_i2c_scb);
+}
+
+/*******************************************************************************
+* Function Name: I2cChance
+********************************************************************************
+* Summary:
+*  Returns true with a chance of perMille in a thousand.
+*
+*******************************************************************************/
+static bool I2cChance(uint32_t perMille)
+{
+    return ((perMille > 0UL) && ((sim_random() % 1000ULL) < perMille));
+}
+
+/*******************************************************************************
+* Function Name: I2cBegin
+********************************************************************************
+* Summary:
+*  Enters a phase that lasts a number of bit times.
+*
+*******************************************************************************/
+static void I2cBegin(uint32_t next, uint64_t nowNs, uint32_t bits)
+{
+    if ((phase == PHASE_IDLE) || (phase == PHASE_WAIT))
+    {
+        ownedNs = nowNs;
+    }
+    phase = next;
+    phaseEndNs = nowNs + (((uint64_t)bits * 1000000000ULL) / rateHz);
+}
+
+/*******************************************************************************
+* Function Name: I2cRelease
+********************************************************************************
+* Summary:
+*  Releases the bus.
+*
+*******************************************************************************/
+static void I2cRelease(uint64_t nowNs)
+{
+    if ((phase != PHASE_IDLE) && (phase != PHASE_WAIT))
+    {
+        stats.busyNs += nowNs - ownedNs;
+    }
+    phase = PHASE_IDLE;
+    phaseEndNs = SIM_NEVER;
+    nakHold = false;
+    ackPending = false;
+}
+
+/*******************************************************************************
+* Function Name: I2cHold
+********************************************************************************
+* Summary:
+*  Stretches SCL until software acts.
+*
+*******************************************************************************/
+static void I2cHold(void)
+{
+    phase = PHASE_HOLD;
+    phaseEndNs = SIM_NEVER;
+}
+
+/*******************************************************************************
+* Function Name: I2cLoseArbitration
+********************************************************************************
+* Summary:
+*  Hands the bus to the other master, which keeps it for its transaction.
+*
+*******************************************************************************/
+static void I2cLoseArbitration(uint64_t nowNs)
+{
+    I2cScb()->masterStatus |= CY_SCB_MASTER_INTR_I2C_ARB_LOST;
+    stats.arbLost++;
+    otherUntilNs = nowNs + ((uint64_t)other.holdUs * 1000ULL);
+    I2cRelease(nowNs);
+}
+
+/*******************************************************************************
+* Function Name: I2cStart
+********************************************************************************
+* Summary:
+*  Sends a Start or repeated Start with the slave address from the TX FIFO.
+*
+*******************************************************************************/
+static void I2cStart(uint64_t nowNs)
+{
+    sim_scb_t *scb = I2cScb();
+
+    if (scb->txCount == 0UL)
+    {
+        /* Nothing to address, as a misplaced Start */
+        scb->masterStatus |= CY_SCB_MASTER_INTR_I2C_BUS_ERROR;
+        I2cRelease(nowNs);
+        return;
+    }
+
+    shiftByte = scb->tx[0];
+    (void)memmove(scb->tx, &scb->tx[1], --scb->txCount);
+
+    /* Both masters start at once and the other one wins on the address */
+    raceLost = I2cChance(other.startChance) && ((sim_random() & 1ULL) != 0ULL);
+
+    nakHold = false;
+    ackPending = false;
+    stats.starts++;
+    stats.bytes++;
+    I2cBegin(PHASE_ADDRESS, nowNs, BITS_START + BITS_BYTE);
+}
+
+/*******************************************************************************
+* Function Name: I2cNextWrite
+********************************************************************************
+* Summary:
+*  Sends the next byte of the TX FIFO, or stalls on an empty FIFO.
+*
+*******************************************************************************/
+static void I2cNextWrite(uint64_t nowNs)
+{
+    sim_scb_t *scb = I2cScb();
+
+    if (scb->txCount == 0UL)
+    {
+        scb->txStatus |= CY_SCB_TX_INTR_UNDERFLOW;
+        I2cHold();
+        return;
+    }
+
+    shiftByte = scb->tx[0];
+    (void)memmove(scb->tx, &scb->tx[1], --scb->txCount);
+    stats.bytes++;
+    I2cBegin(PHASE_WRITE, nowNs, BITS_BYTE);
+}
+
+/*******************************************************************************
+* Function Name: I2cResume
+********************************************************************************
+* Summary:
+*  Carries out a command written to I2C_M_CMD, or continues the transaction
+*  once the FIFOs allow it.
+*
+*******************************************************************************/
+static void I2cResume(uint64_t nowNs)
+{
+    sim_scb_t *scb = I2cScb();
+    uint32_t cmd = sim_i2c_scb.I2C_M_CMD;
+
+    if (!enabled)
+    {
+        return;
+    }
+
+    if ((phase == PHASE_IDLE) &&
+        (0UL != (cmd & (SCB_I2C_M_CMD_M_START_Msk | SCB_I2C_M_CMD_M_START_ON_IDLE_Msk))))
+    {
+        sim_i2c_scb.I2C_M_CMD = 0UL;
+        phase = PHASE_WAIT;
+        if (nowNs < otherUntilNs)
+        {
+            stats.busyWaits++;
+        }
+    }
+
+    if (phase == PHASE_WAIT)
+    {
+        /* A stuck SDA hides the idle bus, the other master delays it */
+        if (stuckClocks > 0UL)
+        {
+            phaseEndNs = SIM_NEVER;
+        }
+        else if (nowNs < otherUntilNs)
+        {
+            phaseEndNs = otherUntilNs;
+        }
+        else
+        {
+            I2cStart(nowNs);
+        }
+    }
+    else if (phase == PHASE_HOLD)
+    {
+        if (0UL != (cmd & SCB_I2C_M_CMD_M_STOP_Msk))
+        {
+            sim_i2c_scb.I2C_M_CMD = 0UL;
+            I2cBegin(PHASE_STOP, nowNs, BITS_STOP);
+        }
+        else if (0UL != (cmd & (SCB_I2C_M_CMD_M_START_Msk | SCB_I2C_M_CMD_M_START_ON_IDLE_Msk)))
+        {
+            sim_i2c_scb.I2C_M_CMD = 0UL;
+            I2cStart(nowNs);
+        }
+        else if (nakHold)
+        {
+            /* Only a Stop or a repeated Start follows a NAK */
+        }
+        else if (readDir)
+        {
+            bool autoAck = (0UL != (sim_i2c_scb.I2C_CTRL & SCB_I2C_CTRL_M_READY_DATA_ACK_Msk)) &&
+                           (scb->rxCount < SIM_SCB_FIFO_SIZE);
+
+            if ((0UL != (cmd & SCB_I2C_M_CMD_M_ACK_Msk)) || (ackPending && autoAck))
+            {
+                sim_i2c_scb.I2C_M_CMD = 0UL;
+                ackPending = false;
+                I2cBegin(PHASE_READ, nowNs, BITS_BYTE);
+            }
+        }
+        else if (scb->txCount > 0UL)
+        {
+            I2cNextWrite(nowNs);
+        }
+        else
+        {
+            /* Stalled on the empty TX FIFO */
+        }
+    }
+    else
+    {
+        /* The bus is idle or a phase is in progress */
+    }
+}
+
+/*******************************************************************************
+* Function Name: I2cPhaseEnd
+********************************************************************************
+* Summary:
+*  Completes the phase that ends at nowNs.
+*
+*******************************************************************************/
+static void I2cPhaseEnd(uint64_t nowNs)
+{
+    sim_scb_t *scb = I2cScb();
+    uint8_t data;
+
+    switch (phase)
+    {
+        case PHASE_WAIT:
+            /* The other master released the bus */
+            phaseEndNs = SIM_NEVER;
+            break;
+
+        case PHASE_ADDRESS:
+            byteSeq++;
+            if (raceLost)
+            {
+                I2cLoseArbitration(nowNs);
+            }
+            else if (!sim_eeprom_bus_start(shiftByte))
+            {
+                scb->masterStatus |= CY_SCB_MASTER_INTR_I2C_NACK;
+                stats.addrNaks++;
+                nakHold = true;
+                addrNak = true;
+                I2cHold();
+            }
+            else
+            {
+                readDir = (0u != (shiftByte & 1u));
+                addrNak = false;
+                dataBytes = 0UL;
+                if (readDir)
+                {
+                    I2cBegin(PHASE_READ, nowNs, BITS_BYTE);
+                }
+                else
+                {
+                    I2cNextWrite(nowNs);
+                }
+            }
+            break;
+
+        case PHASE_WRITE:
+            byteSeq++;
+            if (I2cChance(other.dataChance))
+            {
+                /* The other master addressed the same slave and writes its
+                 * own data from this byte on */
+                uint32_t room = sim_eeprom_bus_page_room();
+
+                for (uint32_t i = 0UL; (i < OTHER_WRITE_LEN) && (i < room); i++)
+                {
+                    (void)sim_eeprom_bus_write(OTHER_WRITE_DATA);
+                }
+                sim_eeprom_bus_stop();
+                I2cLoseArbitration(nowNs);
+            }
+            else if (!sim_eeprom_bus_write(shiftByte))
+            {
+                scb->masterStatus |= CY_SCB_MASTER_INTR_I2C_NACK;
+                nakHold = true;
+                I2cHold();
+            }
+            else
+            {
+                dataBytes++;
+                I2cNextWrite(nowNs);
+            }
+            break;
+
+        case PHASE_READ:
+            byteSeq++;
+            if (I2cChance(other.dataChance))
+            {
+                /* The other master acknowledged where this one did not */
+                sim_eeprom_bus_stop();
+                I2cLoseArbitration(nowNs);
+                break;
+            }
+
+            data = sim_eeprom_bus_read();
+            if ((dataBytes == 0UL) && (failAboveHz > 0UL) && (rateHz > failAboveHz) &&
+                ((++failCount % 3UL) == 0UL))
+            {
+                /* Marginal timing: a bit flips in every third transaction */
+                data ^= 0x10u;
+            }
+            stats.bytes++;
+            dataBytes++;
+
+            if (scb->rxCount < SIM_SCB_FIFO_SIZE)
+            {
+                scb->rx[scb->rxCount++] = data;
+            }
+            else
+            {
+                scb->rxStatus |= CY_SCB_RX_INTR_OVERFLOW;
+            }
+            ackPending = true;
+            I2cHold();
+            break;
+
+        case PHASE_STOP:
+            sim_eeprom_bus_stop();
+            scb->masterStatus |= CY_SCB_MASTER_INTR_I2C_STOP;
+            stats.stops++;
+            I2cRelease(nowNs);
+            break;
+
+        default:
+            phaseEndNs = SIM_NEVER;
+            break;
+    }
+}
+
+/*******************************************************************************
+* Engine
+*******************************************************************************/
+uint64_t sim_i2c_step(uint64_t nowNs)
+{
+    I2cResume(nowNs);
+    while (phaseEndNs <= nowNs)
+    {
+        uint64_t endNs = phaseEndNs;
+
+        I2cPhaseEnd(endNs);
+        I2cResume(endNs);
+    }
+    return phaseEndNs;
+}
+
+bool sim_i2c_irq_pending(void)
+{
+    return (enabled && sim_scb_irq_pending(I2cScb()));
+}
+
+bool sim_i2c_line_low(bool sda)
+{
+    uint64_t nowNs = sim_time_ns();
+    uint64_t halfBitNs = 500000000ULL / rateHz;
+
+    if (sda && (stuckClocks > 0UL))
+    {
+        return true;
+    }
+    if (!sda && (nowNs < stretchUntilNs))
+    {
+        /* The slave of the other master stretches the clock */
+        return true;
+    }
+    if (nowNs < otherUntilNs)
+    {
+        /* The other master clocks its transaction */
+        return sda ? ((sim_random() & 1ULL) != 0ULL) : (((nowNs / halfBitNs) & 1ULL) != 0ULL);
+    }
+    if (enabled && (phase != PHASE_IDLE) && (phase != PHASE_WAIT))
+    {
+        if (phase == PHASE_HOLD)
+        {
+            return !sda;
+        }
+        return sda ? ((sim_random() & 1ULL) != 0ULL) : (((nowNs / halfBitNs) & 1ULL) != 0ULL);
+    }
+    return false;
+}
+
+void sim_i2c_scl_pulse(void)
+{
+    /* The slave shifts out one bit of the byte it is stuck in */
+    if (stuckClocks > 0UL)
+    {
+        stuckClocks--;
+    }
+}
+
+/*******************************************************************************
+* Simulator API
+*******************************************************************************/
+uint32_t sim_i2c_rate_hz(void)
+{
+    return rateHz;
+}
+
+void sim_i2c_fail_above(uint32_t limitHz)
+{
+    failAboveHz = limitHz;
+    failCount = 0UL;
+}
+
+void sim_i2c_hold_sda(uint32_t clocks)
+{
+    stuckClocks = clocks;
+}
+
+uint32_t sim_i2c_sda_held(void)
+{
+    return stuckClocks;
+}
+
+void sim_i2c_set_master(const sim_i2c_master_t *master)
+{
+    if (master != NULL)
+    {
+        other = *master;
+    }
+    else
+    {
+        (void)memset(&other, 0, sizeof(other));
+    }
+    otherUntilNs = 0ULL;
+    stretchUntilNs = 0ULL;
+}
+
+void sim_i2c_stretch(uint32_t us)
+{
+    uint64_t untilNs = sim_time_ns() + ((uint64_t)us * 1000ULL);
+
+    /* The other master holds the bus at least until its slave lets go */
+    stretchUntilNs = untilNs;
+    if (otherUntilNs < untilNs)
+    {
+        otherUntilNs = untilNs;
+    }
+}
+
+void sim_i2c_get_stats(sim_i2c_stats_t *out)
+{
+    *out = stats;
+}
+
+void sim_i2c_reset_stats(void)
+{
+    (void)memset(&stats, 0, sizeof(stats));
+}
+
+/*******************************************************************************
+* SCB I2C: configuration
+*******************************************************************************/
+cy_en_scb_i2c_status_t Cy_SCB_I2C_Init(CySCB_Type *base, cy_stc_scb_i2c_config_t const *config,
+                                       cy_stc_scb_i2c_context_t *context)
+{
+    if ((base == NULL) || (config == NULL) || (context == NULL))
+    {
+        return CY_SCB_I2C_BAD_PARAM;
+    }
+
+    (void)memset(context, 0, sizeof(*context));
+    sim_scb_reset(I2cScb());
+    base->I2C_CTRL = 0UL;
+    base->I2C_M_CMD = 0UL;
+    return CY_SCB_I2C_SUCCESS;
+}
+
+void Cy_SCB_I2C_Enable(CySCB_Type *base, cy_stc_scb_i2c_context_t const *context)
+{
+    (void)base;
+    (void)context;
+    enabled = true;
+}
+
+void Cy_SCB_I2C_Disable(CySCB_Type *base, cy_stc_scb_i2c_context_t *context)
+{
+    /* The SCB lets go of the bus, and its FIFOs and interrupt sources are
+     * cleared. A slave in the middle of a byte keeps its state. */
+    enabled = false;
+    I2cRelease(sim_time_ns());
+    sim_scb_reset(I2cScb());
+    base->I2C_M_CMD = 0UL;
+
+    if (context != NULL)
+    {
+        context->state = DRV_IDLE;
+        context->masterStatus = 0UL;
+        context->masterPause = false;
+    }
+}
+
+uint32_t Cy_SCB_I2C_SetDataRate(CySCB_Type *base, uint32_t dataRateHz, uint32_t scbClockHz)
+{
+    uint32_t minHz;
+    uint32_t maxHz;
+
+    (void)base;
+
+    /* Master SCB clock ranges of the PDL */
+    if (dataRateHz <= 100000UL)
+    {
+        minHz = 1550000UL;
+        maxHz = 12800000UL;
+    }
+    else if (dataRateHz <= 400000UL)
+    {
+        minHz = 7820000UL;
+        maxHz = 15380000UL;
+    }
+    else if (dataRateHz <= 1000000UL)
+    {
+        minHz = 14320000UL;
+        maxHz = 89000000UL;
+    }
+    else
+    {
+        return 0UL;
+    }
+
+    if ((dataRateHz == 0UL) || (scbClockHz < minHz) || (scbClockHz > maxHz))
+    {
+        return 0UL;
+    }
+
+    rateHz = dataRateHz;
+    return dataRateHz;
+}
+
+uint32_t Cy_SCB_I2C_GetDataRate(CySCB_Type const *base, uint32_t scbClockHz)
+{
+    (void)base;
+    (void)scbClockHz;
+    return rateHz;
+}
+
+bool Cy_SCB_I2C_IsBusBusy(CySCB_Type const *base)
+{
+    uint64_t nowNs;
+
+    (void)base;
+    sim_poll();
+    nowNs = sim_time_ns();
+
+    /* Only Start and Stop conditions set the busy flag, a stuck SDA does not */
+    if ((nowNs < otherUntilNs) || ((phase != PHASE_IDLE) && (phase != PHASE_WAIT)))
+    {
+        return true;
+    }
+    if ((other.holdUs > 0UL) && I2cChance(other.busyChance))
+    {
+        /* The other master has just started a transaction */
+        otherUntilNs = nowNs + 1000ULL + ((sim_random() % other.holdUs) * 1000ULL);
+        return true;
+    }
+    return false;
+}
+
+void Cy_SCB_I2C_RegisterEvent(CySCB_Type const *base, cy_cb_scb_i2c_handle_events_t callback,
+                              cy_stc_scb_i2c_context_t *context)
+{
+    (void)base;
+    context->cbEvents = callback;
+    drvCallback = callback;
+}
+
+/*******************************************************************************
+* SCB I2C: interrupt-driven master transfers
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: DrvComplete
+********************************************************************************
+* Summary:
+*  Ends the transfer in progress and reports it with an event.
+*
+*******************************************************************************/
+static void DrvComplete(CySCB_Type *base, cy_stc_scb_i2c_context_t *context, uint32_t event)
+{
+    sim_scb_t *scb = I2cScb();
+
+    scb->txMask = 0UL;
+    scb->rxMask = 0UL;
+    scb->masterMask = 0UL;
+    scb->txStatus = 0UL;
+    scb->masterStatus &= ~DRV_MASTER_INTR;
+
+    if (context->masterRdDir)
+    {
+        base->I2C_CTRL = drvCtrl;
+    }
+    else
+    {
+        context->masterNumBytes = dataBytes;
+    }
+
+    context->masterStatus &= ~CY_SCB_I2C_MASTER_BUSY;
+    context->state = DRV_IDLE;
+
+    if (context->cbEvents != NULL)
+    {
+        context->cbEvents(event);
+    }
+}
+
+/*******************************************************************************
+* Function Name: DrvRxArm
+********************************************************************************
+* Summary:
+*  Sets the RX FIFO level for the next half-FIFO burst of a read. The
+*  hardware acknowledges every byte but the last.
+*
+*******************************************************************************/
+static void DrvRxArm(CySCB_Type *base, uint32_t left)
+{
+    uint32_t burst = left - 1UL;
+
+    if (burst == 0UL)
+    {
+        base->I2C_CTRL &= ~SCB_I2C_CTRL_M_READY_DATA_ACK_Msk;
+        burst = 1UL;
+    }
+    else
+    {
+        base->I2C_CTRL |= SCB_I2C_CTRL_M_READY_DATA_ACK_Msk;
+        if (burst > DRV_HALF_FIFO)
+        {
+            burst = DRV_HALF_FIFO;
+        }
+    }
+    I2cScb()->rxLevel = burst - 1UL;
+}
+
+/*******************************************************************************
+* Function Name: DrvStart
+********************************************************************************
+* Summary:
+*  Starts a transfer of the driver, with a repeated Start when the previous
+*  one kept the bus.
+*
+*******************************************************************************/
+static cy_en_scb_i2c_status_t DrvStart(CySCB_Type *base, cy_stc_scb_i2c_master_xfer_config_t *xferConfig,
+                                       cy_stc_scb_i2c_context_t *context, bool read)
+{
+    sim_scb_t *scb = I2cScb();
+
+    if ((xferConfig == NULL) || (xferConfig->buffer == NULL) || (xferConfig->bufferSize == 0UL))
+    {
+        return CY_SCB_I2C_BAD_PARAM;
+    }
+    if ((context->state != DRV_IDLE) || !enabled)
+    {
+        return CY_SCB_I2C_MASTER_NOT_READY;
+    }
+
+    context->masterBuffer     = xferConfig->buffer;
+    context->masterBufferSize = xferConfig->bufferSize;
+    context->masterBufferIdx  = 0UL;
+    context->masterNumBytes   = 0UL;
+    context->masterStatus     = CY_SCB_I2C_MASTER_BUSY;
+    context->masterRdDir      = read;
+    context->state            = read ? DRV_MASTER_RX : DRV_MASTER_TX;
+    drvPause = xferConfig->xferPending;
+
+    scb->txCount = 0UL;
+    scb->rxCount = 0UL;
+    scb->txStatus = 0UL;
+    scb->rxStatus = 0UL;
+    scb->masterStatus = 0UL;
+    scb->txLevel = DRV_HALF_FIFO;
+    Cy_SCB_WriteTxFifo(base, ((uint32_t)xferConfig->slaveAddress << 1u) | (read ? 1UL : 0UL));
+
+    if (read)
+    {
+        drvCtrl = base->I2C_CTRL;
+        DrvRxArm(base, xferConfig->bufferSize);
+        scb->txMask = 0UL;
+        scb->rxMask = CY_SCB_RX_INTR_LEVEL;
+    }
+    else
+    {
+        context->masterBufferIdx = Cy_SCB_WriteArray(base, xferConfig->buffer, xferConfig->bufferSize);
+        scb->txMask = (context->masterBufferIdx < xferConfig->bufferSize) ?
+                      CY_SCB_TX_INTR_LEVEL : CY_SCB_TX_INTR_UNDERFLOW;
+        scb->rxMask = 0UL;
+    }
+    scb->masterMask = DRV_MASTER_INTR;
+
+    base->I2C_M_CMD = context->masterPause ? SCB_I2C_M_CMD_M_START_Msk : SCB_I2C_M_CMD_M_START_ON_IDLE_Msk;
+    context->masterPause = false;
+
+    return CY_SCB_I2C_SUCCESS;
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterWrite(CySCB_Type *base,
+                                              cy_stc_scb_i2c_master_xfer_config_t *xferConfig,
+                                              cy_stc_scb_i2c_context_t *context)
+{
+    return DrvStart(base, xferConfig, context, false);
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterRead(CySCB_Type *base,
+                                             cy_stc_scb_i2c_master_xfer_config_t *xferConfig,
+                                             cy_stc_scb_i2c_context_t *context)
+{
+    return DrvStart(base, xferConfig, context, true);
+}
+
+void Cy_SCB_I2C_Interrupt(CySCB_Type *base, cy_stc_scb_i2c_context_t *context)
+{
+    sim_scb_t *scb = I2cScb();
+    uint32_t master = Cy_SCB_GetMasterInterruptStatusMasked(base);
+    uint32_t tx = Cy_SCB_GetTxInterruptStatusMasked(base);
+    uint32_t rx = Cy_SCB_GetRxInterruptStatusMasked(base);
+
+    if (0UL != (master & (CY_SCB_MASTER_INTR_I2C_ARB_LOST | CY_SCB_MASTER_INTR_I2C_BUS_ERROR)))
+    {
+        context->masterStatus |= (0UL != (master & CY_SCB_MASTER_INTR_I2C_ARB_LOST)) ?
+                                 CY_SCB_I2C_MASTER_ARB_LOST : CY_SCB_I2C_MASTER_BUS_ERR;
+        context->masterNumBytes = context->masterRdDir ? context->masterBufferIdx : dataBytes;
+        DrvComplete(base, context, CY_SCB_I2C_MASTER_ERR_EVENT);
+    }
+    else if (0UL != (master & CY_SCB_MASTER_INTR_I2C_NACK))
+    {
+        /* The master holds the bus until told to release it */
+        Cy_SCB_ClearMasterInterrupt(base, CY_SCB_MASTER_INTR_I2C_NACK);
+        context->masterStatus |= addrNak ? CY_SCB_I2C_MASTER_ADDR_NAK : CY_SCB_I2C_MASTER_DATA_NAK;
+        scb->txMask = 0UL;
+        scb->rxMask = 0UL;
+        base->I2C_M_CMD = SCB_I2C_M_CMD_M_STOP_Msk;
+        context->state = DRV_MASTER_WAIT_STOP;
+    }
+    else if (0UL != (master & CY_SCB_MASTER_INTR_I2C_STOP))
+    {
+        if (context->masterRdDir)
+        {
+            context->masterNumBytes = context->masterBufferIdx;
+        }
+        DrvComplete(base, context,
+                    (0UL != (context->masterStatus & DRV_ERRORS)) ? CY_SCB_I2C_MASTER_ERR_EVENT :
+                    (context->masterRdDir ? CY_SCB_I2C_MASTER_RD_CMPLT_EVENT : CY_SCB_I2C_MASTER_WR_CMPLT_EVENT));
+    }
+    else if (0UL != (rx & CY_SCB_RX_INTR_LEVEL))
+    {
+        context->masterBufferIdx += Cy_SCB_ReadArray(base, &context->masterBuffer[context->masterBufferIdx],
+                                                     context->masterBufferSize - context->masterBufferIdx);
+        if (context->masterBufferIdx == context->masterBufferSize)
+        {
+            scb->rxMask = 0UL;
+            base->I2C_M_CMD = SCB_I2C_M_CMD_M_NACK_Msk | SCB_I2C_M_CMD_M_STOP_Msk;
+            context->state = DRV_MASTER_WAIT_STOP;
+        }
+        else
+        {
+            DrvRxArm(base, context->masterBufferSize - context->masterBufferIdx);
+        }
+    }
+    else if (0UL != (tx & CY_SCB_TX_INTR_UNDERFLOW))
+    {
+        Cy_SCB_ClearTxInterrupt(base, CY_SCB_TX_INTR_UNDERFLOW);
+        scb->txMask = 0UL;
+        if (drvPause)
+        {
+            /* No Stop: the next transfer starts with a repeated Start */
+            context->masterPause = true;
+            context->masterNumBytes = dataBytes;
+            DrvComplete(base, context, CY_SCB_I2C_MASTER_WR_CMPLT_EVENT);
+        }
+        else
+        {
+            base->I2C_M_CMD = SCB_I2C_M_CMD_M_STOP_Msk;
+            context->state = DRV_MASTER_WAIT_STOP;
+        }
+    }
+    else if (0UL != (tx & CY_SCB_TX_INTR_LEVEL))
+    {
+        context->masterBufferIdx += Cy_SCB_WriteArray(base, &context->masterBuffer[context->masterBufferIdx],
+                                                      context->masterBufferSize - context->masterBufferIdx);
+        if (context->masterBufferIdx == context->masterBufferSize)
+        {
+            /* The FIFO is not empty, an underflow seen before is stale */
+            Cy_SCB_ClearTxInterrupt(base, CY_SCB_TX_INTR_UNDERFLOW);
+            scb->txMask = CY_SCB_TX_INTR_UNDERFLOW;
+        }
+    }
+    else
+    {
+        /* Not a source of the driver */
+    }
+}
+
+uint32_t Cy_SCB_I2C_MasterGetStatus(CySCB_Type const *base, cy_stc_scb_i2c_context_t const *context)
+{
+    (void)base;
+    return context->masterStatus;
+}
+
+uint32_t Cy_SCB_I2C_MasterGetTransferCount(CySCB_Type const *base,
+                                           cy_stc_scb_i2c_context_t const *context)
+{
+    (void)base;
+    return context->masterNumBytes;
+}
+
+/*******************************************************************************
+* SCB I2C: low-level master functions, which poll the SCB
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: ManualWait
+********************************************************************************
+* Summary:
+*  Polls until the byte on the bus completes, and returns its result.
+*
+*******************************************************************************/
+static cy_en_scb_i2c_status_t ManualWait(uint32_t seq, uint32_t timeoutMs,
+                                         cy_stc_scb_i2c_context_t *context)
+{
+    sim_scb_t *scb = I2cScb();
+    uint64_t deadlineNs = (timeoutMs == 0UL) ? SIM_NEVER :
+                          (sim_time_ns() + ((uint64_t)timeoutMs * 1000000ULL));
+
+    while (byteSeq == seq)
+    {
+        if (sim_time_ns() >= deadlineNs)
+        {
+            return CY_SCB_I2C_MASTER_MANUAL_TIMEOUT;
+        }
+        sim_poll();
+    }
+
+    if (0UL != (scb->masterStatus & CY_SCB_MASTER_INTR_I2C_ARB_LOST))
+    {
+        scb->masterStatus &= ~CY_SCB_MASTER_INTR_I2C_ARB_LOST;
+        context->state = DRV_IDLE;
+        return CY_SCB_I2C_MASTER_MANUAL_ARB_LOST;
+    }
+    if (0UL != (scb->masterStatus & CY_SCB_MASTER_INTR_I2C_NACK))
+    {
+        scb->masterStatus &= ~CY_SCB_MASTER_INTR_I2C_NACK;
+        return addrNak ? CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK : CY_SCB_I2C_MASTER_MANUAL_NAK;
+    }
+    return CY_SCB_I2C_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: ManualAddress
+********************************************************************************
+* Summary:
+*  Sends a Start or repeated Start with the slave address and waits for the
+*  acknowledge.
+*
+*******************************************************************************/
+static cy_en_scb_i2c_status_t ManualAddress(CySCB_Type *base, uint32_t address,
+                                            cy_en_scb_i2c_direction_t bitRnW, uint32_t cmd,
+                                            uint32_t timeoutMs, cy_stc_scb_i2c_context_t *context)
+{
+    sim_scb_t *scb = I2cScb();
+    uint32_t seq = byteSeq;
+
+    scb->txCount = 0UL;
+    scb->rxCount = 0UL;
+    scb->masterStatus = 0UL;
+    Cy_SCB_WriteTxFifo(base, (address << 1u) | (uint32_t)bitRnW);
+    base->I2C_M_CMD = cmd;
+    context->state = DRV_MASTER_MANUAL;
+
+    return ManualWait(seq, timeoutMs, context);
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterSendStart(CySCB_Type *base, uint32_t address,
+                                                  cy_en_scb_i2c_direction_t bitRnW, uint32_t timeoutMs,
+                                                  cy_stc_scb_i2c_context_t *context)
+{
+    if ((context->state != DRV_IDLE) || !enabled)
+    {
+        return CY_SCB_I2C_MASTER_NOT_READY;
+    }
+    return ManualAddress(base, address, bitRnW, SCB_I2C_M_CMD_M_START_ON_IDLE_Msk, timeoutMs, context);
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterSendReStart(CySCB_Type *base, uint32_t address,
+                                                    cy_en_scb_i2c_direction_t bitRnW, uint32_t timeoutMs,
+                                                    cy_stc_scb_i2c_context_t *context)
+{
+    if (context->state != DRV_MASTER_MANUAL)
+    {
+        return CY_SCB_I2C_MASTER_NOT_READY;
+    }
+    return ManualAddress(base, address, bitRnW, SCB_I2C_M_CMD_M_START_Msk, timeoutMs, context);
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterSendStop(CySCB_Type *base, uint32_t timeoutMs,
+                                                 cy_stc_scb_i2c_context_t *context)
+{
+    uint64_t deadlineNs = (timeoutMs == 0UL) ? SIM_NEVER :
+                          (sim_time_ns() + ((uint64_t)timeoutMs * 1000000ULL));
+
+    if (context->state != DRV_MASTER_MANUAL)
+    {
+        return CY_SCB_I2C_MASTER_NOT_READY;
+    }
+
+    /* A read ends with a NAK of its last byte */
+    base->I2C_M_CMD = SCB_I2C_M_CMD_M_NACK_Msk | SCB_I2C_M_CMD_M_STOP_Msk;
+    while (phase != PHASE_IDLE)
+    {
+        if (sim_time_ns() >= deadlineNs)
+        {
+            return CY_SCB_I2C_MASTER_MANUAL_TIMEOUT;
+        }
+        sim_poll();
+    }
+    I2cScb()->masterStatus &= ~CY_SCB_MASTER_INTR_I2C_STOP;
+    context->state = DRV_IDLE;
+    return CY_SCB_I2C_SUCCESS;
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterWriteByte(CySCB_Type *base, uint8_t byte, uint32_t timeoutMs,
+                                                  cy_stc_scb_i2c_context_t *context)
+{
+    uint32_t seq = byteSeq;
+
+    if ((context->state != DRV_MASTER_MANUAL) || (phase != PHASE_HOLD) || readDir)
+    {
+        return CY_SCB_I2C_MASTER_NOT_READY;
+    }
+
+    Cy_SCB_ClearTxInterrupt(base, CY_SCB_TX_INTR_UNDERFLOW);
+    Cy_SCB_WriteTxFifo(base, byte);
+    return ManualWait(seq, timeoutMs, context);
+}
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterReadByte(CySCB_Type *base, cy_en_scb_i2c_command_t ackNack,
+                                                 uint8_t *byte, uint32_t timeoutMs,
+                                                 cy_stc_scb_i2c_context_t *context)
+{
+    sim_scb_t *scb = I2cScb();
+    uint64_t deadlineNs = (timeoutMs == 0UL) ? SIM_NEVER :
+                          (sim_time_ns() + ((uint64_t)timeoutMs * 1000000ULL));
+
+    if ((context->state != DRV_MASTER_MANUAL) || !readDir)
+    {
+        return CY_SCB_I2C_MASTER_NOT_READY;
+    }
+
+    while (scb->rxCount == 0UL)
+    {
+        if (0UL != (scb->masterStatus & CY_SCB_MASTER_INTR_I2C_ARB_LOST))
+        {
+            scb->masterStatus &= ~CY_SCB_MASTER_INTR_I2C_ARB_LOST;
+            context->state = DRV_IDLE;
+            return CY_SCB_I2C_MASTER_MANUAL_ARB_LOST;
+        }
+        if (sim_time_ns() >= deadlineNs)
+        {
+            return CY_SCB_I2C_MASTER_MANUAL_TIMEOUT;
+        }
+        sim_poll();
+    }
+
+    (void)Cy_SCB_ReadArray(base, byte, 1UL);
+
+    /* A NAK is sent with the following Stop or repeated Start */
+    if (ackNack == CY_SCB_I2C_ACK)
+    {
+        base->I2C_M_CMD = SCB_I2C_M_CMD_M_ACK_Msk;
+    }
+    return CY_SCB_I2C_SUCCESS;
+}
+
+/* [] END OF FILE */
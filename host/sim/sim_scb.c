@@ -0,0 +1,222 @@
+/******************************************************************************
+* File Name:  sim_scb.c
+*
+* Description:  Simulated FIFOs and interrupt sources of the SCB blocks.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sim.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+CySCB_Type sim_i2c_scb;
+CySCB_Type sim_uart_scb;
+
+/* FIFOs and interrupt sources of the two SCB blocks */
+static sim_scb_t i2cScb;
+static sim_scb_t uartScb;
+
+/*******************************************************************************
+* Simulator API
+*******************************************************************************/
+sim_scb_t *sim_scb_get(CySCB_Type const *base)
+{
+    return (base == &sim_uart_scb) ? &uartScb : &i2cScb;
+}
+
+void sim_scb_reset(sim_scb_t *scb)
+{
+    (void)memset(scb, 0, sizeof(*scb));
+}
+
+uint32_t sim_scb_tx_status(const sim_scb_t *scb)
+{
+    uint32_t status = scb->txStatus;
+
+    if (scb->txCount < scb->txLevel)
+    {
+        status |= CY_SCB_TX_INTR_LEVEL;
+    }
+    return status;
+}
+
+uint32_t sim_scb_rx_status(const sim_scb_t *scb)
+{
+    uint32_t status = scb->rxStatus;
+
+    if (scb->rxCount > scb->rxLevel)
+    {
+        status |= CY_SCB_RX_INTR_LEVEL;
+    }
+    if (scb->rxCount > 0UL)
+    {
+        status |= CY_SCB_RX_INTR_NOT_EMPTY;
+    }
+    return status;
+}
+
+bool sim_scb_irq_pending(const sim_scb_t *scb)
+{
+    return ((0UL != (sim_scb_tx_status(scb) & scb->txMask)) ||
+            (0UL != (sim_scb_rx_status(scb) & scb->rxMask)) ||
+            (0UL != (scb->masterStatus & scb->masterMask)));
+}
+
+/*******************************************************************************
+* SCB interrupt sources
+*******************************************************************************/
+void Cy_SCB_SetTxInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    sim_scb_get(base)->txMask = interruptMask;
+}
+
+void Cy_SCB_SetRxInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    sim_scb_get(base)->rxMask = interruptMask;
+}
+
+void Cy_SCB_SetMasterInterruptMask(CySCB_Type *base, uint32_t interruptMask)
+{
+    sim_scb_get(base)->masterMask = interruptMask;
+}
+
+uint32_t Cy_SCB_GetTxInterruptStatusMasked(CySCB_Type const *base)
+{
+    sim_scb_t *scb = sim_scb_get(base);
+
+    return (sim_scb_tx_status(scb) & scb->txMask);
+}
+
+uint32_t Cy_SCB_GetRxInterruptStatusMasked(CySCB_Type const *base)
+{
+    sim_scb_t *scb = sim_scb_get(base);
+
+    return (sim_scb_rx_status(scb) & scb->rxMask);
+}
+
+uint32_t Cy_SCB_GetMasterInterruptStatusMasked(CySCB_Type const *base)
+{
+    sim_scb_t *scb = sim_scb_get(base);
+
+    return (scb->masterStatus & scb->masterMask);
+}
+
+void Cy_SCB_ClearTxInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    /* A level source stays set while its condition holds */
+    sim_scb_get(base)->txStatus &= ~interruptMask;
+}
+
+void Cy_SCB_ClearRxInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    sim_scb_get(base)->rxStatus &= ~interruptMask;
+}
+
+void Cy_SCB_ClearMasterInterrupt(CySCB_Type *base, uint32_t interruptMask)
+{
+    sim_scb_get(base)->masterStatus &= ~interruptMask;
+}
+
+/*******************************************************************************
+* SCB FIFOs
+*******************************************************************************/
+void Cy_SCB_SetTxFifoLevel(CySCB_Type *base, uint32_t level)
+{
+    sim_scb_get(base)->txLevel = level;
+}
+
+void Cy_SCB_SetRxFifoLevel(CySCB_Type *base, uint32_t level)
+{
+    sim_scb_get(base)->rxLevel = level;
+}
+
+uint32_t Cy_SCB_GetFifoSize(CySCB_Type const *base)
+{
+    (void)base;
+    return SIM_SCB_FIFO_SIZE;
+}
+
+void Cy_SCB_ClearTxFifo(CySCB_Type *base)
+{
+    sim_scb_get(base)->txCount = 0UL;
+}
+
+void Cy_SCB_ClearRxFifo(CySCB_Type *base)
+{
+    sim_scb_get(base)->rxCount = 0UL;
+}
+
+uint32_t Cy_SCB_WriteArray(CySCB_Type *base, void *buffer, uint32_t size)
+{
+    sim_scb_t *scb = sim_scb_get(base);
+    const uint8_t *src = (const uint8_t *)buffer;
+    uint32_t count = 0UL;
+
+    while ((count < size) && (scb->txCount < SIM_SCB_FIFO_SIZE))
+    {
+        scb->tx[scb->txCount++] = src[count++];
+    }
+    return count;
+}
+
+uint32_t Cy_SCB_ReadArray(CySCB_Type const *base, void *buffer, uint32_t size)
+{
+    sim_scb_t *scb = sim_scb_get(base);
+    uint8_t *dst = (uint8_t *)buffer;
+    uint32_t count = 0UL;
+
+    while ((count < size) && (count < scb->rxCount))
+    {
+        dst[count] = scb->rx[count];
+        count++;
+    }
+    scb->rxCount -= count;
+    (void)memmove(scb->rx, &scb->rx[count], scb->rxCount);
+
+    return count;
+}
+
+void Cy_SCB_WriteTxFifo(CySCB_Type *base, uint32_t data)
+{
+    uint8_t byte = (uint8_t)data;
+
+    (void)Cy_SCB_WriteArray(base, &byte, 1UL);
+}
+
+/* [] END OF FILE */
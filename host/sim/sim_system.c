@@ -0,0 +1,701 @@
+/******************************************************************************
+* File Name:  sim_system.c
+*
+* Description:  Simulated time base, NVIC, SysTick, sleep, delays and GPIO of
+*               the PMG1 on the host.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Interrupt lines of the simulated NVIC */
+#define SIM_IRQ_COUNT           (32)
+
+/* Pseudo interrupt number of the SysTick exception */
+#define SIM_IRQ_SYSTICK         (-1)
+#define SIM_IRQ_NONE            (-2)
+
+/* Interrupts taken in a row before the model reports an interrupt storm */
+#define SIM_ISR_STORM           (10000000UL)
+
+/* Number of SysTick callbacks, as in the PDL */
+#define SIM_SYSTICK_CALLBACKS   (5u)
+
+/* Pins of the simulated port */
+#define SIM_GPIO_PINS           (8u)
+
+/* Conversion of CPU cycles to nanoseconds */
+#define SIM_CYCLES_NS(cycles)   (((uint64_t)(cycles) * 1000000000ULL) / SIM_CPU_HZ)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+SCB_Type sim_core_scb;
+uint32_t SystemCoreClock = SIM_CPU_HZ;
+GPIO_PRT_Type sim_gpio_port;
+
+/* Simulated time */
+static uint64_t simNowNs = 0ULL;
+
+/* PRIMASK, and set while an interrupt handler runs. All interrupts of the
+ * application have the same priority, so none preempts another. */
+static bool simMasked = false;
+static bool simInIsr = false;
+
+/* NVIC */
+static cy_israddress simVectors[SIM_IRQ_COUNT];
+static bool simEnabled[SIM_IRQ_COUNT];
+static bool simSwPending[SIM_IRQ_COUNT];
+
+/* SysTick */
+static bool tickRunning = false;
+static bool tickPending = false;
+static uint32_t tickReload = 0UL;
+static uint64_t tickPeriodNs = 0ULL;
+static uint64_t tickStartNs = 0ULL;
+static uint64_t tickNextNs = SIM_NEVER;
+static Cy_SysTick_Callback tickCallbacks[SIM_SYSTICK_CALLBACKS];
+
+/* Hook of the test, and its reentrancy guard */
+static sim_hook_t simHook = NULL;
+static bool simInHook = false;
+
+/* Counters */
+static uint32_t simIsrCount = 0UL;
+static uint32_t simSleepCount = 0UL;
+
+/* Pins: level driven by the port (1 releases an open-drain line) and HSIOM
+ * selection */
+static uint32_t gpioOut[SIM_GPIO_PINS] = { 1UL, 1UL, 1UL, 1UL, 1UL, 1UL, 1UL, 1UL };
+static uint32_t gpioHsiom[SIM_GPIO_PINS] =
+{
+    CYBSP_I2C_SDA_HSIOM, CYBSP_I2C_SCL_HSIOM, HSIOM_SEL_GPIO, HSIOM_SEL_GPIO,
+    HSIOM_SEL_GPIO, HSIOM_SEL_GPIO, HSIOM_SEL_GPIO, HSIOM_SEL_GPIO
+};
+static uint32_t ledEdges = 0UL;
+
+/* State of the pseudo-random sequence of all models */
+static uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+
+/*******************************************************************************
+* Function Name: SimFatal
+********************************************************************************
+* Summary:
+*  Reports a condition the simulated hardware would hang in, and exits.
+*
+*******************************************************************************/
+static void SimFatal(const char *what)
+{
+    printf("SIM: %s at %.3f ms\n", what, (double)simNowNs / 1e6);
+    exit(2);
+}
+
+/*******************************************************************************
+* Function Name: SimPendingIrq
+********************************************************************************
+* Summary:
+*  Returns the interrupt to take next: SysTick, then the enabled NVIC lines
+*  from the lowest number.
+*
+*******************************************************************************/
+static int SimPendingIrq(void)
+{
+    if (tickPending)
+    {
+        return SIM_IRQ_SYSTICK;
+    }
+
+    for (int irq = 0; irq < SIM_IRQ_COUNT; irq++)
+    {
+        bool pending = simSwPending[irq] ||
+                       ((irq == CYBSP_I2C_IRQ) && sim_i2c_irq_pending()) ||
+                       ((irq == CYBSP_UART_IRQ) && sim_uart_irq_pending());
+
+        if (pending && simEnabled[irq] && (simVectors[irq] != NULL))
+        {
+            return irq;
+        }
+    }
+    return SIM_IRQ_NONE;
+}
+
+/*******************************************************************************
+* Function Name: SimStep
+********************************************************************************
+* Summary:
+*  Lets the peripherals catch up with the simulated time and returns the
+*  time of the next thing they have scheduled.
+*
+*******************************************************************************/
+static uint64_t SimStep(void)
+{
+    uint64_t next = SIM_NEVER;
+    uint64_t t;
+
+    if (tickRunning)
+    {
+        while (tickNextNs <= simNowNs)
+        {
+            /* A tick that is still pending is lost, as on the hardware */
+            tickPending = true;
+            tickNextNs += tickPeriodNs;
+        }
+        next = tickNextNs;
+    }
+    if (tickPending)
+    {
+        sim_core_scb.ICSR |= SCB_ICSR_PENDSTSET_Msk;
+    }
+    else
+    {
+        sim_core_scb.ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+    }
+
+    t = sim_i2c_step(simNowNs);
+    if (t < next)
+    {
+        next = t;
+    }
+    t = sim_uart_step(simNowNs);
+    if (t < next)
+    {
+        next = t;
+    }
+    return next;
+}
+
+/*******************************************************************************
+* Function Name: SimAdvance
+********************************************************************************
+* Summary:
+*  Moves the time forward without taking interrupts.
+*
+*******************************************************************************/
+static void SimAdvance(uint64_t untilNs)
+{
+    uint64_t next = SimStep();
+
+    while (next <= untilNs)
+    {
+        simNowNs = next;
+        next = SimStep();
+    }
+    if (simNowNs < untilNs)
+    {
+        simNowNs = untilNs;
+        (void)SimStep();
+    }
+}
+
+/*******************************************************************************
+* Function Name: SimService
+********************************************************************************
+* Summary:
+*  Takes the pending interrupts unless they are masked. Each one costs
+*  SIM_ISR_CYCLES of CPU time.
+*
+* Return:
+*  true if an interrupt was taken
+*
+*******************************************************************************/
+static bool SimService(void)
+{
+    uint32_t taken = 0UL;
+    int irq;
+
+    if (simMasked || simInIsr)
+    {
+        return false;
+    }
+
+    simInIsr = true;
+    for (irq = SimPendingIrq(); irq != SIM_IRQ_NONE; irq = SimPendingIrq())
+    {
+        if (++taken > SIM_ISR_STORM)
+        {
+            SimFatal("interrupt storm");
+        }
+        simIsrCount++;
+        SimAdvance(simNowNs + SIM_CYCLES_NS(SIM_ISR_CYCLES));
+
+        if (irq == SIM_IRQ_SYSTICK)
+        {
+            tickPending = false;
+            sim_core_scb.ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+            for (uint32_t i = 0u; i < SIM_SYSTICK_CALLBACKS; i++)
+            {
+                if (tickCallbacks[i] != NULL)
+                {
+                    tickCallbacks[i]();
+                }
+            }
+        }
+        else
+        {
+            /* Entry clears a pending edge, a level source stays pending
+             * until the handler clears its cause */
+            simSwPending[irq] = false;
+            simVectors[irq]();
+        }
+    }
+    simInIsr = false;
+
+    return (taken > 0UL);
+}
+
+/*******************************************************************************
+* Function Name: SimRun
+********************************************************************************
+* Summary:
+*  Moves the time forward and takes the interrupts that become pending.
+*
+*******************************************************************************/
+static void SimRun(uint64_t untilNs)
+{
+    uint64_t next;
+
+    for (;;)
+    {
+        next = SimStep();
+        if (SimService())
+        {
+            continue;
+        }
+        if (next > untilNs)
+        {
+            break;
+        }
+        simNowNs = next;
+    }
+    if (simNowNs < untilNs)
+    {
+        simNowNs = untilNs;
+        (void)SimStep();
+    }
+}
+
+/*******************************************************************************
+* Function Name: SimCallHook
+********************************************************************************
+* Summary:
+*  Gives control to the test from the sleep and delay functions of the
+*  application.
+*
+*******************************************************************************/
+static void SimCallHook(void)
+{
+    if ((simHook != NULL) && !simInHook && !simInIsr)
+    {
+        simInHook = true;
+        simHook();
+        simInHook = false;
+    }
+}
+
+/*******************************************************************************
+* Simulator API
+*******************************************************************************/
+uint64_t sim_time_ns(void)
+{
+    return simNowNs;
+}
+
+uint64_t sim_time_us(void)
+{
+    return simNowNs / 1000ULL;
+}
+
+void sim_run_us(uint64_t us)
+{
+    SimRun(simNowNs + (us * 1000ULL));
+}
+
+void sim_spend_ns(uint64_t ns)
+{
+    SimRun(simNowNs + ns);
+}
+
+void sim_poll(void)
+{
+    sim_spend_ns(SIM_CYCLES_NS(SIM_POLL_CYCLES));
+}
+
+void sim_set_hook(sim_hook_t hook)
+{
+    simHook = hook;
+}
+
+uint32_t sim_isr_count(void)
+{
+    return simIsrCount;
+}
+
+uint32_t sim_sleep_count(void)
+{
+    return simSleepCount;
+}
+
+void sim_button_press(void)
+{
+    simSwPending[CYBSP_USER_BTN_IRQ] = true;
+    (void)SimService();
+}
+
+bool sim_led_on(void)
+{
+    /* The kit LED is lit by driving its pin low */
+    return (gpioOut[CYBSP_USER_LED_PIN] == 0UL);
+}
+
+uint32_t sim_led_edges(void)
+{
+    return ledEdges;
+}
+
+void sim_seed(uint64_t seed)
+{
+    randomState = (seed != 0ULL) ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+uint64_t sim_random(void)
+{
+    /* xorshift64 */
+    randomState ^= randomState << 13u;
+    randomState ^= randomState >> 7u;
+    randomState ^= randomState << 17u;
+    return randomState;
+}
+
+void sim_assert(bool condition, const char *expr, const char *file, int line)
+{
+    if (!condition)
+    {
+        printf("%s:%d: CY_ASSERT(%s) failed\n", file, line, expr);
+        exit(1);
+    }
+}
+
+/*******************************************************************************
+* NVIC and SysInt
+*******************************************************************************/
+void __enable_irq(void)
+{
+    simMasked = false;
+    (void)SimService();
+}
+
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    if ((irqn >= 0) && (irqn < SIM_IRQ_COUNT))
+    {
+        simEnabled[irqn] = true;
+        (void)SimService();
+    }
+}
+
+void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    if ((irqn >= 0) && (irqn < SIM_IRQ_COUNT))
+    {
+        simEnabled[irqn] = false;
+    }
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+    if ((irqn >= 0) && (irqn < SIM_IRQ_COUNT))
+    {
+        simSwPending[irqn] = false;
+    }
+}
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    if ((config == NULL) || (config->intrSrc < 0) || (config->intrSrc >= SIM_IRQ_COUNT))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+    simVectors[config->intrSrc] = userIsr;
+    return CY_SYSINT_SUCCESS;
+}
+
+/*******************************************************************************
+* SysLib
+*******************************************************************************/
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+    SimCallHook();
+    SimRun(simNowNs + ((uint64_t)milliseconds * 1000000ULL));
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    SimCallHook();
+    SimRun(simNowNs + ((uint64_t)microseconds * 1000ULL));
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    uint32_t saved = simMasked ? 1UL : 0UL;
+
+    simMasked = true;
+    return saved;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    simMasked = (savedIntrStatus != 0UL);
+    (void)SimService();
+}
+
+uint64_t Cy_SysLib_GetUniqueId(void)
+{
+    return 0x0123456789ABCDEFULL;
+}
+
+/*******************************************************************************
+* SysTick
+*******************************************************************************/
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval)
+{
+    (void)clockSource;
+
+    tickReload   = interval;
+    tickPeriodNs = SIM_CYCLES_NS((uint64_t)interval + 1ULL);
+    tickStartNs  = simNowNs;
+    tickNextNs   = simNowNs + tickPeriodNs;
+    tickPending  = false;
+    tickRunning  = true;
+}
+
+Cy_SysTick_Callback Cy_SysTick_SetCallback(uint32_t number, Cy_SysTick_Callback function)
+{
+    Cy_SysTick_Callback old = NULL;
+
+    if (number < SIM_SYSTICK_CALLBACKS)
+    {
+        old = tickCallbacks[number];
+        tickCallbacks[number] = function;
+    }
+    return old;
+}
+
+uint32_t Cy_SysTick_GetValue(void)
+{
+    uint64_t cycles;
+
+    sim_poll();
+    if (!tickRunning)
+    {
+        return 0UL;
+    }
+
+    /* The counter runs down from the reload value */
+    cycles = (((simNowNs - tickStartNs) % tickPeriodNs) * SIM_CPU_HZ) / 1000000000ULL;
+    return tickReload - (uint32_t)cycles;
+}
+
+uint32_t Cy_SysTick_GetReload(void)
+{
+    return tickReload;
+}
+
+/*******************************************************************************
+* SysPm
+*******************************************************************************/
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void)
+{
+    uint64_t next;
+
+    simSleepCount++;
+    SimCallHook();
+
+    /* WFI: a pending interrupt wakes the CPU even while PRIMASK is set */
+    next = SimStep();
+    while (SimPendingIrq() == SIM_IRQ_NONE)
+    {
+        if (next == SIM_NEVER)
+        {
+            SimFatal("sleep without a wake-up source");
+        }
+        simNowNs = next;
+        next = SimStep();
+    }
+    (void)SimService();
+
+    return CY_SYSPM_SUCCESS;
+}
+
+/*******************************************************************************
+* SysClk
+*******************************************************************************/
+uint32_t Cy_SysClk_ClkHfGetFrequency(void)
+{
+    return SIM_CPU_HZ;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphSetDivider(cy_en_divider_types_t dividerType,
+                                                 uint32_t dividerNum, uint32_t dividerValue)
+{
+    (void)dividerType;
+    (void)dividerNum;
+    (void)dividerValue;
+    return CY_SYSCLK_SUCCESS;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphEnableDivider(cy_en_divider_types_t dividerType,
+                                                    uint32_t dividerNum)
+{
+    (void)dividerType;
+    (void)dividerNum;
+    return CY_SYSCLK_SUCCESS;
+}
+
+cy_en_sysclk_status_t Cy_SysClk_PeriphDisableDivider(cy_en_divider_types_t dividerType,
+                                                     uint32_t dividerNum)
+{
+    (void)dividerType;
+    (void)dividerNum;
+    return CY_SYSCLK_SUCCESS;
+}
+
+/*******************************************************************************
+* GPIO
+*******************************************************************************/
+void Cy_GPIO_Set(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    Cy_GPIO_Write(base, pinNum, 1UL);
+}
+
+void Cy_GPIO_Clr(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    Cy_GPIO_Write(base, pinNum, 0UL);
+}
+
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    Cy_GPIO_Write(base, pinNum, (pinNum < SIM_GPIO_PINS) ? (gpioOut[pinNum] ^ 1UL) : 0UL);
+}
+
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value)
+{
+    (void)base;
+
+    if (pinNum >= SIM_GPIO_PINS)
+    {
+        return;
+    }
+    value = (value != 0UL) ? 1UL : 0UL;
+
+    if (value != gpioOut[pinNum])
+    {
+        if (pinNum == CYBSP_USER_LED_PIN)
+        {
+            ledEdges++;
+        }
+        else if ((pinNum == CYBSP_I2C_SCL_PIN) && (value == 0UL) &&
+                 (gpioHsiom[pinNum] == HSIOM_SEL_GPIO))
+        {
+            /* Falling edge clocked out by software */
+            sim_i2c_scl_pulse();
+        }
+        else
+        {
+            /* No effect on the models */
+        }
+    }
+    gpioOut[pinNum] = value;
+}
+
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    uint32_t level;
+
+    (void)base;
+    sim_poll();
+
+    if (pinNum >= SIM_GPIO_PINS)
+    {
+        return 0UL;
+    }
+
+    /* Open drain: the line is low if anyone pulls it low */
+    level = (gpioHsiom[pinNum] == HSIOM_SEL_GPIO) ? gpioOut[pinNum] : 1UL;
+    if (((pinNum == CYBSP_I2C_SDA_PIN) || (pinNum == CYBSP_I2C_SCL_PIN)) &&
+        sim_i2c_line_low(pinNum == CYBSP_I2C_SDA_PIN))
+    {
+        level = 0UL;
+    }
+    return level;
+}
+
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value)
+{
+    (void)base;
+    if (pinNum < SIM_GPIO_PINS)
+    {
+        gpioHsiom[pinNum] = value;
+    }
+}
+
+uint32_t Cy_GPIO_GetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    return (pinNum < SIM_GPIO_PINS) ? gpioHsiom[pinNum] : HSIOM_SEL_GPIO;
+}
+
+void Cy_GPIO_ClearInterrupt(GPIO_PRT_Type *base, uint32_t pinNum)
+{
+    (void)base;
+    (void)pinNum;
+}
+
+/*******************************************************************************
+* BSP
+*******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,320 @@
+/******************************************************************************
+* File Name:  sim_uart.c
+*
+* Description:  Simulated SCB in UART mode, with timed receive and transmit.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes that can be on their way to the UART at a time */
+#define UART_RX_QUEUE_SIZE      (1UL << 20u)
+
+/* Bits per character: start, eight data, stop */
+#define UART_CHAR_BITS          (10ULL)
+
+#define UART_DEFAULT_BAUD       (115200UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+const cy_stc_scb_uart_config_t CYBSP_UART_config = { 8UL };
+
+static bool enabled = false;
+static uint32_t baud = UART_DEFAULT_BAUD;
+
+/* Bytes on the RX line, with the time their stop bit ends */
+static uint8_t rxData[UART_RX_QUEUE_SIZE];
+static uint64_t rxTimeNs[UART_RX_QUEUE_SIZE];
+static uint32_t rxHead = 0UL;
+static uint32_t rxTail = 0UL;
+static uint64_t rxLineNs = 0ULL;
+
+/* Byte in the TX shift register */
+static bool txShifting = false;
+static uint8_t txByte = 0u;
+static uint64_t txEndNs = SIM_NEVER;
+
+static sim_uart_tx_hook_t txHook = NULL;
+static sim_uart_stats_t stats;
+
+/*******************************************************************************
+* Function Name: UartScb
+********************************************************************************
+* Summary:
+*  Returns the FIFOs and interrupt sources of the UART SCB.
+*
+*******************************************************************************/
+static sim_scb_t *UartScb(void)
+{
+    return sim_scb_get(&sim_uart_scb);
+}
+
+/*******************************************************************************
+* Function Name: UartCharNs
+********************************************************************************
+* Summary:
+*  Returns the time of one character on the line.
+*
+*******************************************************************************/
+static uint64_t UartCharNs(void)
+{
+    return (UART_CHAR_BITS * 1000000000ULL) / baud;
+}
+
+/*******************************************************************************
+* Function Name: UartShift
+********************************************************************************
+* Summary:
+*  Moves the next byte of the TX FIFO to the shift register.
+*
+*******************************************************************************/
+static void UartShift(uint64_t nowNs)
+{
+    sim_scb_t *scb = UartScb();
+
+    if (txShifting || (scb->txCount == 0UL))
+    {
+        return;
+    }
+
+    txByte = scb->tx[0];
+    (void)memmove(scb->tx, &scb->tx[1], --scb->txCount);
+    txShifting = true;
+    txEndNs = nowNs + UartCharNs();
+}
+
+/*******************************************************************************
+* Engine
+*******************************************************************************/
+uint64_t sim_uart_step(uint64_t nowNs)
+{
+    sim_scb_t *scb = UartScb();
+    uint64_t next = SIM_NEVER;
+
+    /* Received bytes enter the RX FIFO, or are lost on a full one */
+    while ((rxTail != rxHead) && (rxTimeNs[rxTail % UART_RX_QUEUE_SIZE] <= nowNs))
+    {
+        if (!enabled)
+        {
+            /* Nobody listens */
+        }
+        else if (scb->rxCount < SIM_SCB_FIFO_SIZE)
+        {
+            scb->rx[scb->rxCount++] = rxData[rxTail % UART_RX_QUEUE_SIZE];
+            stats.rxBytes++;
+            if (scb->rxCount > stats.rxPeak)
+            {
+                stats.rxPeak = scb->rxCount;
+            }
+        }
+        else
+        {
+            scb->rxStatus |= CY_SCB_RX_INTR_OVERFLOW;
+            stats.rxOverflows++;
+        }
+        rxTail++;
+    }
+
+    /* Transmit */
+    while (txShifting && (txEndNs <= nowNs))
+    {
+        uint64_t endNs = txEndNs;
+
+        txShifting = false;
+        txEndNs = SIM_NEVER;
+        stats.txBytes++;
+        if (txHook != NULL)
+        {
+            txHook(txByte, endNs / 1000ULL);
+        }
+        UartShift(endNs);
+    }
+    UartShift(nowNs);
+    if (txEndNs < next)
+    {
+        next = txEndNs;
+    }
+
+    /* After the TX hook, which may have sent the next bytes */
+    if ((rxTail != rxHead) && (rxTimeNs[rxTail % UART_RX_QUEUE_SIZE] < next))
+    {
+        next = rxTimeNs[rxTail % UART_RX_QUEUE_SIZE];
+    }
+    return next;
+}
+
+bool sim_uart_irq_pending(void)
+{
+    return (enabled && sim_scb_irq_pending(UartScb()));
+}
+
+/*******************************************************************************
+* Simulator API
+*******************************************************************************/
+void sim_uart_set_baud(uint32_t rate)
+{
+    baud = rate;
+}
+
+void sim_uart_send_at(uint64_t timeUs, const uint8_t *data, uint32_t len)
+{
+    uint64_t startNs = timeUs * 1000ULL;
+
+    if (rxLineNs < startNs)
+    {
+        rxLineNs = startNs;
+    }
+    if (rxLineNs < sim_time_ns())
+    {
+        rxLineNs = sim_time_ns();
+    }
+
+    for (uint32_t i = 0UL; i < len; i++)
+    {
+        if ((rxHead - rxTail) >= UART_RX_QUEUE_SIZE)
+        {
+            printf("SIM: UART RX queue full\n");
+            exit(2);
+        }
+        rxLineNs += UartCharNs();
+        rxData[rxHead % UART_RX_QUEUE_SIZE] = data[i];
+        rxTimeNs[rxHead % UART_RX_QUEUE_SIZE] = rxLineNs;
+        rxHead++;
+    }
+}
+
+void sim_uart_set_tx_hook(sim_uart_tx_hook_t hook)
+{
+    txHook = hook;
+}
+
+void sim_uart_get_stats(sim_uart_stats_t *out)
+{
+    *out = stats;
+}
+
+/*******************************************************************************
+* SCB UART
+*******************************************************************************/
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, cy_stc_scb_uart_config_t const *config,
+                                         cy_stc_scb_uart_context_t *context)
+{
+    if ((base == NULL) || (config == NULL))
+    {
+        return CY_SCB_UART_BAD_PARAM;
+    }
+    if (context != NULL)
+    {
+        (void)memset(context, 0, sizeof(*context));
+    }
+    sim_scb_reset(UartScb());
+    return CY_SCB_UART_SUCCESS;
+}
+
+void Cy_SCB_UART_Enable(CySCB_Type *base)
+{
+    (void)base;
+    enabled = true;
+}
+
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data)
+{
+    sim_scb_t *scb = UartScb();
+
+    (void)base;
+    if (scb->txCount >= SIM_SCB_FIFO_SIZE)
+    {
+        /* The FIFO status read lets the time move on for a caller that
+         * retries */
+        sim_poll();
+        return 0UL;
+    }
+    scb->tx[scb->txCount++] = (uint8_t)data;
+    UartShift(sim_time_ns());
+    return 1UL;
+}
+
+uint32_t Cy_SCB_UART_PutArray(CySCB_Type *base, void *buffer, uint32_t size)
+{
+    const uint8_t *src = (const uint8_t *)buffer;
+    uint32_t count = 0UL;
+
+    while ((count < size) && (Cy_SCB_UART_Put(base, src[count]) != 0UL))
+    {
+        count++;
+    }
+    return count;
+}
+
+void Cy_SCB_UART_PutString(CySCB_Type *base, char_t const string[])
+{
+    /* Blocks until the whole string is in the TX FIFO */
+    for (uint32_t i = 0UL; string[i] != '\0'; i++)
+    {
+        while (Cy_SCB_UART_Put(base, (uint8_t)string[i]) == 0UL)
+        {
+            /* Retry */
+        }
+    }
+}
+
+uint32_t Cy_SCB_UART_Get(CySCB_Type const *base)
+{
+    uint8_t data;
+
+    if (Cy_SCB_ReadArray(base, &data, 1UL) == 0UL)
+    {
+        return CY_SCB_UART_RX_NO_DATA;
+    }
+    return data;
+}
+
+bool Cy_SCB_UART_IsTxComplete(CySCB_Type const *base)
+{
+    (void)base;
+    sim_poll();
+    return (!txShifting && (UartScb()->txCount == 0UL));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,364 @@
+/******************************************************************************
+* File Name:  cy_pdl.h
+*
+* Description:  Host stand-in for the PMG1 peripheral driver library: the
+*               types, registers and functions the EEPROM example uses,
+*               implemented by the simulator in host/sim.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef HOST_CY_PDL_H_
+#define HOST_CY_PDL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+* General
+*******************************************************************************/
+typedef uint32_t cy_rslt_t;
+typedef char char_t;
+#define CY_RSLT_SUCCESS                     (0UL)
+
+#define CY_ASSERT(x)                        sim_assert((x), #x, __FILE__, __LINE__)
+
+typedef int IRQn_Type;
+typedef void (*cy_israddress)(void);
+
+/* Cortex-M0+ system control block, only the interrupt control register */
+typedef struct
+{
+    volatile uint32_t ICSR;
+} SCB_Type;
+
+extern SCB_Type sim_core_scb;
+#define SCB                                 (&sim_core_scb)
+#define SCB_ICSR_PENDSTSET_Msk              (1UL << 26u)
+
+extern uint32_t SystemCoreClock;
+
+void sim_assert(bool condition, const char *expr, const char *file, int line);
+
+void __enable_irq(void);
+void NVIC_EnableIRQ(IRQn_Type irqn);
+void NVIC_DisableIRQ(IRQn_Type irqn);
+void NVIC_ClearPendingIRQ(IRQn_Type irqn);
+
+/*******************************************************************************
+* SysLib, SysInt, SysTick, SysClk, SysPm
+*******************************************************************************/
+typedef enum
+{
+    CY_SYSINT_SUCCESS   = 0,
+    CY_SYSINT_BAD_PARAM = 1
+} cy_en_sysint_status_t;
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+
+void Cy_SysLib_Delay(uint32_t milliseconds);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+uint64_t Cy_SysLib_GetUniqueId(void);
+
+typedef enum
+{
+    CY_SYSTICK_CLOCK_SOURCE_CLK_LF  = 0,
+    CY_SYSTICK_CLOCK_SOURCE_CLK_CPU = 4
+} cy_en_systick_clock_source_t;
+
+typedef void (*Cy_SysTick_Callback)(void);
+
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval);
+Cy_SysTick_Callback Cy_SysTick_SetCallback(uint32_t number, Cy_SysTick_Callback function);
+uint32_t Cy_SysTick_GetValue(void);
+uint32_t Cy_SysTick_GetReload(void);
+
+typedef enum
+{
+    CY_SYSCLK_DIV_8_BIT  = 0,
+    CY_SYSCLK_DIV_16_BIT = 1
+} cy_en_divider_types_t;
+
+typedef enum
+{
+    CY_SYSCLK_SUCCESS   = 0,
+    CY_SYSCLK_BAD_PARAM = 1
+} cy_en_sysclk_status_t;
+
+uint32_t Cy_SysClk_ClkHfGetFrequency(void);
+cy_en_sysclk_status_t Cy_SysClk_PeriphSetDivider(cy_en_divider_types_t dividerType,
+                                                 uint32_t dividerNum, uint32_t dividerValue);
+cy_en_sysclk_status_t Cy_SysClk_PeriphEnableDivider(cy_en_divider_types_t dividerType,
+                                                    uint32_t dividerNum);
+cy_en_sysclk_status_t Cy_SysClk_PeriphDisableDivider(cy_en_divider_types_t dividerType,
+                                                     uint32_t dividerNum);
+
+typedef enum
+{
+    CY_SYSPM_SUCCESS = 0,
+    CY_SYSPM_FAIL    = 1
+} cy_en_syspm_status_t;
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterSleep(void);
+
+/*******************************************************************************
+* GPIO
+*******************************************************************************/
+typedef struct
+{
+    uint32_t port;
+} GPIO_PRT_Type;
+
+#define HSIOM_SEL_GPIO                      (0UL)
+
+void Cy_GPIO_Set(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Clr(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Inv(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_Write(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value);
+uint32_t Cy_GPIO_Read(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_SetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum, uint32_t value);
+uint32_t Cy_GPIO_GetHSIOM(GPIO_PRT_Type *base, uint32_t pinNum);
+void Cy_GPIO_ClearInterrupt(GPIO_PRT_Type *base, uint32_t pinNum);
+
+/*******************************************************************************
+* SCB registers and FIFOs
+*******************************************************************************/
+/* An SCB block. Only the registers the application writes directly are
+ * visible, the rest of the state is kept by the simulator. */
+typedef struct
+{
+    volatile uint32_t I2C_CTRL;
+    volatile uint32_t I2C_M_CMD;
+} CySCB_Type;
+
+#define SCB_I2C_CTRL(base)                  ((base)->I2C_CTRL)
+#define SCB_I2C_M_CMD(base)                 ((base)->I2C_M_CMD)
+
+#define SCB_I2C_CTRL_M_READY_DATA_ACK_Msk       (1UL << 8u)
+#define SCB_I2C_CTRL_M_NOT_READY_DATA_NACK_Msk  (1UL << 9u)
+
+#define SCB_I2C_M_CMD_M_START_Msk           (1UL << 0u)
+#define SCB_I2C_M_CMD_M_START_ON_IDLE_Msk   (1UL << 1u)
+#define SCB_I2C_M_CMD_M_ACK_Msk             (1UL << 2u)
+#define SCB_I2C_M_CMD_M_NACK_Msk            (1UL << 3u)
+#define SCB_I2C_M_CMD_M_STOP_Msk            (1UL << 4u)
+
+#define CY_SCB_CLEAR_ALL_INTR_SRC           (0UL)
+
+#define CY_SCB_TX_INTR_LEVEL                (1UL << 0u)
+#define CY_SCB_TX_INTR_UNDERFLOW            (1UL << 6u)
+
+#define CY_SCB_RX_INTR_LEVEL                (1UL << 0u)
+#define CY_SCB_RX_INTR_NOT_EMPTY            (1UL << 2u)
+#define CY_SCB_RX_INTR_OVERFLOW             (1UL << 5u)
+
+#define CY_SCB_MASTER_INTR_I2C_ARB_LOST     (1UL << 0u)
+#define CY_SCB_MASTER_INTR_I2C_NACK         (1UL << 1u)
+#define CY_SCB_MASTER_INTR_I2C_ACK          (1UL << 2u)
+#define CY_SCB_MASTER_INTR_I2C_STOP         (1UL << 4u)
+#define CY_SCB_MASTER_INTR_I2C_BUS_ERROR    (1UL << 8u)
+
+void Cy_SCB_SetTxInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+void Cy_SCB_SetRxInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+void Cy_SCB_SetMasterInterruptMask(CySCB_Type *base, uint32_t interruptMask);
+uint32_t Cy_SCB_GetTxInterruptStatusMasked(CySCB_Type const *base);
+uint32_t Cy_SCB_GetRxInterruptStatusMasked(CySCB_Type const *base);
+uint32_t Cy_SCB_GetMasterInterruptStatusMasked(CySCB_Type const *base);
+void Cy_SCB_ClearTxInterrupt(CySCB_Type *base, uint32_t interruptMask);
+void Cy_SCB_ClearRxInterrupt(CySCB_Type *base, uint32_t interruptMask);
+void Cy_SCB_ClearMasterInterrupt(CySCB_Type *base, uint32_t interruptMask);
+void Cy_SCB_SetTxFifoLevel(CySCB_Type *base, uint32_t level);
+void Cy_SCB_SetRxFifoLevel(CySCB_Type *base, uint32_t level);
+uint32_t Cy_SCB_GetFifoSize(CySCB_Type const *base);
+void Cy_SCB_ClearTxFifo(CySCB_Type *base);
+void Cy_SCB_ClearRxFifo(CySCB_Type *base);
+uint32_t Cy_SCB_WriteArray(CySCB_Type *base, void *buffer, uint32_t size);
+uint32_t Cy_SCB_ReadArray(CySCB_Type const *base, void *buffer, uint32_t size);
+void Cy_SCB_WriteTxFifo(CySCB_Type *base, uint32_t data);
+
+/*******************************************************************************
+* SCB I2C
+*******************************************************************************/
+#define CY_SCB_WAIT_1_UNIT                  (1UL)
+
+typedef enum
+{
+    CY_SCB_I2C_SUCCESS                      = 0,
+    CY_SCB_I2C_BAD_PARAM                    = 1,
+    CY_SCB_I2C_MASTER_NOT_READY             = 2,
+    CY_SCB_I2C_MASTER_MANUAL_TIMEOUT        = 3,
+    CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK       = 4,
+    CY_SCB_I2C_MASTER_MANUAL_NAK            = 5,
+    CY_SCB_I2C_MASTER_MANUAL_ARB_LOST       = 6,
+    CY_SCB_I2C_MASTER_MANUAL_BUS_ERR        = 7,
+    CY_SCB_I2C_MASTER_MANUAL_ABORT_START    = 8
+} cy_en_scb_i2c_status_t;
+
+typedef enum
+{
+    CY_SCB_I2C_WRITE_XFER = 0,
+    CY_SCB_I2C_READ_XFER  = 1
+} cy_en_scb_i2c_direction_t;
+
+typedef enum
+{
+    CY_SCB_I2C_ACK = 0,
+    CY_SCB_I2C_NAK = 1
+} cy_en_scb_i2c_command_t;
+
+/* Master status, returned by Cy_SCB_I2C_MasterGetStatus() */
+#define CY_SCB_I2C_MASTER_DATA_NAK          (1UL << 1u)
+#define CY_SCB_I2C_MASTER_ADDR_NAK          (1UL << 2u)
+#define CY_SCB_I2C_MASTER_ARB_LOST          (1UL << 3u)
+#define CY_SCB_I2C_MASTER_BUS_ERR           (1UL << 4u)
+#define CY_SCB_I2C_MASTER_ABORT_START       (1UL << 5u)
+#define CY_SCB_I2C_MASTER_BUSY              (1UL << 16u)
+
+/* Master events, passed to the callback registered with
+ * Cy_SCB_I2C_RegisterEvent() */
+#define CY_SCB_I2C_MASTER_WR_IN_FIFO_EVENT  (1UL << 17u)
+#define CY_SCB_I2C_MASTER_WR_CMPLT_EVENT    (1UL << 18u)
+#define CY_SCB_I2C_MASTER_RD_CMPLT_EVENT    (1UL << 19u)
+#define CY_SCB_I2C_MASTER_ERR_EVENT         (1UL << 20u)
+
+typedef void (*cy_cb_scb_i2c_handle_events_t)(uint32_t event);
+
+typedef struct
+{
+    uint32_t i2cMode;
+    bool useRxFifo;
+    bool useTxFifo;
+} cy_stc_scb_i2c_config_t;
+
+/* Driver context: state of the transfer in progress */
+typedef struct
+{
+    uint32_t state;
+    uint32_t masterStatus;
+    bool masterPause;
+    bool masterRdDir;
+    uint8_t *masterBuffer;
+    uint32_t masterBufferSize;
+    uint32_t masterBufferIdx;
+    uint32_t masterNumBytes;
+    cy_cb_scb_i2c_handle_events_t cbEvents;
+} cy_stc_scb_i2c_context_t;
+
+typedef struct
+{
+    uint8_t slaveAddress;
+    uint8_t *buffer;
+    uint32_t bufferSize;
+    bool xferPending;
+} cy_stc_scb_i2c_master_xfer_config_t;
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_Init(CySCB_Type *base, cy_stc_scb_i2c_config_t const *config,
+                                       cy_stc_scb_i2c_context_t *context);
+void Cy_SCB_I2C_Enable(CySCB_Type *base, cy_stc_scb_i2c_context_t const *context);
+void Cy_SCB_I2C_Disable(CySCB_Type *base, cy_stc_scb_i2c_context_t *context);
+uint32_t Cy_SCB_I2C_SetDataRate(CySCB_Type *base, uint32_t dataRateHz, uint32_t scbClockHz);
+uint32_t Cy_SCB_I2C_GetDataRate(CySCB_Type const *base, uint32_t scbClockHz);
+bool Cy_SCB_I2C_IsBusBusy(CySCB_Type const *base);
+void Cy_SCB_I2C_RegisterEvent(CySCB_Type const *base, cy_cb_scb_i2c_handle_events_t callback,
+                              cy_stc_scb_i2c_context_t *context);
+void Cy_SCB_I2C_Interrupt(CySCB_Type *base, cy_stc_scb_i2c_context_t *context);
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterWrite(CySCB_Type *base,
+                                              cy_stc_scb_i2c_master_xfer_config_t *xferConfig,
+                                              cy_stc_scb_i2c_context_t *context);
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterRead(CySCB_Type *base,
+                                             cy_stc_scb_i2c_master_xfer_config_t *xferConfig,
+                                             cy_stc_scb_i2c_context_t *context);
+uint32_t Cy_SCB_I2C_MasterGetStatus(CySCB_Type const *base, cy_stc_scb_i2c_context_t const *context);
+uint32_t Cy_SCB_I2C_MasterGetTransferCount(CySCB_Type const *base,
+                                           cy_stc_scb_i2c_context_t const *context);
+
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterSendStart(CySCB_Type *base, uint32_t address,
+                                                  cy_en_scb_i2c_direction_t bitRnW, uint32_t timeoutMs,
+                                                  cy_stc_scb_i2c_context_t *context);
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterSendReStart(CySCB_Type *base, uint32_t address,
+                                                    cy_en_scb_i2c_direction_t bitRnW, uint32_t timeoutMs,
+                                                    cy_stc_scb_i2c_context_t *context);
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterSendStop(CySCB_Type *base, uint32_t timeoutMs,
+                                                 cy_stc_scb_i2c_context_t *context);
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterWriteByte(CySCB_Type *base, uint8_t byte, uint32_t timeoutMs,
+                                                  cy_stc_scb_i2c_context_t *context);
+cy_en_scb_i2c_status_t Cy_SCB_I2C_MasterReadByte(CySCB_Type *base, cy_en_scb_i2c_command_t ackNack,
+                                                 uint8_t *byte, uint32_t timeoutMs,
+                                                 cy_stc_scb_i2c_context_t *context);
+
+/*******************************************************************************
+* SCB UART
+*******************************************************************************/
+#define CY_SCB_UART_RX_NO_DATA              (0xFFFFFFFFUL)
+
+typedef struct
+{
+    uint32_t oversample;
+} cy_stc_scb_uart_config_t;
+
+typedef struct
+{
+    uint32_t txStatus;
+    uint32_t rxStatus;
+} cy_stc_scb_uart_context_t;
+
+typedef enum
+{
+    CY_SCB_UART_SUCCESS   = 0,
+    CY_SCB_UART_BAD_PARAM = 1
+} cy_en_scb_uart_status_t;
+
+cy_en_scb_uart_status_t Cy_SCB_UART_Init(CySCB_Type *base, cy_stc_scb_uart_config_t const *config,
+                                         cy_stc_scb_uart_context_t *context);
+void Cy_SCB_UART_Enable(CySCB_Type *base);
+uint32_t Cy_SCB_UART_Put(CySCB_Type *base, uint32_t data);
+uint32_t Cy_SCB_UART_PutArray(CySCB_Type *base, void *buffer, uint32_t size);
+void Cy_SCB_UART_PutString(CySCB_Type *base, char_t const string[]);
+uint32_t Cy_SCB_UART_Get(CySCB_Type const *base);
+bool Cy_SCB_UART_IsTxComplete(CySCB_Type const *base);
+
+#endif /* HOST_CY_PDL_H_ */
@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:  cybsp.h
+*
+* Description:  Host stand-in for the board support package of the PMG1 kit:
+*               the peripherals and pins the EEPROM example uses, mapped to
+*               the simulator.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef HOST_CYBSP_H_
+#define HOST_CYBSP_H_
+
+#include "cy_pdl.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Interrupt numbers */
+#define CYBSP_I2C_IRQ               (9)
+#define CYBSP_UART_IRQ              (10)
+#define CYBSP_USER_BTN_IRQ          (2)
+
+/* SCB blocks */
+#define CYBSP_I2C_HW                (&sim_i2c_scb)
+#define CYBSP_UART_HW               (&sim_uart_scb)
+
+/* Peripheral clock divider of the I2C SCB */
+#define CYBSP_I2C_CLK_DIV_HW        (CY_SYSCLK_DIV_16_BIT)
+#define CYBSP_I2C_CLK_DIV_NUM       (0U)
+
+/* Pins, all on one simulated port */
+#define CYBSP_I2C_SDA_PORT          (&sim_gpio_port)
+#define CYBSP_I2C_SDA_PIN           (0U)
+#define CYBSP_I2C_SDA_HSIOM         (14UL)
+#define CYBSP_I2C_SCL_PORT          (&sim_gpio_port)
+#define CYBSP_I2C_SCL_PIN           (1U)
+#define CYBSP_I2C_SCL_HSIOM         (14UL)
+#define CYBSP_USER_LED_PORT         (&sim_gpio_port)
+#define CYBSP_USER_LED_PIN          (2U)
+#define CYBSP_USER_BTN_PORT         (&sim_gpio_port)
+#define CYBSP_USER_BTN_PIN          (3U)
+#define CYBSP_USER_BTN_NUM          (3U)
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern CySCB_Type sim_i2c_scb;
+extern CySCB_Type sim_uart_scb;
+extern GPIO_PRT_Type sim_gpio_port;
+
+extern const cy_stc_scb_i2c_config_t CYBSP_I2C_config;
+extern const cy_stc_scb_uart_config_t CYBSP_UART_config;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t cybsp_init(void);
+
+#endif /* HOST_CYBSP_H_ */
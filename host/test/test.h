@@ -0,0 +1,138 @@
+/******************************************************************************
+* File Name:  test.h
+*
+* Description:  Checks and helpers shared by the host tests.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include "sim.h"
+#include "I2CMaster.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Fails the test program with the location of the check */
+#define TEST_ASSERT(cond)                                                       \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #cond);             \
+            exit(1);                                                            \
+        }                                                                       \
+    } while (0)
+
+#define TEST_ASSERT_EQUAL(expected, actual)                                     \
+    do                                                                          \
+    {                                                                           \
+        uint64_t testExpected = (uint64_t)(expected);                           \
+        uint64_t testActual = (uint64_t)(actual);                               \
+        if (testExpected != testActual)                                         \
+        {                                                                       \
+            printf("%s:%d: FAIL: %s == %s, expected 0x%" PRIx64 ", got 0x%" PRIx64 "\n", \
+                   __FILE__, __LINE__, #expected, #actual, testExpected, testActual); \
+            exit(1);                                                            \
+        }                                                                       \
+    } while (0)
+
+/* Span of n bytes, cut to the array of the device profile, for tests built
+ * with a small EEPROM_DEVICE */
+#define TEST_SPAN(n)            (((n) < EEPROM_SIZE) ? (n) : EEPROM_SIZE)
+
+/*******************************************************************************
+* Function Name: test_init
+********************************************************************************
+* Summary:
+*  Attaches one EEPROM at the slave address of the device profile and brings
+*  up the driver as main() does.
+*
+*******************************************************************************/
+static inline void test_init(void)
+{
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+    __enable_irq();
+    TEST_ASSERT(initI2CMaster() == I2C_SUCCESS);
+}
+
+/*******************************************************************************
+* Function Name: test_fill
+********************************************************************************
+* Summary:
+*  Fills buf with a pattern that differs for each seed and position.
+*
+*******************************************************************************/
+static inline void test_fill(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    for (uint32_t i = 0UL; i < len; i++)
+    {
+        buf[i] = (uint8_t)((i * 7UL) + (seed * 13UL) + (i >> 8u));
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_log_text
+********************************************************************************
+* Summary:
+*  Fills buf with log text from line first on, the records of the benchmark
+*  LZ workloads: a timestamp in ms, a channel and a voltage in mV per line.
+*
+*******************************************************************************/
+static inline void test_log_text(uint8_t *buf, uint32_t len, uint32_t first)
+{
+    char line[32];
+    uint32_t pos = 0UL;
+
+    for (uint32_t n = first; pos < len; n++)
+    {
+        int lineLen = snprintf(line, sizeof(line), "t=%06lu ch=%lu v=%04lu ok\n",
+                               (unsigned long)((n * 250UL) % 1000000UL), (unsigned long)(n % 4UL),
+                               (unsigned long)(3300UL + ((n * 37UL) % 61UL)));
+
+        for (int i = 0; (i < lineLen) && (pos < len); i++)
+        {
+            buf[pos++] = (uint8_t)line[i];
+        }
+    }
+}
+
+#endif /* HOST_TEST_H_ */
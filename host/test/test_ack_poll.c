@@ -0,0 +1,170 @@
+/******************************************************************************
+* File Name:  test_ack_poll.c
+*
+* Description:  Host tests of acknowledge polling: variable write cycle time
+*               and the timeout bound.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_power.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: TestVariableCycle
+********************************************************************************
+* Summary:
+*  eeprom_wait_ready() returns once the write cycle has ended, whatever its
+*  length, and no later than about one poll interval after: the sleep
+*  between polls is not rounded up to the SysTick tick. Only a cycle shorter
+*  than the previous one can end during the sleep ahead of the polls, and
+*  the wait then lasts no longer than the previous one.
+*
+*******************************************************************************/
+static void TestVariableCycle(void)
+{
+    uint8_t page[EEPROM_PAGE_SIZE];
+    uint8_t back[EEPROM_PAGE_SIZE];
+    sim_eeprom_stats_t stats;
+    uint64_t prevWaitUs = SIM_EEPROM_WRITE_CYCLE_US + (2ULL * EEPROM_ACK_POLL_INTERVAL_US);
+
+    sim_eeprom_set_write_cycle(500UL, 5000UL);
+    for (uint32_t i = 0UL; i < 100UL; i++)
+    {
+        uint32_t addr = (i % (EEPROM_SIZE / EEPROM_PAGE_SIZE)) * EEPROM_PAGE_SIZE;
+        uint64_t busyUs;
+        uint64_t waitUs;
+
+        test_fill(page, sizeof(page), i);
+        sim_eeprom_reset_stats();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, page, sizeof(page)));
+        waitUs = sim_time_us();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        waitUs = sim_time_us() - waitUs;
+        sim_eeprom_get_stats(&stats);
+        busyUs = stats.busyUs;
+
+        TEST_ASSERT(stats.busyNaks >= 1u);
+        TEST_ASSERT(waitUs >= busyUs - 100ULL);
+        TEST_ASSERT((waitUs <= busyUs + (2ULL * EEPROM_ACK_POLL_INTERVAL_US)) ||
+                    (waitUs <= prevWaitUs));
+        prevWaitUs = waitUs;
+
+        /* The device answers at once */
+        sim_eeprom_reset_stats();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)addr, back, sizeof(back)));
+        sim_eeprom_get_stats(&stats);
+        TEST_ASSERT_EQUAL(0u, stats.busyNaks);
+        TEST_ASSERT(memcmp(page, back, sizeof(page)) == 0);
+    }
+    sim_eeprom_set_write_cycle(SIM_EEPROM_WRITE_CYCLE_US, SIM_EEPROM_WRITE_CYCLE_US);
+}
+
+/*******************************************************************************
+* Function Name: TestSleep
+********************************************************************************
+* Summary:
+*  Once a write cycle has been seen, the CPU sleeps through most of the next
+*  ones and the wait still ends within one poll interval.
+*
+*******************************************************************************/
+static void TestSleep(void)
+{
+    uint8_t page[EEPROM_PAGE_SIZE];
+    sim_eeprom_stats_t stats;
+    eeprom_power_stats_t powerStats;
+    uint64_t waitUs;
+
+    for (uint32_t i = 0UL; i < 20UL; i++)
+    {
+        test_fill(page, sizeof(page), i);
+        sim_eeprom_reset_stats();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write(0U, page, sizeof(page)));
+        eeprom_power_reset();
+        waitUs = sim_time_us();
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        waitUs = sim_time_us() - waitUs;
+        sim_eeprom_get_stats(&stats);
+        eeprom_power_get(&powerStats);
+
+        TEST_ASSERT(waitUs <= stats.busyUs + (2ULL * EEPROM_ACK_POLL_INTERVAL_US));
+        if (i >= 10UL)
+        {
+            TEST_ASSERT(powerStats.sleeps >= 1u);
+            TEST_ASSERT(stats.busyNaks < (SIM_EEPROM_WRITE_CYCLE_US / (2UL * EEPROM_ACK_POLL_INTERVAL_US)));
+            TEST_ASSERT((2UL * powerStats.activeUs) < powerStats.elapsedUs);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestTimeout
+********************************************************************************
+* Summary:
+*  A device that never answers ends the wait with an error after the
+*  configured bound.
+*
+*******************************************************************************/
+static void TestTimeout(void)
+{
+    uint64_t startUs;
+
+    sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_ERROR, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT((sim_time_us() - startUs) >= (EEPROM_WRITE_CYCLE_TIMEOUT_MS * 1000ULL));
+    TEST_ASSERT((sim_time_us() - startUs) <= ((EEPROM_WRITE_CYCLE_TIMEOUT_MS + 2ULL) * 1000ULL));
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestVariableCycle();
+    TestSleep();
+    TestTimeout();
+
+    printf("test_ack_poll: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
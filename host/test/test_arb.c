@@ -0,0 +1,207 @@
+/******************************************************************************
+* File Name:  test_arb.c
+*
+* Description:  Host tests of the multi-master arbitration handling:
+*               randomized backoff, resumed transfers and giving up.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_arb.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Span of the transfers, one sequential read of many bytes */
+#define TEST_LEN                TEST_SPAN(4096UL)
+
+/* Transfers of each kind, so that small arrays see as much contention */
+#define TEST_ROUNDS             (4096UL / TEST_LEN)
+
+/* Span of the interrupt-driven reads */
+#define TEST_PIECE              (TEST_LEN / 16UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t src[TEST_LEN];
+static uint8_t dst[TEST_LEN];
+
+/*******************************************************************************
+* Function Name: TestBackoff
+********************************************************************************
+* Summary:
+*  The pause before a retry lies in the window of its attempt, which doubles
+*  up to EEPROM_ARB_BACKOFF_MAX_US, and is not the same every time.
+*
+*******************************************************************************/
+static void TestBackoff(void)
+{
+    for (uint32_t attempt = 0UL; attempt < 20UL; attempt++)
+    {
+        uint32_t windowUs = EEPROM_ARB_BACKOFF_MAX_US;
+        uint32_t first = eeprom_arb_backoff_us(attempt);
+        bool varied = false;
+
+        if (attempt < 16UL)
+        {
+            windowUs = EEPROM_ARB_BACKOFF_MIN_US << (attempt + 1UL);
+            if (windowUs > EEPROM_ARB_BACKOFF_MAX_US)
+            {
+                windowUs = EEPROM_ARB_BACKOFF_MAX_US;
+            }
+        }
+        for (uint32_t i = 0UL; i < 100UL; i++)
+        {
+            uint32_t backoffUs = eeprom_arb_backoff_us(attempt);
+
+            TEST_ASSERT(backoffUs >= EEPROM_ARB_BACKOFF_MIN_US);
+            TEST_ASSERT(backoffUs <= windowUs);
+            varied = varied || (backoffUs != first);
+        }
+        TEST_ASSERT(varied);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestResume
+********************************************************************************
+* Summary:
+*  Another master wins Starts and data bytes of low-level writes and reads.
+*  Each transfer resumes behind the bytes already done, including a write
+*  whose page the winner overwrote, and returns the right data. Reads through
+*  the interrupt-driven driver are repeated and return the right data too.
+*
+*******************************************************************************/
+static void TestResume(void)
+{
+    static const sim_i2c_master_t master = { 20u, 200u, 2u, 200u };
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    eeprom_arb_stats_t stats;
+    sim_i2c_stats_t bus;
+
+    eeprom_arb_reset_stats();
+    sim_i2c_reset_stats();
+    sim_i2c_set_master(&master);
+
+    for (uint32_t round = 0UL; round < TEST_ROUNDS; round++)
+    {
+        test_fill(src, sizeof(src), 7UL + round);
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_dev_write(&eeprom_default_dev, 0u, src, sizeof(src)));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        TEST_ASSERT(memcmp(mem, src, sizeof(src)) == 0);
+
+        (void)memset(dst, 0, sizeof(dst));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_dev_read(&eeprom_default_dev, 0u, dst, sizeof(dst)));
+        TEST_ASSERT(memcmp(dst, src, sizeof(dst)) == 0);
+
+        /* The interrupt-driven read is repeated as a whole, so it reads pieces */
+        (void)memset(dst, 0, sizeof(dst));
+        for (uint32_t addr = 0UL; addr < sizeof(dst); addr += TEST_PIECE)
+        {
+            TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)addr, &dst[addr], TEST_PIECE));
+        }
+        TEST_ASSERT(memcmp(dst, src, sizeof(dst)) == 0);
+    }
+    sim_i2c_set_master(NULL);
+
+    eeprom_arb_get_stats(&stats);
+    sim_i2c_get_stats(&bus);
+    TEST_ASSERT(bus.arbLost > 0UL);
+    TEST_ASSERT_EQUAL(bus.arbLost, stats.lost);
+    TEST_ASSERT(stats.resumed > 0UL);
+    TEST_ASSERT(stats.resumedBytes > stats.resumed);
+    TEST_ASSERT(stats.backoffUs >= (stats.lost * EEPROM_ARB_BACKOFF_MIN_US));
+    TEST_ASSERT(stats.busBusy > 0UL);
+    TEST_ASSERT_EQUAL(0u, stats.failed);
+}
+
+/*******************************************************************************
+* Function Name: TestGiveUp
+********************************************************************************
+* Summary:
+*  A bus that another master never releases fails the transfer with
+*  ARB_LOST_ERROR after EEPROM_ARB_RETRY_MAX waits for its Stop, and the
+*  next transfer runs once the bus is free.
+*
+*******************************************************************************/
+static void TestGiveUp(void)
+{
+    eeprom_arb_stats_t stats;
+    uint64_t startUs;
+
+    eeprom_arb_reset_stats();
+    sim_i2c_stretch(1000000UL);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(ARB_LOST_ERROR, eeprom_read(0u, dst, EEPROM_PAGE_SIZE));
+    TEST_ASSERT((sim_time_us() - startUs) >=
+                ((EEPROM_ARB_RETRY_MAX + 1UL) * EEPROM_ARB_BUS_FREE_TIMEOUT_US));
+    sim_i2c_set_master(NULL);
+
+    eeprom_arb_get_stats(&stats);
+    TEST_ASSERT_EQUAL(EEPROM_ARB_RETRY_MAX + 1UL, stats.busTimeouts);
+    TEST_ASSERT_EQUAL(1u, stats.failed);
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0u, dst, EEPROM_PAGE_SIZE));
+    TEST_ASSERT(memcmp(dst, src, EEPROM_PAGE_SIZE) == 0);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    static const uint32_t rates[] = { 100000UL, 400000UL };
+
+    test_init();
+    TestBackoff();
+
+    for (uint32_t i = 0UL; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(rates[i]));
+        TestResume();
+        TestGiveUp();
+    }
+
+    printf("test_arb: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
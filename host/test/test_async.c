@@ -0,0 +1,169 @@
+/******************************************************************************
+* File Name:  test_async.c
+*
+* Description:  Host tests of the interrupt-completed asynchronous transfer
+*               API.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static volatile uint32_t doneCount;
+static volatile uint8_t doneStatus;
+
+/*******************************************************************************
+* Function Name: Done
+********************************************************************************
+* Summary:
+*  Completion callback, called from the I2C interrupt.
+*
+*******************************************************************************/
+static void Done(uint8_t status)
+{
+    doneCount++;
+    doneStatus = status;
+}
+
+/*******************************************************************************
+* Function Name: WaitDone
+********************************************************************************
+* Summary:
+*  Does other work until the transfer completes, and returns how many units
+*  of it were done.
+*
+*******************************************************************************/
+static uint32_t WaitDone(void)
+{
+    uint32_t work = 0UL;
+
+    while (eeprom_is_busy())
+    {
+        Cy_SysLib_DelayUs(10u);
+        work++;
+    }
+    return work;
+}
+
+/*******************************************************************************
+* Function Name: TestWriteRead
+********************************************************************************
+* Summary:
+*  An asynchronous write and random read return at once, leave the CPU free
+*  while the bus works, and call back once with the result.
+*
+*******************************************************************************/
+static void TestWriteRead(void)
+{
+    const eeprom_addr_t addr = (eeprom_addr_t)(3UL * EEPROM_PAGE_SIZE);
+    uint8_t src[EEPROM_PAGE_SIZE];
+    uint8_t dst[EEPROM_PAGE_SIZE];
+    uint64_t startUs;
+
+    test_fill(src, sizeof(src), 5UL);
+
+    doneCount = 0UL;
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_write_async(addr, src, sizeof(src), &Done));
+    TEST_ASSERT((sim_time_us() - startUs) < 20ULL);
+    TEST_ASSERT(eeprom_is_busy());
+    TEST_ASSERT_EQUAL(TRANSFER_BUSY, eeprom_read_async(dst, sizeof(dst), &Done));
+    TEST_ASSERT_EQUAL(TRANSFER_BUSY, eeprom_write(addr, src, 1UL));
+    TEST_ASSERT(WaitDone() > 10UL);
+    TEST_ASSERT_EQUAL(1u, doneCount);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, doneStatus);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT(memcmp(&sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addr], src, sizeof(src)) == 0);
+
+    doneCount = 0UL;
+    (void)memset(dst, 0, sizeof(dst));
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_read_at_async(addr, dst, sizeof(dst), &Done));
+    TEST_ASSERT(WaitDone() > 10UL);
+    TEST_ASSERT_EQUAL(1u, doneCount);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, doneStatus);
+    TEST_ASSERT(memcmp(dst, src, sizeof(src)) == 0);
+
+    /* The blocking functions wrap the same path */
+    (void)memset(dst, 0, sizeof(dst));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(addr, dst, sizeof(dst)));
+    TEST_ASSERT(memcmp(dst, src, sizeof(src)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestErrors
+********************************************************************************
+* Summary:
+*  A span across a page is rejected, and a missing device completes the
+*  transfer with an address NAK.
+*
+*******************************************************************************/
+static void TestErrors(void)
+{
+    uint8_t src[2] = { 0u, 0u };
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR,
+                      eeprom_write_async((eeprom_addr_t)(EEPROM_PAGE_SIZE - 1UL), src, 2UL, &Done));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read_async(NULL, 1UL, &Done));
+
+    sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+    doneCount = 0UL;
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_write_async(0U, src, sizeof(src), &Done));
+    (void)WaitDone();
+    TEST_ASSERT_EQUAL(1u, doneCount);
+    TEST_ASSERT_EQUAL(ADDR_NAK_ERROR, doneStatus);
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestWriteRead();
+    TestErrors();
+
+    printf("test_async: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,276 @@
+/******************************************************************************
+* File Name:  test_block.c
+*
+* Description:  Reads and writes across the block boundary of the 24LC1025,
+*               and across the middle and up to the end of the array on the
+*               other devices.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_queue.h"
+#include "eeprom_fifo.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Address the test spans cross: the block boundary of the 24LC1025, or the
+ * middle of the array on a device with a single block */
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+#define TEST_BOUNDARY           (EEPROM_BLOCK_SIZE)
+#else
+#define TEST_BOUNDARY           (EEPROM_SIZE / 2UL)
+#endif
+
+/* Unaligned span of three pages around the boundary */
+#define TEST_ADDR               (TEST_BOUNDARY - ((3UL * EEPROM_PAGE_SIZE) / 2UL) - 1UL)
+#define TEST_LEN                (3UL * EEPROM_PAGE_SIZE)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* What the stream consumer has seen */
+static const uint8_t *streamExpect;
+static uint32_t streamDone;
+static bool streamMatch;
+
+/* Completions of the queued transactions */
+static uint32_t queueDone;
+static uint8_t queueStatus;
+
+/*******************************************************************************
+* Function Name: StreamCheck
+********************************************************************************
+* Summary:
+*  Stream consumer, compares each chunk with the expected data.
+*
+*******************************************************************************/
+static void StreamCheck(const uint8_t *data, uint32_t len)
+{
+    if (memcmp(data, &streamExpect[streamDone], len) != 0)
+    {
+        streamMatch = false;
+    }
+    streamDone += len;
+}
+
+/*******************************************************************************
+* Function Name: QueueDone
+********************************************************************************
+* Summary:
+*  Completion callback of the queued transactions.
+*
+*******************************************************************************/
+static void QueueDone(uint8_t status)
+{
+    queueStatus = status;
+    queueDone++;
+}
+
+/*******************************************************************************
+* Function Name: QueueWait
+********************************************************************************
+* Summary:
+*  Waits for one queued transaction and checks its status.
+*
+*******************************************************************************/
+static void QueueWait(void)
+{
+    uint64_t startUs = sim_time_us();
+
+    while (queueDone == 0UL)
+    {
+        Cy_SysLib_DelayUs(50u);
+        TEST_ASSERT((sim_time_us() - startUs) < 1000000ULL);
+    }
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, queueStatus);
+    queueDone = 0UL;
+}
+
+/*******************************************************************************
+* Function Name: CheckMem
+********************************************************************************
+* Summary:
+*  Checks that the span landed at its linear address in the array, so no
+*  byte past the boundary wrapped to the start of a block.
+*
+*******************************************************************************/
+static void CheckMem(const uint8_t *expect)
+{
+    const uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+
+    TEST_ASSERT(memcmp(&mem[TEST_ADDR], expect, TEST_LEN) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestBlocking
+********************************************************************************
+* Summary:
+*  eeprom_write(), eeprom_read(), and eeprom_read_stream() across the
+*  boundary.
+*
+*******************************************************************************/
+static void TestBlocking(void)
+{
+    uint8_t src[TEST_LEN];
+    uint8_t dst[TEST_LEN];
+
+    test_fill(src, sizeof(src), 1UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)TEST_ADDR, src, sizeof(src)));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    CheckMem(src);
+
+    memset(dst, 0, sizeof(dst));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)TEST_ADDR, dst, sizeof(dst)));
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+
+    streamExpect = src;
+    streamDone = 0UL;
+    streamMatch = true;
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read_stream((eeprom_addr_t)TEST_ADDR, TEST_LEN, &StreamCheck));
+    TEST_ASSERT_EQUAL(TEST_LEN, streamDone);
+    TEST_ASSERT(streamMatch);
+}
+
+/*******************************************************************************
+* Function Name: TestQueue
+********************************************************************************
+* Summary:
+*  A queued write and a queued read across the boundary.
+*
+*******************************************************************************/
+static void TestQueue(void)
+{
+    static uint8_t src[TEST_LEN];
+    static uint8_t dst[TEST_LEN];
+
+    test_fill(src, sizeof(src), 2UL);
+    queueDone = 0UL;
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_queue_write((eeprom_addr_t)TEST_ADDR, src, sizeof(src),
+                                                           &QueueDone));
+    QueueWait();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    CheckMem(src);
+
+    memset(dst, 0, sizeof(dst));
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_queue_read((eeprom_addr_t)TEST_ADDR, dst, sizeof(dst),
+                                                          &QueueDone));
+    QueueWait();
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestFifo
+********************************************************************************
+* Summary:
+*  A FIFO-level write and read across the boundary.
+*
+*******************************************************************************/
+#if EEPROM_FIFO_ENABLE
+static void TestFifo(void)
+{
+    uint8_t src[TEST_LEN];
+    uint8_t dst[TEST_LEN];
+
+    test_fill(src, sizeof(src), 3UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_fifo_write((eeprom_addr_t)TEST_ADDR, src, sizeof(src)));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    CheckMem(src);
+
+    memset(dst, 0, sizeof(dst));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_fifo_read((eeprom_addr_t)TEST_ADDR, dst, sizeof(dst)));
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: TestArrayEnd
+********************************************************************************
+* Summary:
+*  The last page of the array is written and read on every path, which
+*  needs the block select bits and the widest memory address.
+*
+*******************************************************************************/
+static void TestArrayEnd(void)
+{
+    const uint32_t addr = EEPROM_SIZE - EEPROM_PAGE_SIZE;
+    uint8_t src[EEPROM_PAGE_SIZE];
+    uint8_t dst[EEPROM_PAGE_SIZE];
+
+    test_fill(src, sizeof(src), 4UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, src, sizeof(src)));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT(memcmp(&sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addr], src, sizeof(src)) == 0);
+
+#if EEPROM_FIFO_ENABLE
+    memset(dst, 0, sizeof(dst));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_fifo_read((eeprom_addr_t)addr, dst, sizeof(dst)));
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+#endif
+
+    memset(dst, 0, sizeof(dst));
+    queueDone = 0UL;
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_queue_read((eeprom_addr_t)addr, dst, sizeof(dst), &QueueDone));
+    QueueWait();
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+
+    /* One byte past the end is rejected */
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read((eeprom_addr_t)addr, dst, sizeof(dst) + 1UL));
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestBlocking();
+    TestQueue();
+#if EEPROM_FIFO_ENABLE
+    TestFifo();
+#endif
+    TestArrayEnd();
+
+    printf("test_block: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,215 @@
+/******************************************************************************
+* File Name:  test_cache.c
+*
+* Description:  Host tests of the write-back page cache: coalescing, eviction
+*               and the idle flush.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_cache.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* What the application has written, through the cache or not */
+static uint8_t model[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: CacheWrite
+********************************************************************************
+* Summary:
+*  Writes through the cache and into the model.
+*
+*******************************************************************************/
+static void CacheWrite(uint32_t addr, uint32_t len, uint32_t seed)
+{
+    uint8_t data[4UL * EEPROM_PAGE_SIZE];
+
+    test_fill(data, len, seed);
+    (void)memcpy(&model[addr], data, len);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_write((eeprom_addr_t)addr, data, len));
+}
+
+/*******************************************************************************
+* Function Name: CheckRead
+********************************************************************************
+* Summary:
+*  Reads through the cache and compares with the model.
+*
+*******************************************************************************/
+static void CheckRead(uint32_t addr, uint32_t len)
+{
+    uint8_t data[4UL * EEPROM_PAGE_SIZE];
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_read((eeprom_addr_t)addr, data, len));
+    TEST_ASSERT(memcmp(data, &model[addr], len) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestCoalesce
+********************************************************************************
+* Summary:
+*  Small writes to two pages stay in RAM, are read back from RAM, and cost
+*  one page write per page on flush.
+*
+*******************************************************************************/
+static void TestCoalesce(void)
+{
+    eeprom_cache_stats_t before;
+    eeprom_cache_stats_t after;
+    sim_eeprom_stats_t eeprom;
+    sim_i2c_stats_t bus;
+
+    eeprom_cache_get_stats(&before);
+    sim_eeprom_reset_stats();
+
+    for (uint32_t i = 0UL; i < 20UL; i++)
+    {
+        CacheWrite((10UL * EEPROM_PAGE_SIZE) + ((i * 12UL) % (EEPROM_PAGE_SIZE - 4UL)), 4UL, i);
+        CacheWrite((11UL * EEPROM_PAGE_SIZE) + ((i * 20UL) % (EEPROM_PAGE_SIZE - 2UL)), 2UL, i + 100UL);
+    }
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(0u, eeprom.writeCycles);
+
+    sim_i2c_reset_stats();
+    CheckRead(10UL * EEPROM_PAGE_SIZE, 2UL * EEPROM_PAGE_SIZE);
+    sim_i2c_get_stats(&bus);
+    TEST_ASSERT_EQUAL(0u, bus.starts);
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_flush());
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(2u, eeprom.writeCycles);
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), model, EEPROM_SIZE) == 0);
+
+    eeprom_cache_get_stats(&after);
+    TEST_ASSERT_EQUAL(2u, after.flushes - before.flushes);
+    TEST_ASSERT_EQUAL(38u, after.coalesced - before.coalesced);
+    TEST_ASSERT_EQUAL(120u, after.bytesWritten - before.bytesWritten);
+    TEST_ASSERT((after.bytesFlushed - before.bytesFlushed) <= (2UL * EEPROM_PAGE_SIZE));
+
+    /* Nothing is left to flush */
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_flush());
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(2u, eeprom.writeCycles);
+}
+
+/*******************************************************************************
+* Function Name: TestEviction
+********************************************************************************
+* Summary:
+*  Touching one page more than the cache holds writes back the least
+*  recently used dirty page, and a page that is overwritten completely is
+*  not read first.
+*
+*******************************************************************************/
+static void TestEviction(void)
+{
+    sim_eeprom_stats_t eeprom;
+
+    for (uint32_t p = 0UL; p < EEPROM_CACHE_PAGES; p++)
+    {
+        CacheWrite((20UL + p) * EEPROM_PAGE_SIZE, 1UL, p);
+    }
+    CheckRead(20UL * EEPROM_PAGE_SIZE, 1UL);
+
+    sim_eeprom_reset_stats();
+    CacheWrite((20UL + EEPROM_CACHE_PAGES) * EEPROM_PAGE_SIZE, EEPROM_PAGE_SIZE, 50UL);
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(1u, eeprom.writeCycles);
+    TEST_ASSERT_EQUAL(0u, eeprom.bytesRead);
+    TEST_ASSERT_EQUAL(model[21UL * EEPROM_PAGE_SIZE], sim_eeprom_mem(EEPROM_SLAVE_ADDR)[21UL * EEPROM_PAGE_SIZE]);
+
+    /* Spans across pages */
+    CacheWrite((27UL * EEPROM_PAGE_SIZE) - 5UL, (2UL * EEPROM_PAGE_SIZE) + 10UL, 60UL);
+    CheckRead((27UL * EEPROM_PAGE_SIZE) - 7UL, (2UL * EEPROM_PAGE_SIZE) + 14UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_flush());
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), model, EEPROM_SIZE) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestIdleFlush
+********************************************************************************
+* Summary:
+*  Dirty pages are written back once no write has reached the cache for the
+*  flush delay.
+*
+*******************************************************************************/
+static void TestIdleFlush(void)
+{
+    sim_eeprom_stats_t eeprom;
+
+    CacheWrite(30UL * EEPROM_PAGE_SIZE, 4UL, 70UL);
+    sim_eeprom_reset_stats();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_service(EEPROM_CACHE_FLUSH_DELAY_MS - 10UL));
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(0u, eeprom.writeCycles);
+
+    /* A write restarts the delay */
+    CacheWrite((30UL * EEPROM_PAGE_SIZE) + 4UL, 4UL, 71UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_service(20UL));
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(0u, eeprom.writeCycles);
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_cache_service(EEPROM_CACHE_FLUSH_DELAY_MS));
+    sim_eeprom_get_stats(&eeprom);
+    TEST_ASSERT_EQUAL(1u, eeprom.writeCycles);
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), model, EEPROM_SIZE) == 0);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    (void)memset(model, 0xFF, sizeof(model));
+
+    TestCoalesce();
+    TestEviction();
+    TestIdleFlush();
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_cache_write((eeprom_addr_t)(EEPROM_SIZE - 1UL), model, 2UL));
+
+    printf("test_cache: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
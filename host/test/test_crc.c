@@ -0,0 +1,143 @@
+/******************************************************************************
+* File Name:  test_crc.c
+*
+* Description:  Host tests of the CRC-32 kernel and read-back verification.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_crc.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: TestKernel
+********************************************************************************
+* Summary:
+*  The kernel gives the IEEE 802.3 check value, and the same result when the
+*  data arrives in pieces.
+*
+*******************************************************************************/
+static void TestKernel(void)
+{
+    static const uint8_t check[] = "123456789";
+    uint8_t data[1000];
+    uint32_t whole;
+    uint32_t crc = EEPROM_CRC32_INIT;
+
+    TEST_ASSERT_EQUAL(0xCBF43926UL, eeprom_crc32_update(EEPROM_CRC32_INIT, check, 9UL) ^ EEPROM_CRC32_INIT);
+    TEST_ASSERT_EQUAL(0UL, eeprom_crc32_update(EEPROM_CRC32_INIT, check, 0UL) ^ EEPROM_CRC32_INIT);
+
+    test_fill(data, sizeof(data), 2UL);
+    whole = eeprom_crc32_update(EEPROM_CRC32_INIT, data, sizeof(data));
+    for (uint32_t offset = 0UL; offset < sizeof(data); )
+    {
+        uint32_t len = 1UL + (uint32_t)(sim_random() % 37UL);
+
+        len = ((offset + len) > sizeof(data)) ? (sizeof(data) - offset) : len;
+        crc = eeprom_crc32_update(crc, &data[offset], len);
+        offset += len;
+    }
+    TEST_ASSERT_EQUAL(whole, crc);
+}
+
+/*******************************************************************************
+* Function Name: TestVerify
+********************************************************************************
+* Summary:
+*  A region verifies against its checksum, a stored checksum verifies, and a
+*  single flipped bit anywhere fails both.
+*
+*******************************************************************************/
+static void TestVerify(void)
+{
+    const uint32_t addr = 100UL;
+    /* Room for the stored checksum behind the region, on every profile */
+    const uint32_t len = TEST_SPAN(3000UL + addr + EEPROM_CRC32_SIZE) - addr - EEPROM_CRC32_SIZE;
+    static uint8_t data[3000];
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    uint32_t crc;
+    uint32_t computed = 0UL;
+
+    test_fill(data, sizeof(data), 4UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, data, len));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    crc = eeprom_crc32_update(EEPROM_CRC32_INIT, data, len) ^ EEPROM_CRC32_INIT;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_crc_compute((eeprom_addr_t)addr, len, &computed));
+    TEST_ASSERT_EQUAL(crc, computed);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_crc_verify((eeprom_addr_t)addr, len, crc));
+    TEST_ASSERT_EQUAL(INVALID_DATA_ERROR, eeprom_crc_verify((eeprom_addr_t)addr, len, crc ^ 1UL));
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_crc_store((eeprom_addr_t)addr, len));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(crc, (uint32_t)mem[addr + len] | ((uint32_t)mem[addr + len + 1UL] << 8u) |
+                           ((uint32_t)mem[addr + len + 2UL] << 16u) | ((uint32_t)mem[addr + len + 3UL] << 24u));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_crc_verify_stored((eeprom_addr_t)addr, len));
+
+    for (uint32_t i = 0UL; i < 20UL; i++)
+    {
+        uint32_t pos = addr + (uint32_t)(sim_random() % (len + EEPROM_CRC32_SIZE));
+        uint8_t bit = (uint8_t)(1u << (sim_random() % 8u));
+
+        mem[pos] ^= bit;
+        TEST_ASSERT_EQUAL(INVALID_DATA_ERROR, eeprom_crc_verify_stored((eeprom_addr_t)addr, len));
+        if (pos < (addr + len))
+        {
+            TEST_ASSERT_EQUAL(INVALID_DATA_ERROR, eeprom_crc_verify((eeprom_addr_t)addr, len, crc));
+        }
+        mem[pos] ^= bit;
+    }
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_crc_store((eeprom_addr_t)(EEPROM_SIZE - 4UL), 1UL));
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestKernel();
+    TestVerify();
+
+    printf("test_crc: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
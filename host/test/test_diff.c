@@ -0,0 +1,150 @@
+/******************************************************************************
+* File Name:  test_diff.c
+*
+* Description:  Differential programming writes and statistics.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_diff.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* New content for the whole array, and what the array must hold afterwards */
+static uint8_t image[EEPROM_SIZE];
+static uint8_t expect[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: CheckDiff
+********************************************************************************
+* Summary:
+*  Programs image[addr..addr+len) with eeprom_write_diff() and checks the
+*  array content, the write cycles it took and every statistics counter.
+*
+*******************************************************************************/
+static void CheckDiff(uint32_t addr, uint32_t len, uint32_t pagesWritten, uint32_t bytesWritten)
+{
+    uint32_t pages = ((addr + len - 1UL) / EEPROM_PAGE_SIZE) - (addr / EEPROM_PAGE_SIZE) + 1UL;
+    sim_eeprom_stats_t cycles;
+    eeprom_diff_stats_t stats;
+
+    (void)memcpy(&expect[addr], &image[addr], len);
+    sim_eeprom_reset_stats();
+    eeprom_diff_reset_stats();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write_diff((eeprom_addr_t)addr, &image[addr], len));
+
+    sim_eeprom_get_stats(&cycles);
+    eeprom_diff_get_stats(&stats);
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), expect, EEPROM_SIZE) == 0);
+    TEST_ASSERT_EQUAL(pagesWritten, cycles.writeCycles);
+    TEST_ASSERT_EQUAL(bytesWritten, cycles.bytesWritten);
+    TEST_ASSERT_EQUAL(pages - pagesWritten, stats.pagesSkipped);
+    TEST_ASSERT_EQUAL(pagesWritten, stats.pagesWritten);
+    TEST_ASSERT_EQUAL(len, stats.bytesCompared);
+    TEST_ASSERT_EQUAL(bytesWritten, stats.bytesWritten);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    uint8_t *mem;
+    eeprom_diff_stats_t stats;
+
+    test_init();
+    mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    test_fill(mem, EEPROM_SIZE, 3UL);
+    (void)memcpy(image, mem, EEPROM_SIZE);
+    (void)memcpy(expect, mem, EEPROM_SIZE);
+
+    /* Identical image: every page is compared and skipped */
+    CheckDiff(0UL, EEPROM_SIZE, 0UL, 0UL);
+
+    /* One byte in the middle of a page costs one 1-byte write */
+    image[(2UL * EEPROM_PAGE_SIZE) + (EEPROM_PAGE_SIZE / 2UL)] ^= 0xFFu;
+    CheckDiff(0UL, EEPROM_SIZE, 1UL, 1UL);
+
+    /* The first and last byte of a page are written as the whole page */
+    image[5UL * EEPROM_PAGE_SIZE] ^= 0x01u;
+    image[(6UL * EEPROM_PAGE_SIZE) - 1UL] ^= 0x80u;
+    CheckDiff(0UL, EEPROM_SIZE, 1UL, EEPROM_PAGE_SIZE);
+
+    /* The first and last byte of the array are two pages of one byte */
+    image[0] ^= 0x55u;
+    image[EEPROM_SIZE - 1UL] ^= 0xAAu;
+    CheckDiff(0UL, EEPROM_SIZE, 2UL, 2UL);
+
+    /* Unaligned span across three pages: the bytes changed around it stay
+     * untouched, and the differing range of each page is cut at the span */
+    image[EEPROM_PAGE_SIZE - 6UL] ^= 0x11u;
+    image[EEPROM_PAGE_SIZE - 2UL] ^= 0x22u;
+    image[(2UL * EEPROM_PAGE_SIZE) + 3UL] ^= 0x33u;
+    image[(3UL * EEPROM_PAGE_SIZE) + 4UL] ^= 0x44u;
+    image[(3UL * EEPROM_PAGE_SIZE) + 6UL] ^= 0x66u;
+    CheckDiff(EEPROM_PAGE_SIZE - 5UL, (2UL * EEPROM_PAGE_SIZE) + 10UL, 3UL, 3UL);
+    TEST_ASSERT(mem[EEPROM_PAGE_SIZE - 6UL] != image[EEPROM_PAGE_SIZE - 6UL]);
+    TEST_ASSERT(mem[(3UL * EEPROM_PAGE_SIZE) + 6UL] != image[(3UL * EEPROM_PAGE_SIZE) + 6UL]);
+
+    /* The statistics add up until they are reset: the first page now differs
+     * in the byte left out above, then matches */
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write_diff(0U, image, EEPROM_PAGE_SIZE));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write_diff(0U, image, EEPROM_PAGE_SIZE));
+    eeprom_diff_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2UL, stats.pagesSkipped);
+    TEST_ASSERT_EQUAL(4UL, stats.pagesWritten);
+    TEST_ASSERT_EQUAL((4UL * EEPROM_PAGE_SIZE) + 10UL, stats.bytesCompared);
+    TEST_ASSERT_EQUAL(4UL, stats.bytesWritten);
+    TEST_ASSERT_EQUAL(image[EEPROM_PAGE_SIZE - 6UL], mem[EEPROM_PAGE_SIZE - 6UL]);
+    eeprom_diff_reset_stats();
+    eeprom_diff_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0UL, stats.pagesSkipped + stats.pagesWritten + stats.bytesCompared + stats.bytesWritten);
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write_diff(0U, NULL, 1UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write_diff(0U, image, 0UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write_diff((eeprom_addr_t)(EEPROM_SIZE - 1UL), image, 2UL));
+
+    printf("test_diff: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+################################################################################
+# File Name: test_eeprom_uart.py
+#
+# Description: Loopback test of scripts/eeprom_uart.py against the
+#              simulated device of tool/uart_pty.c.
+#
+# Related Document: See README.md
+#
+################################################################################
+# Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+################################################################################
+
+"""Runs scripts/eeprom_uart.py against the application built for the host.
+
+Usage: test_eeprom_uart.py <uart_pty program>
+
+The program runs main.c with UART_PROTOCOL_ENABLE and one simulated EEPROM,
+with the kit UART on a pseudo terminal. Each command of the tool is run as a
+user would, and its result checked with a dump. Skipped without pyserial.
+"""
+
+import os
+import random
+import re
+import subprocess
+import sys
+import tempfile
+
+HOST_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TOOL = os.path.join(HOST_DIR, "..", "scripts", "eeprom_uart.py")
+
+# Baud rate of the simulated UART; a pseudo terminal ignores that of the tool
+BAUD = 921600
+
+
+def fail(what):
+    print("test_eeprom_uart: FAIL: %s" % what)
+    sys.exit(1)
+
+
+def tool(port, *args):
+    """Runs the host tool and returns its output."""
+    result = subprocess.run([sys.executable, TOOL, "--port", port, "--baud", str(BAUD)] + list(args),
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True,
+                            timeout=60)
+    if result.returncode != 0:
+        fail("eeprom_uart.py %s: %s" % (" ".join(args), result.stdout.strip()))
+    return result.stdout
+
+
+def dump(port, tmp):
+    path = os.path.join(tmp, "dump.bin")
+    tool(port, "dump", path)
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def run(port, tmp):
+    # The application may be built for any EEPROM_DEVICE profile
+    out = tool(port, "info")
+    match = re.search(r"EEPROM (\d+) bytes, page (\d+) bytes, chunk (\d+) bytes", out)
+    if not match or match.group(2) != match.group(3):
+        fail("info: %s" % out.strip())
+    size = int(match.group(1))
+
+    rng = random.Random(22)
+    image = bytes(rng.getrandbits(8) for _ in range(size))
+    image_path = os.path.join(tmp, "image.bin")
+    with open(image_path, "wb") as f:
+        f.write(image)
+    tool(port, "program", image_path)
+    tool(port, "verify", image_path)
+    if dump(port, tmp) != image:
+        fail("dump after program differs from the image")
+
+    # An unaligned part in the middle
+    part_addr = (size // 4) + 7
+    part = bytes(rng.getrandbits(8) for _ in range(min(200, size // 2)))
+    with open(image_path, "wb") as f:
+        f.write(part)
+    tool(port, "--addr", hex(part_addr), "program", image_path)
+    image = image[:part_addr] + part + image[part_addr + len(part):]
+    if dump(port, tmp) != image:
+        fail("dump after unaligned program differs")
+
+    erase_addr = min(100, size // 4)
+    erase_len = min(300, size // 2)
+    tool(port, "--addr", str(erase_addr), "erase", "--len", str(erase_len))
+    image = image[:erase_addr] + b"\xff" * erase_len + image[erase_addr + erase_len:]
+    if dump(port, tmp) != image:
+        fail("dump after erase differs")
+
+    # The tool reports a mismatch
+    with open(image_path, "wb") as f:
+        f.write(b"\x00" * 64)
+    result = subprocess.run([sys.executable, TOOL, "--port", port, "verify", image_path],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True,
+                            timeout=60)
+    if result.returncode == 0 or "verify failed" not in result.stdout:
+        fail("verify of a different image passed")
+
+
+def main():
+    try:
+        import serial  # noqa: F401
+    except ImportError:
+        print("test_eeprom_uart: SKIPPED, needs pyserial")
+        return 0
+
+    device = subprocess.Popen([sys.argv[1], str(BAUD)], stdout=subprocess.PIPE, universal_newlines=True)
+    try:
+        port = device.stdout.readline().strip()
+        if not port:
+            fail("%s did not start" % sys.argv[1])
+        with tempfile.TemporaryDirectory() as tmp:
+            run(port, tmp)
+    finally:
+        device.kill()
+        device.wait()
+
+    print("test_eeprom_uart: OK")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
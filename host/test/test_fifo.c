@@ -0,0 +1,181 @@
+/******************************************************************************
+* File Name:  test_fifo.c
+*
+* Description:  Host tests of the FIFO-level transfer path.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_fifo.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Block size of the interrupt count comparison, as the benchmark */
+#define BLOCK_SIZE              (256UL)
+
+#if EEPROM_FIFO_ENABLE
+/*******************************************************************************
+* Function Name: CheckRead
+********************************************************************************
+* Summary:
+*  Reads a span on the FIFO-level path and checks the data.
+*
+*******************************************************************************/
+static void CheckRead(uint32_t addr, uint32_t len)
+{
+    static uint8_t dst[EEPROM_SIZE];
+
+    (void)memset(dst, 0, len);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_fifo_read((eeprom_addr_t)addr, dst, len));
+    TEST_ASSERT(memcmp(dst, &sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addr], len) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestWriteRead
+********************************************************************************
+* Summary:
+*  An unaligned write is split at the page boundaries, and reads of every
+*  length around the FIFO depth return the data.
+*
+*******************************************************************************/
+static void TestWriteRead(void)
+{
+    const uint32_t addr = EEPROM_PAGE_SIZE - 5UL;
+    const uint32_t len = (3UL * EEPROM_PAGE_SIZE) + 7UL;
+    static uint8_t src[4UL * EEPROM_PAGE_SIZE];
+    sim_eeprom_stats_t stats;
+
+    test_fill(src, len, 11UL);
+    sim_eeprom_reset_stats();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_fifo_write((eeprom_addr_t)addr, src, len));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT(memcmp(&sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addr], src, len) == 0);
+
+    sim_eeprom_get_stats(&stats);
+    TEST_ASSERT_EQUAL(5u, stats.writeCycles);
+    TEST_ASSERT_EQUAL(0u, stats.pageWraps);
+
+    /* Every way the last bursts can fall */
+    for (uint32_t n = 1UL; n <= ((3UL * SIM_SCB_FIFO_SIZE) + 2UL); n++)
+    {
+        CheckRead(addr, n);
+    }
+    CheckRead(addr + 3UL, len - 3UL);
+    CheckRead(0UL, EEPROM_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: TestIsrCount
+********************************************************************************
+* Summary:
+*  Block reads take fewer interrupts on the FIFO-level path than on the PDL
+*  path, about one per RX FIFO.
+*
+*******************************************************************************/
+static void TestIsrCount(void)
+{
+    static uint8_t dst[BLOCK_SIZE];
+    uint32_t pdlIsrs;
+    uint32_t fifoIsrs;
+    uint32_t count;
+
+    count = eeprom_isr_count();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0U, dst, sizeof(dst)));
+    pdlIsrs = eeprom_isr_count() - count;
+
+    count = eeprom_isr_count();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_fifo_read(0U, dst, sizeof(dst)));
+    fifoIsrs = eeprom_isr_count() - count;
+
+    TEST_ASSERT(fifoIsrs < pdlIsrs);
+    TEST_ASSERT(fifoIsrs <= ((BLOCK_SIZE / SIM_SCB_FIFO_SIZE) + 4UL));
+}
+
+/*******************************************************************************
+* Function Name: TestErrors
+********************************************************************************
+* Summary:
+*  Bad parameters are rejected, a missing device is reported, and the SCB
+*  interrupt is handed back to the PDL driver after a failed transfer.
+*
+*******************************************************************************/
+static void TestErrors(void)
+{
+    uint8_t buf[EEPROM_PAGE_SIZE];
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_fifo_write(0U, NULL, 1UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_fifo_write(0U, buf, 0UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_fifo_read((eeprom_addr_t)(EEPROM_SIZE - 1UL), buf, 2UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_fifo_read(0U, NULL, 1UL));
+
+    sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+    TEST_ASSERT_EQUAL(ADDR_NAK_ERROR, eeprom_fifo_read(0U, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL(ADDR_NAK_ERROR, eeprom_fifo_write(0U, buf, sizeof(buf)));
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+
+    test_fill(buf, sizeof(buf), 3UL);
+    (void)memcpy(sim_eeprom_mem(EEPROM_SLAVE_ADDR), buf, sizeof(buf));
+    (void)memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0U, buf, sizeof(buf)));
+    TEST_ASSERT(memcmp(buf, sim_eeprom_mem(EEPROM_SLAVE_ADDR), sizeof(buf)) == 0);
+}
+
+#endif /* EEPROM_FIFO_ENABLE */
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+#if EEPROM_FIFO_ENABLE
+    test_init();
+
+    TestWriteRead();
+    TestIsrCount();
+    TestErrors();
+
+    printf("test_fifo: OK\n");
+#else
+    printf("test_fifo: SKIPPED, EEPROM_FIFO_ENABLE is 0u\n");
+#endif
+    return 0;
+}
+
+/* [] END OF FILE */
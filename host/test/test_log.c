@@ -0,0 +1,343 @@
+/******************************************************************************
+* File Name:  test_log.c
+*
+* Description:  Host tests of the log-structured record store: appends,
+*               compaction, and power cuts at every byte of a record write and
+*               in each write cycle of a compaction.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_log.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_KEYS               (8u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Value of a key, as the application last wrote it */
+typedef struct
+{
+    uint8_t data[EEPROM_LOG_MAX_DATA];
+    uint32_t len;
+} test_value_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static test_value_t model[TEST_KEYS];
+static uint32_t seedCounter = 1UL;
+
+/*******************************************************************************
+* Function Name: NewValue
+********************************************************************************
+* Summary:
+*  Makes a new value of the given length for a key.
+*
+*******************************************************************************/
+static void NewValue(test_value_t *value, uint32_t len)
+{
+    value->len = len;
+    test_fill(value->data, len, seedCounter++);
+}
+
+/*******************************************************************************
+* Function Name: WriteKey
+********************************************************************************
+* Summary:
+*  Writes a new value of a key and records it in the model.
+*
+*******************************************************************************/
+static void WriteKey(uint8_t key, uint32_t len)
+{
+    NewValue(&model[key], len);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_write(key, model[key].data, len));
+}
+
+/*******************************************************************************
+* Function Name: ValueIs
+********************************************************************************
+* Summary:
+*  Returns whether a key reads back as the given value.
+*
+*******************************************************************************/
+static bool ValueIs(uint8_t key, const test_value_t *value)
+{
+    uint8_t data[EEPROM_LOG_MAX_DATA];
+    uint32_t len = 0UL;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_read(key, data, sizeof(data), &len));
+    return ((len == value->len) && (memcmp(data, value->data, len) == 0));
+}
+
+/*******************************************************************************
+* Function Name: CheckAll
+********************************************************************************
+* Summary:
+*  Checks every key against the model, except skipKey.
+*
+*******************************************************************************/
+static void CheckAll(uint8_t skipKey)
+{
+    for (uint8_t key = 0u; key < TEST_KEYS; key++)
+    {
+        if (key != skipKey)
+        {
+            TEST_ASSERT(ValueIs(key, &model[key]));
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestAppendCompact
+********************************************************************************
+* Summary:
+*  Values survive a remount and many laps of the log, with compaction.
+*
+*******************************************************************************/
+static void TestAppendCompact(void)
+{
+    eeprom_log_stats_t stats;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_format());
+    for (uint8_t key = 0u; key < TEST_KEYS; key++)
+    {
+        WriteKey(key, 1UL + (key * 7UL) % EEPROM_LOG_MAX_DATA);
+    }
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_mount());
+    CheckAll(0xFFu);
+
+    for (uint32_t i = 0UL; i < (4UL * EEPROM_LOG_PAGES * 4UL); i++)
+    {
+        uint8_t key = (uint8_t)(sim_random() % TEST_KEYS);
+
+        WriteKey(key, (uint32_t)(sim_random() % (EEPROM_LOG_MAX_DATA + 1UL)));
+    }
+    CheckAll(0xFFu);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_mount());
+    CheckAll(0xFFu);
+
+    eeprom_log_get_stats(&stats);
+    TEST_ASSERT(stats.pageWrites > (2UL * EEPROM_LOG_PAGES));
+    TEST_ASSERT(stats.gcRuns > 0u);
+
+    TEST_ASSERT_EQUAL(LOG_NOT_FOUND_ERROR, eeprom_log_read(TEST_KEYS, NULL, 0UL, NULL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_log_write(EEPROM_LOG_KEY_FREE, NULL, 0UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_log_write(0u, model[0].data, EEPROM_LOG_MAX_DATA + 1UL));
+}
+
+/*******************************************************************************
+* Function Name: CutWrite
+********************************************************************************
+* Summary:
+*  Restores the EEPROM and the store to a snapshot, then writes a new value
+*  of key with the power cut in write cycle cycle after programmedBytes
+*  bytes. After power comes back and the store is mounted again, the key
+*  holds its old or its new value, all other keys are unchanged, and the
+*  store takes new writes. Returns whether the new value survived.
+*
+*******************************************************************************/
+static bool CutWrite(const uint8_t *snapshot, const test_value_t *snapModel, uint8_t key, uint32_t len,
+                     uint32_t cycle, uint32_t programmedBytes)
+{
+    test_value_t newValue;
+    bool isNew;
+
+    (void)memcpy(sim_eeprom_mem(EEPROM_SLAVE_ADDR), snapshot, EEPROM_SIZE);
+    (void)memcpy(model, snapModel, sizeof(model));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_mount());
+
+    NewValue(&newValue, len);
+    sim_eeprom_power_cut(cycle, programmedBytes);
+    TEST_ASSERT(eeprom_log_write(key, newValue.data, len) != TRANSFER_CMPLT);
+    TEST_ASSERT(!sim_eeprom_powered());
+
+    /* Power comes back, the application starts again */
+    sim_eeprom_power_on();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_mount());
+    CheckAll(key);
+    isNew = ValueIs(key, &newValue);
+    TEST_ASSERT(isNew || ValueIs(key, &model[key]));
+    if (isNew)
+    {
+        model[key] = newValue;
+    }
+
+    /* The store goes on, and a second mount agrees */
+    for (uint32_t i = 0UL; i < 3UL; i++)
+    {
+        WriteKey((uint8_t)((key + i) % TEST_KEYS), 1UL + (i % EEPROM_LOG_MAX_DATA));
+    }
+    CheckAll(0xFFu);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_mount());
+    CheckAll(0xFFu);
+
+    return isNew;
+}
+
+/*******************************************************************************
+* Function Name: TestPowerCutRecord
+********************************************************************************
+* Summary:
+*  Cuts the power at every byte of a record write, for a record at the start
+*  of a page, which is written with the free space after it, and for one in
+*  the middle of a page where the page has room for two records. The new
+*  value survives only once all of its record is programmed.
+*
+*******************************************************************************/
+static void TestPowerCutRecord(void)
+{
+    static uint8_t snapshot[EEPROM_SIZE];
+    static test_value_t snapModel[TEST_KEYS];
+    const uint32_t len = (EEPROM_LOG_MAX_DATA < 20UL) ? EEPROM_LOG_MAX_DATA : 20UL;
+    const uint32_t recordLen = EEPROM_LOG_HEADER_SIZE + len;
+    const uint32_t places = ((EEPROM_LOG_HEADER_SIZE + 1UL + recordLen) <= EEPROM_PAGE_SIZE) ? 2u : 1u;
+
+    for (uint32_t at = 0u; at < places; at++)
+    {
+        sim_eeprom_stats_t eeprom;
+        uint32_t writeLen;
+
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_format());
+        for (uint8_t key = 0u; key < TEST_KEYS; key++)
+        {
+            WriteKey(key, (3UL + key) % (EEPROM_LOG_MAX_DATA + 1UL));
+        }
+        /* Records of a page each, so the next one starts a new page, or a
+         * small one after them, so the next one follows it in its page */
+        for (uint32_t i = 0UL; i < 40UL; i++)
+        {
+            WriteKey((uint8_t)(i % TEST_KEYS), EEPROM_LOG_MAX_DATA);
+        }
+        if (at != 0u)
+        {
+            WriteKey(3u, 1UL);
+        }
+        (void)memcpy(snapshot, sim_eeprom_mem(EEPROM_SLAVE_ADDR), EEPROM_SIZE);
+        (void)memcpy(snapModel, model, sizeof(model));
+
+        writeLen = (at == 0u) ? EEPROM_PAGE_SIZE : recordLen;
+
+        /* Without a cut, the record takes one write cycle of writeLen bytes */
+        sim_eeprom_reset_stats();
+        WriteKey(2u, len);
+        sim_eeprom_get_stats(&eeprom);
+        TEST_ASSERT_EQUAL(1UL, eeprom.writeCycles);
+        TEST_ASSERT_EQUAL(writeLen, eeprom.bytesWritten);
+
+        for (uint32_t programmed = 0UL; programmed <= writeLen; programmed++)
+        {
+            bool isNew = CutWrite(snapshot, snapModel, 2u, len, 0UL, programmed);
+
+            TEST_ASSERT(isNew == (programmed >= recordLen));
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestPowerCutCompaction
+********************************************************************************
+* Summary:
+*  Cuts the power in each write cycle of an append that compacts the log,
+*  at the start, the middle and the end of the write.
+*
+*******************************************************************************/
+static void TestPowerCutCompaction(void)
+{
+    static uint8_t snapshot[EEPROM_SIZE];
+    static test_value_t snapModel[TEST_KEYS];
+    const uint32_t len = EEPROM_LOG_MAX_DATA;
+    static const uint32_t cuts[] = { 0UL, 3UL, EEPROM_LOG_HEADER_SIZE + 1UL, 33UL, EEPROM_PAGE_SIZE };
+    eeprom_log_stats_t before;
+    eeprom_log_stats_t after;
+    uint32_t cycles;
+
+    /* Find an append that compacts */
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_log_format());
+    for (uint8_t key = 0u; key < TEST_KEYS; key++)
+    {
+        WriteKey(key, (EEPROM_LOG_MAX_DATA < 10UL) ? EEPROM_LOG_MAX_DATA : 10UL);
+    }
+    for (;;)
+    {
+        (void)memcpy(snapshot, sim_eeprom_mem(EEPROM_SLAVE_ADDR), EEPROM_SIZE);
+        (void)memcpy(snapModel, model, sizeof(model));
+        eeprom_log_get_stats(&before);
+        sim_eeprom_reset_stats();
+        WriteKey(1u, len);
+        eeprom_log_get_stats(&after);
+        if (after.relocated != before.relocated)
+        {
+            sim_eeprom_stats_t eeprom;
+
+            sim_eeprom_get_stats(&eeprom);
+            cycles = eeprom.writeCycles;
+            break;
+        }
+    }
+    TEST_ASSERT(cycles > 1UL);
+
+    for (uint32_t cycle = 0UL; cycle < cycles; cycle++)
+    {
+        for (uint32_t c = 0UL; c < (sizeof(cuts) / sizeof(cuts[0])); c++)
+        {
+            (void)CutWrite(snapshot, snapModel, 1u, len, cycle, cuts[c]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestAppendCompact();
+    TestPowerCutRecord();
+    TestPowerCutCompaction();
+
+    printf("test_log: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,275 @@
+/******************************************************************************
+* File Name:  test_lz.c
+*
+* Description:  Host tests of the LZ block storage.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_lz.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest block of the tests */
+#define TEST_MAX_LEN            (4096UL)
+
+/* Bytes after the data that a read must leave alone */
+#define TEST_GUARD              (16UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t data[TEST_MAX_LEN];
+static uint8_t out[TEST_MAX_LEN + TEST_GUARD];
+static uint32_t streamLen;
+static uint32_t streamMax;
+
+/*******************************************************************************
+* Function Name: StreamConsumer
+********************************************************************************
+* Summary:
+*  Collects the output of eeprom_lz_read_stream() in out.
+*
+*******************************************************************************/
+static void StreamConsumer(const uint8_t *chunk, uint32_t len)
+{
+    TEST_ASSERT((streamLen + len) <= TEST_MAX_LEN);
+    if (len > streamMax)
+    {
+        streamMax = len;
+    }
+    (void)memcpy(&out[streamLen], chunk, len);
+    streamLen += len;
+}
+
+/*******************************************************************************
+* Function Name: RoundTrip
+********************************************************************************
+* Summary:
+*  Stores len bytes of data at addr, reads them back both ways and returns
+*  the EEPROM bytes used.
+*
+*******************************************************************************/
+static uint32_t RoundTrip(uint32_t addr, uint32_t len)
+{
+    uint32_t stored = 0UL;
+    uint32_t readLen = 0UL;
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write((eeprom_addr_t)addr, EEPROM_SIZE - addr, data, len, &stored));
+    TEST_ASSERT(stored <= (EEPROM_LZ_HEADER_SIZE + len));
+
+    (void)memset(out, 0xA5, sizeof(out));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_read((eeprom_addr_t)addr, out, TEST_MAX_LEN, &readLen));
+    TEST_ASSERT_EQUAL(len, readLen);
+    TEST_ASSERT(memcmp(out, data, len) == 0);
+
+    (void)memset(out, 0xA5, sizeof(out));
+    streamLen = 0UL;
+    streamMax = 0UL;
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_read_stream((eeprom_addr_t)addr, &StreamConsumer));
+    TEST_ASSERT_EQUAL(len, streamLen);
+    TEST_ASSERT(memcmp(out, data, len) == 0);
+    return stored;
+}
+
+/*******************************************************************************
+* Function Name: TestRoundTrip
+********************************************************************************
+* Summary:
+*  Log text of any length at any alignment, including a header that crosses
+*  a page boundary, reads back unchanged. Blocks of more than a few lines
+*  are compressed, and the decoder output comes in window-sized chunks.
+*  Blocks that could not be stored raw in the array are left out.
+*
+*******************************************************************************/
+static void TestRoundTrip(void)
+{
+    static const uint32_t lens[] = { 1UL, 3UL, 24UL, 50UL, 251UL, 1000UL, TEST_MAX_LEN };
+    static const uint32_t addrs[] = { 0UL, 7UL, EEPROM_PAGE_SIZE - 2UL, 200UL, 5000UL };
+    uint32_t stored;
+
+    for (uint32_t a = 0UL; a < (sizeof(addrs) / sizeof(addrs[0])); a++)
+    {
+        for (uint32_t l = 0UL; l < (sizeof(lens) / sizeof(lens[0])); l++)
+        {
+            if ((addrs[a] + EEPROM_LZ_HEADER_SIZE + lens[l]) > EEPROM_SIZE)
+            {
+                continue;
+            }
+            test_log_text(data, lens[l], (a * 100UL) + l);
+            stored = RoundTrip(addrs[a], lens[l]);
+
+            if (lens[l] >= 251UL)
+            {
+                TEST_ASSERT_EQUAL(EEPROM_LZ_METHOD_LZSS, sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addrs[a]]);
+                TEST_ASSERT(stored < ((lens[l] * 6UL) / 10UL));
+                TEST_ASSERT(streamMax <= EEPROM_LZ_WINDOW_SIZE);
+            }
+        }
+    }
+
+    /* Long runs take the longest matches */
+    (void)memset(data, 0, TEST_MAX_LEN);
+    TEST_ASSERT(RoundTrip(TEST_SPAN(364UL) - 64UL, TEST_MAX_LEN) < 64UL);
+}
+
+/*******************************************************************************
+* Function Name: TestRaw
+********************************************************************************
+* Summary:
+*  Data that does not compress is stored as it is, with the header only.
+*
+*******************************************************************************/
+static void TestRaw(void)
+{
+    const uint32_t len = TEST_SPAN(61UL + EEPROM_LZ_HEADER_SIZE + 1000UL) - 61UL - EEPROM_LZ_HEADER_SIZE;
+
+    for (uint32_t i = 0UL; i < TEST_MAX_LEN; i++)
+    {
+        data[i] = (uint8_t)sim_random();
+    }
+
+    TEST_ASSERT_EQUAL(EEPROM_LZ_HEADER_SIZE + len, RoundTrip(61UL, len));
+    TEST_ASSERT_EQUAL(EEPROM_LZ_METHOD_RAW, sim_eeprom_mem(EEPROM_SLAVE_ADDR)[61UL]);
+    TEST_ASSERT_EQUAL(EEPROM_LZ_HEADER_SIZE + 2UL, RoundTrip(0UL, 2UL));
+}
+
+/*******************************************************************************
+* Function Name: TestLimits
+********************************************************************************
+* Summary:
+*  A block is stored only within the space given. Compressed data fits where
+*  the raw data would not; the parameters are checked.
+*
+*******************************************************************************/
+static void TestLimits(void)
+{
+    const uint32_t textLen = TEST_SPAN(1000UL);
+    uint32_t stored = 0UL;
+    uint32_t len = 0UL;
+
+    test_log_text(data, textLen, 0UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write(0u, (textLen * 6UL) / 10UL, data, textLen, &stored));
+    TEST_ASSERT(stored <= ((textLen * 6UL) / 10UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_lz_write(0u, 100UL, data, textLen, &stored));
+
+    for (uint32_t i = 0UL; i < 200UL; i++)
+    {
+        data[i] = (uint8_t)sim_random();
+    }
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_lz_write(0u, 200UL, data, 200UL, &stored));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write(0u, 205UL, data, 200UL, &stored));
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_lz_write(0u, 100UL, data, 0UL, &stored));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_lz_write((eeprom_addr_t)(EEPROM_SIZE - 10UL), 100UL, data,
+                                                           5UL, &stored));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_lz_read(0u, out, 199UL, &len));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_lz_read_stream(0u, NULL));
+}
+
+/*******************************************************************************
+* Function Name: TestCorrupt
+********************************************************************************
+* Summary:
+*  A corrupt header is rejected, and corrupt compressed data either decodes
+*  to something of the stored length or is rejected, never writing past the
+*  length in the header.
+*
+*******************************************************************************/
+static void TestCorrupt(void)
+{
+    const uint32_t textLen = TEST_SPAN(2000UL);
+    const uint32_t addr = (EEPROM_SIZE - textLen) / 2UL;
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    uint32_t stored = 0UL;
+    uint32_t len = 0UL;
+    uint32_t rejected = 0UL;
+    uint8_t status;
+
+    test_log_text(data, textLen, 7UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_write((eeprom_addr_t)addr, EEPROM_SIZE - addr, data, textLen,
+                                                      &stored));
+
+    mem[addr] = 7u;
+    TEST_ASSERT_EQUAL(INVALID_DATA_ERROR, eeprom_lz_read((eeprom_addr_t)addr, out, TEST_MAX_LEN, &len));
+    mem[addr] = EEPROM_LZ_METHOD_LZSS;
+    mem[addr + 3UL] ^= 0x80u;
+    TEST_ASSERT_EQUAL(INVALID_DATA_ERROR, eeprom_lz_read((eeprom_addr_t)addr, out, TEST_MAX_LEN, &len));
+    mem[addr + 3UL] ^= 0x80u;
+
+    for (uint32_t i = 0UL; i < 500UL; i++)
+    {
+        uint32_t pos = addr + EEPROM_LZ_HEADER_SIZE + (uint32_t)(sim_random() % (stored - EEPROM_LZ_HEADER_SIZE));
+        uint8_t bits = (uint8_t)(1u + (sim_random() % 255u));
+
+        mem[pos] ^= bits;
+        (void)memset(out, 0xA5, sizeof(out));
+        status = eeprom_lz_read((eeprom_addr_t)addr, out, textLen + TEST_GUARD, &len);
+        TEST_ASSERT((status == TRANSFER_CMPLT) || (status == INVALID_DATA_ERROR));
+        rejected += (status == INVALID_DATA_ERROR) ? 1UL : 0UL;
+        for (uint32_t g = textLen; g < sizeof(out); g++)
+        {
+            TEST_ASSERT_EQUAL(0xA5u, out[g]);
+        }
+        mem[pos] ^= bits;
+    }
+    TEST_ASSERT(rejected > 0UL);
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_lz_read((eeprom_addr_t)addr, out, TEST_MAX_LEN, &len));
+    TEST_ASSERT(memcmp(out, data, textLen) == 0);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestRoundTrip();
+    TestRaw();
+    TestLimits();
+    TestCorrupt();
+
+    printf("test_lz: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,203 @@
+/******************************************************************************
+* File Name:  test_main.c
+*
+* Description:  Runs main.c against the simulated kit: button presses, write,
+*               read back and the LED patterns of the results.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_event.h"
+#include "eeprom_led.h"
+#include "eeprom_time.h"
+
+/* main.c is built with its main() renamed */
+#undef main
+int app_main(void);
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Time between two presses, longer than the debounce time and than one
+ * write and read back */
+#define PRESS_INTERVAL_US       (100000ULL)
+
+/* Contact bounce after the first press, within the debounce time */
+#define BOUNCE_US               (EEPROM_BUTTON_DEBOUNCE_MS * 500ULL)
+
+/* Presses made while the first pattern is shown; the last one fails */
+#define PRESS_COUNT             (EEPROM_LED_QUEUE_DEPTH + 3UL)
+
+/* Time for all the patterns left in the queue to be shown */
+#define SETTLE_US               (20000000ULL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static bool started = false;
+static uint64_t startUs = 0ULL;
+static uint32_t presses = 0UL;
+static bool bounced = false;
+static uint32_t startEdges = 0UL;
+static uint32_t lastWrites = 0UL;
+
+/*******************************************************************************
+* Function Name: Writes
+********************************************************************************
+* Summary:
+*  Returns the page writes programmed so far.
+*
+*******************************************************************************/
+static uint32_t Writes(void)
+{
+    sim_eeprom_stats_t stats;
+
+    sim_eeprom_get_stats(&stats);
+    return stats.writeCycles;
+}
+
+/*******************************************************************************
+* Function Name: TestQueue
+********************************************************************************
+* Summary:
+*  A full LED queue drops its oldest pattern for a new one.
+*
+*******************************************************************************/
+static void TestQueue(void)
+{
+    TEST_ASSERT(!eeprom_led_blink(0u));
+    TEST_ASSERT(eeprom_led_blink(1u));
+    TEST_ASSERT(eeprom_led_busy());
+    for (uint32_t i = 0UL; i < EEPROM_LED_QUEUE_DEPTH; i++)
+    {
+        TEST_ASSERT(eeprom_led_blink(1u));
+    }
+    TEST_ASSERT(!eeprom_led_blink(2u));
+
+    while (eeprom_led_busy())
+    {
+        sim_run_us(1000ULL);
+        eeprom_led_tick();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Script
+********************************************************************************
+* Summary:
+*  Runs whenever the application sleeps. Presses the button at a fixed
+*  interval, with a contact bounce after the first press, makes the last
+*  write fail, and checks the LED once all patterns have been shown.
+*
+*******************************************************************************/
+static void Script(void)
+{
+    uint64_t nowUs = sim_time_us();
+
+    if (!started)
+    {
+        /* The first press waits for the end of the initialization, which
+         * sleeps in the driver wait paths before the button is enabled */
+        started = true;
+        startUs = nowUs + PRESS_INTERVAL_US;
+        startEdges = sim_led_edges();
+    }
+
+    if ((presses < PRESS_COUNT) && (nowUs >= (startUs + (presses * PRESS_INTERVAL_US))))
+    {
+        if (presses == 0UL)
+        {
+            lastWrites = Writes();
+        }
+        else
+        {
+            /* The previous press has been written without waiting for the
+             * LED, and its bounce was ignored */
+            TEST_ASSERT_EQUAL(lastWrites + 1UL, Writes());
+            lastWrites = Writes();
+        }
+        if (presses == (PRESS_COUNT - 1UL))
+        {
+            sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+        }
+
+        sim_button_press();
+        presses++;
+    }
+
+    if (!bounced && (presses == 1UL) && (nowUs >= (startUs + BOUNCE_US)))
+    {
+        bounced = true;
+        sim_button_press();
+    }
+
+    if ((presses == PRESS_COUNT) && (nowUs >= (startUs + SETTLE_US)))
+    {
+        /* The first pattern was shown at once, then the queue kept the
+         * newest ones: three single blinks and the three blinks of the
+         * failed write, two edges per blink */
+        TEST_ASSERT_EQUAL(lastWrites, Writes());
+        TEST_ASSERT(!eeprom_led_busy());
+        TEST_ASSERT(!sim_led_on());
+        TEST_ASSERT_EQUAL(2UL * (1UL + (EEPROM_LED_QUEUE_DEPTH - 1UL) + 3UL),
+                          sim_led_edges() - startEdges);
+
+        printf("test_main: OK\n");
+        exit(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+    __enable_irq();
+    eeprom_time_init();
+    TestQueue();
+
+    /* The application never returns; the script ends the test */
+    sim_set_hook(&Script);
+    (void)app_main();
+
+    printf("test_main: FAIL: main() returned\n");
+    return 1;
+}
+
+/* [] END OF FILE */
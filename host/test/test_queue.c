@@ -0,0 +1,365 @@
+/******************************************************************************
+* File Name:  test_queue.c
+*
+* Description:  Host tests of the interrupt-driven transaction queue.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_queue.h"
+#include "eeprom_arb.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t doneStatus[2UL * EEPROM_QUEUE_DEPTH];
+static volatile uint32_t doneCount;
+
+/*******************************************************************************
+* Function Name: Done
+********************************************************************************
+* Summary:
+*  Completion callback, records the status of each transaction in order.
+*
+*******************************************************************************/
+static void Done(uint8_t status)
+{
+    doneStatus[doneCount++] = status;
+}
+
+/*******************************************************************************
+* Function Name: WaitIdle
+********************************************************************************
+* Summary:
+*  Waits for the queue to drain.
+*
+*******************************************************************************/
+static void WaitIdle(void)
+{
+    uint64_t startUs = sim_time_us();
+
+    while (eeprom_queue_pending() > 0UL)
+    {
+        Cy_SysLib_DelayUs(50u);
+        TEST_ASSERT((sim_time_us() - startUs) < 1000000ULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestBurst
+********************************************************************************
+* Summary:
+*  A full queue of page writes, followed by reads of the same pages, runs in
+*  order without the caller waiting, and each write starts when the write
+*  cycle of the previous one ends.
+*
+*******************************************************************************/
+static void TestBurst(void)
+{
+    static uint8_t src[EEPROM_QUEUE_DEPTH][EEPROM_PAGE_SIZE + 3u];
+    static uint8_t dst[EEPROM_QUEUE_DEPTH][EEPROM_PAGE_SIZE + 3u];
+    const uint32_t base = 8UL * EEPROM_PAGE_SIZE;
+    eeprom_queue_stats_t before;
+    eeprom_queue_stats_t after;
+    uint64_t startUs;
+
+    eeprom_queue_get_stats(&before);
+    doneCount = 0UL;
+    startUs = sim_time_us();
+
+    /* Spans across page boundaries */
+    for (uint32_t i = 0UL; i < EEPROM_QUEUE_DEPTH; i++)
+    {
+        test_fill(src[i], sizeof(src[i]), i);
+        TEST_ASSERT_EQUAL(TRANSFER_STARTED,
+                          eeprom_queue_write((eeprom_addr_t)(base + (i * sizeof(src[i]))), src[i],
+                                             sizeof(src[i]), &Done));
+    }
+    TEST_ASSERT((sim_time_us() - startUs) < 100ULL);
+    TEST_ASSERT_EQUAL(EEPROM_QUEUE_DEPTH, eeprom_queue_pending());
+    TEST_ASSERT_EQUAL(TRANSFER_BUSY, eeprom_queue_read(0U, dst[0], 1UL, &Done));
+
+    /* Reads queued behind the writes see the new data */
+    for (uint32_t i = 0UL; i < EEPROM_QUEUE_DEPTH; i++)
+    {
+        while (eeprom_queue_read((eeprom_addr_t)(base + (i * sizeof(dst[i]))), dst[i], sizeof(dst[i]),
+                                 &Done) == TRANSFER_BUSY)
+        {
+            Cy_SysLib_DelayUs(50u);
+        }
+    }
+    WaitIdle();
+
+    TEST_ASSERT_EQUAL(2UL * EEPROM_QUEUE_DEPTH, doneCount);
+    for (uint32_t i = 0UL; i < doneCount; i++)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, doneStatus[i]);
+    }
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+
+    eeprom_queue_get_stats(&after);
+    TEST_ASSERT_EQUAL(2UL * EEPROM_QUEUE_DEPTH, after.completed - before.completed);
+    TEST_ASSERT_EQUAL(0u, after.failed - before.failed);
+    TEST_ASSERT_EQUAL(2UL * sizeof(src), after.bytes - before.bytes);
+    TEST_ASSERT(after.nakRetries > before.nakRetries);
+    TEST_ASSERT_EQUAL(EEPROM_QUEUE_DEPTH, after.peakDepth);
+}
+
+/*******************************************************************************
+* Function Name: TestMissingDevice
+********************************************************************************
+* Summary:
+*  A device that never answers fails the transaction once the NAK retry time
+*  is used up, whatever the bus speed, and the next transaction still runs.
+*
+*******************************************************************************/
+static void TestMissingDevice(void)
+{
+    uint8_t data[4] = { 1u, 2u, 3u, 4u };
+    eeprom_queue_stats_t before;
+    eeprom_queue_stats_t after;
+    uint64_t startUs;
+
+    eeprom_queue_get_stats(&before);
+    doneCount = 0UL;
+    sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_queue_write(0U, data, sizeof(data), &Done));
+    WaitIdle();
+    TEST_ASSERT((sim_time_us() - startUs) >= EEPROM_QUEUE_NAK_TIMEOUT_US);
+    TEST_ASSERT((sim_time_us() - startUs) < (EEPROM_QUEUE_NAK_TIMEOUT_US + 1000ULL));
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+
+    TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_queue_write(0U, data, sizeof(data), &Done));
+    WaitIdle();
+
+    TEST_ASSERT_EQUAL(2u, doneCount);
+    TEST_ASSERT_EQUAL(ADDR_NAK_ERROR, doneStatus[0]);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, doneStatus[1]);
+    eeprom_queue_get_stats(&after);
+    TEST_ASSERT_EQUAL(1u, after.failed - before.failed);
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), data, sizeof(data)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestArbitration
+********************************************************************************
+* Summary:
+*  Another master wins some of the Starts. Each lost transfer is restarted by
+*  the SysTick callback after a random backoff, not at once from the I2C
+*  interrupt, and all transactions complete with the right data.
+*
+*******************************************************************************/
+static void TestArbitration(void)
+{
+    static const sim_i2c_master_t master = { 0u, 600u, 0u, 0u };
+    static uint8_t src[4][EEPROM_PAGE_SIZE];
+    static uint8_t dst[4][EEPROM_PAGE_SIZE];
+    const uint32_t base = 24UL * EEPROM_PAGE_SIZE;
+    eeprom_queue_stats_t before;
+    eeprom_queue_stats_t after;
+    sim_i2c_stats_t bus;
+    uint32_t lost = 0UL;
+    uint32_t starts = 0UL;
+    uint64_t lostUs = 0ULL;
+    uint64_t gapUs = 0ULL;
+    uint64_t startUs = sim_time_us();
+
+    eeprom_queue_get_stats(&before);
+    sim_i2c_get_stats(&bus);
+    lost = bus.arbLost;
+    doneCount = 0UL;
+    sim_i2c_set_master(&master);
+
+    for (uint32_t i = 0UL; i < 4UL; i++)
+    {
+        test_fill(src[i], sizeof(src[i]), i + 40UL);
+        TEST_ASSERT_EQUAL(TRANSFER_STARTED,
+                          eeprom_queue_write((eeprom_addr_t)(base + (i * sizeof(src[i]))), src[i],
+                                             sizeof(src[i]), &Done));
+        TEST_ASSERT_EQUAL(TRANSFER_STARTED,
+                          eeprom_queue_read((eeprom_addr_t)(base + (i * sizeof(dst[i]))), dst[i],
+                                            sizeof(dst[i]), &Done));
+    }
+
+    /* Time from each lost arbitration to the next Start */
+    while (eeprom_queue_pending() > 0UL)
+    {
+        Cy_SysLib_DelayUs(1u);
+        sim_i2c_get_stats(&bus);
+        if ((starts != 0UL) && (bus.starts != starts))
+        {
+            gapUs += sim_time_us() - lostUs;
+            starts = 0UL;
+        }
+        if (bus.arbLost != lost)
+        {
+            lost = bus.arbLost;
+            starts = bus.starts;
+            lostUs = sim_time_us();
+        }
+        TEST_ASSERT((sim_time_us() - startUs) < 1000000ULL);
+    }
+    sim_i2c_set_master(NULL);
+
+    TEST_ASSERT_EQUAL(8UL, doneCount);
+    for (uint32_t i = 0UL; i < doneCount; i++)
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, doneStatus[i]);
+    }
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+
+    eeprom_queue_get_stats(&after);
+    TEST_ASSERT(after.arbRetries > before.arbRetries);
+    TEST_ASSERT((after.backoffUs - before.backoffUs) >=
+                ((after.arbRetries - before.arbRetries) * EEPROM_ARB_BACKOFF_MIN_US));
+
+    /* The restarts waited for the pauses drawn */
+    TEST_ASSERT(gapUs >= (after.backoffUs - before.backoffUs));
+}
+
+/*******************************************************************************
+* Function Name: StreamCheck
+********************************************************************************
+* Summary:
+*  Stream consumer, compares the data with the simulated array.
+*
+*******************************************************************************/
+static uint32_t streamDone;
+static bool streamMatch;
+
+static void StreamCheck(const uint8_t *data, uint32_t len)
+{
+    if (memcmp(data, &sim_eeprom_mem(EEPROM_SLAVE_ADDR)[streamDone], len) != 0)
+    {
+        streamMatch = false;
+    }
+    streamDone += len;
+}
+
+/*******************************************************************************
+* Function Name: TestBlockingOwner
+********************************************************************************
+* Summary:
+*  A queued write loses arbitration, and a streaming read of the main loop
+*  starts before its restart is due. The SysTick callback must not start the
+*  write while the low-level read holds the bus: the read gets all its data,
+*  and the write follows once the read has returned.
+*
+*******************************************************************************/
+static void TestBlockingOwner(void)
+{
+    static const sim_i2c_master_t master = { 0u, 1000u, 0u, 0u };
+    static uint8_t src[EEPROM_PAGE_SIZE];
+    const uint32_t base = (EEPROM_SIZE / 32UL) * 25UL;
+    const uint32_t streamLen = TEST_SPAN(128UL * EEPROM_PAGE_SIZE);
+    eeprom_queue_stats_t before;
+    eeprom_queue_stats_t stats;
+    uint64_t startUs = sim_time_us();
+
+    test_fill(src, sizeof(src), 60UL);
+
+    /* Half of the Starts lose, so the write is queued again until one of
+     * them has lost and its restart is scheduled */
+    sim_i2c_set_master(&master);
+    do
+    {
+        WaitIdle();
+        eeprom_queue_get_stats(&before);
+        doneCount = 0UL;
+        TEST_ASSERT_EQUAL(TRANSFER_STARTED, eeprom_queue_write((eeprom_addr_t)base, src, sizeof(src), &Done));
+        do
+        {
+            Cy_SysLib_DelayUs(1u);
+            eeprom_queue_get_stats(&stats);
+        } while ((stats.arbRetries == before.arbRetries) && (eeprom_queue_pending() > 0UL));
+        TEST_ASSERT((sim_time_us() - startUs) < 1000000ULL);
+    } while (stats.arbRetries == before.arbRetries);
+    sim_i2c_set_master(NULL);
+
+    /* A write that won an earlier round may still be in its write cycle */
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(1UL, eeprom_queue_pending());
+
+    streamDone = 0UL;
+    streamMatch = true;
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read_stream(0U, streamLen, &StreamCheck));
+    TEST_ASSERT_EQUAL(streamLen, streamDone);
+    TEST_ASSERT(streamMatch);
+
+    /* The restart was held back for the whole read */
+    TEST_ASSERT_EQUAL(1UL, eeprom_queue_pending());
+
+    WaitIdle();
+    TEST_ASSERT_EQUAL(1UL, doneCount);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, doneStatus[0]);
+    TEST_ASSERT(memcmp(&sim_eeprom_mem(EEPROM_SLAVE_ADDR)[base], src, sizeof(src)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    static const uint32_t rates[] = { 400000UL, 1000000UL };
+
+    test_init();
+
+    /* Built for a 24FC part, see DEFINES_test_queue. At 1 MHz an address
+     * probe is 2.5 times shorter, so the same write cycle takes more of them. */
+    sim_eeprom_set_write_cycle(EEPROM_WRITE_CYCLE_MS * 1000UL, EEPROM_WRITE_CYCLE_MS * 1000UL);
+    for (uint32_t i = 0UL; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(rates[i]));
+        TestBurst();
+        TestMissingDevice();
+        TestArbitration();
+        TestBlockingOwner();
+    }
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_queue_write(0U, NULL, 1UL, &Done));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_queue_read((eeprom_addr_t)(EEPROM_SIZE - 1UL),
+                                                             doneStatus, 2UL, &Done));
+
+    printf("test_queue: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name:  test_random_read.c
+*
+* Description:  Host tests of the single-transaction random read with a
+*               repeated Start.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: CheckRead
+********************************************************************************
+* Summary:
+*  Reads a span and checks the data, and that it took one transaction for
+*  each block of the device it touches: a Start, a repeated Start and one
+*  Stop.
+*
+*******************************************************************************/
+static void CheckRead(uint32_t addr, uint32_t len)
+{
+    static uint8_t dst[EEPROM_SIZE];
+    uint32_t blocks = ((addr + len - 1UL) / EEPROM_BLOCK_SIZE) - (addr / EEPROM_BLOCK_SIZE) + 1UL;
+    sim_i2c_stats_t bus;
+
+    sim_i2c_reset_stats();
+    (void)memset(dst, 0, len);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read((eeprom_addr_t)addr, dst, len));
+    sim_i2c_get_stats(&bus);
+
+    TEST_ASSERT(memcmp(dst, &sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addr], len) == 0);
+    TEST_ASSERT_EQUAL(2UL * blocks, bus.starts);
+    TEST_ASSERT_EQUAL(blocks, bus.stops);
+    TEST_ASSERT_EQUAL((blocks * (1UL + EEPROM_ADDR_SIZE + 1UL)) + len, bus.bytes);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    static uint8_t image[EEPROM_SIZE];
+    const uint32_t mid = 0x1234UL % EEPROM_SIZE;
+    uint8_t dst[4];
+
+    test_init();
+    test_fill(image, sizeof(image), 9UL);
+    (void)memcpy(sim_eeprom_mem(EEPROM_SLAVE_ADDR), image, sizeof(image));
+
+    /* Any address, any length, across pages */
+    CheckRead(0UL, 1UL);
+    CheckRead(EEPROM_SIZE - 1UL, 1UL);
+    CheckRead(EEPROM_PAGE_SIZE - 3UL, 7UL);
+    CheckRead(mid, TEST_SPAN(mid + 300UL) - mid);
+    CheckRead(0UL, EEPROM_SIZE);
+    for (uint32_t i = 0UL; i < 200UL; i++)
+    {
+        uint32_t len = 1UL + (uint32_t)(sim_random() % 64UL);
+
+        CheckRead((uint32_t)(sim_random() % (EEPROM_SIZE - len + 1UL)), len);
+    }
+
+    /* Invalid spans, and a missing device */
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read((eeprom_addr_t)(EEPROM_SIZE - 1UL), dst, 2UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read(0U, NULL, 1UL));
+    sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+    TEST_ASSERT(eeprom_read(0U, dst, sizeof(dst)) != TRANSFER_CMPLT);
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+
+    printf("test_random_read: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,227 @@
+/******************************************************************************
+* File Name:  test_recovery.c
+*
+* Description:  Host tests of bus recovery: sustained-low stuck detection, bus
+*               clear and retry.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_recovery.h"
+#include "eeprom_arb.h"
+#include <string.h>
+
+/*******************************************************************************
+* Function Name: StuckLimitUs
+********************************************************************************
+* Summary:
+*  Returns the time a line must stay low before the bus counts as stuck.
+*
+*******************************************************************************/
+static uint32_t StuckLimitUs(void)
+{
+    return ((9UL * 1000000UL) / eeprom_bus_get_speed()) + EEPROM_RECOVERY_STRETCH_US;
+}
+
+/*******************************************************************************
+* Function Name: TestOtherMaster
+********************************************************************************
+* Summary:
+*  The lines of a transaction of another master go low and high many times
+*  within a byte. Single samples see a low line, but the bus is not taken for
+*  stuck and is left alone.
+*
+*******************************************************************************/
+static void TestOtherMaster(void)
+{
+    static const sim_i2c_master_t master = { 1000u, 0u, 0u, 5000u };
+    uint32_t lowSamples = 0UL;
+
+    sim_i2c_set_master(&master);
+    TEST_ASSERT(Cy_SCB_I2C_IsBusBusy(CYBSP_I2C_HW));
+
+    for (uint32_t i = 0UL; i < 20UL; i++)
+    {
+        if ((0UL == Cy_GPIO_Read(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN)) ||
+            (0UL == Cy_GPIO_Read(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN)))
+        {
+            lowSamples++;
+        }
+        TEST_ASSERT(!eeprom_recovery_bus_stuck());
+    }
+    TEST_ASSERT(lowSamples > 0UL);
+    sim_i2c_set_master(NULL);
+}
+
+/*******************************************************************************
+* Function Name: TestHeldBus
+********************************************************************************
+* Summary:
+*  The slave of another master stretches SCL for longer than a byte. The bus
+*  is busy, so the check waits for the Stop of the other master instead of
+*  clocking the bus under it. Only a bus that stays held past the wait and
+*  the sustained-low timeout is cleared, which fails while SCL is held.
+*
+*******************************************************************************/
+static void TestHeldBus(void)
+{
+    uint64_t startUs;
+    uint64_t tookUs;
+
+    /* Released within the bus-free wait */
+    sim_i2c_stretch(EEPROM_ARB_BUS_FREE_TIMEOUT_US / 2UL);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_recovery_check(&eeprom_default_dev));
+    tookUs = sim_time_us() - startUs;
+    TEST_ASSERT(tookUs >= (EEPROM_ARB_BUS_FREE_TIMEOUT_US / 2UL));
+    TEST_ASSERT(tookUs < ((EEPROM_ARB_BUS_FREE_TIMEOUT_US / 2UL) + 50ULL));
+
+    /* Released after the bus-free wait, before the sustained-low timeout */
+    sim_i2c_stretch(EEPROM_ARB_BUS_FREE_TIMEOUT_US + 5000UL);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_recovery_check(&eeprom_default_dev));
+    tookUs = sim_time_us() - startUs;
+    TEST_ASSERT(tookUs >= (EEPROM_ARB_BUS_FREE_TIMEOUT_US + 5000UL));
+    TEST_ASSERT(tookUs < (EEPROM_ARB_BUS_FREE_TIMEOUT_US + 5050ULL));
+
+    /* Never released: cleared after both timeouts */
+    sim_i2c_stretch(100000UL);
+    startUs = sim_time_us();
+    TEST_ASSERT(eeprom_recovery_check(&eeprom_default_dev) != TRANSFER_CMPLT);
+    tookUs = sim_time_us() - startUs;
+    TEST_ASSERT(tookUs > (EEPROM_ARB_BUS_FREE_TIMEOUT_US + EEPROM_RECOVERY_HELD_LOW_US));
+    TEST_ASSERT(tookUs < (EEPROM_ARB_BUS_FREE_TIMEOUT_US + EEPROM_RECOVERY_HELD_LOW_US + 1000ULL));
+    sim_i2c_set_master(NULL);
+
+    /* A stuck slave on an idle bus is still cleared at once */
+    sim_i2c_hold_sda(5UL);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_recovery_check(&eeprom_default_dev));
+    TEST_ASSERT(sim_i2c_sda_held() == 0u);
+    TEST_ASSERT((sim_time_us() - startUs) < (StuckLimitUs() + 200ULL));
+}
+
+/*******************************************************************************
+* Function Name: TestStuckSlave
+********************************************************************************
+* Summary:
+*  A slave that holds SDA is detected once the line stayed low for longer
+*  than a byte and the stretch allowance, and the bus clear releases it.
+*
+*******************************************************************************/
+static void TestStuckSlave(void)
+{
+    uint64_t startUs;
+
+    /* A free bus is decided at once */
+    startUs = sim_time_us();
+    TEST_ASSERT(!eeprom_recovery_bus_stuck());
+    TEST_ASSERT((sim_time_us() - startUs) < 5ULL);
+
+    sim_i2c_hold_sda(5UL);
+    startUs = sim_time_us();
+    TEST_ASSERT(eeprom_recovery_bus_stuck());
+    TEST_ASSERT((sim_time_us() - startUs) > StuckLimitUs());
+    TEST_ASSERT((sim_time_us() - startUs) < (StuckLimitUs() + 20ULL));
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_recovery_clear_bus());
+    TEST_ASSERT_EQUAL(0u, sim_i2c_sda_held());
+    TEST_ASSERT(!eeprom_recovery_bus_stuck());
+
+    /* A slave that never lets go fails the clear */
+    sim_i2c_hold_sda(1000UL);
+    TEST_ASSERT(eeprom_recovery_clear_bus() != TRANSFER_CMPLT);
+    sim_i2c_hold_sda(0UL);
+}
+
+/*******************************************************************************
+* Function Name: TestRetry
+********************************************************************************
+* Summary:
+*  A read that times out on a stuck bus clears the bus, is retried and
+*  returns the data.
+*
+*******************************************************************************/
+static void TestRetry(void)
+{
+    uint8_t dst[EEPROM_PAGE_SIZE];
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    uint64_t startUs;
+    uint64_t readUs;
+
+    test_fill(mem, EEPROM_PAGE_SIZE, 17UL);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0u, dst, sizeof(dst)));
+    readUs = sim_time_us() - startUs;
+
+    sim_i2c_hold_sda(3UL);
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0u, dst, sizeof(dst)));
+    TEST_ASSERT(memcmp(dst, mem, sizeof(dst)) == 0);
+    TEST_ASSERT_EQUAL(0u, sim_i2c_sda_held());
+
+    /* The timeout, the clear and the first backoff on top of the read, well
+     * below the former flat second */
+    TEST_ASSERT((sim_time_us() - startUs) <
+                (readUs + ((eeprom_bus_timeout_ms(sizeof(dst)) + 2UL) * 1000ULL)));
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    static const uint32_t rates[] = { 100000UL, 400000UL };
+
+    test_init();
+
+    for (uint32_t i = 0UL; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(rates[i]));
+        TestOtherMaster();
+        TestHeldBus();
+        TestStuckSlave();
+        TestRetry();
+    }
+
+    printf("test_recovery: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,225 @@
+/******************************************************************************
+* File Name:  test_sim.c
+*
+* Description:  Host tests of the 24LCxx and I2C bus simulation: page wrap,
+*               busy NAK during the write cycle, bus time at the configured
+*               clock, and a driver round trip.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Timeout of one byte with the manual master API */
+#define TEST_TIMEOUT_MS         (10UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern cy_stc_scb_i2c_context_t CYBSP_I2C_context;
+
+/*******************************************************************************
+* Function Name: RawWrite
+********************************************************************************
+* Summary:
+*  Writes bytes at a memory address with the manual master API, ignoring the
+*  page boundary as a careless master would.
+*
+*******************************************************************************/
+static cy_en_scb_i2c_status_t RawWrite(uint32_t addr, const uint8_t *src, uint32_t len)
+{
+    cy_en_scb_i2c_status_t status;
+
+    status = Cy_SCB_I2C_MasterSendStart(CYBSP_I2C_HW, EEPROM_SLAVE_ADDR, CY_SCB_I2C_WRITE_XFER,
+                                        TEST_TIMEOUT_MS, &CYBSP_I2C_context);
+    if (status != CY_SCB_I2C_SUCCESS)
+    {
+        (void)Cy_SCB_I2C_MasterSendStop(CYBSP_I2C_HW, TEST_TIMEOUT_MS, &CYBSP_I2C_context);
+        return status;
+    }
+    for (uint32_t i = EEPROM_ADDR_SIZE; i > 0UL; i--)
+    {
+        TEST_ASSERT_EQUAL(CY_SCB_I2C_SUCCESS, Cy_SCB_I2C_MasterWriteByte(CYBSP_I2C_HW,
+                                                                         (uint8_t)(addr >> (8UL * (i - 1UL))),
+                                                                         TEST_TIMEOUT_MS, &CYBSP_I2C_context));
+    }
+    for (uint32_t i = 0UL; i < len; i++)
+    {
+        TEST_ASSERT_EQUAL(CY_SCB_I2C_SUCCESS, Cy_SCB_I2C_MasterWriteByte(CYBSP_I2C_HW, src[i],
+                                                                         TEST_TIMEOUT_MS, &CYBSP_I2C_context));
+    }
+    return Cy_SCB_I2C_MasterSendStop(CYBSP_I2C_HW, TEST_TIMEOUT_MS, &CYBSP_I2C_context);
+}
+
+/*******************************************************************************
+* Function Name: TestPageWrap
+********************************************************************************
+* Summary:
+*  Bytes past the end of a page roll over to the start of the same page.
+*
+*******************************************************************************/
+static void TestPageWrap(void)
+{
+    const uint32_t addr = (2UL * EEPROM_PAGE_SIZE) - 4UL;
+    uint8_t data[8] = { 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u };
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    sim_eeprom_stats_t stats;
+
+    sim_eeprom_reset_stats();
+    TEST_ASSERT_EQUAL(CY_SCB_I2C_SUCCESS, RawWrite(addr, data, sizeof(data)));
+    sim_eeprom_get_stats(&stats);
+
+    TEST_ASSERT_EQUAL(4u, stats.pageWraps);
+    TEST_ASSERT(memcmp(&mem[addr], data, 4u) == 0);
+    TEST_ASSERT(memcmp(&mem[EEPROM_PAGE_SIZE], &data[4], 4u) == 0);
+    TEST_ASSERT_EQUAL(0xFFu, mem[2UL * EEPROM_PAGE_SIZE]);
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+}
+
+/*******************************************************************************
+* Function Name: TestBusyNak
+********************************************************************************
+* Summary:
+*  The device does not acknowledge its address for the write cycle time.
+*  The first cycle, shorter than the ones before, may end while the CPU
+*  sleeps ahead of the polls; the second is polled to within one interval.
+*
+*******************************************************************************/
+static void TestBusyNak(void)
+{
+    uint8_t data = 0x5Au;
+    uint64_t start;
+    sim_eeprom_stats_t stats;
+
+    sim_eeprom_set_write_cycle(2000UL, 2000UL);
+    for (uint32_t i = 0UL; i < 2UL; i++)
+    {
+        TEST_ASSERT_EQUAL(CY_SCB_I2C_SUCCESS, RawWrite(0x10UL, &data, 1UL));
+        start = sim_time_us();
+
+        sim_eeprom_reset_stats();
+        TEST_ASSERT_EQUAL(CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK, RawWrite(0x10UL, &data, 1UL));
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+        sim_eeprom_get_stats(&stats);
+
+        TEST_ASSERT(stats.busyNaks >= 2u);
+        TEST_ASSERT((sim_time_us() - start) >= 2000ULL);
+    }
+    TEST_ASSERT((sim_time_us() - start) < (2000ULL + (2ULL * EEPROM_ACK_POLL_INTERVAL_US)));
+    sim_eeprom_set_write_cycle(SIM_EEPROM_WRITE_CYCLE_US, SIM_EEPROM_WRITE_CYCLE_US);
+}
+
+/*******************************************************************************
+* Function Name: TestBusTime
+********************************************************************************
+* Summary:
+*  A transaction takes nine clocks per byte plus Start and Stop at the
+*  configured rate.
+*
+*******************************************************************************/
+static void TestBusTime(void)
+{
+    static const uint32_t rates[] = { 100000UL, 400000UL };
+    uint8_t buf[EEPROM_PAGE_SIZE];
+    sim_i2c_stats_t stats;
+
+    for (uint32_t i = 0UL; i < (sizeof(rates) / sizeof(rates[0])); i++)
+    {
+        uint64_t expectNs;
+
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_bus_set_speed(rates[i]));
+        TEST_ASSERT_EQUAL(rates[i], sim_i2c_rate_hz());
+
+        sim_i2c_reset_stats();
+        TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_read(0U, buf, sizeof(buf)));
+        sim_i2c_get_stats(&stats);
+
+        /* Address write, restart and read of a page, 2 Starts, 1 Stop */
+        TEST_ASSERT_EQUAL(1u + EEPROM_ADDR_SIZE + 1u + EEPROM_PAGE_SIZE, stats.bytes);
+        expectNs = ((9ULL * stats.bytes) + stats.starts + stats.stops) * (1000000000ULL / rates[i]);
+        TEST_ASSERT(stats.busyNs >= expectNs);
+        TEST_ASSERT(stats.busyNs <= (expectNs + (expectNs / 20ULL)));
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestRoundTrip
+********************************************************************************
+* Summary:
+*  Data written through the driver is in the model memory and reads back.
+*
+*******************************************************************************/
+static void TestRoundTrip(void)
+{
+    static uint8_t src[EEPROM_SIZE / 8u];
+    static uint8_t dst[EEPROM_SIZE / 8u];
+    const eeprom_addr_t addr = (eeprom_addr_t)(EEPROM_PAGE_SIZE + 3u);
+
+    test_fill(src, sizeof(src), 1UL);
+    sim_eeprom_set_write_cycle(1000UL, 5000UL);
+
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_write(addr, src, sizeof(src)));
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    TEST_ASSERT(memcmp(&sim_eeprom_mem(EEPROM_SLAVE_ADDR)[addr], src, sizeof(src)) == 0);
+
+    TEST_ASSERT_EQUAL(I2C_SUCCESS, eeprom_read(addr, dst, sizeof(dst)));
+    TEST_ASSERT(memcmp(src, dst, sizeof(src)) == 0);
+    sim_eeprom_set_write_cycle(SIM_EEPROM_WRITE_CYCLE_US, SIM_EEPROM_WRITE_CYCLE_US);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestPageWrap();
+    TestBusyNak();
+    TestBusTime();
+    TestRoundTrip();
+
+    printf("test_sim: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
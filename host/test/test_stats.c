@@ -0,0 +1,222 @@
+/******************************************************************************
+* File Name:  test_stats.c
+*
+* Description:  Host tests of the transfer statistics: SysTick clock
+*               durations, histogram buckets and error counters.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_stats.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#if !EEPROM_STATS_ENABLE
+#error "test_stats needs EEPROM_STATS_ENABLE, see DEFINES_test_stats"
+#endif
+
+#define TEST_TIMEOUT_MS         (10UL)
+
+/*******************************************************************************
+* Function Name: HistogramSum
+********************************************************************************
+* Summary:
+*  Returns the number of entries in the histogram of an operation type.
+*
+*******************************************************************************/
+static uint32_t HistogramSum(const eeprom_stats_op_t *op)
+{
+    uint32_t sum = 0UL;
+
+    for (uint32_t i = 0UL; i < EEPROM_STATS_BUCKETS; i++)
+    {
+        sum += op->histogram[i];
+    }
+    return sum;
+}
+
+/*******************************************************************************
+* Function Name: BucketOf
+********************************************************************************
+* Summary:
+*  Returns the histogram bucket of a duration in microseconds.
+*
+*******************************************************************************/
+static uint32_t BucketOf(uint32_t us)
+{
+    uint32_t bucket = 0UL;
+
+    while ((us >= (1UL << (EEPROM_STATS_BUCKET_SHIFT + bucket))) && (bucket < (EEPROM_STATS_BUCKETS - 1UL)))
+    {
+        bucket++;
+    }
+    return bucket;
+}
+
+/*******************************************************************************
+* Function Name: TestTicks
+********************************************************************************
+* Summary:
+*  A duration in SysTick clocks converts to the same microseconds as the
+*  difference of two eeprom_time_us() values.
+*
+*******************************************************************************/
+static void TestTicks(void)
+{
+    static const uint32_t spans[] = { 1UL, 127UL, 999UL, 1000UL, 12345UL, 987654UL };
+
+    for (uint32_t i = 0UL; i < (sizeof(spans) / sizeof(spans[0])); i++)
+    {
+        uint32_t startUs = eeprom_time_us();
+        uint32_t startTicks = eeprom_time_ticks();
+        uint32_t us;
+
+        sim_run_us(spans[i]);
+        us = eeprom_time_ticks_to_us(eeprom_time_ticks() - startTicks);
+        TEST_ASSERT((us + 1UL) >= (eeprom_time_us() - startUs));
+        TEST_ASSERT(us <= (eeprom_time_us() - startUs + 1UL));
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestTransfers
+********************************************************************************
+* Summary:
+*  A read and a page write are counted once each, with their bus time, in the
+*  histogram bucket of their duration, and the write cycle that follows is
+*  counted as acknowledge polling.
+*
+*******************************************************************************/
+static void TestTransfers(void)
+{
+    uint8_t page[EEPROM_PAGE_SIZE];
+    uint8_t dst[16];
+    eeprom_stats_t stats;
+    uint64_t startUs;
+    uint32_t readUs;
+
+    test_fill(page, sizeof(page), 3UL);
+    eeprom_stats_reset();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write(0u, page, sizeof(page)));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(TEST_TIMEOUT_MS));
+    startUs = sim_time_us();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read(0u, dst, sizeof(dst)));
+    readUs = (uint32_t)(sim_time_us() - startUs);
+    eeprom_stats_get(&stats);
+
+    /* A page write at 400 kHz: nine clocks of 2.5 us for each byte, 1.5 ms
+     * for the 64-byte page of the 24LC128 */
+    TEST_ASSERT_EQUAL(1u, stats.op[EEPROM_STATS_OP_WRITE].count);
+    TEST_ASSERT_EQUAL(1u, stats.op[EEPROM_STATS_OP_WRITE].histogram[
+                          BucketOf((9UL * (1UL + EEPROM_ADDR_SIZE + EEPROM_PAGE_SIZE) * 5UL) / 2UL)]);
+    TEST_ASSERT(stats.op[EEPROM_STATS_OP_WRITE].maxUs == stats.op[EEPROM_STATS_OP_WRITE].totalUs);
+
+    TEST_ASSERT_EQUAL(1u, stats.op[EEPROM_STATS_OP_WAIT_READY].count);
+    TEST_ASSERT(stats.op[EEPROM_STATS_OP_WAIT_READY].totalUs >= SIM_EEPROM_WRITE_CYCLE_US);
+    TEST_ASSERT(stats.ackPolls > 0u);
+
+    /* The address phase and the data phase of the random read */
+    TEST_ASSERT_EQUAL(1u, stats.op[EEPROM_STATS_OP_ADDRESS].count);
+    TEST_ASSERT_EQUAL(1u, stats.op[EEPROM_STATS_OP_READ].count);
+    TEST_ASSERT((stats.op[EEPROM_STATS_OP_ADDRESS].totalUs + stats.op[EEPROM_STATS_OP_READ].totalUs) <= readUs);
+
+    for (uint32_t i = 0UL; i < EEPROM_STATS_OP_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(stats.op[i].count, HistogramSum(&stats.op[i]));
+    }
+    for (uint32_t i = 0UL; i < EEPROM_STATS_ERR_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(0u, stats.errors[i]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestErrors
+********************************************************************************
+* Summary:
+*  Errors of the interrupt-driven and of the low-level transfers are counted,
+*  including a Start that another master aborted.
+*
+*******************************************************************************/
+static void TestErrors(void)
+{
+    uint8_t dst[4];
+    eeprom_stats_t stats;
+
+    eeprom_stats_reset();
+
+    /* No device answers */
+    sim_eeprom_detach(EEPROM_SLAVE_ADDR);
+    TEST_ASSERT(eeprom_read(0u, dst, sizeof(dst)) != TRANSFER_CMPLT);
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+    eeprom_stats_get(&stats);
+    TEST_ASSERT(stats.errors[EEPROM_STATS_ERR_ADDR_NAK] > 0u);
+
+    eeprom_stats_manual_error(CY_SCB_I2C_MASTER_MANUAL_ABORT_START);
+    eeprom_stats_manual_error(CY_SCB_I2C_MASTER_MANUAL_ARB_LOST);
+    eeprom_stats_get(&stats);
+    TEST_ASSERT_EQUAL(1u, stats.errors[EEPROM_STATS_ERR_ABORT_START]);
+    TEST_ASSERT_EQUAL(1u, stats.errors[EEPROM_STATS_ERR_ARB_LOST]);
+
+    eeprom_stats_reset();
+    eeprom_stats_get(&stats);
+    TEST_ASSERT_EQUAL(0u, stats.errors[EEPROM_STATS_ERR_ADDR_NAK]);
+    TEST_ASSERT_EQUAL(0u, stats.op[EEPROM_STATS_OP_READ].count);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_bus_set_speed(400000UL));
+
+    TestTicks();
+    TestTransfers();
+    TestErrors();
+
+    printf("test_stats: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
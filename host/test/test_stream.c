@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name:  test_stream.c
+*
+* Description:  Streaming read transactions and consumer chunking.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+
+/* Header file includes */
+#include "test.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* What the consumer has seen */
+static uint32_t streamAddr;
+static uint32_t streamDone;
+static uint32_t streamCalls;
+static uint32_t streamShortCalls;
+static uint32_t streamLastLen;
+static bool streamMatch;
+
+/*******************************************************************************
+* Function Name: StreamCheck
+********************************************************************************
+* Summary:
+*  Stream consumer, compares each chunk with the simulated array and counts
+*  the calls and the chunks shorter than EEPROM_STREAM_CHUNK_SIZE.
+*
+*******************************************************************************/
+static void StreamCheck(const uint8_t *data, uint32_t len)
+{
+    TEST_ASSERT((len > 0UL) && (len <= EEPROM_STREAM_CHUNK_SIZE));
+    if (memcmp(data, &sim_eeprom_mem(EEPROM_SLAVE_ADDR)[streamAddr + streamDone], len) != 0)
+    {
+        streamMatch = false;
+    }
+    if (len < EEPROM_STREAM_CHUNK_SIZE)
+    {
+        streamShortCalls++;
+    }
+    streamDone += len;
+    streamLastLen = len;
+    streamCalls++;
+}
+
+/*******************************************************************************
+* Function Name: TestSpan
+********************************************************************************
+* Summary:
+*  Streams len bytes from addr. Each block the span touches is one bus
+*  transaction: a Start, the memory address, a repeated Start, the data and
+*  one Stop. The consumer gets full chunks and one short tail per block where
+*  the block part is not a multiple of the chunk size.
+*
+*******************************************************************************/
+static void TestSpan(uint32_t addr, uint32_t len)
+{
+    uint32_t blocks = 0UL;
+    uint32_t calls = 0UL;
+    uint32_t shortCalls = 0UL;
+    uint32_t lastLen = 0UL;
+    sim_i2c_stats_t bus;
+
+    for (uint32_t pos = addr; pos < (addr + len); )
+    {
+        uint32_t span = EEPROM_BLOCK_SIZE - (pos % EEPROM_BLOCK_SIZE);
+
+        span = (span > ((addr + len) - pos)) ? ((addr + len) - pos) : span;
+        blocks++;
+        calls += (span + EEPROM_STREAM_CHUNK_SIZE - 1UL) / EEPROM_STREAM_CHUNK_SIZE;
+        shortCalls += ((span % EEPROM_STREAM_CHUNK_SIZE) != 0UL) ? 1UL : 0UL;
+        lastLen = ((span % EEPROM_STREAM_CHUNK_SIZE) != 0UL) ? (span % EEPROM_STREAM_CHUNK_SIZE) :
+                  EEPROM_STREAM_CHUNK_SIZE;
+        pos += span;
+    }
+
+    streamAddr = addr;
+    streamDone = 0UL;
+    streamCalls = 0UL;
+    streamShortCalls = 0UL;
+    streamMatch = true;
+    sim_i2c_reset_stats();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_read_stream((eeprom_addr_t)addr, len, &StreamCheck));
+
+    sim_i2c_get_stats(&bus);
+    TEST_ASSERT_EQUAL(len, streamDone);
+    TEST_ASSERT(streamMatch);
+    TEST_ASSERT_EQUAL(calls, streamCalls);
+    TEST_ASSERT_EQUAL(shortCalls, streamShortCalls);
+    TEST_ASSERT_EQUAL(lastLen, streamLastLen);
+    TEST_ASSERT_EQUAL(blocks, bus.stops);
+    TEST_ASSERT_EQUAL(2UL * blocks, bus.starts);
+    TEST_ASSERT_EQUAL(len + (blocks * (EEPROM_ADDR_SIZE + 2UL)), bus.bytes);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    test_fill(sim_eeprom_mem(EEPROM_SLAVE_ADDR), EEPROM_SIZE, 9UL);
+
+    /* Built with a chunk size that does not divide the array, see
+     * DEFINES_test_stream */
+    TestSpan(0UL, EEPROM_SIZE);
+    TestSpan(5UL, EEPROM_SIZE - 5UL);
+    TestSpan(EEPROM_PAGE_SIZE - 1UL, EEPROM_STREAM_CHUNK_SIZE + 2UL);
+    TestSpan(EEPROM_SIZE - 1UL, 1UL);
+
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read_stream(0U, 1UL, NULL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read_stream(0U, 0UL, &StreamCheck));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_read_stream((eeprom_addr_t)(EEPROM_SIZE - 1UL), 2UL,
+                                                              &StreamCheck));
+
+    printf("test_stream: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,168 @@
+/******************************************************************************
+* File Name:  test_stripe.c
+*
+* Description:  Host tests of striping over several EEPROMs: page layout,
+*               read-back and overlapped write cycles.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_bus.h"
+#include "eeprom_stripe.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_DEVICES            (4u)
+
+/* Pages of the timing comparison, at most the array of one device */
+#define TEST_PAGES              (TEST_SPAN(64UL * EEPROM_PAGE_SIZE) / EEPROM_PAGE_SIZE)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+extern cy_stc_scb_i2c_context_t CYBSP_I2C_context;
+
+static eeprom_dev_t devices[TEST_DEVICES];
+
+static uint8_t image[TEST_DEVICES * EEPROM_SIZE];
+static uint8_t readBack[TEST_DEVICES * EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: CheckLayout
+********************************************************************************
+* Summary:
+*  Checks that page n of the striped space is page n / count of device
+*  n % count, for the span written from image.
+*
+*******************************************************************************/
+static void CheckLayout(uint32_t count, uint32_t addr, uint32_t len)
+{
+    for (uint32_t a = addr; a < (addr + len); a++)
+    {
+        uint32_t page = a / EEPROM_PAGE_SIZE;
+        const uint8_t *mem = sim_eeprom_mem(devices[page % count].slaveAddr);
+
+        TEST_ASSERT_EQUAL(image[a], mem[((page / count) * EEPROM_PAGE_SIZE) + (a % EEPROM_PAGE_SIZE)]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: WriteTime
+********************************************************************************
+* Summary:
+*  Returns the time in microseconds to program the first pages pages of the
+*  striped space and wait for the last write cycle.
+*
+*******************************************************************************/
+static uint64_t WriteTime(uint32_t pages)
+{
+    uint64_t startUs = sim_time_us();
+
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_write(0UL, image, pages * EEPROM_PAGE_SIZE));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_wait_ready());
+    return (sim_time_us() - startUs);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    uint64_t singleUs;
+    uint64_t stripedUs;
+
+    test_init();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_bus_set_speed(400000UL));
+    for (uint32_t i = 0UL; i < TEST_DEVICES; i++)
+    {
+        devices[i].base      = CYBSP_I2C_HW;
+        devices[i].context   = &CYBSP_I2C_context;
+        devices[i].slaveAddr = (uint8_t)(0x50u + i);
+        if (devices[i].slaveAddr != EEPROM_SLAVE_ADDR)
+        {
+            sim_eeprom_attach(devices[i].slaveAddr);
+        }
+    }
+    test_fill(image, sizeof(image), 15UL);
+
+    /* Parameters */
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_stripe_init(NULL, 1UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_stripe_init(devices, 0UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_stripe_init(devices, EEPROM_STRIPE_MAX_DEVICES + 1UL));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_init(devices, TEST_DEVICES));
+    TEST_ASSERT_EQUAL(TEST_DEVICES * EEPROM_SIZE, eeprom_stripe_size());
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_stripe_write(eeprom_stripe_size() - 1UL, image, 2UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_stripe_read(0UL, NULL, 1UL));
+
+    /* The whole striped space, then unaligned spans over device boundaries */
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_write(0UL, image, sizeof(image)));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_wait_ready());
+    CheckLayout(TEST_DEVICES, 0UL, sizeof(image));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_read(0UL, readBack, sizeof(readBack)));
+    TEST_ASSERT(memcmp(image, readBack, sizeof(image)) == 0);
+
+    test_fill(image, sizeof(image), 16UL);
+    for (uint32_t i = 0UL; i < 50UL; i++)
+    {
+        uint32_t len = 1UL + (uint32_t)(sim_random() % (3UL * EEPROM_PAGE_SIZE));
+        uint32_t addr = (uint32_t)(sim_random() % (sizeof(image) - len + 1UL));
+
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_write(addr, &image[addr], len));
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_wait_ready());
+        CheckLayout(TEST_DEVICES, addr, len);
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_read(addr, readBack, len));
+        TEST_ASSERT(memcmp(&image[addr], readBack, len) == 0);
+    }
+
+    /* The write cycles of the devices overlap: on four devices, at least half
+     * of the write cycle of each page is hidden behind the bus transfers */
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_init(devices, 1UL));
+    singleUs = WriteTime(TEST_PAGES);
+    CheckLayout(1UL, 0UL, TEST_PAGES * EEPROM_PAGE_SIZE);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_stripe_init(devices, TEST_DEVICES));
+    stripedUs = WriteTime(TEST_PAGES);
+    CheckLayout(TEST_DEVICES, 0UL, TEST_PAGES * EEPROM_PAGE_SIZE);
+    TEST_ASSERT((stripedUs + ((TEST_PAGES * SIM_EEPROM_WRITE_CYCLE_US) / 2ULL)) < singleUs);
+
+    printf("test_stripe: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
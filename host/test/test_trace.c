@@ -0,0 +1,205 @@
+/******************************************************************************
+* File Name:  test_trace.c
+*
+* Description:  Host tests of the interrupt-driven UART trace.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include "eeprom_trace.h"
+#include "eeprom_bench.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* UART output kept for the checks */
+#define TEST_OUT_SIZE           (8192UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_scb_uart_context_t uartContext;
+static char out[TEST_OUT_SIZE];
+static uint32_t outLen = 0UL;
+
+/*******************************************************************************
+* Function Name: Capture
+********************************************************************************
+* Summary:
+*  Keeps the bytes the UART sends.
+*
+*******************************************************************************/
+static void Capture(uint8_t data, uint64_t timeUs)
+{
+    (void)timeUs;
+    TEST_ASSERT(outLen < (TEST_OUT_SIZE - 1UL));
+    out[outLen++] = (char)data;
+    out[outLen] = '\0';
+}
+
+/*******************************************************************************
+* Function Name: TestFormat
+********************************************************************************
+* Summary:
+*  A message is queued without waiting for the UART, and the interrupt sends
+*  its text and argument in order.
+*
+*******************************************************************************/
+static void TestFormat(void)
+{
+    uint64_t startNs;
+
+    outLen = 0UL;
+    startNs = sim_time_ns();
+    eeprom_trace(EEPROM_TRACE_MSG_WRITE_FAIL, ADDR_NAK_ERROR);
+    eeprom_trace(EEPROM_TRACE_MSG_READ_OK, 0UL);
+    eeprom_trace(EEPROM_TRACE_MSG_COUNT + 1u, 0UL);
+    TEST_ASSERT((sim_time_ns() - startNs) < 1000ULL);
+
+    sim_run_us(20000ULL);
+    TEST_ASSERT(strcmp(out, "\r\n\n Writing to EEPROM failed, status 0x000000F2\r\n"
+                            "\r\n\n Read back successful \r\n"
+                            "Trace message 16\r\n") == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestBenchRow
+********************************************************************************
+* Summary:
+*  A benchmark table row is built from a name message, one message per
+*  column, and a line end, with the columns lined up under the header.
+*
+*******************************************************************************/
+static void TestBenchRow(void)
+{
+    TEST_ASSERT_EQUAL(EEPROM_TRACE_DEPTH - 1UL, eeprom_trace_space());
+
+    outLen = 0UL;
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_HEADER, 0UL);
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_NAME, EEPROM_BENCH_STREAM_READ);
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, 44059UL);
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, 0UL);
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, 4294967295UL);
+    eeprom_trace(EEPROM_TRACE_MSG_LINE_END, 0UL);
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_NAME, EEPROM_BENCH_COUNT);
+    eeprom_trace(EEPROM_TRACE_MSG_LINE_END, 0UL);
+    TEST_ASSERT_EQUAL(EEPROM_TRACE_DEPTH - 9UL, eeprom_trace_space());
+
+    sim_run_us(20000ULL);
+    TEST_ASSERT_EQUAL(EEPROM_TRACE_DEPTH - 1UL, eeprom_trace_space());
+    TEST_ASSERT(strcmp(out, "\r\nworkload       bytes/s  EEPROM B     xfers    min us    max us"
+                            "  total us    bus us act us/KB    isr/KB\r\n"
+                            "stream read      44059         0 4294967295\r\n"
+                            "?           \r\n") == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestDrop
+********************************************************************************
+* Summary:
+*  Messages that find the ring full are counted, and the count is sent once
+*  the ring has drained.
+*
+*******************************************************************************/
+static void TestDrop(void)
+{
+    const uint32_t extra = 5UL;
+    uint32_t intState;
+    uint32_t lines = 0UL;
+
+    outLen = 0UL;
+    intState = Cy_SysLib_EnterCriticalSection();
+    for (uint32_t i = 0UL; i < (EEPROM_TRACE_DEPTH - 1UL + extra); i++)
+    {
+        eeprom_trace(EEPROM_TRACE_MSG_LOOP, 0UL);
+    }
+    TEST_ASSERT_EQUAL(extra, eeprom_trace_dropped());
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    sim_run_us(100000ULL);
+    for (const char *p = strstr(out, "Entered for loop"); p != NULL; p = strstr(p + 1, "Entered for loop"))
+    {
+        lines++;
+    }
+    TEST_ASSERT_EQUAL(EEPROM_TRACE_DEPTH - 1UL, lines);
+    TEST_ASSERT(strstr(out, "Entered for loop\r\n\r\nTrace messages dropped: 5\r\n") != NULL);
+}
+
+/*******************************************************************************
+* Function Name: TestFlush
+********************************************************************************
+* Summary:
+*  A flush sends everything queued even with interrupts masked, as ahead of
+*  an assert.
+*
+*******************************************************************************/
+static void TestFlush(void)
+{
+    uint32_t intState;
+
+    outLen = 0UL;
+    intState = Cy_SysLib_EnterCriticalSection();
+    eeprom_trace(EEPROM_TRACE_MSG_INIT_FAIL, 0xF1UL);
+    eeprom_trace_flush();
+    TEST_ASSERT(Cy_SCB_UART_IsTxComplete(CYBSP_UART_HW));
+    Cy_SysLib_ExitCriticalSection(intState);
+    TEST_ASSERT(strcmp(out, "\r\nFAIL: API initI2CMaster failed with error code 0x000000F1\r\n") == 0);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+    (void)Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &uartContext);
+    Cy_SCB_UART_Enable(CYBSP_UART_HW);
+    TEST_ASSERT(eeprom_trace_init() == CY_SYSINT_SUCCESS);
+    sim_uart_set_tx_hook(&Capture);
+
+    TestFormat();
+    TestBenchRow();
+    TestDrop();
+    TestFlush();
+
+    printf("test_trace: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
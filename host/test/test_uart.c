@@ -0,0 +1,230 @@
+/******************************************************************************
+* File Name:  test_uart.c
+*
+* Description:  Host tests of the UART program and dump protocol against the
+*               simulated device.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "uart_host.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_BAUD               (115200UL)
+
+/* Write cycle of the test, the 24LC128 worst case */
+#define TEST_WRITE_CYCLE_US     (5000UL)
+
+/* Bytes of a WRITE frame on the line, and bits of a byte */
+#define TEST_WRITE_FRAME_SIZE   (1UL + EEPROM_UART_HEADER_SIZE + EEPROM_UART_CHUNK_SIZE + EEPROM_CRC32_SIZE)
+#define TEST_BITS_PER_BYTE      (10ULL)
+
+/* Bus time of a page write at 400 kHz, nine clocks of 2.5 us per byte */
+#define TEST_PAGE_BUS_US        (((2UL + EEPROM_ADDR_SIZE + EEPROM_PAGE_SIZE) * 9UL * 5UL) / 2UL)
+
+/* Longest READ of the tests, within the 16-bit length field of a request */
+#define TEST_READ_MAX           (TEST_SPAN(0x8000UL))
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t image[EEPROM_SIZE];
+static uint8_t readBack[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: TestInfo
+********************************************************************************
+* Summary:
+*  INFO returns the EEPROM size, the page size and the chunk size.
+*
+*******************************************************************************/
+static void TestInfo(void)
+{
+    uart_host_request(EEPROM_UART_CMD_INFO, 0UL, 0UL, NULL, 1UL);
+    TEST_ASSERT_EQUAL(EEPROM_UART_CMD_INFO, uartHost.cmd);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, uartHost.status);
+    TEST_ASSERT_EQUAL(8u, uartHost.len);
+    TEST_ASSERT_EQUAL(EEPROM_SIZE, (uint32_t)uartHost.data[0] | ((uint32_t)uartHost.data[1] << 8u) |
+                                   ((uint32_t)uartHost.data[2] << 16u));
+    TEST_ASSERT_EQUAL(EEPROM_PAGE_SIZE, (uint32_t)uartHost.data[4] | ((uint32_t)uartHost.data[5] << 8u));
+    TEST_ASSERT_EQUAL(EEPROM_UART_CHUNK_SIZE, (uint32_t)uartHost.data[6] | ((uint32_t)uartHost.data[7] << 8u));
+}
+
+/*******************************************************************************
+* Function Name: TestProgram
+********************************************************************************
+* Summary:
+*  A full image is written, and takes about the time of the slower side
+*  alone: each page is received while the one before it is in its write
+*  cycle. The UART is slower for large pages, the write cycles for the
+*  8-byte pages of the 24LC02.
+*
+*******************************************************************************/
+static void TestProgram(void)
+{
+    const uint32_t frames = EEPROM_SIZE / EEPROM_UART_CHUNK_SIZE;
+    const uint64_t uartUs = (frames * TEST_WRITE_FRAME_SIZE * TEST_BITS_PER_BYTE * 1000000ULL) / TEST_BAUD;
+    const uint64_t writeUs = frames * (TEST_WRITE_CYCLE_US + TEST_PAGE_BUS_US);
+    uint64_t programUs;
+
+    test_fill(image, sizeof(image), 9UL);
+    sim_eeprom_set_write_cycle(TEST_WRITE_CYCLE_US, TEST_WRITE_CYCLE_US);
+
+    programUs = uart_host_program(0UL, image, sizeof(image));
+    TEST_ASSERT_EQUAL(0u, uartHost.errors);
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), image, sizeof(image)) == 0);
+
+    TEST_ASSERT(programUs < ((((uartUs > writeUs) ? uartUs : writeUs) * 105ULL) / 100ULL));
+
+    /* An unaligned image in the middle */
+    test_fill(image, 3UL * EEPROM_PAGE_SIZE, 10UL);
+    (void)uart_host_program(EEPROM_PAGE_SIZE + 7UL, image, 3UL * EEPROM_PAGE_SIZE);
+    TEST_ASSERT_EQUAL(0u, uartHost.errors);
+    TEST_ASSERT(memcmp(&sim_eeprom_mem(EEPROM_SLAVE_ADDR)[EEPROM_PAGE_SIZE + 7UL], image,
+                       3UL * EEPROM_PAGE_SIZE) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestReadVerify
+********************************************************************************
+* Summary:
+*  READ returns a range chunk by chunk, and VERIFY its CRC-32. The whole
+*  array takes more than one READ on devices larger than 32 KB.
+*
+*******************************************************************************/
+static void TestReadVerify(void)
+{
+    const uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    const uint32_t verifyLen = (EEPROM_SIZE < 0x10000UL) ? (EEPROM_SIZE - 9UL) : 0xFFFFUL;
+    uint32_t crc;
+
+    (void)memset(readBack, 0, sizeof(readBack));
+    uartHost.readBuf = readBack;
+    for (uint32_t addr = 0UL; addr < EEPROM_SIZE; addr += TEST_READ_MAX)
+    {
+        uart_host_request(EEPROM_UART_CMD_READ, addr, TEST_READ_MAX, NULL, TEST_READ_MAX / EEPROM_UART_CHUNK_SIZE);
+    }
+    uartHost.readBuf = NULL;
+    TEST_ASSERT_EQUAL(0u, uartHost.errors);
+    TEST_ASSERT(memcmp(readBack, mem, EEPROM_SIZE) == 0);
+
+    crc = eeprom_crc32_update(EEPROM_CRC32_INIT, &mem[5], verifyLen) ^ EEPROM_CRC32_INIT;
+    uart_host_request(EEPROM_UART_CMD_VERIFY, 5UL, verifyLen, NULL, 1UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, uartHost.status);
+    TEST_ASSERT_EQUAL(4u, uartHost.len);
+    TEST_ASSERT_EQUAL(crc, (uint32_t)uartHost.data[0] | ((uint32_t)uartHost.data[1] << 8u) |
+                           ((uint32_t)uartHost.data[2] << 16u) | ((uint32_t)uartHost.data[3] << 24u));
+}
+
+/*******************************************************************************
+* Function Name: TestErase
+********************************************************************************
+* Summary:
+*  ERASE fills a range with 0xFF and leaves the bytes around it.
+*
+*******************************************************************************/
+static void TestErase(void)
+{
+    const uint32_t addr = 100UL;
+    const uint32_t len = TEST_SPAN(addr + 300UL + 1UL) - addr - 1UL;
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    uint8_t before = mem[addr - 1UL];
+    uint8_t after = mem[addr + len];
+
+    TEST_ASSERT((before != 0xFFu) && (after != 0xFFu));
+    uart_host_request(EEPROM_UART_CMD_ERASE, addr, len, NULL, 1UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, uartHost.status);
+    for (uint32_t i = 0UL; i < len; i++)
+    {
+        TEST_ASSERT_EQUAL(0xFFu, mem[addr + i]);
+    }
+    TEST_ASSERT_EQUAL(before, mem[addr - 1UL]);
+    TEST_ASSERT_EQUAL(after, mem[addr + len]);
+}
+
+/*******************************************************************************
+* Function Name: TestErrors
+********************************************************************************
+* Summary:
+*  A frame with a bad CRC and a range outside the EEPROM are rejected, and
+*  the protocol goes on.
+*
+*******************************************************************************/
+static void TestErrors(void)
+{
+    eeprom_uart_stats_t stats;
+    uint8_t data[4] = { 1u, 2u, 3u, 4u };
+    uint32_t expected = uartHost.responses + 1UL;
+
+    uart_host_send(EEPROM_UART_CMD_WRITE, 0UL, sizeof(data), data, true);
+    uart_host_wait(expected);
+    TEST_ASSERT_EQUAL(EEPROM_UART_CMD_WRITE, uartHost.cmd);
+    TEST_ASSERT_EQUAL(INVALID_DATA_ERROR, uartHost.status);
+    TEST_ASSERT(memcmp(sim_eeprom_mem(EEPROM_SLAVE_ADDR), data, sizeof(data)) != 0);
+
+    uart_host_request(EEPROM_UART_CMD_READ, EEPROM_SIZE - 1UL, 2UL, NULL, 1UL);
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, uartHost.status);
+
+    uart_host_request(EEPROM_UART_CMD_INFO, 0UL, 0UL, NULL, 1UL);
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, uartHost.status);
+    TEST_ASSERT_EQUAL(0u, uartHost.badFrames);
+
+    eeprom_uart_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1u, stats.badFrames);
+    TEST_ASSERT_EQUAL(0u, stats.overruns);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    uart_host_init(TEST_BAUD);
+
+    TestInfo();
+    TestProgram();
+    TestReadVerify();
+    TestErase();
+    TestErrors();
+
+    printf("test_uart: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,163 @@
+/******************************************************************************
+* File Name:  test_write.c
+*
+* Description:  Host tests of eeprom_write(): page splitting of any span in
+*               the fewest write cycles, and invalid spans.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "test.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint8_t image[EEPROM_SIZE];
+static uint8_t expect[EEPROM_SIZE];
+
+/*******************************************************************************
+* Function Name: PagesTouched
+********************************************************************************
+* Summary:
+*  Returns the number of pages a span covers, the least number of write
+*  cycles that can program it.
+*
+*******************************************************************************/
+static uint32_t PagesTouched(uint32_t addr, uint32_t len)
+{
+    return ((addr + len - 1UL) / EEPROM_PAGE_SIZE) - (addr / EEPROM_PAGE_SIZE) + 1UL;
+}
+
+/*******************************************************************************
+* Function Name: CheckWrite
+********************************************************************************
+* Summary:
+*  Writes a span and checks that exactly the span changed, in the least
+*  number of write cycles and without a page wrap.
+*
+*******************************************************************************/
+static void CheckWrite(uint32_t addr, uint32_t len, uint32_t seed)
+{
+    uint8_t *mem = sim_eeprom_mem(EEPROM_SLAVE_ADDR);
+    sim_eeprom_stats_t stats;
+
+    test_fill(image, len, seed);
+    (void)memcpy(expect, mem, EEPROM_SIZE);
+    (void)memcpy(&expect[addr], image, len);
+
+    sim_eeprom_reset_stats();
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_write((eeprom_addr_t)addr, image, len));
+    TEST_ASSERT_EQUAL(TRANSFER_CMPLT, eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS));
+    sim_eeprom_get_stats(&stats);
+
+    TEST_ASSERT(memcmp(expect, mem, EEPROM_SIZE) == 0);
+    TEST_ASSERT_EQUAL(PagesTouched(addr, len), stats.writeCycles);
+    TEST_ASSERT_EQUAL(len, stats.bytesWritten);
+    TEST_ASSERT_EQUAL(0u, stats.pageWraps);
+}
+
+/*******************************************************************************
+* Function Name: TestSpans
+********************************************************************************
+* Summary:
+*  Spans that start and end inside, on and across page boundaries.
+*
+*******************************************************************************/
+static void TestSpans(void)
+{
+    static const uint32_t offsets[] = { 0UL, 1UL, EEPROM_PAGE_SIZE / 2UL, EEPROM_PAGE_SIZE - 1UL };
+    static const uint32_t lengths[] = { 1UL, 2UL, EEPROM_PAGE_SIZE - 1UL, EEPROM_PAGE_SIZE,
+                                        EEPROM_PAGE_SIZE + 1UL, (3UL * EEPROM_PAGE_SIZE) + 5UL };
+    uint32_t seed = 1UL;
+
+    for (uint32_t o = 0UL; o < (sizeof(offsets) / sizeof(offsets[0])); o++)
+    {
+        for (uint32_t l = 0UL; l < (sizeof(lengths) / sizeof(lengths[0])); l++)
+        {
+            CheckWrite((5UL * EEPROM_PAGE_SIZE) + offsets[o], lengths[l], seed++);
+        }
+    }
+
+    /* Random spans, and the ends of the array */
+    for (uint32_t i = 0UL; i < 50UL; i++)
+    {
+        uint32_t len = 1UL + (uint32_t)(sim_random() % (4UL * EEPROM_PAGE_SIZE));
+        uint32_t addr = (uint32_t)(sim_random() % (EEPROM_SIZE - len + 1UL));
+
+        CheckWrite(addr, len, seed++);
+    }
+    CheckWrite(0UL, 1UL, seed++);
+    CheckWrite(EEPROM_SIZE - 1UL, 1UL, seed++);
+    CheckWrite(0UL, EEPROM_SIZE, seed++);
+}
+
+/*******************************************************************************
+* Function Name: TestInvalid
+********************************************************************************
+* Summary:
+*  Invalid spans are rejected before the bus is used.
+*
+*******************************************************************************/
+static void TestInvalid(void)
+{
+    sim_i2c_stats_t stats;
+
+    sim_i2c_reset_stats();
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write(0U, image, 0UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write(0U, NULL, 1UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write((eeprom_addr_t)(EEPROM_SIZE - 1UL), image, 2UL));
+    TEST_ASSERT_EQUAL(INVALID_PARAM_ERROR, eeprom_write(0U, image, EEPROM_SIZE + 1UL));
+    sim_i2c_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0u, stats.starts);
+}
+
+/*******************************************************************************
+* Function Name: main
+*******************************************************************************/
+int main(void)
+{
+    test_init();
+
+    TestSpans();
+    TestInvalid();
+
+    printf("test_write: OK\n");
+    return 0;
+}
+
+/* [] END OF FILE */
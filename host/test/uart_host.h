@@ -0,0 +1,332 @@
+/******************************************************************************
+* File Name:  uart_host.h
+*
+* Description:  Host side of the UART program and dump protocol, for the host
+*               tests and benchmarks.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef HOST_UART_HOST_H_
+#define HOST_UART_HOST_H_
+
+#include "test.h"
+#include "eeprom_uart.h"
+#include "eeprom_power.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* WRITE frames in flight, as WRITE_WINDOW in scripts/eeprom_uart.py */
+#define UART_HOST_WINDOW            (EEPROM_UART_RX_BUFFERS)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Host side of the protocol. READ data is stored by address into readBuf. */
+typedef struct
+{
+    uint32_t responses;     /* Response frames received */
+    uint32_t errors;        /* Responses with a status other than TRANSFER_CMPLT */
+    uint32_t badFrames;     /* Responses with a bad CRC */
+    uint8_t cmd;            /* Last response */
+    uint8_t status;
+    uint32_t addr;
+    uint32_t len;
+    uint8_t data[EEPROM_UART_CHUNK_SIZE];
+    uint8_t *readBuf;
+
+    /* Image being programmed with UART_HOST_WINDOW frames in flight */
+    const uint8_t *image;
+    uint32_t imageAddr;
+    uint32_t imageLen;
+    uint32_t sent;
+    uint32_t acked;
+    uint64_t doneUs;
+} uart_host_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uart_host_t uartHost;
+static cy_stc_scb_uart_context_t uartHostContext;
+static uint8_t uartHostRx[EEPROM_UART_FRAME_MAX];
+static uint32_t uartHostRxPos = 0UL;
+
+/*******************************************************************************
+* Function Name: uart_host_send
+********************************************************************************
+* Summary:
+*  Sends a frame to the device as soon as the line is free. A corrupt frame
+*  has a bad CRC.
+*
+*******************************************************************************/
+static inline void uart_host_send(uint8_t cmd, uint32_t addr, uint32_t len, const uint8_t *data, bool corrupt)
+{
+    uint8_t frame[EEPROM_UART_FRAME_MAX];
+    uint32_t dataLen = (cmd == EEPROM_UART_CMD_WRITE) ? len : 0UL;
+    uint32_t crc;
+
+    frame[0] = EEPROM_UART_SYNC_REQUEST;
+    frame[1] = cmd;
+    frame[2] = 0u;
+    for (uint32_t i = 0UL; i < 4UL; i++)
+    {
+        frame[3UL + i] = (uint8_t)(addr >> (8UL * i));
+    }
+    frame[7] = (uint8_t)len;
+    frame[8] = (uint8_t)(len >> 8u);
+    if ((dataLen > 0UL) && (data != NULL))
+    {
+        (void)memcpy(&frame[9], data, dataLen);
+    }
+
+    crc = eeprom_crc32_update(EEPROM_CRC32_INIT, &frame[1], EEPROM_UART_HEADER_SIZE + dataLen) ^
+          EEPROM_CRC32_INIT;
+    if (corrupt)
+    {
+        crc ^= 1UL;
+    }
+    for (uint32_t i = 0UL; i < 4UL; i++)
+    {
+        frame[9UL + dataLen + i] = (uint8_t)(crc >> (8UL * i));
+    }
+
+    sim_uart_send_at(sim_time_us(), frame, 1UL + EEPROM_UART_HEADER_SIZE + dataLen + EEPROM_CRC32_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: UartHostSendChunk
+********************************************************************************
+* Summary:
+*  Sends the next WRITE frame of the image: the first one ends at a page
+*  boundary, the others fill a page.
+*
+*******************************************************************************/
+static inline void UartHostSendChunk(void)
+{
+    uint32_t addr = uartHost.imageAddr + uartHost.sent;
+    uint32_t size = EEPROM_UART_CHUNK_SIZE - (addr % EEPROM_PAGE_SIZE);
+
+    if (size > (uartHost.imageLen - uartHost.sent))
+    {
+        size = uartHost.imageLen - uartHost.sent;
+    }
+    uart_host_send(EEPROM_UART_CMD_WRITE, addr, size, &uartHost.image[uartHost.sent], false);
+    uartHost.sent += size;
+}
+
+/*******************************************************************************
+* Function Name: UartHostResponse
+********************************************************************************
+* Summary:
+*  Handles a complete response: keeps READ data and sends the next WRITE
+*  frame of the image, at once, as the host tool does.
+*
+*******************************************************************************/
+static inline void UartHostResponse(uint64_t timeUs)
+{
+    uartHost.responses++;
+    if (uartHost.status != TRANSFER_CMPLT)
+    {
+        uartHost.errors++;
+    }
+
+    if ((uartHost.cmd == EEPROM_UART_CMD_READ) && (uartHost.readBuf != NULL))
+    {
+        (void)memcpy(&uartHost.readBuf[uartHost.addr], uartHost.data, uartHost.len);
+    }
+
+    if ((uartHost.cmd == EEPROM_UART_CMD_WRITE) && (uartHost.image != NULL))
+    {
+        TEST_ASSERT_EQUAL(TRANSFER_CMPLT, uartHost.status);
+        TEST_ASSERT_EQUAL(uartHost.imageAddr + uartHost.acked, uartHost.addr);
+        uartHost.acked += EEPROM_UART_CHUNK_SIZE - (uartHost.addr % EEPROM_PAGE_SIZE);
+        if (uartHost.acked >= uartHost.imageLen)
+        {
+            uartHost.acked = uartHost.imageLen;
+            uartHost.image = NULL;
+            uartHost.doneUs = timeUs;
+        }
+        else if (uartHost.sent < uartHost.imageLen)
+        {
+            UartHostSendChunk();
+        }
+        else
+        {
+            /* The last frames are in flight */
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: UartHostTx
+********************************************************************************
+* Summary:
+*  UART TX hook of the simulator: parses the response frames of the device.
+*
+*******************************************************************************/
+static inline void UartHostTx(uint8_t byte, uint64_t timeUs)
+{
+    uint32_t len;
+    uint32_t crc;
+
+    if ((uartHostRxPos == 0UL) && (byte != EEPROM_UART_SYNC_RESPONSE))
+    {
+        return;
+    }
+    uartHostRx[uartHostRxPos++] = byte;
+    if (uartHostRxPos < (1UL + EEPROM_UART_HEADER_SIZE))
+    {
+        return;
+    }
+
+    len = (uint32_t)uartHostRx[7] | ((uint32_t)uartHostRx[8] << 8u);
+    TEST_ASSERT(len <= EEPROM_UART_CHUNK_SIZE);
+    if (uartHostRxPos < (1UL + EEPROM_UART_HEADER_SIZE + len + EEPROM_CRC32_SIZE))
+    {
+        return;
+    }
+    uartHostRxPos = 0UL;
+
+    crc = eeprom_crc32_update(EEPROM_CRC32_INIT, &uartHostRx[1], EEPROM_UART_HEADER_SIZE + len) ^
+          EEPROM_CRC32_INIT;
+    if (((uint32_t)uartHostRx[9UL + len] | ((uint32_t)uartHostRx[10UL + len] << 8u) |
+         ((uint32_t)uartHostRx[11UL + len] << 16u) | ((uint32_t)uartHostRx[12UL + len] << 24u)) != crc)
+    {
+        uartHost.badFrames++;
+        return;
+    }
+
+    uartHost.cmd    = uartHostRx[1];
+    uartHost.status = uartHostRx[2];
+    uartHost.addr   = (uint32_t)uartHostRx[3] | ((uint32_t)uartHostRx[4] << 8u) |
+                      ((uint32_t)uartHostRx[5] << 16u) | ((uint32_t)uartHostRx[6] << 24u);
+    uartHost.len    = len;
+    (void)memcpy(uartHost.data, &uartHostRx[9], len);
+    UartHostResponse(timeUs);
+}
+
+/*******************************************************************************
+* Function Name: uart_host_init
+********************************************************************************
+* Summary:
+*  Brings up the driver and the UART protocol as main() does with
+*  UART_PROTOCOL_ENABLE, and connects the host side to the UART.
+*
+*******************************************************************************/
+static inline void uart_host_init(uint32_t baud)
+{
+    sim_uart_set_baud(baud);
+    test_init();
+    (void)Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &uartHostContext);
+    Cy_SCB_UART_Enable(CYBSP_UART_HW);
+    TEST_ASSERT(eeprom_uart_init() == CY_SYSINT_SUCCESS);
+    sim_uart_set_tx_hook(&UartHostTx);
+}
+
+/*******************************************************************************
+* Function Name: uart_host_wait
+********************************************************************************
+* Summary:
+*  Runs the main loop of the device until responses responses have arrived
+*  in all, or the image has been programmed.
+*
+*******************************************************************************/
+static inline void uart_host_wait(uint32_t responses)
+{
+    uint64_t startUs = sim_time_us();
+    uint32_t intState;
+
+    while ((uartHost.responses < responses) || (uartHost.image != NULL))
+    {
+        TEST_ASSERT((sim_time_us() - startUs) < 60000000ULL);
+
+        eeprom_uart_poll();
+
+        intState = Cy_SysLib_EnterCriticalSection();
+        if (!eeprom_uart_pending())
+        {
+            eeprom_power_sleep();
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_host_request
+********************************************************************************
+* Summary:
+*  Sends a command and waits for its responses.
+*
+*******************************************************************************/
+static inline void uart_host_request(uint8_t cmd, uint32_t addr, uint32_t len, const uint8_t *data,
+                                     uint32_t responses)
+{
+    uint32_t expected = uartHost.responses + responses;
+
+    uart_host_send(cmd, addr, len, data, false);
+    uart_host_wait(expected);
+}
+
+/*******************************************************************************
+* Function Name: uart_host_program
+********************************************************************************
+* Summary:
+*  Writes an image with UART_HOST_WINDOW frames in flight and returns the
+*  time from the first frame to the last response.
+*
+*******************************************************************************/
+static inline uint64_t uart_host_program(uint32_t addr, const uint8_t *image, uint32_t len)
+{
+    uint64_t startUs = sim_time_us();
+
+    uartHost.image     = image;
+    uartHost.imageAddr = addr;
+    uartHost.imageLen  = len;
+    uartHost.sent      = 0UL;
+    uartHost.acked     = 0UL;
+    for (uint32_t i = 0UL; (i < UART_HOST_WINDOW) && (uartHost.sent < len); i++)
+    {
+        UartHostSendChunk();
+    }
+
+    uart_host_wait(0UL);
+    return uartHost.doneUs - startUs;
+}
+
+#endif /* HOST_UART_HOST_H_ */
@@ -0,0 +1,194 @@
+/******************************************************************************
+* File Name:  uart_pty.c
+*
+* Description:  Runs the application with the UART protocol against the
+*               simulated EEPROM, with the kit UART on a pseudo terminal.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes, posix_openpt() and ptsname() need _GNU_SOURCE */
+#define _GNU_SOURCE
+#include "test.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* main.c is built with its main() renamed */
+#undef main
+int app_main(void);
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define PTY_DEFAULT_BAUD        (115200UL)
+
+/* Bytes read from the pseudo terminal at a time */
+#define PTY_READ_SIZE           (256u)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static int ptyMaster = -1;
+static uint64_t wallStartUs = 0ULL;
+static uint64_t simStartUs = 0ULL;
+
+/*******************************************************************************
+* Function Name: WallUs
+********************************************************************************
+* Summary:
+*  Returns the monotonic wall time.
+*
+*******************************************************************************/
+static uint64_t WallUs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+/*******************************************************************************
+* Function Name: PtyTx
+********************************************************************************
+* Summary:
+*  UART TX hook of the simulator: passes each byte sent by the device to the
+*  host tool.
+*
+*******************************************************************************/
+static void PtyTx(uint8_t byte, uint64_t timeUs)
+{
+    (void)timeUs;
+    while ((write(ptyMaster, &byte, 1u) < 0) && (errno == EINTR))
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: PtyPace
+********************************************************************************
+* Summary:
+*  Runs whenever the application sleeps. Holds the simulated time back to
+*  the wall time, waiting for the host meanwhile, and puts the bytes of the
+*  host on the UART RX line.
+*
+*******************************************************************************/
+static void PtyPace(void)
+{
+    uint8_t buf[PTY_READ_SIZE];
+    struct pollfd pfd = { .fd = ptyMaster, .events = POLLIN };
+    uint64_t simUs = sim_time_us() - simStartUs;
+    uint64_t wallUs = WallUs() - wallStartUs;
+    int timeoutMs = 0;
+    ssize_t len;
+
+    if (simUs > wallUs)
+    {
+        timeoutMs = (int)(((simUs - wallUs) + 999ULL) / 1000ULL);
+    }
+
+    if (poll(&pfd, 1u, timeoutMs) > 0)
+    {
+        len = read(ptyMaster, buf, sizeof(buf));
+        if (len > 0)
+        {
+            sim_uart_send_at(sim_time_us(), buf, (uint32_t)len);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: PtyOpen
+********************************************************************************
+* Summary:
+*  Opens a pseudo terminal in raw mode and returns the path of its slave
+*  side. The slave side is kept open, so the host tool can open and close it
+*  as often as it wants.
+*
+*******************************************************************************/
+static const char *PtyOpen(void)
+{
+    struct termios tio;
+    const char *path;
+
+    ptyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+    TEST_ASSERT(ptyMaster >= 0);
+    TEST_ASSERT((grantpt(ptyMaster) == 0) && (unlockpt(ptyMaster) == 0));
+    path = ptsname(ptyMaster);
+    TEST_ASSERT(path != NULL);
+
+    TEST_ASSERT(tcgetattr(ptyMaster, &tio) == 0);
+    cfmakeraw(&tio);
+    TEST_ASSERT(tcsetattr(ptyMaster, TCSANOW, &tio) == 0);
+
+    TEST_ASSERT(open(path, O_RDWR | O_NOCTTY) >= 0);
+    return path;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+*  Runs the application with UART_PROTOCOL_ENABLE against one simulated
+*  EEPROM, with the kit UART on a pseudo terminal, at the baud rate given as
+*  the argument. Prints the path of the terminal for scripts/eeprom_uart.py
+*  and runs until killed.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t baud = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : PTY_DEFAULT_BAUD;
+
+    sim_uart_set_baud(baud);
+    sim_eeprom_attach(EEPROM_SLAVE_ADDR);
+
+    printf("%s\n", PtyOpen());
+    (void)fflush(stdout);
+
+    wallStartUs = WallUs();
+    simStartUs = sim_time_us();
+    sim_uart_set_tx_hook(&PtyTx);
+    sim_set_hook(&PtyPace);
+    (void)app_main();
+
+    return 1;
+}
+
+/* [] END OF FILE */
@@ -43,6 +43,14 @@
 
 /* Header file includes */
 #include "I2CMaster.h"
+#include "eeprom_arb.h"
+#include "eeprom_bus.h"
+#include "eeprom_crc.h"
+#include "eeprom_fifo.h"
+#include "eeprom_power.h"
+#include "eeprom_recovery.h"
+#include "eeprom_stats.h"
+#include <string.h>
 
 /*******************************************************************************
 * Macros
@@ -54,20 +62,11 @@
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
-/* Structure for master transfer configuration */
-cy_stc_scb_i2c_master_xfer_config_t masterTransferCfg =
+/* Interrupt of the I2C SCB */
+static const cy_stc_sysint_t i2cIrqCfg =
 {
-    .slaveAddress = EEPROM_SLAVE_ADDR,
-    .buffer       = NULL,
-    .bufferSize   = 0U,
-    .xferPending  = false
-};
-
-/*structure for a single interrupt channel*/
-cy_stc_sysint_t CYBSP_I2C_SCB_IRQ_cfg =
-{
-     /*.intrSrc =*/ CYBSP_I2C_IRQ,
-     /*.intrPriority =*/ 3u
+    .intrSrc      = I2C_INTR_NUM,
+    .intrPriority = I2C_INTR_PRIORITY
 };
 
 /** The instance-specific context structure.
@@ -76,212 +75,1611 @@ cy_stc_sysint_t CYBSP_I2C_SCB_IRQ_cfg =
  */
 cy_stc_scb_i2c_context_t CYBSP_I2C_context;
 
-/* Read buffer */
-uint8_t readbuffer[READ_SIZE];
+/* EEPROM on the kit I2C bus, used by the single-device functions */
+const eeprom_dev_t eeprom_default_dev =
+{
+    .base      = CYBSP_I2C_HW,
+    .context   = &CYBSP_I2C_context,
+    .slaveAddr = EEPROM_SLAVE_ADDR
+};
+
+/* Memory address sent ahead of a read */
+static uint8_t addrHeader[EEPROM_ADDR_SIZE];
+
+/* Staging buffer of asynchronous page writes: the interrupt-driven transfer
+ * sends the address and the data from a single buffer. Kept apart from
+ * addrHeader, so the linker drops it when eeprom_write_async() is not used. */
+static uint8_t writebuffer[EEPROM_ADDR_SIZE + EEPROM_PAGE_SIZE];
+
+/* Slave address and size of the interrupt-driven transfer. The slave address
+ * is kept for the current address read that follows an address phase. */
+static uint8_t xferSlaveAddr = EEPROM_SLAVE_ADDR;
+static uint32_t xferSize = 0UL;
 
-/* Write buffer, 2UL is for eeprom start address high and low */
-uint8_t writebuffer[WRITE_SIZE+2UL];
+/* Set while a transfer is in progress, cleared from the I2C interrupt */
+static volatile bool xferBusy = false;
+
+/* Nesting depth of the blocking functions that own the bus, see
+ * eeprom_blocking_begin() */
+static volatile uint32_t blockingDepth = 0UL;
+
+/* Result of the last completed transfer */
+static volatile uint8_t xferStatus = TRANSFER_CMPLT;
+
+/* Completion callback of the transfer in progress */
+static eeprom_callback_t xferCallback = NULL;
+
+/* Data phase of the random read in progress */
+static uint8_t *randomReadDst = NULL;
+static uint32_t randomReadLen = 0UL;
+static eeprom_callback_t randomReadCallback = NULL;
+
+/* Write cycle time that eeprom_dev_wait_ready() sleeps through: follows a
+ * shorter cycle at once and a longer one slowly, 0 until the first cycle */
+static uint32_t writeCycleMinUs = 0UL;
+
+/* Entries of the I2C interrupt since startup */
+static volatile uint32_t isrCount = 0UL;
+
+#if EEPROM_STATS_ENABLE
+/* Start time and operation type of the interrupt-driven transfer */
+static uint32_t xferStartTicks = 0UL;
+static uint8_t xferOp = EEPROM_STATS_OP_WRITE;
+#endif
 
 /*******************************************************************************
 * Function Declaration
 *******************************************************************************/
 void CYBSP_I2C_Interrupt(void);
+static void MasterEventHandler(uint32_t event);
+static void RandomReadAddressComplete(uint8_t status);
 
 /*******************************************************************************
 * Function Name: CYBSP_I2C_Interrupt
 ****************************************************************************//**
 *
 * Summary:
-*   Invokes the Cy_SCB_I2C_Interrupt() PDL driver function.
+*   Invokes the Cy_SCB_I2C_Interrupt() PDL driver function, or the FIFO-level
+*   transfer path while that owns the SCB.
 *
 *******************************************************************************/
 void CYBSP_I2C_Interrupt(void)
 {
+    isrCount++;
+
+#if EEPROM_FIFO_ENABLE
+    if (eeprom_fifo_interrupt())
+    {
+        return;
+    }
+#endif
+
     Cy_SCB_I2C_Interrupt(CYBSP_I2C_HW, &CYBSP_I2C_context);
 }
 
 /*******************************************************************************
-* Function Name: WriteToEEPROM
+* Function Name: MasterEventHandler
 ********************************************************************************
 * Summary:
-* This function writes writeSize number of bytes of sequential data (0 -
-* (writeSize-1)) to the EEPROM memory starting from address 0x0000.
+* This function is registered with Cy_SCB_I2C_RegisterEvent() and is called
+* from CYBSP_I2C_Interrupt when a master transfer completes. It records the
+* result, releases the bus for the next transfer and invokes the completion
+* callback of the transfer.
 *
 * Parameters:
-*  uint32_t writeSize
+*  uint32_t event
 *
 * Return:
-*  uint8_t status
+*  none
 *
 *******************************************************************************/
-uint8_t WriteToEEPROM(uint32_t writeSize)
+static void MasterEventHandler(uint32_t event)
 {
     uint8_t status = TRANSFER_ERROR;
+    eeprom_callback_t callback = xferCallback;
+
+    /* Only completion events end a transfer */
+    if (0UL == (event & (CY_SCB_I2C_MASTER_WR_CMPLT_EVENT |
+                         CY_SCB_I2C_MASTER_RD_CMPLT_EVENT |
+                         CY_SCB_I2C_MASTER_ERR_EVENT)))
+    {
+        return;
+    }
+
+    if ((0UL == (event & CY_SCB_I2C_MASTER_ERR_EVENT)) &&
+        (xferSize == Cy_SCB_I2C_MasterGetTransferCount(CYBSP_I2C_HW, &CYBSP_I2C_context)))
+    {
+        status = TRANSFER_CMPLT;
+    }
+    else if (0UL != (Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context) & CY_SCB_I2C_MASTER_ADDR_NAK))
+    {
+        /* The device does not acknowledge while its write cycle is in progress */
+        status = ADDR_NAK_ERROR;
+    }
+    else if (0UL != (Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context) &
+                     (CY_SCB_I2C_MASTER_ARB_LOST | CY_SCB_I2C_MASTER_ABORT_START)))
+    {
+        /* Another master won the bus */
+        status = ARB_LOST_ERROR;
+    }
 
-    cy_en_scb_i2c_status_t  errorStatus;
-    uint32_t masterStatus;
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_xfer(xferOp, eeprom_time_ticks() - xferStartTicks);
+    if (status != TRANSFER_CMPLT)
+    {
+        eeprom_stats_error(Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context) & MASTER_ERROR_MASK);
+    }
+#endif
 
-    /* Timeout 1 sec (one unit is milliseconds) */
-    uint32_t timeout = 1000UL;
+    xferStatus   = status;
+    xferCallback = NULL;
+    xferBusy     = false;
 
-    /* Memory address of the EEPROM */
-    writebuffer[0] = EEPROM_START_ADDR_HI;
-    writebuffer[1] = EEPROM_START_ADDR_LO;
+    if (callback != NULL)
+    {
+        callback(status);
+    }
+}
 
-    /* Append write buffer with data (0 - (writeSize-1)) to write to EEPROM */
-    for(uint8_t i = 0 ; i < writeSize; i++)
+/*******************************************************************************
+* Function Name: MasterTransferStart
+********************************************************************************
+* Summary:
+* This function starts a master read or write of bufferSize bytes to or from
+* buffer and returns immediately. Completion is signaled from the I2C
+* interrupt through the callback, if not NULL, and by eeprom_is_busy()
+* returning false. When xferPending is true, the transfer ends without a Stop
+* condition so that the next transfer starts with a repeated Start.
+*
+* Parameters:
+*  cy_en_scb_i2c_direction_t direction
+*  uint8_t *buffer
+*  uint32_t bufferSize
+*  bool xferPending
+*  eeprom_callback_t callback
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterTransferStart(cy_en_scb_i2c_direction_t direction, uint8_t *buffer,
+                                   uint32_t bufferSize, bool xferPending,
+                                   eeprom_callback_t callback)
+{
+    cy_en_scb_i2c_status_t errorStatus;
+    cy_stc_scb_i2c_master_xfer_config_t xferCfg;
+
+    if (xferBusy)
     {
-        writebuffer[i+2]  = i;
+        return TRANSFER_BUSY;
     }
 
-    /* Setup transfer specific parameters */
-    masterTransferCfg.buffer     = writebuffer;
-    masterTransferCfg.bufferSize = writeSize+2;
+    /* The driver copies the configuration into its context */
+    xferCfg.slaveAddress = xferSlaveAddr;
+    xferCfg.buffer       = buffer;
+    xferCfg.bufferSize   = bufferSize;
+    xferCfg.xferPending  = xferPending;
+    xferSize = bufferSize;
 
-    if(writeSize == 0)
-         masterTransferCfg.xferPending  = true;
+    xferCallback = callback;
+    xferBusy     = true;
 
-    /* Initiate write transaction */
-    errorStatus = Cy_SCB_I2C_MasterWrite(CYBSP_I2C_HW, &masterTransferCfg, &CYBSP_I2C_context);
-    if(errorStatus == CY_SCB_I2C_SUCCESS)
+#if EEPROM_STATS_ENABLE
+    /* A transfer without Stop is the address phase of a random read */
+    xferStartTicks = eeprom_time_ticks();
+    xferOp = xferPending ? EEPROM_STATS_OP_ADDRESS :
+             ((direction == CY_SCB_I2C_READ_XFER) ? EEPROM_STATS_OP_READ : EEPROM_STATS_OP_WRITE);
+#endif
+
+    /* Initiate transaction, the rest is handled in the interrupt */
+    if (direction == CY_SCB_I2C_READ_XFER)
     {
-        /* Wait until master complete write transfer or time out has occurred */
-        do
-        {
-            masterStatus  = Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context);
-            Cy_SysLib_Delay(CY_SCB_WAIT_1_UNIT);
-            timeout--;
+        errorStatus = Cy_SCB_I2C_MasterRead(CYBSP_I2C_HW, &xferCfg, &CYBSP_I2C_context);
+    }
+    else
+    {
+        errorStatus = Cy_SCB_I2C_MasterWrite(CYBSP_I2C_HW, &xferCfg, &CYBSP_I2C_context);
+    }
+
+    if (errorStatus != CY_SCB_I2C_SUCCESS)
+    {
+        xferCallback = NULL;
+        xferBusy     = false;
+        return TRANSFER_ERROR;
+    }
+
+    return TRANSFER_STARTED;
+}
 
-        } while ((0UL != (masterStatus & CY_SCB_I2C_MASTER_BUSY)) && (timeout > 0));
+/*******************************************************************************
+* Function Name: MasterWaitComplete
+********************************************************************************
+* Summary:
+* This function waits until the transfer in progress completes or the timeout
+* expires. With EEPROM_POWER_SLEEP_ENABLE the CPU sleeps until the I2C
+* interrupt or the next SysTick tick, otherwise the completion flag is checked
+* every EEPROM_XFER_POLL_INTERVAL_US so that the wait ends shortly after the
+* bus finishes.
+*
+* Parameters:
+*  uint32_t timeoutMs
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterWaitComplete(uint32_t timeoutMs)
+{
+    uint32_t startUs = eeprom_time_us();
+#if EEPROM_POWER_SLEEP_ENABLE
+    uint32_t intState;
+#endif
 
-        if (timeout == 0)
+    while (xferBusy)
+    {
+        if ((eeprom_time_us() - startUs) >= (timeoutMs * 1000UL))
         {
             /* Timeout recovery */
             Cy_SCB_I2C_Disable(CYBSP_I2C_HW, &CYBSP_I2C_context);
             Cy_SCB_I2C_Enable(CYBSP_I2C_HW, &CYBSP_I2C_context);
+
+#if EEPROM_STATS_ENABLE
+            eeprom_stats_timeout();
+#endif
+
+            xferCallback = NULL;
+            xferBusy     = false;
+            return TRANSFER_ERROR;
         }
-        else
+
+#if EEPROM_POWER_SLEEP_ENABLE
+        /* The completion interrupt cannot slip in between check and sleep */
+        intState = Cy_SysLib_EnterCriticalSection();
+        if (xferBusy)
+        {
+            eeprom_power_sleep();
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+#else
+        Cy_SysLib_DelayUs((uint16_t)EEPROM_XFER_POLL_INTERVAL_US);
+#endif
+    }
+
+    return xferStatus;
+}
+
+/*******************************************************************************
+* Function Name: MasterAddrHeader
+********************************************************************************
+* Summary:
+* This function stores the memory address bytes of addr in header, most
+* significant byte first. The number of bytes is set by the device profile.
+*
+* Parameters:
+*  uint8_t *header - EEPROM_ADDR_SIZE bytes
+*  eeprom_addr_t addr
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void MasterAddrHeader(uint8_t *header, eeprom_addr_t addr)
+{
+#if (EEPROM_ADDR_SIZE == 2UL)
+    header[0] = (uint8_t)(((uint32_t)addr >> 8u) & 0xFFu);
+    header[1] = (uint8_t)(addr & 0xFFu);
+#else
+    header[0] = (uint8_t)(addr & 0xFFu);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: MasterSetAddress
+********************************************************************************
+* Summary:
+* This function sends the memory address addr to the EEPROM without a Stop
+* condition and waits until the transfer completes, so that a read can follow
+* with a repeated Start. A transfer error is retried as set by
+* eeprom_recovery_retry(), and a lost arbitration as set by eeprom_arb_retry().
+*
+* Parameters:
+*  eeprom_addr_t addr
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterSetAddress(eeprom_addr_t addr)
+{
+    uint32_t attempt = 0UL;
+    uint32_t contention = 0UL;
+    uint8_t status;
+
+    eeprom_blocking_begin();
+    for (;;)
+    {
+        status = ARB_LOST_ERROR;
+        if (eeprom_arb_bus_free(&eeprom_default_dev))
         {
-            if ((0u == (MASTER_ERROR_MASK & masterStatus)) &&
-                ((writeSize+2) == Cy_SCB_I2C_MasterGetTransferCount(CYBSP_I2C_HW, &CYBSP_I2C_context)))
+            status = eeprom_address_async(addr, NULL);
+        }
+        if (status == TRANSFER_STARTED)
+        {
+            status = MasterWaitComplete(eeprom_bus_timeout_ms(0UL));
+        }
+
+        if (status == ARB_LOST_ERROR)
+        {
+            if (!eeprom_arb_retry(&contention, 0UL))
             {
-                status = TRANSFER_CMPLT;
+                break;
             }
         }
+        else if ((status != TRANSFER_ERROR) || !eeprom_recovery_retry(&eeprom_default_dev, attempt++))
+        {
+            break;
+        }
+        else
+        {
+            /* Retry after a transfer error */
+        }
     }
+    eeprom_blocking_end();
     return (status);
 }
 
 /*******************************************************************************
-* Function Name: ReadFromEEPROM
+* Function Name: MasterArbLost
 ********************************************************************************
 * Summary:
-* This function reads the readSize number of bytes of data from EEPROM memory
-* starting from address 0x0000. It also verifies whether the data read matches
-* with the data that was written earlier and returns the "status" appropriately.
+* This function returns true if errorStatus of a low-level master function
+* means that another master won the bus, either during the Start or later in
+* the transaction.
 *
 * Parameters:
-*  uint32_t readSize
+*  cy_en_scb_i2c_status_t errorStatus
 *
 * Return:
-*  uint8_t status
+*  bool
 *
 *******************************************************************************/
-uint8_t ReadFromEEPROM(uint32_t readSize)
+static bool MasterArbLost(cy_en_scb_i2c_status_t errorStatus)
 {
-    uint8_t status = TRANSFER_ERROR;
-    cy_en_scb_i2c_status_t errorStatus;
-    uint32_t masterStatus;
+    return ((errorStatus == CY_SCB_I2C_MASTER_MANUAL_ARB_LOST) ||
+            (errorStatus == CY_SCB_I2C_MASTER_MANUAL_ABORT_START));
+}
 
-    /* Timeout counter */
-    uint32_t timeout = 1000UL;
+/*******************************************************************************
+* Function Name: MasterManualStart
+********************************************************************************
+* Summary:
+* This function starts a transaction with the low-level master functions and
+* sends the memory address addr. For a read, a repeated Start with the read bit
+* follows the address. The Start waits until no other master holds the bus,
+* see eeprom_arb_bus_free().
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  eeprom_addr_t addr
+*  cy_en_scb_i2c_direction_t direction
+*
+* Return:
+*  cy_en_scb_i2c_status_t
+*
+*******************************************************************************/
+static cy_en_scb_i2c_status_t MasterManualStart(const eeprom_dev_t *dev, eeprom_addr_t addr,
+                                                cy_en_scb_i2c_direction_t direction)
+{
+    cy_en_scb_i2c_status_t errorStatus;
+    uint8_t header[EEPROM_ADDR_SIZE];
 
-    /* Write the starting address of memory to read data from EEPROM */
-    if(TRANSFER_CMPLT != WriteToEEPROM(0))
-        return INVALID_DATA_ERROR;
+    if (!eeprom_arb_bus_free(dev))
+    {
+        /* The other master kept the bus, as if it had won the Start */
+        return CY_SCB_I2C_MASTER_MANUAL_ABORT_START;
+    }
 
-    /* Setup transfer specific parameters */
-    masterTransferCfg.buffer     = readbuffer;
-    masterTransferCfg.bufferSize = readSize;
-    masterTransferCfg.xferPending = false;
+    MasterAddrHeader(header, addr);
 
-    /* Initiate read transaction */
-    errorStatus = Cy_SCB_I2C_MasterRead(CYBSP_I2C_HW, &masterTransferCfg, &CYBSP_I2C_context);
-    if(errorStatus == CY_SCB_I2C_SUCCESS)
+    errorStatus = Cy_SCB_I2C_MasterSendStart(dev->base, (dev->slaveAddr | EEPROM_BLOCK_BITS(addr)),
+                                             CY_SCB_I2C_WRITE_XFER, CY_SCB_WAIT_1_UNIT,
+                                             dev->context);
+    for (uint32_t i = 0UL; (i < EEPROM_ADDR_SIZE) && (errorStatus == CY_SCB_I2C_SUCCESS); i++)
     {
-        /* Wait until master complete read transfer or time out has occurred */
-        do
-        {
-            masterStatus  = Cy_SCB_I2C_MasterGetStatus(CYBSP_I2C_HW, &CYBSP_I2C_context);
-            Cy_SysLib_Delay(CY_SCB_WAIT_1_UNIT);
-            timeout--;
+        errorStatus = Cy_SCB_I2C_MasterWriteByte(dev->base, header[i],
+                                                 CY_SCB_WAIT_1_UNIT, dev->context);
+    }
+    if ((errorStatus == CY_SCB_I2C_SUCCESS) && (direction == CY_SCB_I2C_READ_XFER))
+    {
+        errorStatus = Cy_SCB_I2C_MasterSendReStart(dev->base, (dev->slaveAddr | EEPROM_BLOCK_BITS(addr)),
+                                                   CY_SCB_I2C_READ_XFER, CY_SCB_WAIT_1_UNIT,
+                                                   dev->context);
+    }
+    return (errorStatus);
+}
+
+/*******************************************************************************
+* Function Name: MasterManualStop
+********************************************************************************
+* Summary:
+* This function ends a transaction started with MasterManualStart(). The Stop
+* condition is sent unless the master already released the bus, and a
+* timeout is recovered by re-enabling the SCB. A transaction that lost
+* arbitration ends with ARB_LOST_ERROR.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  cy_en_scb_i2c_status_t errorStatus - result of the transaction so far
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterManualStop(const eeprom_dev_t *dev, cy_en_scb_i2c_status_t errorStatus)
+{
+    uint8_t status = TRANSFER_ERROR;
 
-        } while ((0UL != (masterStatus & CY_SCB_I2C_MASTER_BUSY)) && (timeout > 0));
+#if EEPROM_STATS_ENABLE
+    if (errorStatus != CY_SCB_I2C_SUCCESS)
+    {
+        eeprom_stats_manual_error(errorStatus);
+    }
+#endif
 
-        if (timeout == 0)
+    if ((errorStatus == CY_SCB_I2C_SUCCESS) ||
+        (errorStatus == CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK) ||
+        (errorStatus == CY_SCB_I2C_MASTER_MANUAL_NAK))
+    {
+        /* The Stop condition ends the transaction and starts a write cycle */
+        if ((CY_SCB_I2C_SUCCESS == Cy_SCB_I2C_MasterSendStop(dev->base, CY_SCB_WAIT_1_UNIT,
+                                                             dev->context)) &&
+            (errorStatus == CY_SCB_I2C_SUCCESS))
         {
-            /* Timeout recovery */
-            Cy_SCB_I2C_Disable(CYBSP_I2C_HW, &CYBSP_I2C_context);
-            Cy_SCB_I2C_Enable(CYBSP_I2C_HW, &CYBSP_I2C_context);
+            status = TRANSFER_CMPLT;
+        }
+        else if (errorStatus == CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK)
+        {
+            status = ADDR_NAK_ERROR;
         }
         else
         {
-            /* Check transfer status */
-            if (0u == (MASTER_ERROR_MASK & masterStatus))
+            /* Data NAK or Stop failure */
+        }
+    }
+    else if (errorStatus == CY_SCB_I2C_MASTER_MANUAL_TIMEOUT)
+    {
+        /* Timeout recovery */
+        Cy_SCB_I2C_Disable(dev->base, dev->context);
+        Cy_SCB_I2C_Enable(dev->base, dev->context);
+    }
+    else if (MasterArbLost(errorStatus))
+    {
+        /* The winning master owns the bus and ends the transaction */
+        status = ARB_LOST_ERROR;
+    }
+    else
+    {
+        /* Bus error, the master already released the bus */
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: MasterWritePage
+********************************************************************************
+* Summary:
+* This function writes len bytes from src to the EEPROM at memory address
+* addr in one transaction. The address and the data are sent byte by byte
+* with the low-level master functions straight from the caller's buffer, so no
+* staging copy is needed. The span must not cross a page boundary. A
+* transfer error is retried as set by eeprom_recovery_retry(). After a lost
+* arbitration the write resumes behind the last acknowledged byte, as set by
+* eeprom_arb_retry().
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterWritePage(const eeprom_dev_t *dev, eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    cy_en_scb_i2c_status_t errorStatus;
+    uint32_t attempt = 0UL;
+    uint32_t contention = 0UL;
+    uint32_t done = 0UL;
+    uint32_t resume;
+    uint8_t status;
+#if EEPROM_STATS_ENABLE
+    uint32_t startTicks = eeprom_time_ticks();
+#endif
+
+    /* The low-level functions must not interrupt a transfer in progress */
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    for (;;)
+    {
+        resume = done;
+        errorStatus = MasterManualStart(dev, (eeprom_addr_t)(addr + done), CY_SCB_I2C_WRITE_XFER);
+        while ((done < len) && (errorStatus == CY_SCB_I2C_SUCCESS))
+        {
+            errorStatus = Cy_SCB_I2C_MasterWriteByte(dev->base, src[done],
+                                                     CY_SCB_WAIT_1_UNIT, dev->context);
+            if (errorStatus == CY_SCB_I2C_SUCCESS)
             {
-                status = TRANSFER_CMPLT;
+                done++;
             }
         }
 
-        /* Verify if data read back matches with the data written to EEPROM */
-        for(uint8_t i = 0; i < readSize; i++)
+        status = MasterManualStop(dev, errorStatus);
+
+        if (status == ARB_LOST_ERROR)
         {
-            if(readbuffer[i] != writebuffer[i+2])
+            /* The winner sent the same bytes up to the loss, so they are
+             * written. Its write cycle ends before the rest follows. */
+            if (!eeprom_arb_retry(&contention, done - resume))
             {
-                status = INVALID_DATA_ERROR;
                 break;
             }
-
+            (void)eeprom_dev_wait_ready(dev, EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+        else if ((status != TRANSFER_ERROR) || !eeprom_recovery_retry(dev, attempt++))
+        {
+            break;
+        }
+        else
+        {
+            /* A page write can be repeated as a whole */
+            done = 0UL;
         }
     }
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_xfer(EEPROM_STATS_OP_WRITE, eeprom_time_ticks() - startTicks);
+#endif
     return (status);
 }
 
 /*******************************************************************************
-* Function Name: initI2CMaster
+* Function Name: WriteToEEPROM
 ********************************************************************************
 * Summary:
-*  This function initializes and enables SCB as I2C Master
+* This function writes writeSize number of bytes of sequential data (0 -
+* (writeSize-1)) to the EEPROM memory starting from address 0x0000. With a
+* writeSize of 0 it only sets the address pointer for a following read.
 *
 * Parameters:
-*  none
+*  uint32_t writeSize
 *
 * Return:
-*  uint32_t
+*  uint8_t status
 *
 *******************************************************************************/
-uint32_t initI2CMaster(void)
+uint8_t WriteToEEPROM(uint32_t writeSize)
 {
-    cy_en_scb_i2c_status_t initStatus;
-    cy_en_sysint_status_t sysStatus;
+    uint8_t pattern[WRITE_SIZE];
 
-    /*Initialize and enable the I2C in master mode*/
-    initStatus = Cy_SCB_I2C_Init(CYBSP_I2C_HW, &CYBSP_I2C_config, &CYBSP_I2C_context);
-    if(initStatus != CY_SCB_I2C_SUCCESS)
+    if (writeSize == 0UL)
     {
-        return I2C_FAILURE;
+        return MasterSetAddress(EEPROM_START_ADDR);
     }
 
-    /* Hook interrupt service routine */
-    sysStatus = Cy_SysInt_Init(&CYBSP_I2C_SCB_IRQ_cfg, &CYBSP_I2C_Interrupt);
-    if(sysStatus != CY_SYSINT_SUCCESS)
+    if (writeSize > WRITE_SIZE)
     {
-        return I2C_FAILURE;
+        return INVALID_PARAM_ERROR;
     }
-    NVIC_EnableIRQ((IRQn_Type) CYBSP_I2C_SCB_IRQ_cfg.intrSrc);
 
-    /*Enable the I2C in master mode*/
-    Cy_SCB_I2C_Enable(CYBSP_I2C_HW, &CYBSP_I2C_context);
+    /* Data (0 - (writeSize-1)) to write to EEPROM */
+    for(uint8_t i = 0 ; i < writeSize; i++)
+    {
+        pattern[i] = i;
+    }
+
+    return eeprom_write(EEPROM_START_ADDR, pattern, writeSize);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_dev_write
+********************************************************************************
+* Summary:
+* This function writes len bytes from src to the EEPROM starting at memory
+* address addr. The span is split into bursts that never cross a page
+* boundary, so the device does not wrap around within a page, and every burst
+* fills as much of its page as possible to keep the number of write cycles to
+* the minimum. The data is sent directly from src. The function waits for the
+* write cycle of each burst except the last one; the caller must call
+* eeprom_wait_ready() before the next access.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_dev_write(const eeprom_dev_t *dev, eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t chunk;
+
+    if ((src == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    eeprom_blocking_begin();
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        /* Burst up to the end of the current page */
+        chunk = EEPROM_PAGE_SIZE - ((uint32_t)addr % EEPROM_PAGE_SIZE);
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        status = MasterWritePage(dev, addr, src, chunk);
+
+        addr += (eeprom_addr_t)chunk;
+        src  += chunk;
+        len  -= chunk;
+
+        /* The device ignores all commands until the write cycle completes */
+        if ((len > 0UL) && (status == TRANSFER_CMPLT))
+        {
+            status = eeprom_dev_wait_ready(dev, EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+    }
+    eeprom_blocking_end();
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_write
+********************************************************************************
+* Summary:
+* This function writes len bytes from src to the EEPROM on the kit I2C bus,
+* see eeprom_dev_write().
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    return eeprom_dev_write(&eeprom_default_dev, addr, src, len);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_dev_wait_ready
+********************************************************************************
+* Summary:
+* This function waits for the end of the EEPROM internal write cycle by
+* acknowledge polling: the device does not acknowledge its address while the
+* write cycle is in progress, so a Start condition with the write bit is sent
+* repeatedly until the address is acknowledged. This returns as soon as the
+* device is ready instead of always waiting the worst-case write cycle time.
+* With EEPROM_POWER_SLEEP_ENABLE the CPU first sleeps through the SysTick
+* ticks that come before the write cycle learned from the previous waits has
+* passed; a device found ready right after that sleep makes the next wait
+* learn the write cycle time again. Between two polls it then sleeps only while a tick comes before the next
+* poll is due and waits the rest of the poll interval awake, so the wait
+* still ends within one poll interval of the end of the write cycle. A poll that loses arbitration
+* is repeated after the backoff of eeprom_arb_retry().
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  uint32_t timeoutMs - upper bound for the wait in milliseconds
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_dev_wait_ready(const eeprom_dev_t *dev, uint32_t timeoutMs)
+{
+    cy_en_scb_i2c_status_t errorStatus;
+    uint8_t status = TRANSFER_ERROR;
+    uint32_t startUs = eeprom_time_us();
+    uint32_t contention = 0UL;
+    uint32_t busyPolls = 0UL;
+    uint32_t elapsedUs;
+    bool slept = false;
+#if EEPROM_STATS_ENABLE
+    uint32_t startTicks = eeprom_time_ticks();
+#endif
+
+    /* The low-level functions must not interrupt a transfer in progress */
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    eeprom_blocking_begin();
+    do
+    {
+        /* A bus kept by another master counts as a lost Start */
+        errorStatus = CY_SCB_I2C_MASTER_MANUAL_ABORT_START;
+        if (eeprom_arb_bus_free(dev))
+        {
+            errorStatus = Cy_SCB_I2C_MasterSendStart(dev->base, dev->slaveAddr,
+                                                     CY_SCB_I2C_WRITE_XFER, CY_SCB_WAIT_1_UNIT,
+                                                     dev->context);
+        }
+
+        if ((errorStatus == CY_SCB_I2C_SUCCESS) ||
+            (errorStatus == CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK))
+        {
+            /* Complete the probe transaction in both cases */
+            (void) Cy_SCB_I2C_MasterSendStop(dev->base, CY_SCB_WAIT_1_UNIT, dev->context);
+        }
+
+        if (errorStatus == CY_SCB_I2C_SUCCESS)
+        {
+            elapsedUs = eeprom_time_us() - startUs;
+            if (slept && (busyPolls == 1UL))
+            {
+                /* The cycle ended during the sleep, learn its length anew */
+                writeCycleMinUs = 0UL;
+            }
+            else if ((busyPolls > 0UL) &&
+                     ((writeCycleMinUs == 0UL) || (elapsedUs < writeCycleMinUs)))
+            {
+                /* Only a device that was busy tells how long a write cycle lasts */
+                writeCycleMinUs = elapsedUs;
+            }
+            else if (busyPolls > 0UL)
+            {
+                /* Follow longer cycles slowly, so one short cycle is not kept forever */
+                writeCycleMinUs += (elapsedUs - writeCycleMinUs) / 4UL;
+            }
+            status = TRANSFER_CMPLT;
+            break;
+        }
+
+        if (MasterArbLost(errorStatus))
+        {
+            /* Another master is on the bus, the device is polled again */
+#if EEPROM_STATS_ENABLE
+            eeprom_stats_manual_error(errorStatus);
+#endif
+            if (!eeprom_arb_retry(&contention, 0UL))
+            {
+                status = ARB_LOST_ERROR;
+                break;
+            }
+            continue;
+        }
+
+        if (errorStatus != CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK)
+        {
+            /* Any other error means the bus, not the device, is the problem */
+#if EEPROM_STATS_ENABLE
+            eeprom_stats_manual_error(errorStatus);
+#endif
+            (void)eeprom_recovery_check(dev);
+            break;
+        }
+
+#if EEPROM_STATS_ENABLE
+        eeprom_stats_ack_poll();
+#endif
+
+        /* The probe won the bus, so lost arbitrations count anew */
+        contention = 0UL;
+        elapsedUs = eeprom_time_us() - startUs + (2UL * EEPROM_ACK_POLL_INTERVAL_US);
+        if ((busyPolls == 0UL) && (elapsedUs < writeCycleMinUs))
+        {
+            /* No write cycle has ended sooner, so sleep through that part and
+             * poll again one interval before it may end */
+            eeprom_power_sleep_us(writeCycleMinUs - elapsedUs);
+            slept = true;
+        }
+        busyPolls++;
+        eeprom_power_delay_us(EEPROM_ACK_POLL_INTERVAL_US);
+
+    } while ((eeprom_time_us() - startUs) < (timeoutMs * 1000UL));
+    eeprom_blocking_end();
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_xfer(EEPROM_STATS_OP_WAIT_READY, eeprom_time_ticks() - startTicks);
+#endif
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_wait_ready
+********************************************************************************
+* Summary:
+* This function waits for the end of the write cycle of the EEPROM on the kit
+* I2C bus, see eeprom_dev_wait_ready().
+*
+* Parameters:
+*  uint32_t timeoutMs - upper bound for the wait in milliseconds
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_wait_ready(uint32_t timeoutMs)
+{
+    return eeprom_dev_wait_ready(&eeprom_default_dev, timeoutMs);
+}
+
+/*******************************************************************************
+* Function Name: ReadFromEEPROM
+********************************************************************************
+* Summary:
+* This function reads the readSize number of bytes of data from EEPROM memory
+* starting from address 0x0000. It also verifies whether the data read matches
+* with the data that was written earlier by comparing CRC-32 checksums, and
+* returns the "status" appropriately.
+*
+* Parameters:
+*  uint32_t readSize
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t ReadFromEEPROM(uint32_t readSize)
+{
+    uint32_t expectedCrc = EEPROM_CRC32_INIT;
+
+    if (readSize > READ_SIZE)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    /* Checksum of the sequential data written by WriteToEEPROM() */
+    for(uint8_t i = 0; i < readSize; i++)
+    {
+        expectedCrc = eeprom_crc32_update(expectedCrc, &i, 1UL);
+    }
+
+    /* Stream the data back from the starting address of memory and compare
+     * the checksums, INVALID_DATA_ERROR is returned on a mismatch */
+    return eeprom_crc_verify(EEPROM_START_ADDR, readSize, expectedCrc ^ EEPROM_CRC32_INIT);
+}
+
+/*******************************************************************************
+* Function Name: MasterReadAt
+********************************************************************************
+* Summary:
+* This function performs a random read of len bytes at memory address addr
+* within one block and waits until it completes. The timeout follows from len
+* and the bus speed, and a transfer error is retried as set by
+* eeprom_recovery_retry(). The driver does not report how much of a transfer
+* that lost arbitration was done, so such a read is repeated as a whole as
+* set by eeprom_arb_retry().
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterReadAt(eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    uint32_t attempt = 0UL;
+    uint32_t contention = 0UL;
+    uint8_t status;
+
+    for (;;)
+    {
+        status = ARB_LOST_ERROR;
+        if (eeprom_arb_bus_free(&eeprom_default_dev))
+        {
+            status = eeprom_read_at_async(addr, dst, len, NULL);
+        }
+        if (status == TRANSFER_STARTED)
+        {
+            status = MasterWaitComplete(eeprom_bus_timeout_ms(len));
+        }
+
+        if (status == ARB_LOST_ERROR)
+        {
+            if (!eeprom_arb_retry(&contention, 0UL))
+            {
+                break;
+            }
+        }
+        else if ((status != TRANSFER_ERROR) || !eeprom_recovery_retry(&eeprom_default_dev, attempt++))
+        {
+            break;
+        }
+        else
+        {
+            /* Retry after a transfer error */
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_read
+********************************************************************************
+* Summary:
+* This function reads len bytes from the EEPROM starting at memory address
+* addr into dst and waits for the single completion of the random read. The
+* EEPROM continues sequentially across page boundaries.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    uint8_t status;
+
+    if ((dst == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    eeprom_blocking_begin();
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+    /* A sequential read wraps around within a block, so each block is read
+     * in its own transaction */
+    status = TRANSFER_CMPLT;
+    while ((status == TRANSFER_CMPLT) && (len > 0UL))
+    {
+        uint32_t span = EEPROM_BLOCK_SIZE - ((uint32_t)addr % EEPROM_BLOCK_SIZE);
+
+        if (span > len)
+        {
+            span = len;
+        }
+
+        status = MasterReadAt(addr, dst, span);
+        addr += (eeprom_addr_t)span;
+        dst  += span;
+        len  -= span;
+    }
+#else
+    status = MasterReadAt(addr, dst, len);
+#endif
+    eeprom_blocking_end();
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: MasterReadSequential
+********************************************************************************
+* Summary:
+* This function reads len bytes starting at memory address addr in a single
+* sequential read transaction within one block and passes the data to
+* consumer in chunks of up to EEPROM_STREAM_CHUNK_SIZE bytes as it arrives.
+* After a lost arbitration the read resumes behind the last byte received,
+* as set by eeprom_arb_retry(), so the consumer sees every byte once.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  eeprom_addr_t addr
+*  uint32_t len
+*  eeprom_stream_callback_t consumer
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterReadSequential(const eeprom_dev_t *dev, eeprom_addr_t addr, uint32_t len,
+                                    eeprom_stream_callback_t consumer)
+{
+    cy_en_scb_i2c_status_t errorStatus;
+    uint8_t chunk[EEPROM_STREAM_CHUNK_SIZE];
+    uint32_t count = 0UL;
+    uint32_t contention = 0UL;
+    uint32_t done = 0UL;
+    uint32_t resume;
+    uint8_t status;
+#if EEPROM_STATS_ENABLE
+    uint32_t startTicks = eeprom_time_ticks();
+#endif
+
+    for (;;)
+    {
+        resume = done;
+        errorStatus = MasterManualStart(dev, (eeprom_addr_t)(addr + done), CY_SCB_I2C_READ_XFER);
+        while ((done < len) && (errorStatus == CY_SCB_I2C_SUCCESS))
+        {
+            /* Acknowledge every byte except the last one of the transfer */
+            errorStatus = Cy_SCB_I2C_MasterReadByte(dev->base,
+                                                    ((len - done) > 1UL) ? CY_SCB_I2C_ACK : CY_SCB_I2C_NAK,
+                                                    &chunk[count], CY_SCB_WAIT_1_UNIT,
+                                                    dev->context);
+            if (errorStatus == CY_SCB_I2C_SUCCESS)
+            {
+                count++;
+                done++;
+
+                if ((count == EEPROM_STREAM_CHUNK_SIZE) || (done == len))
+                {
+                    consumer(chunk, count);
+                    count = 0UL;
+                }
+            }
+        }
+
+        status = MasterManualStop(dev, errorStatus);
+
+        /* The chunk keeps the bytes received before a lost arbitration */
+        if ((status != ARB_LOST_ERROR) || !eeprom_arb_retry(&contention, done - resume))
+        {
+            break;
+        }
+    }
+
+    if (status == TRANSFER_ERROR)
+    {
+        /* Data already went to the consumer, so the read is not retried, but
+         * the bus is left usable for the next transfer */
+        (void)eeprom_recovery_check(dev);
+    }
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_xfer(EEPROM_STATS_OP_STREAM, eeprom_time_ticks() - startTicks);
+#endif
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_read_stream
+********************************************************************************
+* Summary:
+* This function reads len bytes starting at memory address addr in a single
+* sequential read transaction and passes the data to consumer in chunks of up
+* to EEPROM_STREAM_CHUNK_SIZE bytes as it arrives. The whole array can be read
+* this way with one address phase and a chunk-sized buffer. On devices with
+* block select, each block is read in its own transaction. The bus is held
+* while the consumer runs, so the consumer should return quickly.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint32_t len
+*  eeprom_stream_callback_t consumer
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_read_stream(eeprom_addr_t addr, uint32_t len, eeprom_stream_callback_t consumer)
+{
+    uint8_t status;
+
+    if ((consumer == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    eeprom_blocking_begin();
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+    /* A sequential read wraps around within a block */
+    status = TRANSFER_CMPLT;
+    while ((status == TRANSFER_CMPLT) && (len > 0UL))
+    {
+        uint32_t span = EEPROM_BLOCK_SIZE - ((uint32_t)addr % EEPROM_BLOCK_SIZE);
+
+        if (span > len)
+        {
+            span = len;
+        }
+
+        status = MasterReadSequential(&eeprom_default_dev, addr, span, consumer);
+        addr += (eeprom_addr_t)span;
+        len  -= span;
+    }
+#else
+    status = MasterReadSequential(&eeprom_default_dev, addr, len, consumer);
+#endif
+    eeprom_blocking_end();
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: MasterReadBytes
+********************************************************************************
+* Summary:
+* This function reads len bytes starting at memory address addr into dst in a
+* single random read transaction within one block, using the low-level master
+* functions. A transfer error is retried as set by eeprom_recovery_retry().
+* After a lost arbitration the read resumes behind the last byte received,
+* as set by eeprom_arb_retry().
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t MasterReadBytes(const eeprom_dev_t *dev, eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    cy_en_scb_i2c_status_t errorStatus;
+    uint32_t attempt = 0UL;
+    uint32_t contention = 0UL;
+    uint32_t done = 0UL;
+    uint32_t resume;
+    uint8_t status;
+
+    for (;;)
+    {
+        resume = done;
+        errorStatus = MasterManualStart(dev, (eeprom_addr_t)(addr + done), CY_SCB_I2C_READ_XFER);
+        while ((done < len) && (errorStatus == CY_SCB_I2C_SUCCESS))
+        {
+            /* Acknowledge every byte except the last one of the transfer */
+            errorStatus = Cy_SCB_I2C_MasterReadByte(dev->base,
+                                                    (done < (len - 1UL)) ? CY_SCB_I2C_ACK : CY_SCB_I2C_NAK,
+                                                    &dst[done], CY_SCB_WAIT_1_UNIT, dev->context);
+            if (errorStatus == CY_SCB_I2C_SUCCESS)
+            {
+                done++;
+            }
+        }
+
+        status = MasterManualStop(dev, errorStatus);
+
+        if (status == ARB_LOST_ERROR)
+        {
+            if (!eeprom_arb_retry(&contention, done - resume))
+            {
+                break;
+            }
+        }
+        else if ((status != TRANSFER_ERROR) || !eeprom_recovery_retry(dev, attempt++))
+        {
+            break;
+        }
+        else
+        {
+            /* Retry after a transfer error, dst is read again */
+            done = 0UL;
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_dev_read
+********************************************************************************
+* Summary:
+* This function reads len bytes starting at memory address addr of the EEPROM
+* dev into dst. It uses the low-level master functions, so the device can be on
+* any initialized SCB in I2C master mode.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_dev_read(const eeprom_dev_t *dev, eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    uint8_t status;
+
+    if ((dev == NULL) || (dst == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    /* The low-level functions must not interrupt a transfer in progress */
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    eeprom_blocking_begin();
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+    /* A sequential read wraps around within a block */
+    status = TRANSFER_CMPLT;
+    while ((status == TRANSFER_CMPLT) && (len > 0UL))
+    {
+        uint32_t span = EEPROM_BLOCK_SIZE - ((uint32_t)addr % EEPROM_BLOCK_SIZE);
+
+        if (span > len)
+        {
+            span = len;
+        }
+
+        status = MasterReadBytes(dev, addr, dst, span);
+        addr += (eeprom_addr_t)span;
+        dst  += span;
+        len  -= span;
+    }
+#else
+    status = MasterReadBytes(dev, addr, dst, len);
+#endif
+    eeprom_blocking_end();
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_write_async
+********************************************************************************
+* Summary:
+* This function starts writing len bytes from src to the EEPROM at memory
+* address addr and returns without waiting for the bus. The span must not
+* cross a page boundary. The callback is invoked from the I2C interrupt with
+* the transfer status when the data is sent; the EEPROM write cycle starts at
+* that point and must be waited for with eeprom_wait_ready().
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*  eeprom_callback_t callback - may be NULL, poll eeprom_is_busy() instead
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_write_async(eeprom_addr_t addr, const uint8_t *src, uint32_t len,
+                           eeprom_callback_t callback)
+{
+    if ((src == NULL) || (len == 0UL) ||
+        ((((uint32_t)addr % EEPROM_PAGE_SIZE) + len) > EEPROM_PAGE_SIZE) ||
+        (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    /* writebuffer belongs to the transfer in progress */
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    MasterAddrHeader(writebuffer, addr);
+    memcpy(&writebuffer[EEPROM_ADDR_SIZE], src, len);
+
+    xferSlaveAddr = (uint8_t)EEPROM_SLAVE_ADDR_AT(addr);
+
+    return MasterTransferStart(CY_SCB_I2C_WRITE_XFER, writebuffer, len + EEPROM_ADDR_SIZE,
+                               false, callback);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_read_async
+********************************************************************************
+* Summary:
+* This function starts a current address read of len bytes into dst and
+* returns without waiting for the bus. The EEPROM continues from the address
+* following the last byte accessed. The callback is invoked from the I2C
+* interrupt with the transfer status once dst holds the data.
+*
+* Parameters:
+*  uint8_t *dst
+*  uint32_t len
+*  eeprom_callback_t callback - may be NULL, poll eeprom_is_busy() instead
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_read_async(uint8_t *dst, uint32_t len, eeprom_callback_t callback)
+{
+    if ((dst == NULL) || (len == 0UL))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    return MasterTransferStart(CY_SCB_I2C_READ_XFER, dst, len, false, callback);
+}
+
+/*******************************************************************************
+* Function Name: RandomReadAddressComplete
+********************************************************************************
+* Summary:
+* This function is the completion callback of the address phase of a random
+* read and runs in the I2C interrupt. It starts the data phase right away,
+* which the PDL begins with a repeated Start because the address phase ended
+* without a Stop.
+*
+* Parameters:
+*  uint8_t status
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void RandomReadAddressComplete(uint8_t status)
+{
+    eeprom_callback_t callback = randomReadCallback;
+
+    if (status == TRANSFER_CMPLT)
+    {
+        status = MasterTransferStart(CY_SCB_I2C_READ_XFER, randomReadDst, randomReadLen,
+                                     false, callback);
+        if (status == TRANSFER_STARTED)
+        {
+            return;
+        }
+    }
+
+    /* The random read ends with the address phase */
+    xferStatus = status;
+
+    if (callback != NULL)
+    {
+        callback(status);
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_read_at_async
+********************************************************************************
+* Summary:
+* This function starts a random read of len bytes at memory address addr into
+* dst and returns without waiting for the bus. The address is sent without a
+* Stop condition and the data phase follows from the I2C interrupt with a
+* repeated Start, so the read is one operation with a single completion. The
+* callback is invoked with ADDR_NAK_ERROR if the EEPROM is still in a write
+* cycle.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*  eeprom_callback_t callback - may be NULL, poll eeprom_is_busy() instead
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_read_at_async(eeprom_addr_t addr, uint8_t *dst, uint32_t len,
+                             eeprom_callback_t callback)
+{
+    if ((dst == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+    /* A sequential read wraps around within its block */
+    if ((((uint32_t)addr % EEPROM_BLOCK_SIZE) + len) > EEPROM_BLOCK_SIZE)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+#endif
+
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    randomReadDst      = dst;
+    randomReadLen      = len;
+    randomReadCallback = callback;
+
+    return eeprom_address_async(addr, &RandomReadAddressComplete);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_address_async
+********************************************************************************
+* Summary:
+* This function starts sending the memory address addr to the EEPROM without a
+* Stop condition and returns without waiting for the bus. The EEPROM address
+* pointer is set once the callback reports TRANSFER_CMPLT, and the following
+* eeprom_read_async() starts with a repeated Start.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  eeprom_callback_t callback - may be NULL, poll eeprom_is_busy() instead
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_address_async(eeprom_addr_t addr, eeprom_callback_t callback)
+{
+    if (((uint32_t)addr + 1UL) > EEPROM_SIZE)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    if (xferBusy)
+    {
+        return TRANSFER_BUSY;
+    }
+
+    MasterAddrHeader(addrHeader, addr);
+
+    /* The current address read that follows uses the same block */
+    xferSlaveAddr = (uint8_t)EEPROM_SLAVE_ADDR_AT(addr);
+
+    return MasterTransferStart(CY_SCB_I2C_WRITE_XFER, addrHeader, EEPROM_ADDR_SIZE,
+                               true, callback);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_is_busy
+********************************************************************************
+* Summary:
+*  This function returns true while a transfer started by one of the
+*  asynchronous functions is in progress.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool eeprom_is_busy(void)
+{
+    return xferBusy;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_blocking_begin
+********************************************************************************
+* Summary:
+*  This function marks the bus as owned by a blocking function of the main
+*  loop until the matching eeprom_blocking_end(). Such a function runs its
+*  transactions one after the other with the low-level master functions or
+*  with an interrupt-driven transfer it waits for, and the bus must not be
+*  handed to another transfer in between. Calls may be nested.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_blocking_begin(void)
+{
+    blockingDepth++;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_blocking_end
+********************************************************************************
+* Summary:
+*  This function ends the ownership taken with eeprom_blocking_begin().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_blocking_end(void)
+{
+    blockingDepth--;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_is_blocking
+********************************************************************************
+* Summary:
+*  This function returns true while a blocking function owns the bus.
+*  Interrupt handlers that start transfers of their own, like the restart of
+*  the transaction queue, wait until it returns false.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool eeprom_is_blocking(void)
+{
+    return (blockingDepth != 0UL);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_isr_count
+********************************************************************************
+* Summary:
+* This function returns the number of I2C interrupts served since startup.
+* The difference of two readings gives the interrupt load of a transfer.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_isr_count(void)
+{
+    return isrCount;
+}
+
+/*******************************************************************************
+* Function Name: initI2CMaster
+********************************************************************************
+* Summary:
+*  This function initializes and enables SCB as I2C Master and selects the
+*  bus speed
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t initI2CMaster(void)
+{
+    cy_en_scb_i2c_status_t initStatus;
+    cy_en_sysint_status_t sysStatus;
+
+    /*Initialize and enable the I2C in master mode*/
+    initStatus = Cy_SCB_I2C_Init(CYBSP_I2C_HW, &CYBSP_I2C_config, &CYBSP_I2C_context);
+    if(initStatus != CY_SCB_I2C_SUCCESS)
+    {
+        return I2C_FAILURE;
+    }
+
+    /* Transfers complete in the interrupt and are reported through events */
+    Cy_SCB_I2C_RegisterEvent(CYBSP_I2C_HW, &MasterEventHandler, &CYBSP_I2C_context);
+
+    /* Hook interrupt service routine */
+    sysStatus = Cy_SysInt_Init(&i2cIrqCfg, &CYBSP_I2C_Interrupt);
+    if(sysStatus != CY_SYSINT_SUCCESS)
+    {
+        return I2C_FAILURE;
+    }
+    NVIC_EnableIRQ((IRQn_Type) i2cIrqCfg.intrSrc);
+
+    /* Timebase of the transfer timeouts, the low-power waits and the
+     * transfer latency histograms */
+    eeprom_time_init();
+
+    /*Enable the I2C in master mode*/
+    Cy_SCB_I2C_Enable(CYBSP_I2C_HW, &CYBSP_I2C_context);
+
+#if EEPROM_BUS_AUTOTUNE_ENABLE
+    /* Move to the fastest bus speed the EEPROM reads reliably at. Failure
+     * leaves the bus at Standard-mode and is reported by the first transfer */
+    (void)eeprom_bus_autotune();
+#endif
+
     return I2C_SUCCESS;
 }
 
@@ -305,9 +1703,9 @@ void BlinkUserLED(uint8_t count)
     for(uint8_t i = 0; i < count; i++)
     {
         Cy_GPIO_Clr(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-        Cy_SysLib_Delay(LED_DELAY_MS);
+        eeprom_power_delay_ms(LED_DELAY_MS);
 
         Cy_GPIO_Set(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
-        Cy_SysLib_Delay(LED_DELAY_MS);
+        eeprom_power_delay_ms(LED_DELAY_MS);
     }
 }
@@ -57,15 +57,106 @@
 #define READ_CMPLT              (TRANSFER_CMPLT)
 #define TRANSFER_ERROR          (0xFFUL)
 #define INVALID_DATA_ERROR      (0x0FUL)
+#define INVALID_PARAM_ERROR     (0xF0UL)
+#define TRANSFER_BUSY           (0xF1UL)
+#define ADDR_NAK_ERROR          (0xF2UL)
+#define ARB_LOST_ERROR          (0xF3UL)
+#define TRANSFER_STARTED        (TRANSFER_CMPLT)
 #define READ_ERROR              (TRANSFER_ERROR)
 
-#define WRITE_SIZE              (0x40UL)
+/* Supported EEPROM devices */
+#define EEPROM_DEVICE_24LC02    (0u)
+#define EEPROM_DEVICE_24LC128   (1u)
+#define EEPROM_DEVICE_24LC512   (2u)
+#define EEPROM_DEVICE_24LC1025  (3u)
+
+/* Device the driver is built for, can be overridden from the Makefile DEFINES */
+#ifndef EEPROM_DEVICE
+#define EEPROM_DEVICE           (EEPROM_DEVICE_24LC128)
+#endif
+
+/* Part families of the same organization: 24LC parts are rated for 400 kHz
+ * and 24FC parts for 1 MHz */
+#define EEPROM_FAMILY_24LC      (0u)
+#define EEPROM_FAMILY_24FC      (1u)
+
+/* Part family fitted, can be overridden from the Makefile DEFINES */
+#ifndef EEPROM_FAMILY
+#define EEPROM_FAMILY           (EEPROM_FAMILY_24LC)
+#endif
+
+/* Device profile: array size, page size, number of memory address bytes sent
+ * ahead of the data, and the span addressed by one slave address. Devices
+ * larger than that span select the block with a bit of the slave address. */
+#if (EEPROM_DEVICE == EEPROM_DEVICE_24LC02)
+/* 24LC02: 256-byte array organized as 32 pages of 8 bytes */
+#define EEPROM_SIZE             (0x100UL)
+#define EEPROM_PAGE_SIZE        (0x08UL)
+#define EEPROM_ADDR_SIZE        (1UL)
+#define EEPROM_BLOCK_SIZE       (EEPROM_SIZE)
+#define EEPROM_SLAVE_ADDR       (0x50)
+#elif (EEPROM_DEVICE == EEPROM_DEVICE_24LC128)
+/* 24LC128: 16 KB array organized as 256 pages of 64 bytes */
+#define EEPROM_SIZE             (0x4000UL)
+#define EEPROM_PAGE_SIZE        (0x40UL)
+#define EEPROM_ADDR_SIZE        (2UL)
+#define EEPROM_BLOCK_SIZE       (EEPROM_SIZE)
+#define EEPROM_SLAVE_ADDR       (0x51)
+#elif (EEPROM_DEVICE == EEPROM_DEVICE_24LC512)
+/* 24LC512: 64 KB array organized as 512 pages of 128 bytes */
+#define EEPROM_SIZE             (0x10000UL)
+#define EEPROM_PAGE_SIZE        (0x80UL)
+#define EEPROM_ADDR_SIZE        (2UL)
+#define EEPROM_BLOCK_SIZE       (EEPROM_SIZE)
+#define EEPROM_SLAVE_ADDR       (0x51)
+#elif (EEPROM_DEVICE == EEPROM_DEVICE_24LC1025)
+/* 24LC1025: 128 KB array organized as two 64 KB blocks of 128-byte pages, the
+ * block is selected with bit 2 of the slave address */
+#define EEPROM_SIZE             (0x20000UL)
+#define EEPROM_PAGE_SIZE        (0x80UL)
+#define EEPROM_ADDR_SIZE        (2UL)
+#define EEPROM_BLOCK_SIZE       (0x10000UL)
+#define EEPROM_BLOCK_SELECT_BIT (2u)
+#define EEPROM_SLAVE_ADDR       (0x51)
+#else
+#error "Unsupported EEPROM_DEVICE"
+#endif
+
+/* Slave address bits that select the block of memory address addr */
+#if (EEPROM_BLOCK_SIZE < EEPROM_SIZE)
+#define EEPROM_BLOCK_BITS(addr)     (((uint32_t)(addr) / EEPROM_BLOCK_SIZE) << EEPROM_BLOCK_SELECT_BIT)
+#else
+#define EEPROM_BLOCK_BITS(addr)     (0UL)
+#endif
+
+/* Slave address that reaches memory address addr */
+#define EEPROM_SLAVE_ADDR_AT(addr)  ((uint32_t)EEPROM_SLAVE_ADDR | EEPROM_BLOCK_BITS(addr))
+
+/* Worst-case internal write cycle time (tWR) in milliseconds */
+#define EEPROM_WRITE_CYCLE_MS   (5UL)
+
+/* Upper bound for acknowledge polling after a write, in milliseconds */
+#define EEPROM_WRITE_CYCLE_TIMEOUT_MS   (2UL * EEPROM_WRITE_CYCLE_MS)
+
+/* Pause between two acknowledge polls while the device is busy */
+#define EEPROM_ACK_POLL_INTERVAL_US     (100UL)
+
+/* Interval at which blocking functions check for transfer completion when the
+ * CPU does not sleep */
+#define EEPROM_XFER_POLL_INTERVAL_US    (10UL)
+
+/* Bytes passed to the consumer of a streaming read at a time, can be
+ * overridden from the Makefile DEFINES */
+#ifndef EEPROM_STREAM_CHUNK_SIZE
+#define EEPROM_STREAM_CHUNK_SIZE        (32UL)
+#endif
+
+#define WRITE_SIZE              (EEPROM_PAGE_SIZE)
 #define READ_SIZE               (WRITE_SIZE)
 
 #define EEPROM_START_ADDR_HI    (0x00)
 #define EEPROM_START_ADDR_LO    (0x00)
-
-#define EEPROM_SLAVE_ADDR       (0x51)
+#define EEPROM_START_ADDR       ((eeprom_addr_t)((EEPROM_START_ADDR_HI << 8u) | EEPROM_START_ADDR_LO))
 
 /* Delay of 500 milliseconds*/
 #define LED_DELAY_MS            (500)
@@ -77,11 +168,62 @@
                             CY_SCB_I2C_MASTER_ARB_LOST | CY_SCB_I2C_MASTER_ABORT_START | \
                             CY_SCB_I2C_MASTER_BUS_ERR)
 
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* EEPROM memory address, wide enough for the selected device */
+#if (EEPROM_SIZE > 0x10000UL)
+typedef uint32_t eeprom_addr_t;
+#else
+typedef uint16_t eeprom_addr_t;
+#endif
+
+/* EEPROM device: the SCB in I2C master mode it is connected to, the context
+ * of that SCB, and the slave address set by its chip select pins */
+typedef struct
+{
+    CySCB_Type *base;
+    cy_stc_scb_i2c_context_t *context;
+    uint8_t slaveAddr;
+} eeprom_dev_t;
+
+/* Completion callback of the asynchronous transfer functions, called from the
+ * I2C interrupt with TRANSFER_CMPLT, ADDR_NAK_ERROR (device busy in its write
+ * cycle), ARB_LOST_ERROR (another master won the bus) or TRANSFER_ERROR */
+typedef void (*eeprom_callback_t)(uint8_t status);
+
+/* Consumer of eeprom_read_stream(), called with each chunk of data read */
+typedef void (*eeprom_stream_callback_t)(const uint8_t *data, uint32_t len);
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* EEPROM on the kit I2C bus */
+extern const eeprom_dev_t eeprom_default_dev;
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
 uint8_t WriteToEEPROM(uint32_t writeSize);
 uint8_t ReadFromEEPROM(uint32_t readSize);
+uint8_t eeprom_dev_write(const eeprom_dev_t *dev, eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+uint8_t eeprom_dev_read(const eeprom_dev_t *dev, eeprom_addr_t addr, uint8_t *dst, uint32_t len);
+uint8_t eeprom_dev_wait_ready(const eeprom_dev_t *dev, uint32_t timeoutMs);
+uint8_t eeprom_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+uint8_t eeprom_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len);
+uint8_t eeprom_read_stream(eeprom_addr_t addr, uint32_t len, eeprom_stream_callback_t consumer);
+uint8_t eeprom_wait_ready(uint32_t timeoutMs);
+uint8_t eeprom_write_async(eeprom_addr_t addr, const uint8_t *src, uint32_t len,
+                           eeprom_callback_t callback);
+uint8_t eeprom_read_async(uint8_t *dst, uint32_t len, eeprom_callback_t callback);
+uint8_t eeprom_read_at_async(eeprom_addr_t addr, uint8_t *dst, uint32_t len,
+                             eeprom_callback_t callback);
+uint8_t eeprom_address_async(eeprom_addr_t addr, eeprom_callback_t callback);
+bool eeprom_is_busy(void);
+void eeprom_blocking_begin(void);
+void eeprom_blocking_end(void);
+bool eeprom_is_blocking(void);
+uint32_t eeprom_isr_count(void);
 uint32_t initI2CMaster(void);
 void handle_error(void);
 void BlinkUserLED(uint8_t num);
@@ -0,0 +1,261 @@
+/******************************************************************************
+* File Name:  eeprom_arb.c
+*
+* Description:  This file contains the multi-master arbitration handling:
+*               the wait for a free bus before a Start and the randomized
+*               backoff before a transfer that lost arbitration is resumed.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_arb.h"
+#include "eeprom_stats.h"
+#include "eeprom_time.h"
+#include <string.h>
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* State of the backoff random number generator, 0 until it is seeded */
+static uint32_t arbSeed = 0UL;
+
+static eeprom_arb_stats_t arbStats;
+
+/*******************************************************************************
+* Function Name: ArbRandom
+********************************************************************************
+* Summary:
+*  This function returns the next number of a xorshift32 sequence. The
+*  sequence is seeded on first use from the unique ID of the die and the time
+*  of the first collision, so masters running the same firmware draw
+*  different backoffs.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t ArbRandom(void)
+{
+    if (arbSeed == 0UL)
+    {
+        uint64_t id = Cy_SysLib_GetUniqueId();
+
+        arbSeed = (uint32_t)id ^ (uint32_t)(id >> 32u) ^ eeprom_time_us();
+        if (arbSeed == 0UL)
+        {
+            arbSeed = 1UL;
+        }
+    }
+
+    arbSeed ^= arbSeed << 13u;
+    arbSeed ^= arbSeed >> 17u;
+    arbSeed ^= arbSeed << 5u;
+    return arbSeed;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_arb_bus_free
+********************************************************************************
+* Summary:
+*  This function is called before a Start with the low-level master functions.
+*  While another master holds the bus, a Start would only wait in the
+*  hardware or lose arbitration, so the function waits for the Stop condition
+*  of the other master for up to EEPROM_ARB_BUS_FREE_TIMEOUT_US.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*
+* Return:
+*  bool - false if the bus is still busy
+*
+*******************************************************************************/
+bool eeprom_arb_bus_free(const eeprom_dev_t *dev)
+{
+    uint32_t startUs;
+
+    if (!Cy_SCB_I2C_IsBusBusy(dev->base))
+    {
+        return true;
+    }
+
+    arbStats.busBusy++;
+    startUs = eeprom_time_us();
+    do
+    {
+        Cy_SysLib_DelayUs((uint16_t)EEPROM_ARB_BUS_POLL_US);
+        if (!Cy_SCB_I2C_IsBusBusy(dev->base))
+        {
+            return true;
+        }
+    } while ((eeprom_time_us() - startUs) < EEPROM_ARB_BUS_FREE_TIMEOUT_US);
+
+    arbStats.busTimeouts++;
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_arb_backoff_us
+********************************************************************************
+* Summary:
+*  This function draws the pause before retry number attempt, counted from 0:
+*  a random time of at least EEPROM_ARB_BACKOFF_MIN_US from a window that
+*  doubles with every attempt up to EEPROM_ARB_BACKOFF_MAX_US.
+*
+* Parameters:
+*  uint32_t attempt
+*
+* Return:
+*  uint32_t - pause in microseconds
+*
+*******************************************************************************/
+uint32_t eeprom_arb_backoff_us(uint32_t attempt)
+{
+    uint32_t windowUs = EEPROM_ARB_BACKOFF_MAX_US;
+
+    if (attempt < 16UL)
+    {
+        windowUs = EEPROM_ARB_BACKOFF_MIN_US << (attempt + 1UL);
+        if (windowUs > EEPROM_ARB_BACKOFF_MAX_US)
+        {
+            windowUs = EEPROM_ARB_BACKOFF_MAX_US;
+        }
+    }
+    return (EEPROM_ARB_BACKOFF_MIN_US + (ArbRandom() % ((windowUs - EEPROM_ARB_BACKOFF_MIN_US) + 1UL)));
+}
+
+/*******************************************************************************
+* Function Name: eeprom_arb_retry
+********************************************************************************
+* Summary:
+*  This function decides whether a transfer that failed with ARB_LOST_ERROR
+*  is tried again. The caller's attempt counter starts at 0 and is advanced
+*  here. Up to EEPROM_ARB_RETRY_MAX retries in a row are allowed. Before each
+*  retry the function waits the random pause of eeprom_arb_backoff_us(), so
+*  that the masters that collided start at different times.
+*
+*  Arbitration is only lost at the first bit that differs between the
+*  masters, so every byte before it was sent identically by the winner. The
+*  caller passes those bytes in doneBytes and resumes behind them. An attempt
+*  that got bytes done restarts the count, so a long transfer on a busy bus
+*  only fails if it stops making progress.
+*
+* Parameters:
+*  uint32_t *attempt
+*  uint32_t doneBytes - bytes the failed attempt completed
+*
+* Return:
+*  bool - true to retry the transfer
+*
+*******************************************************************************/
+bool eeprom_arb_retry(uint32_t *attempt, uint32_t doneBytes)
+{
+    uint32_t backoffUs;
+
+    arbStats.lost++;
+
+    if (doneBytes > 0UL)
+    {
+        *attempt = 0UL;
+    }
+
+    if (*attempt >= EEPROM_ARB_RETRY_MAX)
+    {
+        arbStats.failed++;
+        return false;
+    }
+
+    backoffUs = eeprom_arb_backoff_us(*attempt);
+    Cy_SysLib_DelayUs((uint16_t)backoffUs);
+    (*attempt)++;
+
+    arbStats.backoffUs += backoffUs;
+    if (doneBytes > 0UL)
+    {
+        arbStats.resumed++;
+        arbStats.resumedBytes += doneBytes;
+    }
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_retry();
+#endif
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_arb_get_stats
+********************************************************************************
+* Summary:
+*  This function copies the contention counters to stats.
+*
+* Parameters:
+*  eeprom_arb_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_arb_get_stats(eeprom_arb_stats_t *stats)
+{
+    uint32_t intrStatus = Cy_SysLib_EnterCriticalSection();
+    *stats = arbStats;
+    Cy_SysLib_ExitCriticalSection(intrStatus);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_arb_reset_stats
+********************************************************************************
+* Summary:
+*  This function clears the contention counters.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_arb_reset_stats(void)
+{
+    uint32_t intrStatus = Cy_SysLib_EnterCriticalSection();
+    memset(&arbStats, 0, sizeof(arbStats));
+    Cy_SysLib_ExitCriticalSection(intrStatus);
+}
+
+/* [] END OF FILE */
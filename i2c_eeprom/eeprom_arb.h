@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:  eeprom_arb.h
+*
+* Description:  This file provides constants and function prototypes of
+*               the multi-master arbitration and contention retry policy.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_ARB_H_
+#define SOURCE_EEPROM_ARB_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Retries in a row of a transfer that lost arbitration to another master
+ * without getting a byte done. Contention is expected on a shared bus, so
+ * more retries are allowed than for errors. */
+#define EEPROM_ARB_RETRY_MAX            (8UL)
+
+/* Upper bound for the wait for another master's Stop condition before a
+ * Start, about one 64-byte page write at 100 kHz */
+#define EEPROM_ARB_BUS_FREE_TIMEOUT_US  (8000UL)
+
+/* Interval at which the bus is checked while another master holds it */
+#define EEPROM_ARB_BUS_POLL_US          (10UL)
+
+/* The pause before a retry is drawn at random from EEPROM_ARB_BACKOFF_MIN_US
+ * up to a window that doubles with every attempt and is capped at
+ * EEPROM_ARB_BACKOFF_MAX_US, so that two masters do not collide again */
+#define EEPROM_ARB_BACKOFF_MIN_US       (20UL)
+#define EEPROM_ARB_BACKOFF_MAX_US       (2000UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Contention counters */
+typedef struct
+{
+    uint32_t lost;          /* Transfers that lost the bus to another master */
+    uint32_t resumed;       /* Retries that continued behind bytes already done */
+    uint32_t resumedBytes;  /* Bytes that did not have to be transferred again */
+    uint32_t failed;        /* Transfers that gave up with ARB_LOST_ERROR */
+    uint32_t busBusy;       /* Starts delayed while another master held the bus */
+    uint32_t busTimeouts;   /* Starts abandoned because the bus stayed busy */
+    uint32_t backoffUs;     /* Total time spent in the randomized backoff */
+} eeprom_arb_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool eeprom_arb_bus_free(const eeprom_dev_t *dev);
+uint32_t eeprom_arb_backoff_us(uint32_t attempt);
+bool eeprom_arb_retry(uint32_t *attempt, uint32_t doneBytes);
+void eeprom_arb_get_stats(eeprom_arb_stats_t *stats);
+void eeprom_arb_reset_stats(void);
+
+#endif /* SOURCE_EEPROM_ARB_H_ */
@@ -0,0 +1,625 @@
+/******************************************************************************
+* File Name:  eeprom_bench.c
+*
+* Description:  This file implements the EEPROM throughput benchmark. It
+*               times write, read and verify workloads on the target and
+*               reports throughput and per-transaction latency.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_bench.h"
+#include "eeprom_bus.h"
+#include "eeprom_crc.h"
+#include "eeprom_power.h"
+#include "eeprom_time.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bytes sent besides data: slave address and memory address, plus the slave
+ * address after the repeated Start of a read */
+#define BENCH_WRITE_OVERHEAD    (1UL + EEPROM_ADDR_SIZE)
+#define BENCH_READ_OVERHEAD     (2UL + EEPROM_ADDR_SIZE)
+
+/* Data of each compressed block, short enough to be stored uncompressed in a
+ * block-sized slot */
+#define BENCH_LZ_LEN            (EEPROM_BENCH_BLOCK_SIZE - EEPROM_LZ_HEADER_SIZE)
+
+/* Lines of the log text of the compressed workloads, 24 bytes each */
+#define BENCH_LOG_LINE          "t=000000 ch=0 v=0000 ok\n"
+#define BENCH_LOG_LINE_LEN      (sizeof(BENCH_LOG_LINE) - 1UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Write and read functions compared by the workloads */
+typedef uint8_t (*bench_write_t)(eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+typedef uint8_t (*bench_read_t)(eeprom_addr_t addr, uint8_t *dst, uint32_t len);
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Names of the workloads, as printed in the result table */
+static const char * const benchNames[EEPROM_BENCH_COUNT] =
+{
+    "page write", "page read", "stream read", "CRC verify", "block read",
+#if EEPROM_FIFO_ENABLE
+    "FIFO write", "FIFO read",
+#endif
+#if EEPROM_LZ_ENABLE
+    "LZ write", "LZ read",
+#endif
+};
+
+/* Destination of the read workloads */
+static uint8_t benchBuffer[EEPROM_BENCH_BLOCK_SIZE];
+
+/* CPU active time and I2C interrupt count at the start of the workload */
+static uint32_t benchActiveUs = 0UL;
+static uint32_t benchIsrCount = 0UL;
+
+#if EEPROM_LZ_ENABLE
+/* Running CRC-32 of the data decompressed by the streaming read */
+static uint32_t benchLzCrc;
+#endif
+
+/*******************************************************************************
+* Function Name: BenchBusUs
+********************************************************************************
+* Summary:
+*  This function returns the time needed to clock bytes over the bus at
+*  the current SCL frequency, nine clocks per byte.
+*
+* Parameters:
+*  uint32_t bytes
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t BenchBusUs(uint32_t bytes)
+{
+    return (uint32_t)(((uint64_t)bytes * 9UL * 1000000UL) / eeprom_bus_get_speed());
+}
+
+/*******************************************************************************
+* Function Name: BenchDiscard
+********************************************************************************
+* Summary:
+*  Stream consumer of the sequential read workload, drops the data.
+*
+* Parameters:
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void BenchDiscard(const uint8_t *data, uint32_t len)
+{
+    (void) data;
+    (void) len;
+}
+
+/*******************************************************************************
+* Function Name: BenchActiveUs
+********************************************************************************
+* Summary:
+*  This function returns the CPU active time of the current accounting period
+*  of eeprom_power_get(). Workloads take the difference of two readings, so the
+*  accounting period of the application is left alone.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t BenchActiveUs(void)
+{
+    eeprom_power_stats_t power;
+
+    eeprom_power_get(&power);
+    return power.activeUs;
+}
+
+/*******************************************************************************
+* Function Name: BenchBegin
+********************************************************************************
+* Summary:
+*  This function takes the CPU active time and the I2C interrupt count at the
+*  start of a workload.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void BenchBegin(void)
+{
+    benchActiveUs = BenchActiveUs();
+    benchIsrCount = eeprom_isr_count();
+}
+
+/*******************************************************************************
+* Function Name: BenchEnd
+********************************************************************************
+* Summary:
+*  This function stores the CPU active time and the I2C interrupts of the
+*  workload started with BenchBegin() in its result.
+*
+* Parameters:
+*  eeprom_bench_result_t *result
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void BenchEnd(eeprom_bench_result_t *result)
+{
+    result->activeUs = BenchActiveUs() - benchActiveUs;
+    result->isrCount = eeprom_isr_count() - benchIsrCount;
+}
+
+/*******************************************************************************
+* Function Name: BenchAdd
+********************************************************************************
+* Summary:
+*  This function adds one timed transaction to a workload result.
+*
+* Parameters:
+*  eeprom_bench_result_t *result
+*  uint32_t bytes - data bytes
+*  uint32_t overhead - address bytes
+*  uint32_t us - elapsed time
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void BenchAdd(eeprom_bench_result_t *result, uint32_t bytes, uint32_t overhead, uint32_t us)
+{
+    if ((result->transactions == 0UL) || (us < result->minUs))
+    {
+        result->minUs = us;
+    }
+    if (us > result->maxUs)
+    {
+        result->maxUs = us;
+    }
+
+    result->transactions++;
+    result->bytes   += bytes;
+    result->eepromBytes += bytes;
+    result->totalUs += us;
+    result->busUs   += BenchBusUs(bytes + overhead);
+}
+
+/*******************************************************************************
+* Function Name: BenchPageWrites
+********************************************************************************
+* Summary:
+*  This function writes the test pattern over the benchmark region a page at
+*  a time with write, timing each page until its write cycle has completed.
+*
+* Parameters:
+*  eeprom_bench_result_t *result
+*  bench_write_t write - eeprom_write() or eeprom_fifo_write()
+*  uint32_t *crc - updated with the CRC-32 of the pattern
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t BenchPageWrites(eeprom_bench_result_t *result, bench_write_t write, uint32_t *crc)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint8_t page[EEPROM_PAGE_SIZE];
+    uint32_t start;
+
+    BenchBegin();
+    for (uint32_t addr = EEPROM_BENCH_START; (addr < (EEPROM_BENCH_START + EEPROM_BENCH_SIZE)) &&
+                                             (status == TRANSFER_CMPLT); addr += EEPROM_PAGE_SIZE)
+    {
+        for (uint32_t i = 0UL; i < EEPROM_PAGE_SIZE; i++)
+        {
+            page[i] = (uint8_t)(addr + (i * 7UL));
+        }
+        *crc = eeprom_crc32_update(*crc, page, EEPROM_PAGE_SIZE);
+
+        start = eeprom_time_us();
+        status = write((eeprom_addr_t)addr, page, EEPROM_PAGE_SIZE);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+        BenchAdd(result, EEPROM_PAGE_SIZE, BENCH_WRITE_OVERHEAD, eeprom_time_us() - start);
+    }
+    BenchEnd(result);
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: BenchReads
+********************************************************************************
+* Summary:
+*  This function reads the benchmark region with read in random reads of
+*  size bytes, timing each of them.
+*
+* Parameters:
+*  eeprom_bench_result_t *result
+*  bench_read_t read - eeprom_read() or eeprom_fifo_read()
+*  uint32_t size - EEPROM_PAGE_SIZE or EEPROM_BENCH_BLOCK_SIZE
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t BenchReads(eeprom_bench_result_t *result, bench_read_t read, uint32_t size)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t start;
+
+    BenchBegin();
+    for (uint32_t addr = EEPROM_BENCH_START; (addr < (EEPROM_BENCH_START + EEPROM_BENCH_SIZE)) &&
+                                             (status == TRANSFER_CMPLT); addr += size)
+    {
+        start = eeprom_time_us();
+        status = read((eeprom_addr_t)addr, benchBuffer, size);
+        BenchAdd(result, size, BENCH_READ_OVERHEAD, eeprom_time_us() - start);
+    }
+    BenchEnd(result);
+    return (status);
+}
+
+#if EEPROM_LZ_ENABLE
+/*******************************************************************************
+* Function Name: BenchDigit
+********************************************************************************
+* Summary:
+*  This function returns the ASCII decimal digit of value at position digit,
+*  0 being the least significant.
+*
+* Parameters:
+*  uint32_t value
+*  uint32_t digit
+*
+* Return:
+*  uint8_t
+*
+*******************************************************************************/
+static uint8_t BenchDigit(uint32_t value, uint32_t digit)
+{
+    while (digit > 0UL)
+    {
+        value /= 10UL;
+        digit--;
+    }
+    return (uint8_t)('0' + (value % 10UL));
+}
+
+/*******************************************************************************
+* Function Name: BenchLogText
+********************************************************************************
+* Summary:
+*  This function fills dst with the len bytes of log text that start at line
+*  first: a timestamp in ms, a channel and a voltage in mV on each line. The
+*  text stands for the records an application logs to the EEPROM.
+*
+* Parameters:
+*  uint8_t *dst
+*  uint32_t len
+*  uint32_t first
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void BenchLogText(uint8_t *dst, uint32_t len, uint32_t first)
+{
+    static const char line[] = BENCH_LOG_LINE;
+    uint32_t n;
+    uint32_t k;
+
+    for (uint32_t i = 0UL; i < len; i++)
+    {
+        n = first + (i / BENCH_LOG_LINE_LEN);
+        k = i % BENCH_LOG_LINE_LEN;
+        if ((k >= 2UL) && (k <= 7UL))
+        {
+            dst[i] = BenchDigit(n * 250UL, 7UL - k);
+        }
+        else if (k == 12UL)
+        {
+            dst[i] = BenchDigit(n % 4UL, 0UL);
+        }
+        else if ((k >= 16UL) && (k <= 19UL))
+        {
+            dst[i] = BenchDigit(3300UL + ((n * 37UL) % 61UL), 19UL - k);
+        }
+        else
+        {
+            dst[i] = (uint8_t)line[k];
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: BenchLzConsumer
+********************************************************************************
+* Summary:
+*  Stream consumer of the decompression workload, adds the data to the
+*  running checksum.
+*
+* Parameters:
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void BenchLzConsumer(const uint8_t *data, uint32_t len)
+{
+    benchLzCrc = eeprom_crc32_update(benchLzCrc, data, len);
+}
+
+/*******************************************************************************
+* Function Name: BenchLzWrites
+********************************************************************************
+* Summary:
+*  This function stores log text over the benchmark region as compressed
+*  blocks of BENCH_LZ_LEN bytes, one per block-sized slot, timing each block
+*  until its last write cycle has completed. The throughput is that of the
+*  log text, and the bus time that of the compressed bytes, so the result
+*  compares directly with the page writes.
+*
+* Parameters:
+*  eeprom_bench_result_t *result
+*  uint32_t *crc - updated with the CRC-32 of the log text
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t BenchLzWrites(eeprom_bench_result_t *result, uint32_t *crc)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t stored = 0UL;
+    uint32_t writes = 0UL;
+    uint32_t line = 0UL;
+    uint32_t start;
+
+    BenchBegin();
+    for (uint32_t addr = EEPROM_BENCH_START; (addr < (EEPROM_BENCH_START + EEPROM_BENCH_SIZE)) &&
+                                             (status == TRANSFER_CMPLT); addr += EEPROM_BENCH_BLOCK_SIZE)
+    {
+        BenchLogText(benchBuffer, BENCH_LZ_LEN, line);
+        line += BENCH_LZ_LEN / BENCH_LOG_LINE_LEN;
+        *crc = eeprom_crc32_update(*crc, benchBuffer, BENCH_LZ_LEN);
+
+        start = eeprom_time_us();
+        status = eeprom_lz_write((eeprom_addr_t)addr, EEPROM_BENCH_BLOCK_SIZE, benchBuffer, BENCH_LZ_LEN,
+                                 &stored);
+        BenchAdd(result, BENCH_LZ_LEN, BENCH_WRITE_OVERHEAD, eeprom_time_us() - start);
+
+        /* One write per page the block touches */
+        if (status == TRANSFER_CMPLT)
+        {
+            result->eepromBytes += stored - BENCH_LZ_LEN;
+            writes += (((addr + stored - 1UL) / EEPROM_PAGE_SIZE) - (addr / EEPROM_PAGE_SIZE)) + 1UL;
+        }
+    }
+    BenchEnd(result);
+
+    result->transactions = writes;
+    result->busUs = BenchBusUs(result->eepromBytes + (writes * BENCH_WRITE_OVERHEAD));
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: BenchLzReads
+********************************************************************************
+* Summary:
+*  This function streams the blocks stored by BenchLzWrites() through the
+*  decompressor, timing each block, and checks the CRC-32 of the log text.
+*  Each block takes a header read and one sequential read of the compressed
+*  data.
+*
+* Parameters:
+*  eeprom_bench_result_t *result
+*  uint32_t eepromBytes - EEPROM bytes of the blocks
+*  uint32_t crc - running CRC-32 of the log text, from BenchLzWrites()
+*
+* Return:
+*  uint8_t status - INVALID_DATA_ERROR if the checksums differ
+*
+*******************************************************************************/
+static uint8_t BenchLzReads(eeprom_bench_result_t *result, uint32_t eepromBytes, uint32_t crc)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t start;
+
+    benchLzCrc = EEPROM_CRC32_INIT;
+
+    BenchBegin();
+    for (uint32_t addr = EEPROM_BENCH_START; (addr < (EEPROM_BENCH_START + EEPROM_BENCH_SIZE)) &&
+                                             (status == TRANSFER_CMPLT); addr += EEPROM_BENCH_BLOCK_SIZE)
+    {
+        start = eeprom_time_us();
+        status = eeprom_lz_read_stream((eeprom_addr_t)addr, &BenchLzConsumer);
+        BenchAdd(result, BENCH_LZ_LEN, BENCH_READ_OVERHEAD, eeprom_time_us() - start);
+    }
+    BenchEnd(result);
+
+    result->eepromBytes = eepromBytes;
+    result->transactions *= 2UL;
+    result->busUs = BenchBusUs(eepromBytes + (result->transactions * BENCH_READ_OVERHEAD));
+
+    if ((status == TRANSFER_CMPLT) && (benchLzCrc != crc))
+    {
+        status = INVALID_DATA_ERROR;
+    }
+    return (status);
+}
+#endif /* EEPROM_LZ_ENABLE */
+
+/*******************************************************************************
+* Function Name: eeprom_bench_run
+********************************************************************************
+* Summary:
+*  This function runs the benchmark workloads over the EEPROM_BENCH_SIZE bytes
+*  at EEPROM_BENCH_START and fills one result per workload. The region is
+*  overwritten with a test pattern. initI2CMaster() must have been called.
+*
+* Parameters:
+*  eeprom_bench_result_t results[] - EEPROM_BENCH_COUNT results
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_bench_run(eeprom_bench_result_t results[EEPROM_BENCH_COUNT])
+{
+    uint8_t status;
+    uint32_t crc = EEPROM_CRC32_INIT;
+    uint32_t start;
+
+    memset(results, 0, EEPROM_BENCH_COUNT * sizeof(eeprom_bench_result_t));
+
+    /* Page writes, each timed until the write cycle has completed */
+    status = BenchPageWrites(&results[EEPROM_BENCH_PAGE_WRITE], &eeprom_write, &crc);
+
+    /* Page-sized and block-sized random reads */
+    if (status == TRANSFER_CMPLT)
+    {
+        status = BenchReads(&results[EEPROM_BENCH_PAGE_READ], &eeprom_read, EEPROM_PAGE_SIZE);
+    }
+    if (status == TRANSFER_CMPLT)
+    {
+        status = BenchReads(&results[EEPROM_BENCH_BLOCK_READ], &eeprom_read, EEPROM_BENCH_BLOCK_SIZE);
+    }
+
+    /* The whole region in one sequential read, data discarded */
+    if (status == TRANSFER_CMPLT)
+    {
+        BenchBegin();
+        start = eeprom_time_us();
+        status = eeprom_read_stream((eeprom_addr_t)EEPROM_BENCH_START, EEPROM_BENCH_SIZE, &BenchDiscard);
+        BenchAdd(&results[EEPROM_BENCH_STREAM_READ], EEPROM_BENCH_SIZE, BENCH_READ_OVERHEAD,
+                 eeprom_time_us() - start);
+        BenchEnd(&results[EEPROM_BENCH_STREAM_READ]);
+    }
+
+    /* Sequential read with CRC-32 verification */
+    if (status == TRANSFER_CMPLT)
+    {
+        BenchBegin();
+        start = eeprom_time_us();
+        status = eeprom_crc_verify((eeprom_addr_t)EEPROM_BENCH_START, EEPROM_BENCH_SIZE, crc ^ EEPROM_CRC32_INIT);
+        BenchAdd(&results[EEPROM_BENCH_CRC_VERIFY], EEPROM_BENCH_SIZE, BENCH_READ_OVERHEAD,
+                 eeprom_time_us() - start);
+        BenchEnd(&results[EEPROM_BENCH_CRC_VERIFY]);
+    }
+
+#if EEPROM_FIFO_ENABLE
+    /* The same pattern and block reads on the FIFO-level path */
+    if (status == TRANSFER_CMPLT)
+    {
+        crc = EEPROM_CRC32_INIT;
+        status = BenchPageWrites(&results[EEPROM_BENCH_FIFO_WRITE], &eeprom_fifo_write, &crc);
+    }
+    if (status == TRANSFER_CMPLT)
+    {
+        status = BenchReads(&results[EEPROM_BENCH_FIFO_READ], &eeprom_fifo_read, EEPROM_BENCH_BLOCK_SIZE);
+    }
+#endif
+
+#if EEPROM_LZ_ENABLE
+    /* Compressed log text, written and streamed back through the decompressor */
+    if (status == TRANSFER_CMPLT)
+    {
+        crc = EEPROM_CRC32_INIT;
+        status = BenchLzWrites(&results[EEPROM_BENCH_LZ_WRITE], &crc);
+    }
+    if (status == TRANSFER_CMPLT)
+    {
+        status = BenchLzReads(&results[EEPROM_BENCH_LZ_READ], results[EEPROM_BENCH_LZ_WRITE].eepromBytes, crc);
+    }
+#endif
+
+    for (uint32_t w = 0UL; w < EEPROM_BENCH_COUNT; w++)
+    {
+        if (results[w].totalUs > 0UL)
+        {
+            results[w].bytesPerSec = (uint32_t)(((uint64_t)results[w].bytes * 1000000UL) / results[w].totalUs);
+        }
+        if (results[w].bytes > 0UL)
+        {
+            results[w].activeUsPerKB = (uint32_t)(((uint64_t)results[w].activeUs * 1024UL) / results[w].bytes);
+            results[w].isrPerKB = (uint32_t)(((uint64_t)results[w].isrCount * 1024UL) / results[w].bytes);
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_bench_name
+********************************************************************************
+* Summary:
+*  This function returns the name of a workload, as printed in the result
+*  table.
+*
+* Parameters:
+*  uint32_t workload - EEPROM_BENCH_*
+*
+* Return:
+*  const char * - the name, or "?" for an unknown workload
+*
+*******************************************************************************/
+const char *eeprom_bench_name(uint32_t workload)
+{
+    return (workload < EEPROM_BENCH_COUNT) ? benchNames[workload] : "?";
+}
+
+/* [] END OF FILE */
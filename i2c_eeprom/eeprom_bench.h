@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:  eeprom_bench.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the EEPROM throughput benchmark.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_BENCH_H_
+#define SOURCE_EEPROM_BENCH_H_
+
+#include "I2CMaster.h"
+#include "eeprom_fifo.h"
+#include "eeprom_lz.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* EEPROM region overwritten by the benchmark, the second quarter of the device */
+#define EEPROM_BENCH_START          (EEPROM_SIZE / 4UL)
+#define EEPROM_BENCH_SIZE           (EEPROM_SIZE / 4UL)
+
+/* Transfer size of the block read workloads */
+#define EEPROM_BENCH_BLOCK_SIZE     ((EEPROM_BENCH_SIZE < 256UL) ? EEPROM_BENCH_SIZE : 256UL)
+
+/* Workloads */
+#define EEPROM_BENCH_PAGE_WRITE     (0u)    /* Page writes with acknowledge polling */
+#define EEPROM_BENCH_PAGE_READ      (1u)    /* Page-sized random reads */
+#define EEPROM_BENCH_STREAM_READ    (2u)    /* One sequential read of the region */
+#define EEPROM_BENCH_CRC_VERIFY     (3u)    /* Streaming CRC-32 verification */
+#define EEPROM_BENCH_BLOCK_READ     (4u)    /* Block-sized random reads */
+#if EEPROM_FIFO_ENABLE
+#define EEPROM_BENCH_FIFO_WRITE     (5u)    /* Page writes on the FIFO-level path */
+#define EEPROM_BENCH_FIFO_READ      (6u)    /* Block reads on the FIFO-level path */
+#define EEPROM_BENCH_LZ_FIRST       (7u)
+#else
+#define EEPROM_BENCH_LZ_FIRST       (5u)
+#endif
+#if EEPROM_LZ_ENABLE
+#define EEPROM_BENCH_LZ_WRITE       (EEPROM_BENCH_LZ_FIRST)         /* Compressed log text blocks */
+#define EEPROM_BENCH_LZ_READ        (EEPROM_BENCH_LZ_FIRST + 1u)    /* Streaming decompression */
+#define EEPROM_BENCH_COUNT          (EEPROM_BENCH_LZ_FIRST + 2u)
+#else
+#define EEPROM_BENCH_COUNT          (EEPROM_BENCH_LZ_FIRST)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Result of one workload */
+typedef struct
+{
+    uint32_t bytes;         /* Data bytes transferred */
+    uint32_t eepromBytes;   /* Bytes written to or read from the EEPROM, fewer
+                             * than bytes for compressed data */
+    uint32_t transactions;  /* I2C transactions */
+    uint32_t totalUs;       /* Elapsed time */
+    uint32_t minUs;         /* Fastest transaction */
+    uint32_t maxUs;         /* Slowest transaction */
+    uint32_t busUs;         /* Bus time of the bytes sent, without polling */
+    uint32_t bytesPerSec;   /* Data throughput */
+    uint32_t activeUs;      /* CPU active time, see eeprom_power_get() */
+    uint32_t activeUsPerKB; /* CPU active time per 1024 data bytes */
+    uint32_t isrCount;      /* I2C interrupts, see eeprom_isr_count() */
+    uint32_t isrPerKB;      /* I2C interrupts per 1024 data bytes */
+} eeprom_bench_result_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_bench_run(eeprom_bench_result_t results[EEPROM_BENCH_COUNT]);
+const char *eeprom_bench_name(uint32_t workload);
+
+#endif /* SOURCE_EEPROM_BENCH_H_ */
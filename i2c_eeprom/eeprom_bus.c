@@ -0,0 +1,257 @@
+/******************************************************************************
+* File Name:  eeprom_bus.c
+*
+* Description:  This file provides the runtime I2C bus speed selection
+*               of the kit I2C bus.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_bus.h"
+#include "eeprom_crc.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of supported bus speeds */
+#define BUS_SPEED_COUNT     (3u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* SCL frequency and the SCB clock it is generated from. Each SCB clock lies
+ * within the range the PDL accepts for a master at that data rate. */
+typedef struct
+{
+    uint32_t rateHz;
+    uint32_t scbClkHz;
+} bus_speed_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Supported bus speeds, fastest first */
+static const bus_speed_t busSpeeds[BUS_SPEED_COUNT] =
+{
+    { EEPROM_BUS_FAST_PLUS_HZ, 24000000UL },
+    { EEPROM_BUS_FAST_HZ,      12000000UL },
+    { EEPROM_BUS_STANDARD_HZ,   8000000UL },
+};
+
+/* Current SCL frequency */
+static uint32_t busRateHz = EEPROM_BUS_DEFAULT_HZ;
+
+/*******************************************************************************
+* Function Name: eeprom_bus_set_speed
+********************************************************************************
+* Summary:
+*  This function switches the kit I2C bus to SCL frequency rateHz. The SCB is
+*  disabled while its clock divider and data rate are reprogrammed, so no
+*  transfer may be in progress. Rates above EEPROM_BUS_MAX_HZ, the rating of
+*  the fitted part, are refused.
+*
+* Parameters:
+*  uint32_t rateHz - EEPROM_BUS_STANDARD_HZ, EEPROM_BUS_FAST_HZ or
+*                    EEPROM_BUS_FAST_PLUS_HZ
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_bus_set_speed(uint32_t rateHz)
+{
+    const bus_speed_t *speed = NULL;
+    uint32_t divider;
+    uint32_t scbClkHz;
+    uint8_t status = TRANSFER_CMPLT;
+
+    for (uint32_t i = 0UL; i < BUS_SPEED_COUNT; i++)
+    {
+        if (busSpeeds[i].rateHz == rateHz)
+        {
+            speed = &busSpeeds[i];
+        }
+    }
+
+    if ((speed == NULL) || (rateHz > EEPROM_BUS_MAX_HZ))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    if (eeprom_is_busy())
+    {
+        return TRANSFER_BUSY;
+    }
+
+    /* Fastest SCB clock the peripheral clock divides down to, not above the
+     * wanted one */
+    divider = Cy_SysClk_ClkHfGetFrequency() / speed->scbClkHz;
+    if (divider == 0UL)
+    {
+        divider = 1UL;
+    }
+    scbClkHz = Cy_SysClk_ClkHfGetFrequency() / divider;
+
+    eeprom_blocking_begin();
+    Cy_SCB_I2C_Disable(eeprom_default_dev.base, eeprom_default_dev.context);
+
+    /* Returns 0 and leaves the SCB untouched when scbClkHz is out of range
+     * for rateHz */
+    if (Cy_SCB_I2C_SetDataRate(eeprom_default_dev.base, rateHz, scbClkHz) == 0UL)
+    {
+        status = INVALID_PARAM_ERROR;
+    }
+    else
+    {
+        Cy_SysClk_PeriphDisableDivider(CYBSP_I2C_CLK_DIV_HW, CYBSP_I2C_CLK_DIV_NUM);
+        Cy_SysClk_PeriphSetDivider(CYBSP_I2C_CLK_DIV_HW, CYBSP_I2C_CLK_DIV_NUM, divider - 1UL);
+        Cy_SysClk_PeriphEnableDivider(CYBSP_I2C_CLK_DIV_HW, CYBSP_I2C_CLK_DIV_NUM);
+        busRateHz = rateHz;
+    }
+
+    Cy_SCB_I2C_Enable(eeprom_default_dev.base, eeprom_default_dev.context);
+    eeprom_blocking_end();
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_bus_get_speed
+********************************************************************************
+* Summary:
+*  This function returns the current SCL frequency of the kit I2C bus.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_bus_get_speed(void)
+{
+    return busRateHz;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_bus_timeout_ms
+********************************************************************************
+* Summary:
+*  This function returns the timeout of a transaction carrying len data bytes
+*  at the current SCL frequency. The bus time counts nine clocks for each data
+*  byte, the memory address and the slave address sent twice for a random
+*  read. The timeout is twice that time, rounded up to milliseconds, plus
+*  EEPROM_BUS_TIMEOUT_MARGIN_MS.
+*
+* Parameters:
+*  uint32_t len
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_bus_timeout_ms(uint32_t len)
+{
+    uint64_t busUs = (((uint64_t)len + EEPROM_ADDR_SIZE + 2UL) * 9UL * 1000000UL) / busRateHz;
+
+    return (uint32_t)(((2UL * busUs) + 999UL) / 1000UL) + EEPROM_BUS_TIMEOUT_MARGIN_MS;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_bus_autotune
+********************************************************************************
+* Summary:
+*  This function selects the fastest bus speed up to EEPROM_BUS_MAX_HZ at which
+*  the EEPROM reads reliably. The probe block is first read at Standard-mode
+*  and its CRC-32 kept as reference. Then, fastest first, each speed must read
+*  the block EEPROM_BUS_PROBE_PASSES times without a bus error and with the
+*  same CRC-32. The probe buffer is on the stack, as autotuning runs once.
+*  The bus is left at Standard-mode if no faster speed passes, or if the
+*  reference read fails.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_bus_autotune(void)
+{
+    uint8_t status;
+    uint8_t probe[EEPROM_BUS_PROBE_SIZE];
+    uint32_t probeCrc;
+
+    status = eeprom_bus_set_speed(EEPROM_BUS_STANDARD_HZ);
+    if (status == TRANSFER_CMPLT)
+    {
+        status = eeprom_read(EEPROM_BUS_PROBE_ADDR, probe, EEPROM_BUS_PROBE_SIZE);
+    }
+    if (status != TRANSFER_CMPLT)
+    {
+        return status;
+    }
+    probeCrc = eeprom_crc32_update(EEPROM_CRC32_INIT, probe, EEPROM_BUS_PROBE_SIZE);
+
+    for (uint32_t i = 0UL; i < (BUS_SPEED_COUNT - 1UL); i++)
+    {
+        uint8_t pass = 0u;
+
+        /* Speeds above EEPROM_BUS_MAX_HZ are refused */
+        if (eeprom_bus_set_speed(busSpeeds[i].rateHz) != TRANSFER_CMPLT)
+        {
+            continue;
+        }
+
+        while ((pass < EEPROM_BUS_PROBE_PASSES) &&
+               (eeprom_read(EEPROM_BUS_PROBE_ADDR, probe, EEPROM_BUS_PROBE_SIZE) == TRANSFER_CMPLT) &&
+               (eeprom_crc32_update(EEPROM_CRC32_INIT, probe, EEPROM_BUS_PROBE_SIZE) == probeCrc))
+        {
+            pass++;
+        }
+
+        if (pass == EEPROM_BUS_PROBE_PASSES)
+        {
+            return TRANSFER_CMPLT;
+        }
+    }
+
+    /* No faster speed passed */
+    return eeprom_bus_set_speed(EEPROM_BUS_STANDARD_HZ);
+}
+
+/* [] END OF FILE */
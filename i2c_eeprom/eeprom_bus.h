@@ -0,0 +1,99 @@
+/******************************************************************************
+* File Name:  eeprom_bus.h
+*
+* Description:  This file provides constants and function prototypes of
+*               the runtime I2C bus speed selection.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_BUS_H_
+#define SOURCE_EEPROM_BUS_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Supported SCL frequencies */
+#define EEPROM_BUS_STANDARD_HZ      (100000UL)      /* Standard-mode */
+#define EEPROM_BUS_FAST_HZ          (400000UL)      /* Fast-mode */
+#define EEPROM_BUS_FAST_PLUS_HZ     (1000000UL)     /* Fast-mode Plus */
+
+/* SCL frequency configured for CYBSP_I2C in design.modus */
+#define EEPROM_BUS_DEFAULT_HZ       (EEPROM_BUS_FAST_HZ)
+
+/* Fastest SCL frequency eeprom_bus_set_speed() accepts and eeprom_bus_autotune()
+ * tries: 1 MHz for a 24FC part, 400 kHz otherwise. Can be lowered from the
+ * Makefile DEFINES. */
+#ifndef EEPROM_BUS_MAX_HZ
+#if (EEPROM_FAMILY == EEPROM_FAMILY_24FC)
+#define EEPROM_BUS_MAX_HZ           (EEPROM_BUS_FAST_PLUS_HZ)
+#else
+#define EEPROM_BUS_MAX_HZ           (EEPROM_BUS_FAST_HZ)
+#endif
+#endif
+
+#if ((EEPROM_BUS_MAX_HZ > EEPROM_BUS_FAST_HZ) && (EEPROM_FAMILY != EEPROM_FAMILY_24FC))
+#error "Fast-mode Plus needs a 24FC part, set EEPROM_FAMILY to EEPROM_FAMILY_24FC"
+#endif
+
+/* Run eeprom_bus_autotune() from initI2CMaster(), 0u keeps the design.modus
+ * data rate, can be overridden from the Makefile DEFINES */
+#ifndef EEPROM_BUS_AUTOTUNE_ENABLE
+#define EEPROM_BUS_AUTOTUNE_ENABLE  (1u)
+#endif
+
+/* Memory address and size of the block read to qualify a bus speed */
+#define EEPROM_BUS_PROBE_ADDR       (EEPROM_START_ADDR)
+#define EEPROM_BUS_PROBE_SIZE       (EEPROM_PAGE_SIZE)
+
+/* Error-free reads of the probe block a bus speed must pass */
+#define EEPROM_BUS_PROBE_PASSES     (4u)
+
+/* Transfer timeout: twice the bus time of the transfer plus a margin for
+ * interrupt latency */
+#define EEPROM_BUS_TIMEOUT_MARGIN_MS    (2UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_bus_set_speed(uint32_t rateHz);
+uint32_t eeprom_bus_get_speed(void);
+uint32_t eeprom_bus_timeout_ms(uint32_t len);
+uint8_t eeprom_bus_autotune(void);
+
+#endif /* SOURCE_EEPROM_BUS_H_ */
@@ -0,0 +1,398 @@
+/******************************************************************************
+* File Name:  eeprom_cache.c
+*
+* Description:  This file implements a write-back RAM cache of EEPROM pages.
+*               Reads are served from RAM on a hit and small writes to the
+*               same page are merged into a single page write.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_cache.h"
+#include <string.h>
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Cache line holding one EEPROM page. Bytes dirtyStart to dirtyEnd - 1 differ
+ * from the EEPROM; the line is clean when dirtyEnd is 0. */
+typedef struct
+{
+    uint16_t page;
+    uint16_t lastUse;
+    bool valid;
+    uint8_t dirtyStart;
+    uint8_t dirtyEnd;
+    uint8_t data[EEPROM_PAGE_SIZE];
+} cache_line_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cache_line_t cacheLines[EEPROM_CACHE_PAGES];
+
+/* Access counter used for least recently used replacement */
+static uint16_t useCounter = 0u;
+
+/* Time since the last write, for the idle flush */
+static uint32_t idleMs = 0UL;
+
+static eeprom_cache_stats_t cacheStats;
+
+/*******************************************************************************
+* Function Name: CacheFlushLine
+********************************************************************************
+* Summary:
+*  This function writes the dirty range of a cache line to the EEPROM and waits
+*  for the write cycle to complete.
+*
+* Parameters:
+*  cache_line_t *line
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t CacheFlushLine(cache_line_t *line)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t len;
+
+    if (line->dirtyEnd != 0u)
+    {
+        len = (uint32_t)line->dirtyEnd - line->dirtyStart;
+
+        status = eeprom_write((eeprom_addr_t)((line->page * EEPROM_PAGE_SIZE) + line->dirtyStart),
+                              &line->data[line->dirtyStart], len);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+
+        if (status == TRANSFER_CMPLT)
+        {
+            line->dirtyStart = 0u;
+            line->dirtyEnd   = 0u;
+
+            cacheStats.flushes++;
+            cacheStats.bytesFlushed += len;
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: CacheGetLine
+********************************************************************************
+* Summary:
+*  This function returns the cache line holding the page, loading it into the
+*  least recently used line on a miss. The page is not read from the EEPROM
+*  when the caller is about to overwrite all of it.
+*
+* Parameters:
+*  uint16_t page
+*  bool fullOverwrite
+*  cache_line_t **line
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t CacheGetLine(uint16_t page, bool fullOverwrite, cache_line_t **line)
+{
+    cache_line_t *victim = &cacheLines[0];
+    uint8_t status = TRANSFER_CMPLT;
+
+    useCounter++;
+
+    for (uint32_t i = 0u; i < EEPROM_CACHE_PAGES; i++)
+    {
+        cache_line_t *entry = &cacheLines[i];
+
+        if (entry->valid && (entry->page == page))
+        {
+            entry->lastUse = useCounter;
+            cacheStats.hits++;
+            *line = entry;
+            return TRANSFER_CMPLT;
+        }
+
+        /* Prefer an empty line, otherwise the least recently used one */
+        if (victim->valid &&
+            ((!entry->valid) || ((uint16_t)(useCounter - entry->lastUse) > (uint16_t)(useCounter - victim->lastUse))))
+        {
+            victim = entry;
+        }
+    }
+
+    cacheStats.misses++;
+
+    if (victim->valid)
+    {
+        status = CacheFlushLine(victim);
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        victim->valid = false;
+
+        if (!fullOverwrite)
+        {
+            status = eeprom_read((eeprom_addr_t)(page * EEPROM_PAGE_SIZE), victim->data, EEPROM_PAGE_SIZE);
+        }
+
+        if (status == TRANSFER_CMPLT)
+        {
+            victim->page       = page;
+            victim->lastUse    = useCounter;
+            victim->valid      = true;
+            victim->dirtyStart = 0u;
+            victim->dirtyEnd   = 0u;
+            *line = victim;
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_cache_read
+********************************************************************************
+* Summary:
+*  This function reads len bytes at memory address addr into dst through the
+*  cache. Pages not in the cache are loaded from the EEPROM.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_cache_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    cache_line_t *line = NULL;
+    uint32_t offset;
+    uint32_t chunk;
+
+    if ((dst == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        offset = (uint32_t)addr % EEPROM_PAGE_SIZE;
+        chunk  = EEPROM_PAGE_SIZE - offset;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        status = CacheGetLine((uint16_t)(addr / EEPROM_PAGE_SIZE), false, &line);
+        if (status == TRANSFER_CMPLT)
+        {
+            memcpy(dst, &line->data[offset], chunk);
+        }
+
+        addr += (eeprom_addr_t)chunk;
+        dst  += chunk;
+        len  -= chunk;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_cache_write
+********************************************************************************
+* Summary:
+*  This function writes len bytes from src to memory address addr in the
+*  cache. The EEPROM is updated when the page is evicted, on
+*  eeprom_cache_flush(), or by eeprom_cache_service() once writes stop.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_cache_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    cache_line_t *line = NULL;
+    uint32_t offset;
+    uint32_t chunk;
+
+    if ((src == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    idleMs = 0UL;
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        offset = (uint32_t)addr % EEPROM_PAGE_SIZE;
+        chunk  = EEPROM_PAGE_SIZE - offset;
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        status = CacheGetLine((uint16_t)(addr / EEPROM_PAGE_SIZE), (chunk == EEPROM_PAGE_SIZE), &line);
+        if (status == TRANSFER_CMPLT)
+        {
+            memcpy(&line->data[offset], src, chunk);
+
+            /* Grow the dirty range to cover the new bytes */
+            if (line->dirtyEnd == 0u)
+            {
+                line->dirtyStart = (uint8_t)offset;
+                line->dirtyEnd   = (uint8_t)(offset + chunk);
+            }
+            else
+            {
+                cacheStats.coalesced++;
+
+                if (offset < line->dirtyStart)
+                {
+                    line->dirtyStart = (uint8_t)offset;
+                }
+                if ((offset + chunk) > line->dirtyEnd)
+                {
+                    line->dirtyEnd = (uint8_t)(offset + chunk);
+                }
+            }
+
+            cacheStats.bytesWritten += chunk;
+        }
+
+        addr += (eeprom_addr_t)chunk;
+        src  += chunk;
+        len  -= chunk;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_cache_flush
+********************************************************************************
+* Summary:
+*  This function writes all dirty pages to the EEPROM.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_cache_flush(void)
+{
+    uint8_t status = TRANSFER_CMPLT;
+
+    for (uint32_t i = 0u; (i < EEPROM_CACHE_PAGES) && (status == TRANSFER_CMPLT); i++)
+    {
+        if (cacheLines[i].valid)
+        {
+            status = CacheFlushLine(&cacheLines[i]);
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_cache_service
+********************************************************************************
+* Summary:
+*  This function is called periodically from the main loop with the time
+*  elapsed since the previous call. It flushes the dirty pages once no write
+*  has reached the cache for EEPROM_CACHE_FLUSH_DELAY_MS.
+*
+* Parameters:
+*  uint32_t elapsedMs
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_cache_service(uint32_t elapsedMs)
+{
+    uint8_t status = TRANSFER_CMPLT;
+
+    if (idleMs < EEPROM_CACHE_FLUSH_DELAY_MS)
+    {
+        idleMs += elapsedMs;
+        if (idleMs >= EEPROM_CACHE_FLUSH_DELAY_MS)
+        {
+            status = eeprom_cache_flush();
+            if (status != TRANSFER_CMPLT)
+            {
+                /* Try again after another delay */
+                idleMs = 0UL;
+            }
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_cache_get_stats
+********************************************************************************
+* Summary:
+*  This function copies the cache statistics to stats. The hit rate is
+*  hits / (hits + misses), and coalesced counts the page writes saved by
+*  merging.
+*
+* Parameters:
+*  eeprom_cache_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_cache_get_stats(eeprom_cache_stats_t *stats)
+{
+    *stats = cacheStats;
+}
+
+/* [] END OF FILE */
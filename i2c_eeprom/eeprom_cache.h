@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:  eeprom_cache.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the write-back EEPROM page cache.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_CACHE_H_
+#define SOURCE_EEPROM_CACHE_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of cached pages. Each page costs EEPROM_PAGE_SIZE + 8 bytes of SRAM.
+ * Can be overridden from the Makefile DEFINES. */
+#ifndef EEPROM_CACHE_PAGES
+#define EEPROM_CACHE_PAGES          (4u)
+#endif
+
+/* Dirty pages are flushed once no write has hit the cache for this long */
+#define EEPROM_CACHE_FLUSH_DELAY_MS (100UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Cache statistics */
+typedef struct
+{
+    uint32_t hits;          /* Page accesses served from RAM */
+    uint32_t misses;        /* Page accesses that loaded the page from EEPROM */
+    uint32_t coalesced;     /* Writes merged into a page that was already dirty */
+    uint32_t flushes;       /* Page writes issued to the EEPROM */
+    uint32_t bytesWritten;  /* Bytes written by the application */
+    uint32_t bytesFlushed;  /* Bytes written to the EEPROM */
+} eeprom_cache_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_cache_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len);
+uint8_t eeprom_cache_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+uint8_t eeprom_cache_flush(void);
+uint8_t eeprom_cache_service(uint32_t elapsedMs);
+void eeprom_cache_get_stats(eeprom_cache_stats_t *stats);
+
+#endif /* SOURCE_EEPROM_CACHE_H_ */
@@ -0,0 +1,66 @@
+/******************************************************************************
+* File Name:  eeprom_crc.h
+*
+* Description:  This file provides the function prototypes of the CRC-32
+*               read-back verification.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_CRC_H_
+#define SOURCE_EEPROM_CRC_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* CRC-32 (IEEE 802.3) initial value, also used as the final XOR value */
+#define EEPROM_CRC32_INIT           (0xFFFFFFFFUL)
+
+/* Size of a checksum stored after a region by eeprom_crc_store() */
+#define EEPROM_CRC32_SIZE           (4UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint32_t eeprom_crc32_update(uint32_t crc, const uint8_t *data, uint32_t len);
+uint8_t eeprom_crc_compute(eeprom_addr_t addr, uint32_t len, uint32_t *crc);
+uint8_t eeprom_crc_verify(eeprom_addr_t addr, uint32_t len, uint32_t expectedCrc);
+uint8_t eeprom_crc_store(eeprom_addr_t addr, uint32_t len);
+uint8_t eeprom_crc_verify_stored(eeprom_addr_t addr, uint32_t len);
+
+#endif /* SOURCE_EEPROM_CRC_H_ */
@@ -0,0 +1,209 @@
+/******************************************************************************
+* File Name:  eeprom_diff.c
+*
+* Description:  This file implements differential EEPROM programming. Each
+*               page is read back and compared with the new content first,
+*               and only the bytes that differ are written.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_diff.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* No differing byte found in the page */
+#define DIFF_NONE               (0xFFFFFFFFUL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* New content of the page being compared */
+static const uint8_t *diffSrc;
+
+/* Offset of the next byte to compare and the differing range found so far */
+static uint32_t diffPos;
+static uint32_t diffFirst;
+static uint32_t diffLast;
+
+static eeprom_diff_stats_t diffStats;
+
+/*******************************************************************************
+* Function Name: DiffConsumer
+********************************************************************************
+* Summary:
+*  This function is the consumer of the streaming read of a page. It compares
+*  the current EEPROM content with the new content as it arrives and tracks the
+*  first and last differing byte, so no page buffer is needed.
+*
+* Parameters:
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void DiffConsumer(const uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0UL; i < len; i++)
+    {
+        if (data[i] != diffSrc[diffPos])
+        {
+            if (diffFirst == DIFF_NONE)
+            {
+                diffFirst = diffPos;
+            }
+            diffLast = diffPos;
+        }
+        diffPos++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_write_diff
+********************************************************************************
+* Summary:
+*  This function programs len bytes from src to the EEPROM at memory address
+*  addr, skipping what is already there. Each page of the span is streamed
+*  back and compared with src; a page that matches costs no write cycle, and a
+*  page that differs is written only from its first to its last differing
+*  byte. The function waits for every write cycle it starts.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_write_diff(eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t chunk;
+
+    if ((src == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        /* Compare up to the end of the current page */
+        chunk = EEPROM_PAGE_SIZE - ((uint32_t)addr % EEPROM_PAGE_SIZE);
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        diffSrc   = src;
+        diffPos   = 0UL;
+        diffFirst = DIFF_NONE;
+        diffLast  = 0UL;
+
+        status = eeprom_read_stream(addr, chunk, &DiffConsumer);
+        if (status == TRANSFER_CMPLT)
+        {
+            diffStats.bytesCompared += chunk;
+
+            if (diffFirst == DIFF_NONE)
+            {
+                diffStats.pagesSkipped++;
+            }
+            else
+            {
+                status = eeprom_write((eeprom_addr_t)(addr + diffFirst), &src[diffFirst],
+                                      (diffLast - diffFirst) + 1UL);
+                if (status == TRANSFER_CMPLT)
+                {
+                    status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+                }
+
+                diffStats.pagesWritten++;
+                diffStats.bytesWritten += (diffLast - diffFirst) + 1UL;
+            }
+        }
+
+        addr += (eeprom_addr_t)chunk;
+        src  += chunk;
+        len  -= chunk;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_diff_get_stats
+********************************************************************************
+* Summary:
+*  This function copies the differential programming statistics to stats.
+*  Every skipped page saves one write cycle of up to EEPROM_WRITE_CYCLE_MS.
+*
+* Parameters:
+*  eeprom_diff_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_diff_get_stats(eeprom_diff_stats_t *stats)
+{
+    *stats = diffStats;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_diff_reset_stats
+********************************************************************************
+* Summary:
+*  This function clears the differential programming statistics, for example
+*  before an image update.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_diff_reset_stats(void)
+{
+    diffStats = (eeprom_diff_stats_t){ 0UL, 0UL, 0UL, 0UL };
+}
+
+/* [] END OF FILE */
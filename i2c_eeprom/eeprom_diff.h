@@ -0,0 +1,67 @@
+/******************************************************************************
+* File Name:  eeprom_diff.h
+*
+* Description:  This file provides data types and function prototypes of
+*               differential EEPROM programming.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_DIFF_H_
+#define SOURCE_EEPROM_DIFF_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Differential programming statistics */
+typedef struct
+{
+    uint32_t pagesSkipped;  /* Pages already holding the new content */
+    uint32_t pagesWritten;  /* Pages that needed a write cycle */
+    uint32_t bytesCompared; /* Bytes read back for comparison */
+    uint32_t bytesWritten;  /* Bytes sent in page writes */
+} eeprom_diff_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_write_diff(eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+void eeprom_diff_get_stats(eeprom_diff_stats_t *stats);
+void eeprom_diff_reset_stats(void);
+
+#endif /* SOURCE_EEPROM_DIFF_H_ */
@@ -0,0 +1,196 @@
+/******************************************************************************
+* File Name:  eeprom_event.c
+*
+* Description:  This file implements the application event queue and
+*               the debounced user button.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_event.h"
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Ring buffer of events, written from interrupts and from the main loop */
+static eeprom_event_t eventQueue[EEPROM_EVENT_QUEUE_DEPTH];
+static uint32_t eventHead = 0UL;
+static uint32_t eventCount = 0UL;
+
+/* Events lost because the queue was full */
+static uint32_t eventsDropped = 0UL;
+
+/* Time of the last accepted button press */
+static uint32_t buttonPressUs = 0UL;
+static bool buttonPressed = false;
+
+/*******************************************************************************
+* Function Name: eeprom_event_post
+********************************************************************************
+* Summary:
+*  This function appends an event to the queue. It can be called from
+*  interrupt handlers.
+*
+* Parameters:
+*  uint8_t id - EEPROM_EVENT_*
+*  uint8_t arg
+*
+* Return:
+*  bool - false if the queue was full and the event was dropped
+*
+*******************************************************************************/
+bool eeprom_event_post(uint8_t id, uint8_t arg)
+{
+    bool posted = false;
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    if (eventCount < EEPROM_EVENT_QUEUE_DEPTH)
+    {
+        eeprom_event_t *slot = &eventQueue[(eventHead + eventCount) % EEPROM_EVENT_QUEUE_DEPTH];
+
+        slot->id  = id;
+        slot->arg = arg;
+        eventCount++;
+        posted = true;
+    }
+    else
+    {
+        eventsDropped++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+    return posted;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_event_get
+********************************************************************************
+* Summary:
+*  This function removes the oldest event from the queue.
+*
+* Parameters:
+*  eeprom_event_t *event
+*
+* Return:
+*  bool - false if the queue was empty
+*
+*******************************************************************************/
+bool eeprom_event_get(eeprom_event_t *event)
+{
+    bool found = false;
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    if (eventCount > 0UL)
+    {
+        *event = eventQueue[eventHead];
+        eventHead = (eventHead + 1UL) % EEPROM_EVENT_QUEUE_DEPTH;
+        eventCount--;
+        found = true;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_event_pending
+********************************************************************************
+* Summary:
+*  This function tells whether an event is queued. Call it with interrupts
+*  masked before the main loop sleeps.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool eeprom_event_pending(void)
+{
+    return (eventCount > 0UL);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_event_dropped
+********************************************************************************
+* Summary:
+*  This function returns the number of events lost to a full queue.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_event_dropped(void)
+{
+    return eventsDropped;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_event_button_isr
+********************************************************************************
+* Summary:
+*  This function is called from the button interrupt on each falling edge.
+*  The first edge of a press posts EEPROM_EVENT_BUTTON at once; the edges of
+*  the contact bounce within EEPROM_BUTTON_DEBOUNCE_MS after it are ignored.
+*  Each press is queued, so presses made while the main loop is busy with a
+*  transfer are neither lost nor merged.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_event_button_isr(void)
+{
+    uint32_t nowUs = eeprom_time_us();
+
+    if ((!buttonPressed) || ((nowUs - buttonPressUs) >= (EEPROM_BUTTON_DEBOUNCE_MS * 1000UL)))
+    {
+        buttonPressed = true;
+        buttonPressUs = nowUs;
+        (void) eeprom_event_post(EEPROM_EVENT_BUTTON, 0u);
+    }
+}
+
+/* [] END OF FILE */
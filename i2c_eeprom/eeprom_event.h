@@ -0,0 +1,84 @@
+/******************************************************************************
+* File Name:  eeprom_event.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the application event queue and the
+*               debounced user button.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_EVENT_H_
+#define SOURCE_EEPROM_EVENT_H_
+
+#include "cy_pdl.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of queued events */
+#define EEPROM_EVENT_QUEUE_DEPTH    (8UL)
+
+/* Button edges closer than this to the last accepted press are contact
+ * bounce */
+#define EEPROM_BUTTON_DEBOUNCE_MS   (50UL)
+
+/* Events of the application */
+#define EEPROM_EVENT_BUTTON         (0u)    /* Debounced button press */
+#define EEPROM_EVENT_VERIFY         (1u)    /* Read back the data written */
+#define EEPROM_EVENT_RESULT         (2u)    /* Operation done, arg: LED blinks */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Queued event */
+typedef struct
+{
+    uint8_t id;
+    uint8_t arg;
+} eeprom_event_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool eeprom_event_post(uint8_t id, uint8_t arg);
+bool eeprom_event_get(eeprom_event_t *event);
+bool eeprom_event_pending(void);
+uint32_t eeprom_event_dropped(void);
+void eeprom_event_button_isr(void);
+
+#endif /* SOURCE_EEPROM_EVENT_H_ */
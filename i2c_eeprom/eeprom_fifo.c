@@ -0,0 +1,599 @@
+/******************************************************************************
+* File Name:  eeprom_fifo.c
+*
+* Description:  This file contains the FIFO-level transfer path: page writes
+*               and sequential reads that drive the SCB FIFOs and the I2C
+*               master commands directly, moving a FIFO-sized burst per
+*               interrupt instead of going through the PDL driver state
+*               machine.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_fifo.h"
+#include "eeprom_bus.h"
+#include "eeprom_power.h"
+#include "eeprom_arb.h"
+#include "eeprom_recovery.h"
+#include "eeprom_stats.h"
+
+#if EEPROM_FIFO_ENABLE
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Transfer phases */
+#define FIFO_PHASE_IDLE         (0u)
+#define FIFO_PHASE_ADDRESS      (1u)    /* Memory address ahead of a read */
+#define FIFO_PHASE_WRITE        (2u)    /* Memory address and data */
+#define FIFO_PHASE_READ         (3u)    /* Data after the repeated Start */
+#define FIFO_PHASE_STOP         (4u)    /* Waiting for the Stop condition */
+
+/* Master interrupt sources that end a transfer early */
+#define FIFO_MASTER_ERRORS      (CY_SCB_MASTER_INTR_I2C_NACK | \
+                                 CY_SCB_MASTER_INTR_I2C_ARB_LOST | \
+                                 CY_SCB_MASTER_INTR_I2C_BUS_ERROR)
+
+/* Slave address and memory address bytes ahead of the data */
+#define FIFO_HEADER_SIZE        (1UL + EEPROM_ADDR_SIZE)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Phase of the transfer in progress, FIFO_PHASE_IDLE hands the SCB interrupt
+ * back to the PDL driver */
+static volatile uint8_t fifoPhase = FIFO_PHASE_IDLE;
+
+/* Result of the last transfer */
+static volatile uint8_t fifoStatus = TRANSFER_CMPLT;
+
+/* Data not yet in the TX FIFO, or not yet taken from the RX FIFO */
+static const uint8_t *fifoSrc = NULL;
+static uint8_t *fifoDst = NULL;
+static uint32_t fifoLeft = 0UL;
+
+/* Slave address of the transfer, including the block select bits */
+static uint32_t fifoSlaveAddr = EEPROM_SLAVE_ADDR;
+
+/* I2C_CTRL of the PDL driver, restored when the transfer ends */
+static uint32_t fifoCtrl = 0UL;
+
+/*******************************************************************************
+* Function Name: FifoFinish
+********************************************************************************
+* Summary:
+*  This function masks all interrupt sources of the transfer, restores the
+*  I2C control register and records the result. The SCB interrupt belongs to
+*  the PDL driver again afterwards.
+*
+* Parameters:
+*  uint8_t status
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void FifoFinish(uint8_t status)
+{
+    Cy_SCB_SetTxInterruptMask(CYBSP_I2C_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+    Cy_SCB_SetRxInterruptMask(CYBSP_I2C_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+    Cy_SCB_SetMasterInterruptMask(CYBSP_I2C_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+    Cy_SCB_ClearTxInterrupt(CYBSP_I2C_HW, CY_SCB_TX_INTR_LEVEL | CY_SCB_TX_INTR_UNDERFLOW);
+    Cy_SCB_ClearRxInterrupt(CYBSP_I2C_HW, CY_SCB_RX_INTR_LEVEL);
+    Cy_SCB_ClearMasterInterrupt(CYBSP_I2C_HW, FIFO_MASTER_ERRORS | CY_SCB_MASTER_INTR_I2C_STOP);
+
+    SCB_I2C_CTRL(CYBSP_I2C_HW) = fifoCtrl;
+
+    fifoStatus = status;
+    fifoPhase  = FIFO_PHASE_IDLE;
+}
+
+/*******************************************************************************
+* Function Name: FifoTxRefill
+********************************************************************************
+* Summary:
+*  This function moves as much of the remaining data into the TX FIFO as fits.
+*  Once all data is queued, the TX interrupt is switched from the FIFO level
+*  to the underflow that the master raises when it stalls after the last
+*  byte.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void FifoTxRefill(void)
+{
+    uint32_t count;
+
+    /* The driver API takes a non-const buffer but only reads from it */
+    count = Cy_SCB_WriteArray(CYBSP_I2C_HW, (void *)fifoSrc, fifoLeft);
+    fifoSrc  += count;
+    fifoLeft -= count;
+
+    Cy_SCB_SetTxInterruptMask(CYBSP_I2C_HW,
+                              (fifoLeft > 0UL) ? CY_SCB_TX_INTR_LEVEL : CY_SCB_TX_INTR_UNDERFLOW);
+}
+
+/*******************************************************************************
+* Function Name: FifoRxArm
+********************************************************************************
+* Summary:
+*  This function sets the RX FIFO level for the next burst. The hardware
+*  acknowledges the received bytes and stretches SCL while the RX FIFO is full,
+*  so the interrupt fires once per full FIFO. The last burst stops one byte
+*  short: its interrupt turns the hardware acknowledge off, and the last byte
+*  is then held until the master is told to NAK it. As in the PDL driver, that
+*  interrupt has to be served within one byte time on the bus.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void FifoRxArm(void)
+{
+    uint32_t burst = fifoLeft - 1UL;
+
+    if (burst == 0UL)
+    {
+        /* Only the last byte is left */
+        SCB_I2C_CTRL(CYBSP_I2C_HW) &= ~SCB_I2C_CTRL_M_READY_DATA_ACK_Msk;
+        burst = 1UL;
+    }
+    else if (burst > Cy_SCB_GetFifoSize(CYBSP_I2C_HW))
+    {
+        burst = Cy_SCB_GetFifoSize(CYBSP_I2C_HW);
+    }
+    else if (burst == Cy_SCB_GetFifoSize(CYBSP_I2C_HW))
+    {
+        /* A full FIFO holds off the acknowledge of its last byte, which
+         * would then wait for a manual ACK once the hardware acknowledge is
+         * off. The burst ahead of the last byte leaves room in the FIFO. */
+        burst--;
+    }
+    else
+    {
+        /* The last burst */
+    }
+
+    /* The level interrupt fires when the FIFO holds more than level bytes */
+    Cy_SCB_SetRxFifoLevel(CYBSP_I2C_HW, burst - 1UL);
+}
+
+/*******************************************************************************
+* Function Name: FifoStart
+********************************************************************************
+* Summary:
+*  This function queues the slave address and the memory address, followed by
+*  as much write data as fits, in the TX FIFO and starts the transaction.
+*  Without src the transaction continues with a repeated Start and a read of
+*  len bytes to dst.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src - data to write, or NULL for a read
+*  uint8_t *dst - read buffer
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void FifoStart(eeprom_addr_t addr, const uint8_t *src, uint8_t *dst, uint32_t len)
+{
+    uint8_t header[FIFO_HEADER_SIZE];
+
+    fifoSlaveAddr = EEPROM_SLAVE_ADDR_AT(addr);
+    header[0] = (uint8_t)((fifoSlaveAddr << 1u) | (uint32_t)CY_SCB_I2C_WRITE_XFER);
+#if (EEPROM_ADDR_SIZE == 2UL)
+    header[1] = (uint8_t)(((uint32_t)addr >> 8u) & 0xFFu);
+    header[2] = (uint8_t)(addr & 0xFFu);
+#else
+    header[1] = (uint8_t)(addr & 0xFFu);
+#endif
+
+    fifoSrc  = src;
+    fifoDst  = dst;
+    fifoLeft = len;
+    fifoCtrl = SCB_I2C_CTRL(CYBSP_I2C_HW);
+
+    /* Hardware acknowledge of read data, SCL is stretched on a full RX FIFO */
+    SCB_I2C_CTRL(CYBSP_I2C_HW) = (fifoCtrl | SCB_I2C_CTRL_M_READY_DATA_ACK_Msk) &
+                                 ~SCB_I2C_CTRL_M_NOT_READY_DATA_NACK_Msk;
+
+    Cy_SCB_ClearTxFifo(CYBSP_I2C_HW);
+    Cy_SCB_ClearRxFifo(CYBSP_I2C_HW);
+    Cy_SCB_ClearTxInterrupt(CYBSP_I2C_HW, CY_SCB_TX_INTR_LEVEL | CY_SCB_TX_INTR_UNDERFLOW);
+    Cy_SCB_ClearRxInterrupt(CYBSP_I2C_HW, CY_SCB_RX_INTR_LEVEL);
+    Cy_SCB_ClearMasterInterrupt(CYBSP_I2C_HW, FIFO_MASTER_ERRORS | CY_SCB_MASTER_INTR_I2C_STOP);
+    Cy_SCB_SetTxFifoLevel(CYBSP_I2C_HW, EEPROM_FIFO_TX_LEVEL);
+
+    /* The header always fits the empty FIFO */
+    (void)Cy_SCB_WriteArray(CYBSP_I2C_HW, header, FIFO_HEADER_SIZE);
+
+    if (src != NULL)
+    {
+        fifoPhase = FIFO_PHASE_WRITE;
+        FifoTxRefill();
+    }
+    else
+    {
+        fifoPhase = FIFO_PHASE_ADDRESS;
+        Cy_SCB_SetTxInterruptMask(CYBSP_I2C_HW, CY_SCB_TX_INTR_UNDERFLOW);
+    }
+    Cy_SCB_SetMasterInterruptMask(CYBSP_I2C_HW, FIFO_MASTER_ERRORS | CY_SCB_MASTER_INTR_I2C_STOP);
+
+    SCB_I2C_M_CMD(CYBSP_I2C_HW) = SCB_I2C_M_CMD_M_START_ON_IDLE_Msk;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_fifo_interrupt
+********************************************************************************
+* Summary:
+*  This function services the SCB interrupt while a FIFO-level transfer is in
+*  progress and is called from CYBSP_I2C_Interrupt. Each call moves a whole
+*  burst between the FIFOs and the buffer or advances the transaction to its
+*  next phase.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool - false if no FIFO-level transfer is in progress and the interrupt
+*         belongs to the PDL driver
+*
+*******************************************************************************/
+bool eeprom_fifo_interrupt(void)
+{
+    uint32_t master;
+    uint32_t tx;
+
+    if (fifoPhase == FIFO_PHASE_IDLE)
+    {
+        return false;
+    }
+
+    master = Cy_SCB_GetMasterInterruptStatusMasked(CYBSP_I2C_HW);
+    tx = Cy_SCB_GetTxInterruptStatusMasked(CYBSP_I2C_HW);
+
+    if (0UL != (master & FIFO_MASTER_ERRORS))
+    {
+        if (0UL != (master & CY_SCB_MASTER_INTR_I2C_NACK))
+        {
+            /* The master still owns the bus after a NAK. The device
+             * acknowledges every data byte, so a NAK before the read means
+             * it is busy in its write cycle. */
+            SCB_I2C_M_CMD(CYBSP_I2C_HW) = SCB_I2C_M_CMD_M_STOP_Msk;
+            FifoFinish((fifoPhase == FIFO_PHASE_READ) ? TRANSFER_ERROR : ADDR_NAK_ERROR);
+        }
+        else if (0UL != (master & CY_SCB_MASTER_INTR_I2C_ARB_LOST))
+        {
+            /* Another master won the bus and ends the transaction */
+            FifoFinish(ARB_LOST_ERROR);
+        }
+        else
+        {
+            /* Bus error, the master already released the bus */
+            FifoFinish(TRANSFER_ERROR);
+        }
+    }
+    else if (0UL != (master & CY_SCB_MASTER_INTR_I2C_STOP))
+    {
+        FifoFinish(TRANSFER_CMPLT);
+    }
+    else if (fifoPhase == FIFO_PHASE_READ)
+    {
+        /* A burst arrived */
+        uint32_t count = Cy_SCB_ReadArray(CYBSP_I2C_HW, fifoDst, fifoLeft);
+
+        fifoDst  += count;
+        fifoLeft -= count;
+        Cy_SCB_ClearRxInterrupt(CYBSP_I2C_HW, CY_SCB_RX_INTR_LEVEL);
+
+        if (fifoLeft == 0UL)
+        {
+            Cy_SCB_SetRxInterruptMask(CYBSP_I2C_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+            SCB_I2C_M_CMD(CYBSP_I2C_HW) = SCB_I2C_M_CMD_M_NACK_Msk | SCB_I2C_M_CMD_M_STOP_Msk;
+            fifoPhase = FIFO_PHASE_STOP;
+        }
+        else
+        {
+            FifoRxArm();
+        }
+    }
+    else if (0UL != (tx & CY_SCB_TX_INTR_UNDERFLOW))
+    {
+        Cy_SCB_ClearTxInterrupt(CYBSP_I2C_HW, CY_SCB_TX_INTR_LEVEL | CY_SCB_TX_INTR_UNDERFLOW);
+        Cy_SCB_SetTxInterruptMask(CYBSP_I2C_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+
+        if (fifoPhase == FIFO_PHASE_ADDRESS)
+        {
+            /* Memory address sent, read with a repeated Start */
+            FifoRxArm();
+            Cy_SCB_SetRxInterruptMask(CYBSP_I2C_HW, CY_SCB_RX_INTR_LEVEL);
+            Cy_SCB_WriteTxFifo(CYBSP_I2C_HW, (fifoSlaveAddr << 1u) | (uint32_t)CY_SCB_I2C_READ_XFER);
+            SCB_I2C_M_CMD(CYBSP_I2C_HW) = SCB_I2C_M_CMD_M_START_Msk;
+            fifoPhase = FIFO_PHASE_READ;
+        }
+        else
+        {
+            /* Last byte written, the Stop condition starts the write cycle */
+            SCB_I2C_M_CMD(CYBSP_I2C_HW) = SCB_I2C_M_CMD_M_STOP_Msk;
+            fifoPhase = FIFO_PHASE_STOP;
+        }
+    }
+    else if (0UL != (tx & CY_SCB_TX_INTR_LEVEL))
+    {
+        FifoTxRefill();
+        Cy_SCB_ClearTxInterrupt(CYBSP_I2C_HW, CY_SCB_TX_INTR_LEVEL);
+    }
+    else
+    {
+        /* Nothing of this transfer is pending */
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FifoTransfer
+********************************************************************************
+* Summary:
+*  This function runs one FIFO-level transaction and waits until it completes.
+*  With EEPROM_POWER_SLEEP_ENABLE the CPU sleeps between the bursts. The
+*  timeout follows from len and the bus speed, and a transfer error is retried
+*  as set by eeprom_recovery_retry(). After a lost arbitration, as set by
+*  eeprom_arb_retry(), a read resumes behind the data already in dst. A write
+*  is repeated as a whole because bytes still in the TX FIFO are not known to
+*  be sent, once the write cycle the winner may have started is over.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src - data to write, or NULL for a read
+*  uint8_t *dst - read buffer
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t FifoTransfer(eeprom_addr_t addr, const uint8_t *src, uint8_t *dst, uint32_t len)
+{
+    uint32_t timeoutUs = eeprom_bus_timeout_ms(len) * 1000UL;
+    uint32_t startUs;
+    uint32_t intState;
+    uint32_t attempt = 0UL;
+    uint32_t contention = 0UL;
+    uint32_t done = 0UL;
+    uint32_t resume;
+    uint8_t status;
+#if EEPROM_STATS_ENABLE
+    uint32_t xferStartTicks = eeprom_time_ticks();
+#endif
+
+    /* The PDL driver must not be in the middle of a transfer */
+    if (eeprom_is_busy())
+    {
+        return TRANSFER_BUSY;
+    }
+
+    for (;;)
+    {
+        /* The Start is held in hardware while another master owns the bus */
+        (void)eeprom_arb_bus_free(&eeprom_default_dev);
+
+        resume = done;
+        FifoStart((eeprom_addr_t)(addr + done), src, (dst != NULL) ? &dst[done] : NULL, len - done);
+        startUs = eeprom_time_us();
+
+        while (fifoPhase != FIFO_PHASE_IDLE)
+        {
+            /* The interrupt cannot slip in between check and sleep */
+            intState = Cy_SysLib_EnterCriticalSection();
+            if ((fifoPhase != FIFO_PHASE_IDLE) && ((eeprom_time_us() - startUs) >= timeoutUs))
+            {
+                /* Timeout recovery */
+                FifoFinish(TRANSFER_ERROR);
+                Cy_SCB_I2C_Disable(eeprom_default_dev.base, eeprom_default_dev.context);
+                Cy_SCB_I2C_Enable(eeprom_default_dev.base, eeprom_default_dev.context);
+#if EEPROM_STATS_ENABLE
+                eeprom_stats_timeout();
+#endif
+            }
+            else if (fifoPhase != FIFO_PHASE_IDLE)
+            {
+#if EEPROM_POWER_SLEEP_ENABLE
+                eeprom_power_sleep();
+#endif
+            }
+            else
+            {
+                /* Completed */
+            }
+            Cy_SysLib_ExitCriticalSection(intState);
+        }
+        status = fifoStatus;
+
+        if (status == ARB_LOST_ERROR)
+        {
+            if (src == NULL)
+            {
+                done = len - fifoLeft;
+            }
+            if (!eeprom_arb_retry(&contention, done - resume))
+            {
+                break;
+            }
+            if (src != NULL)
+            {
+                (void)eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+            }
+        }
+        else if ((status != TRANSFER_ERROR) || !eeprom_recovery_retry(&eeprom_default_dev, attempt++))
+        {
+            break;
+        }
+        else
+        {
+            /* Retry after a transfer error, the whole transfer is repeated */
+            done = 0UL;
+        }
+    }
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_xfer((src != NULL) ? EEPROM_STATS_OP_WRITE : EEPROM_STATS_OP_READ,
+                      eeprom_time_ticks() - xferStartTicks);
+    if (status == ADDR_NAK_ERROR)
+    {
+        eeprom_stats_error(CY_SCB_I2C_MASTER_ADDR_NAK);
+    }
+#endif
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_fifo_write
+********************************************************************************
+* Summary:
+*  This function writes len bytes from src to the EEPROM on the kit I2C bus
+*  like eeprom_write(), one page-bounded burst per transaction, but moves the
+*  data with the FIFO-level transfer path: src is copied straight into the TX
+*  FIFO a FIFO-sized burst per interrupt. The caller must call
+*  eeprom_wait_ready() before the next access.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_fifo_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t chunk;
+
+    if ((src == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    eeprom_blocking_begin();
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        /* Burst up to the end of the current page */
+        chunk = EEPROM_PAGE_SIZE - ((uint32_t)addr % EEPROM_PAGE_SIZE);
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        status = FifoTransfer(addr, src, NULL, chunk);
+
+        addr += (eeprom_addr_t)chunk;
+        src  += chunk;
+        len  -= chunk;
+
+        if ((len > 0UL) && (status == TRANSFER_CMPLT))
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+    }
+    eeprom_blocking_end();
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_fifo_read
+********************************************************************************
+* Summary:
+*  This function reads len bytes from the EEPROM on the kit I2C bus starting at
+*  memory address addr into dst like eeprom_read(), but moves the data with
+*  the FIFO-level transfer path: a FIFO-sized burst per interrupt, straight
+*  from the RX FIFO into dst. Each block is read in its own transaction.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_fifo_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t span;
+
+    if ((dst == NULL) || (len == 0UL) || (((uint32_t)addr + len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    eeprom_blocking_begin();
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        /* A sequential read wraps around within a block */
+        span = EEPROM_BLOCK_SIZE - ((uint32_t)addr % EEPROM_BLOCK_SIZE);
+        if (span > len)
+        {
+            span = len;
+        }
+
+        status = FifoTransfer(addr, NULL, dst, span);
+
+        addr += (eeprom_addr_t)span;
+        dst  += span;
+        len  -= span;
+    }
+    eeprom_blocking_end();
+
+    return (status);
+}
+
+#endif /* EEPROM_FIFO_ENABLE */
+
+/* [] END OF FILE */
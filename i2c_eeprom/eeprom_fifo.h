@@ -0,0 +1,69 @@
+/******************************************************************************
+* File Name:  eeprom_fifo.h
+*
+* Description:  This file provides constants and function prototypes of the
+*               FIFO-level transfer path for large blocks.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_FIFO_H_
+#define SOURCE_EEPROM_FIFO_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Build the FIFO-level transfer path, 0u leaves the SCB interrupt to the
+ * PDL driver alone, can be overridden from the Makefile DEFINES */
+#ifndef EEPROM_FIFO_ENABLE
+#define EEPROM_FIFO_ENABLE          (1u)
+#endif
+
+/* The TX FIFO is refilled once fewer bytes than this are left in it. Two
+ * bytes give the interrupt one byte time on the bus to run before the master
+ * stalls, and leave the rest of the FIFO for each burst. */
+#define EEPROM_FIFO_TX_LEVEL        (2UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_fifo_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len);
+uint8_t eeprom_fifo_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len);
+bool eeprom_fifo_interrupt(void);
+
+#endif /* SOURCE_EEPROM_FIFO_H_ */
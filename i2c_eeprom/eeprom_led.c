@@ -0,0 +1,214 @@
+/******************************************************************************
+* File Name:  eeprom_led.c
+*
+* Description:  This file implements the non-blocking status LED: blink
+*               patterns are queued and advanced by a timer-driven state
+*               machine.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_led.h"
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* States of the pattern engine */
+#define LED_IDLE            (0u)
+#define LED_ON              (1u)
+#define LED_OFF             (2u)
+#define LED_GAP             (3u)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Blink counts of the queued patterns */
+static uint8_t ledQueue[EEPROM_LED_QUEUE_DEPTH];
+static uint32_t ledHead = 0UL;
+static uint32_t ledCount = 0UL;
+
+/* Pattern being shown */
+static uint8_t ledState = LED_IDLE;
+static uint8_t ledBlinksLeft = 0u;
+static uint32_t ledStateStartUs = 0UL;
+static uint32_t ledStateUs = 0UL;
+
+/*******************************************************************************
+* Function Name: LedEnter
+********************************************************************************
+* Summary:
+*  This function switches the pattern engine to state, which lasts ms
+*  milliseconds, and drives the LED for it. The user LED is active low.
+*
+* Parameters:
+*  uint8_t state
+*  uint32_t ms
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LedEnter(uint8_t state, uint32_t ms)
+{
+    if (state == LED_ON)
+    {
+        Cy_GPIO_Clr(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
+    }
+    else
+    {
+        Cy_GPIO_Set(CYBSP_USER_LED_PORT, CYBSP_USER_LED_PIN);
+    }
+
+    ledState        = state;
+    ledStateStartUs = eeprom_time_us();
+    ledStateUs      = ms * 1000UL;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_led_blink
+********************************************************************************
+* Summary:
+*  This function queues a pattern of count blinks at 1 Hz and returns at once.
+*  Patterns are shown in order, separated by EEPROM_LED_GAP_MS. When the
+*  queue is full, the oldest queued pattern is dropped so that the latest
+*  status is always shown. Call eeprom_led_tick() from the main loop to
+*  advance them.
+*
+* Parameters:
+*  uint8_t count
+*
+* Return:
+*  bool - false if count is 0, or if an older pattern was dropped for it
+*
+*******************************************************************************/
+bool eeprom_led_blink(uint8_t count)
+{
+    bool dropped = false;
+
+    if (count == 0u)
+    {
+        return false;
+    }
+
+    if (ledCount >= EEPROM_LED_QUEUE_DEPTH)
+    {
+        ledHead = (ledHead + 1UL) % EEPROM_LED_QUEUE_DEPTH;
+        ledCount--;
+        dropped = true;
+    }
+
+    ledQueue[(ledHead + ledCount) % EEPROM_LED_QUEUE_DEPTH] = count;
+    ledCount++;
+
+    eeprom_led_tick();
+    return !dropped;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_led_tick
+********************************************************************************
+* Summary:
+*  This function advances the pattern engine when the current state has run
+*  its time. It never waits, so it can be called on every pass of the main
+*  loop; the 1-ms SysTick tick wakes the loop often enough.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_led_tick(void)
+{
+    if ((ledState != LED_IDLE) && ((eeprom_time_us() - ledStateStartUs) < ledStateUs))
+    {
+        return;
+    }
+
+    switch (ledState)
+    {
+        case LED_ON:
+            LedEnter(LED_OFF, EEPROM_LED_OFF_MS);
+            break;
+
+        case LED_OFF:
+            ledBlinksLeft--;
+            if (ledBlinksLeft > 0u)
+            {
+                LedEnter(LED_ON, EEPROM_LED_ON_MS);
+            }
+            else
+            {
+                LedEnter(LED_GAP, EEPROM_LED_GAP_MS);
+            }
+            break;
+
+        default:
+            /* Idle, or the gap after a pattern is over: start the next one */
+            ledState = LED_IDLE;
+            if (ledCount > 0UL)
+            {
+                ledBlinksLeft = ledQueue[ledHead];
+                ledHead = (ledHead + 1UL) % EEPROM_LED_QUEUE_DEPTH;
+                ledCount--;
+                LedEnter(LED_ON, EEPROM_LED_ON_MS);
+            }
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_led_busy
+********************************************************************************
+* Summary:
+*  This function tells whether a pattern is shown or queued.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool eeprom_led_busy(void)
+{
+    return ((ledState != LED_IDLE) || (ledCount > 0UL));
+}
+
+/* [] END OF FILE */
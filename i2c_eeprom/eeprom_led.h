@@ -0,0 +1,69 @@
+/******************************************************************************
+* File Name:  eeprom_led.h
+*
+* Description:  This file provides constants and function prototypes of
+*               the non-blocking status LED patterns.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_LED_H_
+#define SOURCE_EEPROM_LED_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Blink patterns waiting behind the one shown, the oldest is dropped when a
+ * new one arrives on a full queue */
+#define EEPROM_LED_QUEUE_DEPTH      (4UL)
+
+/* On and off time of one blink, 1 Hz as BlinkUserLED() */
+#define EEPROM_LED_ON_MS            (LED_DELAY_MS)
+#define EEPROM_LED_OFF_MS           (LED_DELAY_MS)
+
+/* Pause between two patterns so that they can be told apart */
+#define EEPROM_LED_GAP_MS           (1000UL)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool eeprom_led_blink(uint8_t count);
+void eeprom_led_tick(void);
+bool eeprom_led_busy(void);
+
+#endif /* SOURCE_EEPROM_LED_H_ */
@@ -0,0 +1,674 @@
+/******************************************************************************
+* File Name:  eeprom_log.c
+*
+* Description:  This file implements a log-structured, wear-leveled
+*               key/value record store. Records are appended sequentially
+*               around a ring of pages, a RAM index maps every key to its
+*               latest record, and compaction moves live records away from
+*               the oldest page before it is reused.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_log.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Header field offsets */
+#define REC_KEY                 (0u)
+#define REC_LEN                 (1u)
+#define REC_SEQ                 (2u)
+#define REC_CRC                 (4u)
+
+/* Pages kept free ahead of the head so that compaction can always proceed */
+#define LOG_RESERVE_PAGES       (1UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* RAM index entry: location and sequence number of the latest record of a key */
+typedef struct
+{
+    bool used;
+    uint8_t key;
+    uint8_t len;
+    uint16_t seq;
+    uint16_t offset;    /* Offset of the record from EEPROM_LOG_START */
+} log_index_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static log_index_t logIndex[EEPROM_LOG_MAX_KEYS];
+
+/* Append position and the oldest page that may still hold live records */
+static uint32_t headPage = 0UL;
+static uint32_t headOffset = 0UL;
+static uint32_t tailPage = 0UL;
+
+/* Sequence number of the next record */
+static uint16_t nextSeq = 0u;
+
+static bool compacting = false;
+
+static eeprom_log_stats_t logStats;
+
+/*******************************************************************************
+* Function Declaration
+*******************************************************************************/
+static uint8_t LogAppend(uint8_t key, const uint8_t *data, uint32_t len);
+
+/*******************************************************************************
+* Function Name: LogCrc16
+********************************************************************************
+* Summary:
+*  This function returns the CRC-16 (CCITT) of a record: the header without
+*  the CRC field, followed by the data.
+*
+* Parameters:
+*  const uint8_t *record
+*  uint32_t len - length of the data
+*
+* Return:
+*  uint16_t
+*
+*******************************************************************************/
+static uint16_t LogCrc16(const uint8_t *record, uint32_t len)
+{
+    uint16_t crc = 0xFFFFu;
+    uint32_t total = EEPROM_LOG_HEADER_SIZE + len;
+
+    for (uint32_t i = 0UL; i < total; i++)
+    {
+        /* Skip the CRC field itself */
+        if ((i == REC_CRC) || (i == (REC_CRC + 1u)))
+        {
+            continue;
+        }
+
+        crc ^= (uint16_t)((uint16_t)record[i] << 8u);
+        for (uint32_t bit = 0UL; bit < 8UL; bit++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16_t)((crc << 1u) ^ 0x1021u) : (uint16_t)(crc << 1u);
+        }
+    }
+    return (crc);
+}
+
+/*******************************************************************************
+* Function Name: LogSeqNewer
+********************************************************************************
+* Summary:
+*  This function returns true if sequence number a is newer than b, allowing
+*  for wrap-around.
+*
+* Parameters:
+*  uint16_t a
+*  uint16_t b
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+static bool LogSeqNewer(uint16_t a, uint16_t b)
+{
+    return ((int16_t)(uint16_t)(a - b) > 0);
+}
+
+/*******************************************************************************
+* Function Name: LogFindKey
+********************************************************************************
+* Summary:
+*  This function returns the index entry of key, or NULL if the key has no
+*  record.
+*
+* Parameters:
+*  uint8_t key
+*
+* Return:
+*  log_index_t *
+*
+*******************************************************************************/
+static log_index_t *LogFindKey(uint8_t key)
+{
+    for (uint32_t i = 0UL; i < EEPROM_LOG_MAX_KEYS; i++)
+    {
+        if (logIndex[i].used && (logIndex[i].key == key))
+        {
+            return &logIndex[i];
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: LogUpdateIndex
+********************************************************************************
+* Summary:
+*  This function points the index entry of key at a record, adding the key to
+*  the index if needed.
+*
+* Parameters:
+*  uint8_t key
+*  uint8_t len
+*  uint16_t seq
+*  uint16_t offset
+*
+* Return:
+*  uint8_t status - LOG_FULL_ERROR if the index has no free entry
+*
+*******************************************************************************/
+static uint8_t LogUpdateIndex(uint8_t key, uint8_t len, uint16_t seq, uint16_t offset)
+{
+    log_index_t *entry = LogFindKey(key);
+
+    for (uint32_t i = 0UL; (entry == NULL) && (i < EEPROM_LOG_MAX_KEYS); i++)
+    {
+        if (!logIndex[i].used)
+        {
+            entry = &logIndex[i];
+        }
+    }
+
+    if (entry == NULL)
+    {
+        return LOG_FULL_ERROR;
+    }
+
+    entry->used   = true;
+    entry->key    = key;
+    entry->len    = len;
+    entry->seq    = seq;
+    entry->offset = offset;
+
+    return TRANSFER_CMPLT;
+}
+
+/*******************************************************************************
+* Function Name: LogFindTail
+********************************************************************************
+* Summary:
+*  This function sets tailPage to the first page after the head page that
+*  holds a live record. Pages between the head and the tail are free.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LogFindTail(void)
+{
+    tailPage = headPage;
+
+    for (uint32_t d = 1UL; d < EEPROM_LOG_PAGES; d++)
+    {
+        uint32_t page = (headPage + d) % EEPROM_LOG_PAGES;
+
+        for (uint32_t i = 0UL; i < EEPROM_LOG_MAX_KEYS; i++)
+        {
+            if (logIndex[i].used && ((logIndex[i].offset / EEPROM_PAGE_SIZE) == page))
+            {
+                tailPage = page;
+                return;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: LogFreePages
+********************************************************************************
+* Summary:
+*  This function returns the number of free pages between the head and the
+*  tail.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t LogFreePages(void)
+{
+    if (tailPage == headPage)
+    {
+        return (EEPROM_LOG_PAGES - 1UL);
+    }
+    return ((tailPage + EEPROM_LOG_PAGES - headPage - 1UL) % EEPROM_LOG_PAGES);
+}
+
+/*******************************************************************************
+* Function Name: LogCompactTail
+********************************************************************************
+* Summary:
+*  This function reclaims the tail page by appending a copy of each live record
+*  it holds at the head. The copies get new sequence numbers, so after a power
+*  cut either the original or the complete copy is found at mount.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t LogCompactTail(void)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint8_t record[EEPROM_PAGE_SIZE];
+    uint32_t page = tailPage;
+
+    for (uint32_t i = 0UL; (i < EEPROM_LOG_MAX_KEYS) && (status == TRANSFER_CMPLT); i++)
+    {
+        log_index_t *entry = &logIndex[i];
+
+        if (entry->used && ((entry->offset / EEPROM_PAGE_SIZE) == page))
+        {
+            status = eeprom_read((eeprom_addr_t)(EEPROM_LOG_START + entry->offset), record,
+                                 EEPROM_LOG_HEADER_SIZE + entry->len);
+            if (status == TRANSFER_CMPLT)
+            {
+                status = LogAppend(entry->key, &record[EEPROM_LOG_HEADER_SIZE], entry->len);
+                logStats.relocated++;
+            }
+        }
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        logStats.gcRuns++;
+        LogFindTail();
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: LogNextPage
+********************************************************************************
+* Summary:
+*  This function moves the head to the next page, compacting the tail first
+*  when the free pages ahead of the head run out.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status - LOG_FULL_ERROR if compaction cannot free a page
+*
+*******************************************************************************/
+static uint8_t LogNextPage(void)
+{
+    uint8_t status = TRANSFER_CMPLT;
+
+    if (!compacting)
+    {
+        compacting = true;
+
+        /* Each pass reclaims the tail page and uses at most one new page */
+        for (uint32_t pass = 0UL; (pass < EEPROM_LOG_PAGES) && (status == TRANSFER_CMPLT) &&
+                                  (LogFreePages() <= LOG_RESERVE_PAGES); pass++)
+        {
+            status = LogCompactTail();
+        }
+
+        compacting = false;
+
+        if ((status == TRANSFER_CMPLT) && (LogFreePages() <= LOG_RESERVE_PAGES))
+        {
+            status = LOG_FULL_ERROR;
+        }
+    }
+    else if (LogFreePages() == 0UL)
+    {
+        status = LOG_FULL_ERROR;
+    }
+    else
+    {
+        /* Compaction in progress uses the reserve */
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        headPage   = (headPage + 1UL) % EEPROM_LOG_PAGES;
+        headOffset = 0UL;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: LogAppend
+********************************************************************************
+* Summary:
+*  This function appends a record at the head with a single page write. A
+*  record that does not fit into the rest of the head page starts a new page;
+*  the first record of a page is written together with free space filling the
+*  rest of the page, which clears what the previous lap left behind.
+*
+* Parameters:
+*  uint8_t key
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t LogAppend(uint8_t key, const uint8_t *data, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint8_t record[EEPROM_PAGE_SIZE];
+    uint32_t recordLen = EEPROM_LOG_HEADER_SIZE + len;
+    uint32_t writeLen = recordLen;
+    uint16_t crc;
+    uint16_t offset;
+
+    if ((headOffset + recordLen) > EEPROM_PAGE_SIZE)
+    {
+        status = LogNextPage();
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        record[REC_KEY]      = key;
+        record[REC_LEN]      = (uint8_t)len;
+        record[REC_SEQ]      = (uint8_t)(nextSeq & 0xFFu);
+        record[REC_SEQ + 1u] = (uint8_t)(nextSeq >> 8u);
+        memcpy(&record[EEPROM_LOG_HEADER_SIZE], data, len);
+
+        crc = LogCrc16(record, len);
+        record[REC_CRC]      = (uint8_t)(crc & 0xFFu);
+        record[REC_CRC + 1u] = (uint8_t)(crc >> 8u);
+
+        if (headOffset == 0UL)
+        {
+            memset(&record[recordLen], EEPROM_LOG_KEY_FREE, EEPROM_PAGE_SIZE - recordLen);
+            writeLen = EEPROM_PAGE_SIZE;
+        }
+
+        offset = (uint16_t)((headPage * EEPROM_PAGE_SIZE) + headOffset);
+
+        status = eeprom_write((eeprom_addr_t)(EEPROM_LOG_START + offset), record, writeLen);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+        logStats.pageWrites++;
+
+        if (status == TRANSFER_CMPLT)
+        {
+            status = LogUpdateIndex(key, (uint8_t)len, nextSeq, offset);
+            headOffset += recordLen;
+            nextSeq++;
+        }
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_log_format
+********************************************************************************
+* Summary:
+*  This function erases the record store region and clears the index. Call it
+*  once on a new device before eeprom_log_mount().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_log_format(void)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint8_t blank[EEPROM_PAGE_SIZE];
+
+    memset(blank, EEPROM_LOG_KEY_FREE, sizeof(blank));
+
+    for (uint32_t page = 0UL; (page < EEPROM_LOG_PAGES) && (status == TRANSFER_CMPLT); page++)
+    {
+        status = eeprom_write((eeprom_addr_t)(EEPROM_LOG_START + (page * EEPROM_PAGE_SIZE)),
+                              blank, EEPROM_PAGE_SIZE);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+    }
+
+    memset(logIndex, 0, sizeof(logIndex));
+    headPage   = 0UL;
+    headOffset = 0UL;
+    tailPage   = 0UL;
+    nextSeq    = 0u;
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_log_mount
+********************************************************************************
+* Summary:
+*  This function scans the record store region and builds the RAM index from
+*  the newest valid record of every key. The append position follows the
+*  newest record overall. A record that fails its CRC, such as one torn by a
+*  power cut, ends the scan of its page and is ignored.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_log_mount(void)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint8_t page[EEPROM_PAGE_SIZE];
+    bool found = false;
+    uint16_t newestSeq = 0u;
+
+    memset(logIndex, 0, sizeof(logIndex));
+    headPage   = 0UL;
+    headOffset = 0UL;
+
+    for (uint32_t p = 0UL; (p < EEPROM_LOG_PAGES) && (status == TRANSFER_CMPLT); p++)
+    {
+        uint32_t pos = 0UL;
+
+        status = eeprom_read((eeprom_addr_t)(EEPROM_LOG_START + (p * EEPROM_PAGE_SIZE)), page, EEPROM_PAGE_SIZE);
+
+        while ((status == TRANSFER_CMPLT) && ((pos + EEPROM_LOG_HEADER_SIZE) <= EEPROM_PAGE_SIZE) &&
+               (page[pos + REC_KEY] != EEPROM_LOG_KEY_FREE))
+        {
+            uint32_t len = page[pos + REC_LEN];
+            uint16_t seq = (uint16_t)(page[pos + REC_SEQ] | (page[pos + REC_SEQ + 1u] << 8u));
+            uint16_t crc = (uint16_t)(page[pos + REC_CRC] | (page[pos + REC_CRC + 1u] << 8u));
+            uint16_t offset = (uint16_t)((p * EEPROM_PAGE_SIZE) + pos);
+            log_index_t *entry;
+
+            if (((pos + EEPROM_LOG_HEADER_SIZE + len) > EEPROM_PAGE_SIZE) ||
+                (crc != LogCrc16(&page[pos], len)))
+            {
+                logStats.discarded++;
+                break;
+            }
+
+            entry = LogFindKey(page[pos + REC_KEY]);
+            if ((entry == NULL) || LogSeqNewer(seq, entry->seq))
+            {
+                (void) LogUpdateIndex(page[pos + REC_KEY], (uint8_t)len, seq, offset);
+            }
+
+            if ((!found) || LogSeqNewer(seq, newestSeq))
+            {
+                found      = true;
+                newestSeq  = seq;
+                headPage   = p;
+                headOffset = pos + EEPROM_LOG_HEADER_SIZE + len;
+            }
+
+            pos += EEPROM_LOG_HEADER_SIZE + len;
+        }
+    }
+
+    nextSeq = found ? (uint16_t)(newestSeq + 1u) : 0u;
+    LogFindTail();
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_log_write
+********************************************************************************
+* Summary:
+*  This function stores len bytes of data as the new value of key by appending
+*  a record; the previous record of the key becomes garbage. The append costs
+*  at most one page write, plus compaction when the free pages run out.
+*
+* Parameters:
+*  uint8_t key - any value except EEPROM_LOG_KEY_FREE
+*  const uint8_t *data
+*  uint32_t len - up to EEPROM_LOG_MAX_DATA bytes
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_log_write(uint8_t key, const uint8_t *data, uint32_t len)
+{
+    uint8_t status;
+
+    if ((key == EEPROM_LOG_KEY_FREE) || (len > EEPROM_LOG_MAX_DATA) ||
+        ((data == NULL) && (len > 0UL)))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    /* A new key needs a free index entry */
+    if (LogFindKey(key) == NULL)
+    {
+        status = LOG_FULL_ERROR;
+        for (uint32_t i = 0UL; i < EEPROM_LOG_MAX_KEYS; i++)
+        {
+            if (!logIndex[i].used)
+            {
+                status = TRANSFER_CMPLT;
+            }
+        }
+        if (status != TRANSFER_CMPLT)
+        {
+            return status;
+        }
+    }
+
+    status = LogAppend(key, data, len);
+    if (status == TRANSFER_CMPLT)
+    {
+        logStats.appends++;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_log_read
+********************************************************************************
+* Summary:
+*  This function reads the latest value of key into dst. The record is located
+*  through the RAM index and read with a single random read.
+*
+* Parameters:
+*  uint8_t key
+*  uint8_t *dst
+*  uint32_t size - size of dst
+*  uint32_t *len - length of the value
+*
+* Return:
+*  uint8_t status - LOG_NOT_FOUND_ERROR if the key has no record
+*
+*******************************************************************************/
+uint8_t eeprom_log_read(uint8_t key, uint8_t *dst, uint32_t size, uint32_t *len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    log_index_t *entry = LogFindKey(key);
+
+    if (entry == NULL)
+    {
+        return LOG_NOT_FOUND_ERROR;
+    }
+
+    if ((size < entry->len) || ((dst == NULL) && (entry->len > 0u)))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    if (entry->len > 0u)
+    {
+        status = eeprom_read((eeprom_addr_t)(EEPROM_LOG_START + entry->offset + EEPROM_LOG_HEADER_SIZE),
+                             dst, entry->len);
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        *len = entry->len;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_log_get_stats
+********************************************************************************
+* Summary:
+*  This function copies the record store statistics to stats.
+*
+* Parameters:
+*  eeprom_log_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_log_get_stats(eeprom_log_stats_t *stats)
+{
+    *stats = logStats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/******************************************************************************
+* File Name:  eeprom_log.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the log-structured EEPROM record store.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_LOG_H_
+#define SOURCE_EEPROM_LOG_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* EEPROM region used by the record store, the upper half of the device */
+#define EEPROM_LOG_START            (EEPROM_SIZE / 2UL)
+#define EEPROM_LOG_SIZE             (EEPROM_SIZE / 2UL)
+#define EEPROM_LOG_PAGES            (EEPROM_LOG_SIZE / EEPROM_PAGE_SIZE)
+
+/* Maximum number of distinct keys, sets the size of the RAM index */
+#define EEPROM_LOG_MAX_KEYS         (16u)
+
+/* Record header: key, length, 16-bit sequence number and 16-bit CRC */
+#define EEPROM_LOG_HEADER_SIZE      (6UL)
+
+/* A record never crosses a page, so an append is at most one page write */
+#define EEPROM_LOG_MAX_DATA         (EEPROM_PAGE_SIZE - EEPROM_LOG_HEADER_SIZE)
+
+/* Key value of unused space, not available to the application */
+#define EEPROM_LOG_KEY_FREE         (0xFFu)
+
+/* Record store status */
+#define LOG_NOT_FOUND_ERROR         (0xE0UL)
+#define LOG_FULL_ERROR              (0xE1UL)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Record store statistics */
+typedef struct
+{
+    uint32_t appends;       /* Records written by the application */
+    uint32_t pageWrites;    /* Write cycles, including compaction */
+    uint32_t gcRuns;        /* Pages reclaimed by compaction */
+    uint32_t relocated;     /* Live records copied by compaction */
+    uint32_t discarded;     /* Torn or corrupt records skipped at mount */
+} eeprom_log_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_log_format(void);
+uint8_t eeprom_log_mount(void);
+uint8_t eeprom_log_write(uint8_t key, const uint8_t *data, uint32_t len);
+uint8_t eeprom_log_read(uint8_t key, uint8_t *dst, uint32_t size, uint32_t *len);
+void eeprom_log_get_stats(eeprom_log_stats_t *stats);
+
+#endif /* SOURCE_EEPROM_LOG_H_ */
@@ -0,0 +1,720 @@
+/******************************************************************************
+* File Name:  eeprom_lz.c
+*
+* Description:  This file implements compressed block storage. Blocks are
+*               compressed with a small-window LZSS codec on the way to the
+*               EEPROM and decompressed while they are streamed back, in
+*               static buffers of fixed size.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_lz.h"
+#include <string.h>
+
+#if (((EEPROM_LZ_WINDOW_SIZE & (EEPROM_LZ_WINDOW_SIZE - 1UL)) != 0UL) || \
+     (EEPROM_LZ_WINDOW_SIZE > 256UL))
+#error "EEPROM_LZ_WINDOW_SIZE must be a power of two of at most 256"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define LZ_WINDOW_MASK          (EEPROM_LZ_WINDOW_SIZE - 1UL)
+#define LZ_HASH_SIZE            (1UL << EEPROM_LZ_HASH_BITS)
+
+/* The compressed data is made of groups of one flag byte and up to 8 items.
+ * Bit n of the flag byte, from the LSB, tells whether item n is a literal
+ * byte (0) or a match of two bytes (1): offset - 1 and length - MIN_MATCH. */
+#define LZ_GROUP_ITEMS          (8u)
+#define LZ_GROUP_MAX            (1UL + (2UL * LZ_GROUP_ITEMS))
+
+/* Bytes at the start of a block that are written last, together with the
+ * header: up to the first page boundary at least a header away */
+#define LZ_FIRST_MAX            (EEPROM_PAGE_SIZE + EEPROM_LZ_HEADER_SIZE)
+
+/* Decoder states */
+#define LZ_STATE_FLAGS          (0u)    /* Next byte is a flag byte */
+#define LZ_STATE_ITEM           (1u)    /* Next byte is a literal or an offset */
+#define LZ_STATE_LENGTH         (2u)    /* Next byte is the length of a match */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Buffers of the encoder and of the decoder, which never run at the same
+ * time. The first bytes of a block stay in first until the header is known,
+ * the following ones are written a page at a time from page. The window
+ * holds the last EEPROM_LZ_WINDOW_SIZE bytes decoded and is also the output
+ * buffer of the consumer. */
+typedef union
+{
+    struct
+    {
+        uint16_t hash[LZ_HASH_SIZE];    /* Last position + 1 of each hash of 3 bytes, 0 if none */
+        uint8_t group[LZ_GROUP_MAX];    /* Group being built */
+        uint8_t first[LZ_FIRST_MAX];
+        uint8_t page[EEPROM_PAGE_SIZE];
+    } enc;
+    uint8_t window[EEPROM_LZ_WINDOW_SIZE];
+} lz_buffers_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Buffers of the encoder and of the decoder */
+static lz_buffers_t lzBuf;
+
+/* Encoder: group being built */
+static uint32_t lzGroupLen;
+static uint32_t lzGroupItems;
+
+/* Encoder output, see lz_buffers_t */
+static eeprom_addr_t lzAddr;
+static uint32_t lzFirstLen;
+static uint32_t lzStored;
+static uint32_t lzLimit;
+static uint8_t lzStatus;
+
+/* Decoder */
+static uint32_t lzOut;
+static uint32_t lzFlushed;
+static uint32_t lzOrigLen;
+static uint32_t lzOffset;
+static uint8_t lzFlags;
+static uint8_t lzItems;
+static uint8_t lzState;
+static bool lzError;
+static eeprom_stream_callback_t lzConsumer;
+
+/* Destination of eeprom_lz_read() */
+static uint8_t *lzDst;
+
+/*******************************************************************************
+* Function Name: LzWrite
+********************************************************************************
+* Summary:
+*  This function writes len bytes to the EEPROM and waits for the end of the
+*  write cycle, unless an earlier write of the block failed.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LzWrite(eeprom_addr_t addr, const uint8_t *src, uint32_t len)
+{
+    if (lzStatus == TRANSFER_CMPLT)
+    {
+        lzStatus = eeprom_write(addr, src, len);
+    }
+    if (lzStatus == TRANSFER_CMPLT)
+    {
+        lzStatus = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LzPut
+********************************************************************************
+* Summary:
+*  This function appends len bytes to the compressed block and writes each
+*  page as soon as it is complete.
+*
+* Parameters:
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  bool - false if the block exceeds its limit or a write failed
+*
+*******************************************************************************/
+static bool LzPut(const uint8_t *data, uint32_t len)
+{
+    if ((lzStored + len) > lzLimit)
+    {
+        return false;
+    }
+
+    while (len > 0UL)
+    {
+        if (lzStored < lzFirstLen)
+        {
+            lzBuf.enc.first[lzStored] = *data;
+        }
+        else
+        {
+            lzBuf.enc.page[((uint32_t)lzAddr + lzStored) % EEPROM_PAGE_SIZE] = *data;
+        }
+        lzStored++;
+        data++;
+        len--;
+
+        if ((lzStored > lzFirstLen) && ((((uint32_t)lzAddr + lzStored) % EEPROM_PAGE_SIZE) == 0UL))
+        {
+            LzWrite((eeprom_addr_t)(lzAddr + lzStored - EEPROM_PAGE_SIZE), lzBuf.enc.page, EEPROM_PAGE_SIZE);
+        }
+    }
+    return (lzStatus == TRANSFER_CMPLT);
+}
+
+/*******************************************************************************
+* Function Name: LzHashAt
+********************************************************************************
+* Summary:
+*  This function hashes the 3 bytes at data.
+*
+* Parameters:
+*  const uint8_t *data
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t LzHashAt(const uint8_t *data)
+{
+    uint32_t hash = (uint32_t)data[0] ^ ((uint32_t)data[1] << 3u) ^ ((uint32_t)data[2] << 6u);
+
+    return ((hash ^ (hash >> EEPROM_LZ_HASH_BITS)) & (LZ_HASH_SIZE - 1UL));
+}
+
+/*******************************************************************************
+* Function Name: LzEncode
+********************************************************************************
+* Summary:
+*  This function compresses len bytes of src into the block. Each position is
+*  matched greedily against the last earlier position with the same hash
+*  within the window, so the encoder needs one hash lookup per literal and no
+*  search.
+*
+* Parameters:
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  bool - false if the block exceeds its limit or a write failed
+*
+*******************************************************************************/
+static bool LzEncode(const uint8_t *src, uint32_t len)
+{
+    uint32_t pos = 0UL;
+    uint32_t cand;
+    uint32_t hash;
+    uint32_t matchLen;
+    uint32_t maxLen;
+    uint32_t i;
+
+    (void)memset(lzBuf.enc.hash, 0, sizeof(lzBuf.enc.hash));
+    lzBuf.enc.group[0] = 0u;
+    lzGroupLen = 1UL;
+    lzGroupItems = 0UL;
+
+    while (pos < len)
+    {
+        matchLen = 0UL;
+        cand = 0UL;
+        if ((pos + EEPROM_LZ_MIN_MATCH) <= len)
+        {
+            hash = LzHashAt(&src[pos]);
+            cand = lzBuf.enc.hash[hash];
+            lzBuf.enc.hash[hash] = (uint16_t)(pos + 1UL);
+
+            if ((cand != 0UL) && ((pos + 1UL - cand) <= EEPROM_LZ_WINDOW_SIZE))
+            {
+                cand--;
+                maxLen = ((len - pos) < EEPROM_LZ_MAX_MATCH) ? (len - pos) : EEPROM_LZ_MAX_MATCH;
+                while ((matchLen < maxLen) && (src[cand + matchLen] == src[pos + matchLen]))
+                {
+                    matchLen++;
+                }
+            }
+        }
+
+        if (matchLen >= EEPROM_LZ_MIN_MATCH)
+        {
+            lzBuf.enc.group[0] |= (uint8_t)(1u << lzGroupItems);
+            lzBuf.enc.group[lzGroupLen] = (uint8_t)(pos - cand - 1UL);
+            lzBuf.enc.group[lzGroupLen + 1UL] = (uint8_t)(matchLen - EEPROM_LZ_MIN_MATCH);
+            lzGroupLen += 2UL;
+
+            /* Positions inside the match can start later matches */
+            for (i = 1UL; (i < matchLen) && ((pos + i + EEPROM_LZ_MIN_MATCH) <= len); i++)
+            {
+                lzBuf.enc.hash[LzHashAt(&src[pos + i])] = (uint16_t)(pos + i + 1UL);
+            }
+            pos += matchLen;
+        }
+        else
+        {
+            lzBuf.enc.group[lzGroupLen] = src[pos];
+            lzGroupLen++;
+            pos++;
+        }
+
+        lzGroupItems++;
+        if (lzGroupItems == LZ_GROUP_ITEMS)
+        {
+            if (!LzPut(lzBuf.enc.group, lzGroupLen))
+            {
+                return false;
+            }
+            lzBuf.enc.group[0] = 0u;
+            lzGroupLen = 1UL;
+            lzGroupItems = 0UL;
+        }
+    }
+
+    return ((lzGroupItems == 0UL) || LzPut(lzBuf.enc.group, lzGroupLen));
+}
+
+/*******************************************************************************
+* Function Name: eeprom_lz_write
+********************************************************************************
+* Summary:
+*  This function stores len bytes of src as a block at memory address addr,
+*  in at most size bytes of EEPROM. The data is compressed while it is written
+*  page by page. If the compressed block would not be smaller than the data or
+*  does not fit in size, the data is stored as it is. The header, with the
+*  first bytes, is written last, so an interrupted write leaves the previous
+*  header in place.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint32_t size - EEPROM space available at addr
+*  const uint8_t *src
+*  uint32_t len
+*  uint32_t *stored - EEPROM bytes used by the block, header included
+*
+* Return:
+*  uint8_t status - INVALID_PARAM_ERROR if the block does not fit in size
+*
+*******************************************************************************/
+uint8_t eeprom_lz_write(eeprom_addr_t addr, uint32_t size, const uint8_t *src, uint32_t len,
+                        uint32_t *stored)
+{
+    uint32_t rawSize = EEPROM_LZ_HEADER_SIZE + len;
+    uint32_t count;
+    uint8_t method = EEPROM_LZ_METHOD_RAW;
+
+    if ((src == NULL) || (stored == NULL) || (len == 0UL) || (len > EEPROM_LZ_MAX_LEN) ||
+        (((uint32_t)addr + size) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    lzAddr = addr;
+    lzStatus = TRANSFER_CMPLT;
+    lzFirstLen = EEPROM_PAGE_SIZE - ((uint32_t)addr % EEPROM_PAGE_SIZE);
+    if (lzFirstLen < EEPROM_LZ_HEADER_SIZE)
+    {
+        lzFirstLen += EEPROM_PAGE_SIZE;
+    }
+
+#if EEPROM_LZ_ENABLE
+    /* Compressed blocks are kept only if they save space */
+    lzStored = EEPROM_LZ_HEADER_SIZE;
+    lzLimit = (size < rawSize) ? size : (rawSize - 1UL);
+    if (LzEncode(src, len))
+    {
+        method = EEPROM_LZ_METHOD_LZSS;
+        count = ((uint32_t)lzAddr + lzStored) % EEPROM_PAGE_SIZE;
+        if ((lzStored > lzFirstLen) && (count != 0UL))
+        {
+            LzWrite((eeprom_addr_t)(lzAddr + lzStored - count), lzBuf.enc.page, count);
+        }
+    }
+    else if (lzStatus != TRANSFER_CMPLT)
+    {
+        return (lzStatus);
+    }
+#endif /* EEPROM_LZ_ENABLE */
+
+    if (method == EEPROM_LZ_METHOD_RAW)
+    {
+        if (rawSize > size)
+        {
+            return INVALID_PARAM_ERROR;
+        }
+        lzStored = rawSize;
+        count = ((rawSize < lzFirstLen) ? rawSize : lzFirstLen) - EEPROM_LZ_HEADER_SIZE;
+        (void)memcpy(&lzBuf.enc.first[EEPROM_LZ_HEADER_SIZE], src, count);
+        if (len > count)
+        {
+            LzWrite((eeprom_addr_t)(addr + lzFirstLen), &src[count], len - count);
+        }
+    }
+
+    lzBuf.enc.first[0] = method;
+    lzBuf.enc.first[1] = (uint8_t)len;
+    lzBuf.enc.first[2] = (uint8_t)(len >> 8u);
+    lzBuf.enc.first[3] = (uint8_t)(lzStored - EEPROM_LZ_HEADER_SIZE);
+    lzBuf.enc.first[4] = (uint8_t)((lzStored - EEPROM_LZ_HEADER_SIZE) >> 8u);
+    LzWrite(addr, lzBuf.enc.first, (lzStored < lzFirstLen) ? lzStored : lzFirstLen);
+
+    if (lzStatus == TRANSFER_CMPLT)
+    {
+        *stored = lzStored;
+    }
+    return (lzStatus);
+}
+
+/*******************************************************************************
+* Function Name: LzEmit
+********************************************************************************
+* Summary:
+*  This function appends one decoded byte to the window and passes the window
+*  to the consumer each time it is full.
+*
+* Parameters:
+*  uint8_t data
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LzEmit(uint8_t data)
+{
+    lzBuf.window[lzOut & LZ_WINDOW_MASK] = data;
+    lzOut++;
+    if ((lzOut & LZ_WINDOW_MASK) == 0UL)
+    {
+        lzConsumer(lzBuf.window, EEPROM_LZ_WINDOW_SIZE);
+        lzFlushed = lzOut;
+    }
+}
+
+/*******************************************************************************
+* Function Name: LzNextItem
+********************************************************************************
+* Summary:
+*  This function moves the decoder to the next item of the group.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LzNextItem(void)
+{
+    lzFlags >>= 1u;
+    lzItems--;
+    lzState = (lzItems == 0u) ? LZ_STATE_FLAGS : LZ_STATE_ITEM;
+}
+
+/*******************************************************************************
+* Function Name: LzDecodeConsumer
+********************************************************************************
+* Summary:
+*  This function is the consumer of the streaming read of a compressed block
+*  and decodes each chunk as it arrives. Matches that reach before the start
+*  of the block or past its original length mark the block as invalid.
+*
+* Parameters:
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LzDecodeConsumer(const uint8_t *data, uint32_t len)
+{
+    uint32_t count;
+
+    while ((len > 0UL) && !lzError)
+    {
+        if (lzOut >= lzOrigLen)
+        {
+            /* Data past the end of the block */
+            lzError = true;
+        }
+        else if (lzState == LZ_STATE_FLAGS)
+        {
+            lzFlags = *data;
+            lzItems = LZ_GROUP_ITEMS;
+            lzState = LZ_STATE_ITEM;
+        }
+        else if (lzState == LZ_STATE_LENGTH)
+        {
+            count = (uint32_t)*data + EEPROM_LZ_MIN_MATCH;
+            if ((lzOffset > lzOut) || (count > (lzOrigLen - lzOut)))
+            {
+                lzError = true;
+            }
+            else
+            {
+                while (count > 0UL)
+                {
+                    LzEmit(lzBuf.window[(lzOut - lzOffset) & LZ_WINDOW_MASK]);
+                    count--;
+                }
+                LzNextItem();
+            }
+        }
+        else if ((lzFlags & 1u) != 0u)
+        {
+            lzOffset = (uint32_t)*data + 1UL;
+            lzState = LZ_STATE_LENGTH;
+        }
+        else
+        {
+            LzEmit(*data);
+            LzNextItem();
+        }
+        data++;
+        len--;
+    }
+}
+
+/*******************************************************************************
+* Function Name: LzCopyConsumer
+********************************************************************************
+* Summary:
+*  This function is the consumer of eeprom_lz_read() and copies each chunk of
+*  decoded data to the destination.
+*
+* Parameters:
+*  const uint8_t *data
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void LzCopyConsumer(const uint8_t *data, uint32_t len)
+{
+    (void)memcpy(lzDst, data, len);
+    lzDst += len;
+}
+
+/*******************************************************************************
+* Function Name: LzReadHeader
+********************************************************************************
+* Summary:
+*  This function reads and checks the header of the block at memory address
+*  addr.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *method
+*  uint32_t *origLen
+*  uint32_t *storedLen
+*
+* Return:
+*  uint8_t status - INVALID_DATA_ERROR if there is no valid block at addr
+*
+*******************************************************************************/
+static uint8_t LzReadHeader(eeprom_addr_t addr, uint8_t *method, uint32_t *origLen,
+                            uint32_t *storedLen)
+{
+    uint8_t header[EEPROM_LZ_HEADER_SIZE];
+    uint8_t status;
+
+    if (((uint32_t)addr + EEPROM_LZ_HEADER_SIZE) > EEPROM_SIZE)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    status = eeprom_read(addr, header, EEPROM_LZ_HEADER_SIZE);
+    if (status != TRANSFER_CMPLT)
+    {
+        return (status);
+    }
+
+    *method = header[0];
+    *origLen = (uint32_t)header[1] | ((uint32_t)header[2] << 8u);
+    *storedLen = (uint32_t)header[3] | ((uint32_t)header[4] << 8u);
+
+    if ((*storedLen == 0UL) ||
+        (((uint32_t)addr + EEPROM_LZ_HEADER_SIZE + *storedLen) > EEPROM_SIZE) ||
+        ((*method == EEPROM_LZ_METHOD_RAW) && (*storedLen != *origLen)) ||
+        ((*method == EEPROM_LZ_METHOD_LZSS) && (*storedLen >= *origLen)) ||
+        (*method > EEPROM_LZ_METHOD_LZSS))
+    {
+        status = INVALID_DATA_ERROR;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: LzDecode
+********************************************************************************
+* Summary:
+*  This function streams the compressed data of a block from the EEPROM
+*  through the decoder to consumer.
+*
+* Parameters:
+*  eeprom_addr_t addr - address of the compressed data
+*  uint32_t origLen
+*  uint32_t storedLen
+*  eeprom_stream_callback_t consumer
+*
+* Return:
+*  uint8_t status - INVALID_DATA_ERROR if the compressed data is corrupt
+*
+*******************************************************************************/
+static uint8_t LzDecode(eeprom_addr_t addr, uint32_t origLen, uint32_t storedLen,
+                        eeprom_stream_callback_t consumer)
+{
+    uint8_t status;
+
+    lzOut = 0UL;
+    lzFlushed = 0UL;
+    lzOrigLen = origLen;
+    lzState = LZ_STATE_FLAGS;
+    lzError = false;
+    lzConsumer = consumer;
+
+    status = eeprom_read_stream(addr, storedLen, &LzDecodeConsumer);
+    if ((status == TRANSFER_CMPLT) && (lzError || (lzOut != lzOrigLen)))
+    {
+        status = INVALID_DATA_ERROR;
+    }
+    if ((status == TRANSFER_CMPLT) && (lzOut > lzFlushed))
+    {
+        lzConsumer(lzBuf.window, lzOut - lzFlushed);
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_lz_read
+********************************************************************************
+* Summary:
+*  This function reads the block at memory address addr into dst.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t size - size of dst
+*  uint32_t *len - length of the data
+*
+* Return:
+*  uint8_t status - INVALID_DATA_ERROR if there is no valid block at addr
+*
+*******************************************************************************/
+uint8_t eeprom_lz_read(eeprom_addr_t addr, uint8_t *dst, uint32_t size, uint32_t *len)
+{
+    uint8_t status;
+    uint8_t method = EEPROM_LZ_METHOD_RAW;
+    uint32_t origLen = 0UL;
+    uint32_t storedLen = 0UL;
+
+    if ((dst == NULL) || (len == NULL))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    status = LzReadHeader(addr, &method, &origLen, &storedLen);
+    if ((status == TRANSFER_CMPLT) && (origLen > size))
+    {
+        status = INVALID_PARAM_ERROR;
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        if (method == EEPROM_LZ_METHOD_RAW)
+        {
+            status = eeprom_read((eeprom_addr_t)(addr + EEPROM_LZ_HEADER_SIZE), dst, origLen);
+        }
+        else
+        {
+            lzDst = dst;
+            status = LzDecode((eeprom_addr_t)(addr + EEPROM_LZ_HEADER_SIZE), origLen, storedLen,
+                              &LzCopyConsumer);
+        }
+    }
+
+    if (status == TRANSFER_CMPLT)
+    {
+        *len = origLen;
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_lz_read_stream
+********************************************************************************
+* Summary:
+*  This function streams the data of the block at memory address addr to
+*  consumer, in chunks of at most EEPROM_LZ_WINDOW_SIZE bytes for compressed
+*  blocks. Data passed to consumer before a corrupt part of a compressed block
+*  is detected is not taken back. The decoder shares its buffer with the
+*  encoder, so consumer must not call eeprom_lz_write().
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  eeprom_stream_callback_t consumer
+*
+* Return:
+*  uint8_t status - INVALID_DATA_ERROR if there is no valid block at addr
+*
+*******************************************************************************/
+uint8_t eeprom_lz_read_stream(eeprom_addr_t addr, eeprom_stream_callback_t consumer)
+{
+    uint8_t status;
+    uint8_t method = EEPROM_LZ_METHOD_RAW;
+    uint32_t origLen = 0UL;
+    uint32_t storedLen = 0UL;
+
+    if (consumer == NULL)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    status = LzReadHeader(addr, &method, &origLen, &storedLen);
+    if (status == TRANSFER_CMPLT)
+    {
+        if (method == EEPROM_LZ_METHOD_RAW)
+        {
+            status = eeprom_read_stream((eeprom_addr_t)(addr + EEPROM_LZ_HEADER_SIZE), origLen, consumer);
+        }
+        else
+        {
+            status = LzDecode((eeprom_addr_t)(addr + EEPROM_LZ_HEADER_SIZE), origLen, storedLen,
+                              consumer);
+        }
+    }
+    return (status);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:  eeprom_lz.h
+*
+* Description:  This file provides constants and function prototypes of the
+*               compressed block storage.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_LZ_H_
+#define SOURCE_EEPROM_LZ_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Compress the blocks written with eeprom_lz_write(), 0u stores them as they
+ * are. Blocks of both kinds are read back. */
+#define EEPROM_LZ_ENABLE            (1u)
+
+/* A match copies from up to this many bytes back, a power of two of at most
+ * 256. Sets the RAM of the streaming decoder. */
+#define EEPROM_LZ_WINDOW_SIZE       (256UL)
+
+/* Shortest and longest match */
+#define EEPROM_LZ_MIN_MATCH         (3UL)
+#define EEPROM_LZ_MAX_MATCH         (EEPROM_LZ_MIN_MATCH + 255UL)
+
+/* The encoder finds matches with a table of 2^EEPROM_LZ_HASH_BITS positions
+ * of 16 bits */
+#define EEPROM_LZ_HASH_BITS         (8u)
+
+/* Block header: method, original length (2 bytes) and stored length (2 bytes)
+ * of the data that follows, little endian */
+#define EEPROM_LZ_HEADER_SIZE       (5UL)
+
+/* Largest block */
+#define EEPROM_LZ_MAX_LEN           (0xFFFFUL)
+
+/* Methods */
+#define EEPROM_LZ_METHOD_RAW        (0x00u) /* Data stored as it is */
+#define EEPROM_LZ_METHOD_LZSS       (0x01u) /* Compressed */
+
+uint8_t eeprom_lz_write(eeprom_addr_t addr, uint32_t size, const uint8_t *src, uint32_t len,
+                        uint32_t *stored);
+uint8_t eeprom_lz_read(eeprom_addr_t addr, uint8_t *dst, uint32_t size, uint32_t *len);
+uint8_t eeprom_lz_read_stream(eeprom_addr_t addr, eeprom_stream_callback_t consumer);
+
+#endif /* SOURCE_EEPROM_LZ_H_ */
@@ -0,0 +1,247 @@
+/******************************************************************************
+* File Name:  eeprom_power.c
+*
+* Description:  This file implements the low-power waits, which sleep
+*               the CPU until an interrupt, and the accounting of the time
+*               the CPU is active.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_power.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Start of the accounting period */
+static uint32_t periodStartUs = 0UL;
+
+/* Time spent in sleep and number of sleeps in the accounting period */
+static uint32_t sleepUs = 0UL;
+static uint32_t sleepCount = 0UL;
+
+/*******************************************************************************
+* Function Name: eeprom_power_sleep
+********************************************************************************
+* Summary:
+*  This function puts the CPU to sleep until the next interrupt and adds the
+*  time asleep to the accounting. The caller masks interrupts, checks its wake
+*  condition, and calls this function only if the condition is not met yet:
+*  an interrupt that became pending after the check still ends the sleep at
+*  once, and its handler runs when the caller unmasks interrupts. SysTick
+*  wakes the CPU at least once per millisecond.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_power_sleep(void)
+{
+#if EEPROM_POWER_SLEEP_ENABLE
+    uint32_t startUs = eeprom_time_us();
+
+    (void) Cy_SysPm_CpuEnterSleep();
+
+    sleepUs += eeprom_time_us() - startUs;
+    sleepCount++;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: eeprom_power_delay_us
+********************************************************************************
+* Summary:
+*  This function waits for at least us microseconds. With
+*  EEPROM_POWER_SLEEP_ENABLE the CPU sleeps between interrupts while the next
+*  SysTick tick, which ends a sleep at the latest, comes before the end of
+*  the delay. The rest of the delay, shorter than the time to the next tick,
+*  is waited awake, so that a short delay such as the acknowledge polling
+*  interval is not rounded up to the tick.
+*
+* Parameters:
+*  uint32_t us
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_power_delay_us(uint32_t us)
+{
+#if EEPROM_POWER_SLEEP_ENABLE
+    uint32_t startUs = eeprom_time_us();
+    uint32_t leftUs = us;
+    uint32_t elapsedUs;
+    uint32_t intState;
+
+    while (leftUs > 0UL)
+    {
+        intState = Cy_SysLib_EnterCriticalSection();
+        if (leftUs >= eeprom_time_next_tick_us())
+        {
+            eeprom_power_sleep();
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+
+        elapsedUs = eeprom_time_us() - startUs;
+        leftUs = (elapsedUs < us) ? (us - elapsedUs) : 0UL;
+    }
+#else
+    while (us > 0UL)
+    {
+        uint32_t step = (us > 1000UL) ? 1000UL : us;
+
+        Cy_SysLib_DelayUs((uint16_t)step);
+        us -= step;
+    }
+#endif
+}
+
+/*******************************************************************************
+* Function Name: eeprom_power_sleep_us
+********************************************************************************
+* Summary:
+*  This function sleeps through the SysTick ticks that come within the next us
+*  microseconds and returns at the last of them, so it never waits longer
+*  than us and does not wait at all when no tick is due in time. Without
+*  EEPROM_POWER_SLEEP_ENABLE it returns at once.
+*
+* Parameters:
+*  uint32_t us
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_power_sleep_us(uint32_t us)
+{
+#if EEPROM_POWER_SLEEP_ENABLE
+    uint32_t startUs = eeprom_time_us();
+    uint32_t elapsedUs = 0UL;
+    uint32_t intState;
+    bool tickDue = true;
+
+    while (tickDue)
+    {
+        intState = Cy_SysLib_EnterCriticalSection();
+        tickDue = ((elapsedUs + eeprom_time_next_tick_us()) <= us);
+        if (tickDue)
+        {
+            eeprom_power_sleep();
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+
+        elapsedUs = eeprom_time_us() - startUs;
+    }
+#else
+    (void)us;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: eeprom_power_delay_ms
+********************************************************************************
+* Summary:
+*  This function waits for ms milliseconds, see eeprom_power_delay_us().
+*
+* Parameters:
+*  uint32_t ms
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_power_delay_ms(uint32_t ms)
+{
+    eeprom_power_delay_us(ms * 1000UL);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_power_get
+********************************************************************************
+* Summary:
+*  This function returns the wall time and the CPU active time since the last
+*  eeprom_power_reset(). Interrupt handlers run while the CPU is awake and
+*  count as active time. Without EEPROM_POWER_SLEEP_ENABLE the CPU never
+*  sleeps, so all wait time counts as active, which gives the baseline to
+*  compare with.
+*
+* Parameters:
+*  eeprom_power_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_power_get(eeprom_power_stats_t *stats)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    stats->elapsedUs = eeprom_time_us() - periodStartUs;
+    stats->activeUs  = stats->elapsedUs - sleepUs;
+    stats->sleeps    = sleepCount;
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_power_reset
+********************************************************************************
+* Summary:
+*  This function starts a new accounting period.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_power_reset(void)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    periodStartUs = eeprom_time_us();
+    sleepUs       = 0UL;
+    sleepCount    = 0UL;
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,80 @@
+/******************************************************************************
+* File Name:  eeprom_power.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the low-power waits and the CPU active-time
+*               accounting.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_POWER_H_
+#define SOURCE_EEPROM_POWER_H_
+
+#include "cy_pdl.h"
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Sleep the CPU in the wait paths, 0u keeps the busy-wait loops, can be
+ * overridden from the Makefile DEFINES */
+#ifndef EEPROM_POWER_SLEEP_ENABLE
+#define EEPROM_POWER_SLEEP_ENABLE   (1u)
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* CPU time accounting since eeprom_power_reset() */
+typedef struct
+{
+    uint32_t elapsedUs;     /* Wall time */
+    uint32_t activeUs;      /* Time the CPU was running */
+    uint32_t sleeps;        /* Number of sleeps */
+} eeprom_power_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void eeprom_power_sleep(void);
+void eeprom_power_delay_us(uint32_t us);
+void eeprom_power_sleep_us(uint32_t us);
+void eeprom_power_delay_ms(uint32_t ms);
+void eeprom_power_get(eeprom_power_stats_t *stats);
+void eeprom_power_reset(void);
+
+#endif /* SOURCE_EEPROM_POWER_H_ */
@@ -0,0 +1,504 @@
+/******************************************************************************
+* File Name:  eeprom_queue.c
+*
+* Description:  This file implements a fixed-capacity queue of EEPROM
+*               transactions. The next transaction is started from the I2C
+*               interrupt as soon as the previous one completes.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_queue.h"
+#include "eeprom_arb.h"
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Ring buffer of transaction descriptors */
+static eeprom_request_t queue[EEPROM_QUEUE_DEPTH];
+static uint32_t queueHead = 0UL;
+static uint32_t queueTail = 0UL;
+static volatile uint32_t queueCount = 0UL;
+
+/* Set while the transaction at queueTail is on the bus */
+static volatile bool queueActive = false;
+
+/* Progress of the active transaction */
+static uint32_t xferDone = 0UL;
+static uint32_t xferChunk = 0UL;
+static bool nakPolling = false;
+static uint32_t nakStartUs = 0UL;
+static uint32_t arbRetries = 0UL;
+
+/* Restart of the active transaction after a lost arbitration, started by the
+ * SysTick callback once the backoff has passed */
+static volatile bool restartPending = false;
+static uint32_t restartStartUs = 0UL;
+static uint32_t restartWaitUs = 0UL;
+static bool tickRegistered = false;
+
+static eeprom_queue_stats_t queueStats;
+
+/*******************************************************************************
+* Function Declaration
+*******************************************************************************/
+static void QueueStartStep(void);
+static void QueueStepComplete(uint8_t status);
+
+/*******************************************************************************
+* Function Name: QueueStartNext
+********************************************************************************
+* Summary:
+*  This function starts the transaction at the tail of the queue, if any.
+*  Called with interrupts disabled or from the I2C interrupt.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void QueueStartNext(void)
+{
+    if (queueCount == 0UL)
+    {
+        queueActive = false;
+        return;
+    }
+
+    queueActive = true;
+    xferDone    = 0UL;
+    nakPolling  = false;
+    arbRetries  = 0UL;
+
+    QueueStartStep();
+}
+
+/*******************************************************************************
+* Function Name: QueueFinish
+********************************************************************************
+* Summary:
+*  This function removes the active transaction from the queue, reports its
+*  status to the owner and starts the next one.
+*
+* Parameters:
+*  uint8_t status
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void QueueFinish(uint8_t status)
+{
+    eeprom_request_t *req = &queue[queueTail];
+    eeprom_callback_t callback = req->callback;
+
+    if (status == TRANSFER_CMPLT)
+    {
+        queueStats.completed++;
+        queueStats.bytes += req->len;
+    }
+    else
+    {
+        queueStats.failed++;
+    }
+
+    queueTail = (queueTail + 1UL) % EEPROM_QUEUE_DEPTH;
+    queueCount--;
+
+    if (callback != NULL)
+    {
+        callback(status);
+    }
+
+    QueueStartNext();
+}
+
+/*******************************************************************************
+* Function Name: QueueStartStep
+********************************************************************************
+* Summary:
+*  This function starts the next bus transfer of the active transaction: one
+*  page burst of a write, or a read up to the end of the block.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void QueueStartStep(void)
+{
+    eeprom_request_t *req = &queue[queueTail];
+    eeprom_addr_t addr = (eeprom_addr_t)(req->addr + xferDone);
+    uint8_t status;
+
+    if (req->op == EEPROM_OP_WRITE)
+    {
+        /* Burst up to the end of the current page */
+        xferChunk = EEPROM_PAGE_SIZE - ((uint32_t)addr % EEPROM_PAGE_SIZE);
+        if (xferChunk > (req->len - xferDone))
+        {
+            xferChunk = req->len - xferDone;
+        }
+
+        status = eeprom_write_async(addr, &req->src[xferDone], xferChunk, &QueueStepComplete);
+    }
+    else
+    {
+        /* A sequential read wraps around within a block */
+        xferChunk = EEPROM_BLOCK_SIZE - ((uint32_t)addr % EEPROM_BLOCK_SIZE);
+        if (xferChunk > (req->len - xferDone))
+        {
+            xferChunk = req->len - xferDone;
+        }
+
+        status = eeprom_read_at_async(addr, &req->dst[xferDone], xferChunk, &QueueStepComplete);
+    }
+
+    if (status != TRANSFER_STARTED)
+    {
+        QueueFinish(status);
+    }
+}
+
+/*******************************************************************************
+* Function Name: QueueTick
+********************************************************************************
+* Summary:
+*  SysTick callback, called once per millisecond. It restarts the transfer
+*  that lost arbitration once its backoff has passed. While a blocking
+*  function of the main loop owns the bus, the restart waits for a later tick.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void QueueTick(void)
+{
+    uint32_t intrStatus;
+
+    if (!restartPending)
+    {
+        return;
+    }
+
+    /* The queue is also updated from the I2C interrupt */
+    intrStatus = Cy_SysLib_EnterCriticalSection();
+    if (restartPending && ((eeprom_time_us() - restartStartUs) >= restartWaitUs) &&
+        !eeprom_is_busy() && !eeprom_is_blocking())
+    {
+        restartPending = false;
+        QueueStartStep();
+    }
+    Cy_SysLib_ExitCriticalSection(intrStatus);
+}
+
+/*******************************************************************************
+* Function Name: QueueBackoff
+********************************************************************************
+* Summary:
+*  This function schedules the restart of a transfer that lost arbitration.
+*  Restarting at once from the I2C interrupt would start it just as the
+*  winner's Stop frees the bus, together with every other master that lost,
+*  and collide again. The restart waits the random pause of
+*  eeprom_arb_backoff_us() instead and is started by QueueTick(), so it
+*  happens at the first SysTick tick after the pause. The interrupt returns at
+*  once and the bus is left to the other masters in the meantime.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void QueueBackoff(void)
+{
+    restartWaitUs  = eeprom_arb_backoff_us(arbRetries);
+    restartStartUs = eeprom_time_us();
+    restartPending = true;
+
+    arbRetries++;
+    queueStats.arbRetries++;
+    queueStats.backoffUs += restartWaitUs;
+
+    if (!tickRegistered)
+    {
+        (void)Cy_SysTick_SetCallback(EEPROM_QUEUE_TICK_CALLBACK, &QueueTick);
+        tickRegistered = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: QueueStepComplete
+********************************************************************************
+* Summary:
+*  This function is the completion callback of every transfer started by the
+*  queue and runs in the I2C interrupt. An address NAK means the device is in
+*  the write cycle of a previous page, so the transfer is retried right away
+*  for up to EEPROM_QUEUE_NAK_TIMEOUT_US; this acknowledge polling starts the
+*  next transfer as soon as the write cycle ends. A transfer that lost
+*  arbitration is repeated as a whole after the backoff of QueueBackoff().
+*
+* Parameters:
+*  uint8_t status
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void QueueStepComplete(uint8_t status)
+{
+    eeprom_request_t *req = &queue[queueTail];
+
+    if ((status == ADDR_NAK_ERROR) && !nakPolling)
+    {
+        nakPolling = true;
+        nakStartUs = eeprom_time_us();
+    }
+
+    if ((status == ADDR_NAK_ERROR) && ((eeprom_time_us() - nakStartUs) < EEPROM_QUEUE_NAK_TIMEOUT_US))
+    {
+        /* The transfer won the bus, so lost arbitrations count anew */
+        arbRetries = 0UL;
+        queueStats.nakRetries++;
+        QueueStartStep();
+        return;
+    }
+
+    if ((status == ARB_LOST_ERROR) && (arbRetries < EEPROM_ARB_RETRY_MAX))
+    {
+        QueueBackoff();
+        return;
+    }
+
+    if (status != TRANSFER_CMPLT)
+    {
+        QueueFinish(status);
+        return;
+    }
+
+    nakPolling = false;
+    arbRetries = 0UL;
+
+    xferDone += xferChunk;
+    if (xferDone < req->len)
+    {
+        QueueStartStep();
+        return;
+    }
+
+    QueueFinish(TRANSFER_CMPLT);
+}
+
+/*******************************************************************************
+* Function Name: QueueSubmit
+********************************************************************************
+* Summary:
+*  This function adds a transaction to the head of the queue and starts it if
+*  the queue was idle.
+*
+* Parameters:
+*  const eeprom_request_t *req
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t QueueSubmit(const eeprom_request_t *req)
+{
+    uint8_t status = TRANSFER_STARTED;
+    uint32_t intrStatus;
+
+    if ((req->len == 0UL) || (((uint32_t)req->addr + req->len) > EEPROM_SIZE))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    /* The queue is also updated from the I2C interrupt */
+    intrStatus = Cy_SysLib_EnterCriticalSection();
+
+    if (queueCount >= EEPROM_QUEUE_DEPTH)
+    {
+        status = TRANSFER_BUSY;
+    }
+    else
+    {
+        queue[queueHead] = *req;
+        queueHead = (queueHead + 1UL) % EEPROM_QUEUE_DEPTH;
+        queueCount++;
+
+        if (queueCount > queueStats.peakDepth)
+        {
+            queueStats.peakDepth = queueCount;
+        }
+
+        if (!queueActive)
+        {
+            QueueStartNext();
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(intrStatus);
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_queue_write
+********************************************************************************
+* Summary:
+*  This function queues a write of len bytes from src to the EEPROM at memory
+*  address addr. The span may cross page boundaries; it is written in
+*  page-aligned bursts. src must stay valid until the callback is invoked.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  const uint8_t *src
+*  uint32_t len
+*  eeprom_callback_t callback - may be NULL
+*
+* Return:
+*  uint8_t status - TRANSFER_BUSY if the queue is full
+*
+*******************************************************************************/
+uint8_t eeprom_queue_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len,
+                           eeprom_callback_t callback)
+{
+    eeprom_request_t req =
+    {
+        .op       = EEPROM_OP_WRITE,
+        .addr     = addr,
+        .src      = src,
+        .dst      = NULL,
+        .len      = len,
+        .callback = callback
+    };
+
+    if (src == NULL)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    return QueueSubmit(&req);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_queue_read
+********************************************************************************
+* Summary:
+*  This function queues a read of len bytes from the EEPROM at memory address
+*  addr into dst. dst must stay valid until the callback is invoked.
+*
+* Parameters:
+*  eeprom_addr_t addr
+*  uint8_t *dst
+*  uint32_t len
+*  eeprom_callback_t callback - may be NULL
+*
+* Return:
+*  uint8_t status - TRANSFER_BUSY if the queue is full
+*
+*******************************************************************************/
+uint8_t eeprom_queue_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len,
+                          eeprom_callback_t callback)
+{
+    eeprom_request_t req =
+    {
+        .op       = EEPROM_OP_READ,
+        .addr     = addr,
+        .src      = NULL,
+        .dst      = dst,
+        .len      = len,
+        .callback = callback
+    };
+
+    if (dst == NULL)
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    return QueueSubmit(&req);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_queue_pending
+********************************************************************************
+* Summary:
+*  This function returns the number of queued transactions, including the one
+*  in progress.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_queue_pending(void)
+{
+    return queueCount;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_queue_get_stats
+********************************************************************************
+* Summary:
+*  This function copies the queue statistics to stats.
+*
+* Parameters:
+*  eeprom_queue_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_queue_get_stats(eeprom_queue_stats_t *stats)
+{
+    uint32_t intrStatus = Cy_SysLib_EnterCriticalSection();
+    *stats = queueStats;
+    Cy_SysLib_ExitCriticalSection(intrStatus);
+}
+
+/* [] END OF FILE */
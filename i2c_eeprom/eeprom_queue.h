@@ -0,0 +1,106 @@
+/******************************************************************************
+* File Name:  eeprom_queue.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the EEPROM transaction queue.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_QUEUE_H_
+#define SOURCE_EEPROM_QUEUE_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Maximum number of outstanding transactions, can be overridden from the
+ * Makefile DEFINES */
+#ifndef EEPROM_QUEUE_DEPTH
+#define EEPROM_QUEUE_DEPTH          (8UL)
+#endif
+
+/* Time a transfer is retried on address NAKs while the device is in its write
+ * cycle. A budget in time rather than in probes holds at every bus speed. */
+#define EEPROM_QUEUE_NAK_TIMEOUT_US (EEPROM_WRITE_CYCLE_TIMEOUT_MS * 1000UL)
+
+/* SysTick callback slot of the restart after a lost arbitration. Slot 0 is
+ * the time base of eeprom_time.c. */
+#define EEPROM_QUEUE_TICK_CALLBACK  (1UL)
+
+/* Transaction types */
+#define EEPROM_OP_READ              (0u)
+#define EEPROM_OP_WRITE             (1u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Transaction descriptor. The data buffer is owned by the caller and must stay
+ * valid until the callback of the transaction is invoked. */
+typedef struct
+{
+    uint8_t op;
+    eeprom_addr_t addr;
+    const uint8_t *src;
+    uint8_t *dst;
+    uint32_t len;
+    eeprom_callback_t callback;
+} eeprom_request_t;
+
+/* Queue statistics */
+typedef struct
+{
+    uint32_t completed;     /* Transactions finished with TRANSFER_CMPLT */
+    uint32_t failed;        /* Transactions finished with an error */
+    uint32_t bytes;         /* Data bytes transferred by completed transactions */
+    uint32_t nakRetries;    /* Address NAK retries while the device was busy */
+    uint32_t arbRetries;    /* Transfers repeated after another master won the bus */
+    uint32_t backoffUs;     /* Total random pause before those repeats */
+    uint32_t peakDepth;     /* Highest number of queued transactions */
+} eeprom_queue_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+uint8_t eeprom_queue_write(eeprom_addr_t addr, const uint8_t *src, uint32_t len,
+                           eeprom_callback_t callback);
+uint8_t eeprom_queue_read(eeprom_addr_t addr, uint8_t *dst, uint32_t len,
+                          eeprom_callback_t callback);
+uint32_t eeprom_queue_pending(void);
+void eeprom_queue_get_stats(eeprom_queue_stats_t *stats);
+
+#endif /* SOURCE_EEPROM_QUEUE_H_ */
@@ -0,0 +1,303 @@
+/******************************************************************************
+* File Name:  eeprom_recovery.c
+*
+* Description:  This file implements the I2C bus recovery: detection of
+*               a stuck bus, the nine-clock recovery sequence on the kit
+*               I2C pins, and the retry policy of failed transfers.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_recovery.h"
+#include "eeprom_arb.h"
+#include "eeprom_bus.h"
+#include "eeprom_stats.h"
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Function Name: RecoveryHalfPeriod
+********************************************************************************
+* Summary:
+*  This function waits for half a period of the bit-banged SCL.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void RecoveryHalfPeriod(void)
+{
+    Cy_SysLib_DelayUs((uint16_t)EEPROM_RECOVERY_HALF_PERIOD_US);
+}
+
+/*******************************************************************************
+* Function Name: RecoveryLineLow
+********************************************************************************
+* Summary:
+*  This function samples the kit I2C pins until both lines are high or one
+*  line has stayed low for longer than limitUs.
+*
+* Parameters:
+*  uint32_t limitUs
+*
+* Return:
+*  bool - true if a line stayed low for longer than limitUs
+*
+*******************************************************************************/
+static bool RecoveryLineLow(uint32_t limitUs)
+{
+    uint32_t nowUs = eeprom_time_us();
+    uint32_t sdaLowUs = nowUs;
+    uint32_t sclLowUs = nowUs;
+    bool sdaLow;
+    bool sclLow;
+
+    for (;;)
+    {
+        /* Each line restarts its low time whenever it is seen high */
+        sdaLow = (0UL == Cy_GPIO_Read(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN));
+        sclLow = (0UL == Cy_GPIO_Read(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN));
+        if (!sdaLow && !sclLow)
+        {
+            return false;
+        }
+
+        nowUs = eeprom_time_us();
+        if (!sdaLow)
+        {
+            sdaLowUs = nowUs;
+        }
+        if (!sclLow)
+        {
+            sclLowUs = nowUs;
+        }
+        if (((nowUs - sdaLowUs) > limitUs) || ((nowUs - sclLowUs) > limitUs))
+        {
+            return true;
+        }
+
+        Cy_SysLib_DelayUs((uint16_t)EEPROM_RECOVERY_SAMPLE_US);
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_recovery_bus_stuck
+********************************************************************************
+* Summary:
+*  This function watches the kit I2C pins. With no transfer in progress both
+*  lines are pulled high. A line that is low in a single sample may belong to
+*  a byte of another master or a stretched clock, so the bus only counts as
+*  stuck when one line stays low for longer than one byte at the current
+*  speed plus EEPROM_RECOVERY_STRETCH_US. That means a slave is stuck in the
+*  middle of a byte, usually after a glitch or a reset of the master. A free
+*  bus returns at the first sample.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool eeprom_recovery_bus_stuck(void)
+{
+    return RecoveryLineLow(((9UL * 1000000UL) / eeprom_bus_get_speed()) + EEPROM_RECOVERY_STRETCH_US);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_recovery_clear_bus
+********************************************************************************
+* Summary:
+*  This function frees the kit I2C bus. The SCB is disabled and both pins are
+*  handed to GPIO, where their open drain drive mode releases a line on a 1
+*  and pulls it low on a 0. Up to EEPROM_RECOVERY_CLOCKS pulses are clocked
+*  on SCL until the slave releases SDA, which finishes the byte it was
+*  sending. A Stop condition then resets the slave's bus interface, and the
+*  pins are returned to the SCB.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status - TRANSFER_CMPLT if both lines are high afterwards
+*
+*******************************************************************************/
+uint8_t eeprom_recovery_clear_bus(void)
+{
+    uint8_t status = TRANSFER_ERROR;
+#if EEPROM_STATS_ENABLE
+    uint32_t startTicks = eeprom_time_ticks();
+#endif
+
+    Cy_SCB_I2C_Disable(eeprom_default_dev.base, eeprom_default_dev.context);
+
+    Cy_GPIO_Set(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN);
+    Cy_GPIO_Set(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN);
+    Cy_GPIO_SetHSIOM(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN, HSIOM_SEL_GPIO);
+    Cy_GPIO_SetHSIOM(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN, HSIOM_SEL_GPIO);
+    RecoveryHalfPeriod();
+
+    for (uint8_t i = 0u; (i < EEPROM_RECOVERY_CLOCKS) &&
+                         (0UL == Cy_GPIO_Read(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN)); i++)
+    {
+        Cy_GPIO_Clr(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN);
+        RecoveryHalfPeriod();
+        Cy_GPIO_Set(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN);
+        RecoveryHalfPeriod();
+    }
+
+    /* Stop condition: SDA rises while SCL is high */
+    Cy_GPIO_Clr(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN);
+    RecoveryHalfPeriod();
+    Cy_GPIO_Clr(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN);
+    RecoveryHalfPeriod();
+    Cy_GPIO_Set(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN);
+    RecoveryHalfPeriod();
+    Cy_GPIO_Set(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN);
+    RecoveryHalfPeriod();
+
+    if (!eeprom_recovery_bus_stuck())
+    {
+        status = TRANSFER_CMPLT;
+    }
+
+    Cy_GPIO_SetHSIOM(CYBSP_I2C_SCL_PORT, CYBSP_I2C_SCL_PIN, CYBSP_I2C_SCL_HSIOM);
+    Cy_GPIO_SetHSIOM(CYBSP_I2C_SDA_PORT, CYBSP_I2C_SDA_PIN, CYBSP_I2C_SDA_HSIOM);
+
+    Cy_SCB_I2C_Enable(eeprom_default_dev.base, eeprom_default_dev.context);
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_bus_clear(eeprom_time_ticks() - startTicks, (status == TRANSFER_CMPLT));
+#endif
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_recovery_check
+********************************************************************************
+* Summary:
+*  This function is called after a transfer with dev failed. If dev is on the
+*  kit I2C bus and the bus is stuck, the bus is cleared. Devices on other SCBs
+*  are left alone, as their pins are not known.
+*
+*  A bus that is busy, with a Start seen and no Stop yet, belongs to another
+*  master. Its slave may stretch the clock and its data may keep SDA low for
+*  a long time, and clocking the bus would corrupt its transfer. The function
+*  waits for its Stop with eeprom_arb_bus_free() and leaves the bus alone once
+*  it comes. A bus that is still busy after that is only cleared if a line
+*  then stays low for EEPROM_RECOVERY_HELD_LOW_US.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*
+* Return:
+*  uint8_t status - TRANSFER_CMPLT unless a stuck bus could not be cleared
+*
+*******************************************************************************/
+uint8_t eeprom_recovery_check(const eeprom_dev_t *dev)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    bool stuck;
+
+    if (dev->base != eeprom_default_dev.base)
+    {
+        return (status);
+    }
+
+    if (Cy_SCB_I2C_IsBusBusy(dev->base))
+    {
+        stuck = !eeprom_arb_bus_free(dev) && RecoveryLineLow(EEPROM_RECOVERY_HELD_LOW_US);
+    }
+    else
+    {
+        stuck = eeprom_recovery_bus_stuck();
+    }
+
+    if (stuck)
+    {
+        status = eeprom_recovery_clear_bus();
+    }
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_recovery_retry
+********************************************************************************
+* Summary:
+*  This function decides whether a transfer with dev that failed with
+*  TRANSFER_ERROR is tried again. Attempt 0 is the first retry. Up to
+*  EEPROM_RETRY_MAX retries are allowed, as long as the bus is free or can be
+*  cleared. Before each retry the function waits EEPROM_RETRY_BACKOFF_US,
+*  doubled with every attempt up to EEPROM_RETRY_BACKOFF_MAX_US, so that a
+*  disturbance on the bus can settle.
+*
+* Parameters:
+*  const eeprom_dev_t *dev
+*  uint32_t attempt
+*
+* Return:
+*  bool - true to retry the transfer
+*
+*******************************************************************************/
+bool eeprom_recovery_retry(const eeprom_dev_t *dev, uint32_t attempt)
+{
+    uint32_t backoffUs = EEPROM_RETRY_BACKOFF_MAX_US;
+
+    if ((attempt >= EEPROM_RETRY_MAX) || (eeprom_recovery_check(dev) != TRANSFER_CMPLT))
+    {
+        return false;
+    }
+
+    if (attempt < 16UL)
+    {
+        backoffUs = EEPROM_RETRY_BACKOFF_US << attempt;
+        if (backoffUs > EEPROM_RETRY_BACKOFF_MAX_US)
+        {
+            backoffUs = EEPROM_RETRY_BACKOFF_MAX_US;
+        }
+    }
+    Cy_SysLib_DelayUs((uint16_t)backoffUs);
+
+#if EEPROM_STATS_ENABLE
+    eeprom_stats_retry();
+#endif
+    return true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:  eeprom_recovery.h
+*
+* Description:  This file provides constants and function prototypes of
+*               the I2C bus recovery and retry policy.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_RECOVERY_H_
+#define SOURCE_EEPROM_RECOVERY_H_
+
+#include "I2CMaster.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Retries of a transfer that failed with TRANSFER_ERROR */
+#define EEPROM_RETRY_MAX                (3UL)
+
+/* Pause before the first retry, doubled for each further retry up to
+ * EEPROM_RETRY_BACKOFF_MAX_US */
+#define EEPROM_RETRY_BACKOFF_US         (100UL)
+#define EEPROM_RETRY_BACKOFF_MAX_US     (2000UL)
+
+/* SCL pulses clocked out to make a slave release SDA */
+#define EEPROM_RECOVERY_CLOCKS          (9u)
+
+/* Half period of the bit-banged SCL, 5 us gives 100 kHz */
+#define EEPROM_RECOVERY_HALF_PERIOD_US  (5u)
+
+/* Time a slave may stretch the clock on top of the time of one byte. A line
+ * must stay low for longer than both before the bus counts as stuck. */
+#define EEPROM_RECOVERY_STRETCH_US      (100UL)
+
+/* Time a line must stay low before a bus that another master still holds
+ * after EEPROM_ARB_BUS_FREE_TIMEOUT_US counts as stuck, the SMBus clock low
+ * timeout */
+#define EEPROM_RECOVERY_HELD_LOW_US     (25000UL)
+
+/* Interval at which the lines are sampled while deciding whether the bus is
+ * stuck */
+#define EEPROM_RECOVERY_SAMPLE_US       (2u)
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool eeprom_recovery_bus_stuck(void);
+uint8_t eeprom_recovery_clear_bus(void);
+uint8_t eeprom_recovery_check(const eeprom_dev_t *dev);
+bool eeprom_recovery_retry(const eeprom_dev_t *dev, uint32_t attempt);
+
+#endif /* SOURCE_EEPROM_RECOVERY_H_ */
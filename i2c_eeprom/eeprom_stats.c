@@ -0,0 +1,366 @@
+/******************************************************************************
+* File Name:  eeprom_stats.c
+*
+* Description:  This file implements the I2C master instrumentation:
+*               latency histograms per operation type and counters of bus
+*               errors, timeouts, recoveries and retries.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_stats.h"
+#include <string.h>
+
+#if EEPROM_STATS_ENABLE
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Timing of one operation type in SysTick clocks, converted to microseconds
+ * only when a snapshot is taken */
+typedef struct
+{
+    uint32_t count;
+    uint64_t totalTicks;
+    uint32_t maxTicks;
+    uint32_t histogram[EEPROM_STATS_BUCKETS];
+} stats_op_ticks_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Updated from the I2C interrupt, the SysTick callback of the queue and
+ * thread context, so every update is a critical section. The op member of
+ * stats is filled from opTicks in eeprom_stats_get(). */
+static eeprom_stats_t stats;
+static stats_op_ticks_t opTicks[EEPROM_STATS_OP_COUNT];
+
+/* Upper end of the first histogram bucket in SysTick clocks, 0 until known */
+static uint32_t bucketTicks = 0UL;
+
+/* Master status bit of each error counter */
+static const uint32_t errorBits[EEPROM_STATS_ERR_COUNT] =
+{
+    CY_SCB_I2C_MASTER_DATA_NAK,
+    CY_SCB_I2C_MASTER_ADDR_NAK,
+    CY_SCB_I2C_MASTER_ARB_LOST,
+    CY_SCB_I2C_MASTER_ABORT_START,
+    CY_SCB_I2C_MASTER_BUS_ERR
+};
+
+/*******************************************************************************
+* Function Name: eeprom_stats_xfer
+********************************************************************************
+* Summary:
+*  This function adds a transfer duration to the histogram of its operation
+*  type. The duration stays in SysTick clocks, so the hot path does not
+*  divide. The bucket is found before the critical section.
+*
+* Parameters:
+*  uint8_t op - EEPROM_STATS_OP_*
+*  uint32_t ticks - duration, a difference of eeprom_time_ticks() values
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_xfer(uint8_t op, uint32_t ticks)
+{
+    stats_op_ticks_t *entry = &opTicks[op];
+    uint32_t limit;
+    uint32_t bucket = 0UL;
+    uint32_t intState;
+
+    if (bucketTicks == 0UL)
+    {
+        /* Once: the SysTick reload is fixed after eeprom_time_init() */
+        bucketTicks = (uint32_t)(((Cy_SysTick_GetReload() + 1UL) << EEPROM_STATS_BUCKET_SHIFT) / 1000UL);
+    }
+
+    limit = bucketTicks;
+    while ((ticks >= limit) && (bucket < (EEPROM_STATS_BUCKETS - 1UL)))
+    {
+        limit <<= 1u;
+        bucket++;
+    }
+
+    intState = Cy_SysLib_EnterCriticalSection();
+
+    entry->count++;
+    entry->totalTicks += ticks;
+    entry->histogram[bucket]++;
+    if (ticks > entry->maxTicks)
+    {
+        entry->maxTicks = ticks;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_error
+********************************************************************************
+* Summary:
+*  This function counts each MASTER_ERROR_MASK bit set in a master status.
+*
+* Parameters:
+*  uint32_t masterStatus - Cy_SCB_I2C_MasterGetStatus() value
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_error(uint32_t masterStatus)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    for (uint32_t i = 0UL; i < EEPROM_STATS_ERR_COUNT; i++)
+    {
+        if (0UL != (masterStatus & errorBits[i]))
+        {
+            stats.errors[i]++;
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_manual_error
+********************************************************************************
+* Summary:
+*  This function counts the error of a low-level transfer, using the same
+*  counters as eeprom_stats_error(). A timeout also counts a recovery.
+*
+* Parameters:
+*  cy_en_scb_i2c_status_t status
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_manual_error(cy_en_scb_i2c_status_t status)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    switch (status)
+    {
+        case CY_SCB_I2C_MASTER_MANUAL_NAK:
+            stats.errors[EEPROM_STATS_ERR_DATA_NAK]++;
+            break;
+        case CY_SCB_I2C_MASTER_MANUAL_ADDR_NAK:
+            stats.errors[EEPROM_STATS_ERR_ADDR_NAK]++;
+            break;
+        case CY_SCB_I2C_MASTER_MANUAL_ARB_LOST:
+            stats.errors[EEPROM_STATS_ERR_ARB_LOST]++;
+            break;
+        case CY_SCB_I2C_MASTER_MANUAL_ABORT_START:
+            stats.errors[EEPROM_STATS_ERR_ABORT_START]++;
+            break;
+        case CY_SCB_I2C_MASTER_MANUAL_BUS_ERR:
+            stats.errors[EEPROM_STATS_ERR_BUS_ERR]++;
+            break;
+        case CY_SCB_I2C_MASTER_MANUAL_TIMEOUT:
+            stats.timeouts++;
+            stats.recoveries++;
+            break;
+        default:
+            break;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_ack_poll
+********************************************************************************
+* Summary:
+*  This function counts an address NAK received while acknowledge polling.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_ack_poll(void)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    stats.ackPolls++;
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_timeout
+********************************************************************************
+* Summary:
+*  This function counts a transfer timeout and the SCB recovery that follows.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_timeout(void)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    stats.timeouts++;
+    stats.recoveries++;
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_bus_clear
+********************************************************************************
+* Summary:
+*  This function adds the duration of a bus clear to its histogram, counts the
+*  SCB recovery it includes, and counts a failure if the bus stayed stuck.
+*
+* Parameters:
+*  uint32_t ticks - duration, a difference of eeprom_time_ticks() values
+*  bool cleared - both lines were released
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_bus_clear(uint32_t ticks, bool cleared)
+{
+    uint32_t intState;
+
+    eeprom_stats_xfer(EEPROM_STATS_OP_BUS_CLEAR, ticks);
+
+    intState = Cy_SysLib_EnterCriticalSection();
+
+    stats.recoveries++;
+    if (!cleared)
+    {
+        stats.stuckBus++;
+    }
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_retry
+********************************************************************************
+* Summary:
+*  This function counts a retry of a failed transfer.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_retry(void)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    stats.retries++;
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_get
+********************************************************************************
+* Summary:
+*  This function copies all counters to snapshot. The copy is taken in a
+*  critical section so that it is consistent with the I2C interrupt; the
+*  durations are converted to microseconds afterwards.
+*
+* Parameters:
+*  eeprom_stats_t *snapshot
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_get(eeprom_stats_t *snapshot)
+{
+    stats_op_ticks_t ticks[EEPROM_STATS_OP_COUNT];
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    *snapshot = stats;
+    memcpy(ticks, opTicks, sizeof(ticks));
+
+    Cy_SysLib_ExitCriticalSection(intState);
+
+    for (uint32_t i = 0UL; i < EEPROM_STATS_OP_COUNT; i++)
+    {
+        snapshot->op[i].count   = ticks[i].count;
+        snapshot->op[i].totalUs = eeprom_time_ticks_to_us(ticks[i].totalTicks);
+        snapshot->op[i].maxUs   = eeprom_time_ticks_to_us(ticks[i].maxTicks);
+        memcpy(snapshot->op[i].histogram, ticks[i].histogram, sizeof(ticks[i].histogram));
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stats_reset
+********************************************************************************
+* Summary:
+*  This function clears all counters.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_stats_reset(void)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+
+    memset(&stats, 0, sizeof(stats));
+    memset(opTicks, 0, sizeof(opTicks));
+
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+#endif /* EEPROM_STATS_ENABLE */
+
+/* [] END OF FILE */
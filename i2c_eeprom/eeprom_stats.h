@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name:  eeprom_stats.h
+*
+* Description:  This file provides constants, data types, hook macros and
+*               function prototypes of the I2C master instrumentation.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_STATS_H_
+#define SOURCE_EEPROM_STATS_H_
+
+#include "cy_pdl.h"
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Transfer timing and bus error counters, 0u removes all instrumentation,
+ * can be overridden from the Makefile DEFINES */
+#ifndef EEPROM_STATS_ENABLE
+#define EEPROM_STATS_ENABLE         (0u)
+#endif
+
+/* Operation types with a latency histogram */
+#define EEPROM_STATS_OP_WRITE       (0u)    /* Page write */
+#define EEPROM_STATS_OP_READ        (1u)    /* Read data phase */
+#define EEPROM_STATS_OP_ADDRESS     (2u)    /* Address phase of a random read */
+#define EEPROM_STATS_OP_STREAM      (3u)    /* Sequential streaming read */
+#define EEPROM_STATS_OP_WAIT_READY  (4u)    /* Acknowledge polling for a write cycle */
+#define EEPROM_STATS_OP_BUS_CLEAR   (5u)    /* Recovery of a stuck bus */
+#define EEPROM_STATS_OP_COUNT       (6u)
+
+/* Histogram buckets: below 128 us, then doubling up to 8 ms and above */
+#define EEPROM_STATS_BUCKETS        (8u)
+#define EEPROM_STATS_BUCKET_SHIFT   (7u)
+
+/* Counted bits of MASTER_ERROR_MASK */
+#define EEPROM_STATS_ERR_DATA_NAK       (0u)
+#define EEPROM_STATS_ERR_ADDR_NAK       (1u)
+#define EEPROM_STATS_ERR_ARB_LOST       (2u)
+#define EEPROM_STATS_ERR_ABORT_START    (3u)
+#define EEPROM_STATS_ERR_BUS_ERR        (4u)
+#define EEPROM_STATS_ERR_COUNT          (5u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Timing of one operation type */
+typedef struct
+{
+    uint32_t count;
+    uint32_t totalUs;
+    uint32_t maxUs;
+    uint32_t histogram[EEPROM_STATS_BUCKETS];
+} eeprom_stats_op_t;
+
+/* Snapshot of all counters */
+typedef struct
+{
+    eeprom_stats_op_t op[EEPROM_STATS_OP_COUNT];
+    uint32_t errors[EEPROM_STATS_ERR_COUNT];    /* Transfers ended by each error */
+    uint32_t ackPolls;                          /* Address NAKs while polling */
+    uint32_t timeouts;                          /* Transfers that timed out */
+    uint32_t recoveries;                        /* SCB disable/enable cycles */
+    uint32_t retries;                           /* Transfers tried again */
+    uint32_t stuckBus;                          /* Bus clears that failed */
+} eeprom_stats_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void eeprom_stats_xfer(uint8_t op, uint32_t ticks);
+void eeprom_stats_error(uint32_t masterStatus);
+void eeprom_stats_manual_error(cy_en_scb_i2c_status_t status);
+void eeprom_stats_ack_poll(void);
+void eeprom_stats_timeout(void);
+void eeprom_stats_bus_clear(uint32_t ticks, bool cleared);
+void eeprom_stats_retry(void);
+void eeprom_stats_get(eeprom_stats_t *snapshot);
+void eeprom_stats_reset(void);
+
+#endif /* SOURCE_EEPROM_STATS_H_ */
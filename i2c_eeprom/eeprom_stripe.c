@@ -0,0 +1,255 @@
+/******************************************************************************
+* File Name:  eeprom_stripe.c
+*
+* Description:  This file implements page striping across several EEPROM
+*               devices. Consecutive pages of the striped address space go
+*               to consecutive devices, so the write cycle of one device
+*               overlaps with the page writes to the others.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_stripe.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Striped devices, owned by the caller of eeprom_stripe_init() */
+static const eeprom_dev_t *stripeDevices = NULL;
+static uint32_t stripeCount = 0UL;
+
+/*******************************************************************************
+* Function Name: StripeMap
+********************************************************************************
+* Summary:
+*  This function maps a striped address to a device and the memory address on
+*  that device. Page n of the striped space is page n / count of device
+*  n % count.
+*
+* Parameters:
+*  uint32_t addr - striped address
+*  eeprom_addr_t *devAddr - memory address on the device
+*
+* Return:
+*  const eeprom_dev_t *
+*
+*******************************************************************************/
+static const eeprom_dev_t *StripeMap(uint32_t addr, eeprom_addr_t *devAddr)
+{
+    uint32_t page = addr / EEPROM_PAGE_SIZE;
+
+    *devAddr = (eeprom_addr_t)(((page / stripeCount) * EEPROM_PAGE_SIZE) + (addr % EEPROM_PAGE_SIZE));
+
+    return &stripeDevices[page % stripeCount];
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stripe_init
+********************************************************************************
+* Summary:
+*  This function sets the devices of the striped address space. Every SCB used
+*  by the devices must be initialized and enabled in I2C master mode.
+*
+* Parameters:
+*  const eeprom_dev_t *devices - array of count devices
+*  uint32_t count
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_stripe_init(const eeprom_dev_t *devices, uint32_t count)
+{
+    if ((devices == NULL) || (count == 0UL) || (count > EEPROM_STRIPE_MAX_DEVICES))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    stripeDevices = devices;
+    stripeCount   = count;
+
+    return TRANSFER_CMPLT;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stripe_size
+********************************************************************************
+* Summary:
+*  This function returns the size of the striped address space in bytes.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_stripe_size(void)
+{
+    return (stripeCount * EEPROM_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stripe_write
+********************************************************************************
+* Summary:
+*  This function writes len bytes from src at striped address addr. Each page
+*  goes to the next device as soon as that device acknowledges, without
+*  waiting for the write cycle of the previous page, so with N devices up to N
+*  write cycles run at the same time. The write cycles of the last pages are
+*  still in progress on return; wait for them with eeprom_stripe_wait_ready().
+*
+* Parameters:
+*  uint32_t addr
+*  const uint8_t *src
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_stripe_write(uint32_t addr, const uint8_t *src, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    const eeprom_dev_t *dev;
+    eeprom_addr_t devAddr;
+    uint32_t chunk;
+
+    if ((src == NULL) || (len == 0UL) || ((addr + len) > eeprom_stripe_size()))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        /* Burst up to the end of the current page */
+        chunk = EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE);
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        dev = StripeMap(addr, &devAddr);
+
+        /* Returns at once unless the device is still busy with its last page */
+        status = eeprom_dev_wait_ready(dev, EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_dev_write(dev, devAddr, src, chunk);
+        }
+
+        addr += chunk;
+        src  += chunk;
+        len  -= chunk;
+    }
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stripe_read
+********************************************************************************
+* Summary:
+*  This function reads len bytes at striped address addr into dst, one page
+*  per transaction.
+*
+* Parameters:
+*  uint32_t addr
+*  uint8_t *dst
+*  uint32_t len
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_stripe_read(uint32_t addr, uint8_t *dst, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    const eeprom_dev_t *dev;
+    eeprom_addr_t devAddr;
+    uint32_t chunk;
+
+    if ((dst == NULL) || (len == 0UL) || ((addr + len) > eeprom_stripe_size()))
+    {
+        return INVALID_PARAM_ERROR;
+    }
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        chunk = EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE);
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        dev = StripeMap(addr, &devAddr);
+        status = eeprom_dev_read(dev, devAddr, dst, chunk);
+
+        addr += chunk;
+        dst  += chunk;
+        len  -= chunk;
+    }
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_stripe_wait_ready
+********************************************************************************
+* Summary:
+*  This function waits until the write cycles of all striped devices have
+*  completed.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+uint8_t eeprom_stripe_wait_ready(void)
+{
+    uint8_t status = TRANSFER_CMPLT;
+
+    for (uint32_t i = 0UL; (i < stripeCount) && (status == TRANSFER_CMPLT); i++)
+    {
+        status = eeprom_dev_wait_ready(&stripeDevices[i], EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+    }
+    return (status);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,218 @@
+/******************************************************************************
+* File Name:  eeprom_time.c
+*
+* Description:  This file implements a free-running microsecond timebase
+*               from the SysTick timer.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_time.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Milliseconds counted by the SysTick interrupt */
+static volatile uint32_t timeMs = 0UL;
+
+/*******************************************************************************
+* Function Name: TimeTick
+********************************************************************************
+* Summary:
+*  SysTick callback, called once per millisecond.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void TimeTick(void)
+{
+    timeMs++;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_time_init
+********************************************************************************
+* Summary:
+*  This function starts SysTick from the CPU clock with a 1-ms period.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_time_init(void)
+{
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, (SystemCoreClock / 1000UL) - 1UL);
+    (void) Cy_SysTick_SetCallback(0UL, &TimeTick);
+}
+
+/*******************************************************************************
+* Function Name: TimeSample
+********************************************************************************
+* Summary:
+*  Reads the millisecond counter and the SysTick count as one consistent pair.
+*  The time is also correct while the SysTick interrupt is held off for up to
+*  one millisecond, as in the I2C interrupt and the low-power waits.
+*
+* Parameters:
+*  uint32_t *ms - milliseconds since eeprom_time_init()
+*  uint32_t *elapsed - SysTick clocks since the start of that millisecond
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void TimeSample(uint32_t *ms, uint32_t *elapsed)
+{
+    uint32_t count;
+    bool pending;
+
+    /* Read again if the millisecond counter moved or SysTick wrapped while
+     * sampling */
+    do
+    {
+        *ms = timeMs;
+        pending = (0UL != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk));
+        count = Cy_SysTick_GetValue();
+    } while ((*ms != timeMs) || (pending != (0UL != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))));
+
+    /* A tick that is pending while interrupts are masked is not counted yet */
+    if (pending)
+    {
+        (*ms)++;
+    }
+
+    /* SysTick counts down from the reload value */
+    *elapsed = Cy_SysTick_GetReload() - count;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_time_us
+********************************************************************************
+* Summary:
+*  This function returns the time since eeprom_time_init() in microseconds.
+*  The value wraps after about 71 minutes; differences of two timestamps
+*  remain valid across the wrap.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_time_us(void)
+{
+    uint32_t ms;
+    uint32_t elapsed;
+
+    TimeSample(&ms, &elapsed);
+    return ((ms * 1000UL) + ((elapsed * 1000UL) / (Cy_SysTick_GetReload() + 1UL)));
+}
+
+/*******************************************************************************
+* Function Name: eeprom_time_ticks
+********************************************************************************
+* Summary:
+*  This function returns the time since eeprom_time_init() in SysTick clocks.
+*  It only multiplies, so it is cheaper than eeprom_time_us() on a CPU without
+*  a hardware divider. The value wraps after 2^32 clocks, about 89 seconds at
+*  48 MHz; differences of two timestamps remain valid across the wrap.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_time_ticks(void)
+{
+    uint32_t ms;
+    uint32_t elapsed;
+
+    TimeSample(&ms, &elapsed);
+    return ((ms * (Cy_SysTick_GetReload() + 1UL)) + elapsed);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_time_next_tick_us
+********************************************************************************
+* Summary:
+*  This function returns the microseconds until the next SysTick interrupt,
+*  rounded up. A sleep that starts now ends by then at the latest.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_time_next_tick_us(void)
+{
+    uint32_t period = Cy_SysTick_GetReload() + 1UL;
+
+    /* SysTick counts down to 0 and raises the interrupt on the next clock */
+    return ((((Cy_SysTick_GetValue() + 1UL) * 1000UL) + period - 1UL) / period);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_time_ticks_to_us
+********************************************************************************
+* Summary:
+*  This function converts a duration in SysTick clocks to microseconds.
+*
+* Parameters:
+*  uint64_t ticks
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_time_ticks_to_us(uint64_t ticks)
+{
+    return ((uint32_t)((ticks * 1000ULL) / (Cy_SysTick_GetReload() + 1UL)));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,478 @@
+/******************************************************************************
+* File Name:  eeprom_trace.c
+*
+* Description:  This file contains the interrupt-driven UART trace: message IDs
+*               are queued in a lock-free ring buffer by the main loop and
+*               formatted and sent by the UART TX FIFO interrupt.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_trace.h"
+#include "eeprom_bench.h"
+#include <string.h>
+
+#if ((EEPROM_TRACE_DEPTH & (EEPROM_TRACE_DEPTH - 1UL)) != 0UL)
+#error "EEPROM_TRACE_DEPTH must be a power of two"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Argument formats */
+#define TRACE_ARG_NONE          (0u)
+#define TRACE_ARG_HEX           (1u)    /* " 0x" and eight hex digits */
+#define TRACE_ARG_DEC           (2u)    /* Unsigned decimal */
+#define TRACE_ARG_COLUMN        (3u)    /* Unsigned decimal in a table column, no line end */
+#define TRACE_ARG_NAME          (4u)    /* Benchmark workload name, no line end */
+
+/* Longest argument and line end: " 0x" + 8 digits + "\r\n", or the padding
+ * of a table column */
+#define TRACE_SUFFIX_SIZE       (16u)
+
+#if ((EEPROM_TRACE_COLUMN_WIDTH > TRACE_SUFFIX_SIZE) || (EEPROM_TRACE_NAME_WIDTH > TRACE_SUFFIX_SIZE))
+#error "A benchmark table column does not fit the line suffix"
+#endif
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Text and argument format of a message */
+typedef struct
+{
+    const char *text;
+    uint8_t format;
+} trace_format_t;
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const trace_format_t traceFormats[EEPROM_TRACE_MSG_COUNT] =
+{
+    [EEPROM_TRACE_MSG_BANNER]       = { "\x1b[2J\x1b[;H**************************"
+                                        "PMG1 MCU: I2C EEPROM"
+                                        "**************************\r\n", TRACE_ARG_NONE },
+    [EEPROM_TRACE_MSG_LOOP]         = { "Entered for loop", TRACE_ARG_NONE },
+    [EEPROM_TRACE_MSG_WRITE_START]  = { "\r\n Start writing to EEPROM \r\n", TRACE_ARG_NONE },
+    [EEPROM_TRACE_MSG_WRITE_FAIL]   = { "\r\n\n Writing to EEPROM failed, status", TRACE_ARG_HEX },
+    [EEPROM_TRACE_MSG_READ_START]   = { "\r\n\n Start reading back from EEPROM \r\n", TRACE_ARG_NONE },
+    [EEPROM_TRACE_MSG_READ_OK]      = { "\r\n\n Read back successful ", TRACE_ARG_NONE },
+    [EEPROM_TRACE_MSG_READ_FAIL]    = { "\r\n\n Mismatch between data written and read back, status", TRACE_ARG_HEX },
+    [EEPROM_TRACE_MSG_INIT_FAIL]    = { "\r\nFAIL: API initI2CMaster failed with error code", TRACE_ARG_HEX },
+    [EEPROM_TRACE_MSG_BENCH_FAIL]   = { "\r\nFAIL: API eeprom_bench_run failed with error code", TRACE_ARG_HEX },
+    [EEPROM_TRACE_MSG_SYSINT_FAIL]  = { "\r\nFAIL: API Cy_SysInt_Init failed with error code", TRACE_ARG_HEX },
+    [EEPROM_TRACE_MSG_DROPPED]      = { "\r\nTrace messages dropped:", TRACE_ARG_DEC },
+    [EEPROM_TRACE_MSG_BENCH_HEADER] = { "\r\nworkload       bytes/s  EEPROM B     xfers    min us    max us"
+                                        "  total us    bus us act us/KB    isr/KB", TRACE_ARG_NONE },
+    [EEPROM_TRACE_MSG_BENCH_NAME]   = { "", TRACE_ARG_NAME },
+    [EEPROM_TRACE_MSG_BENCH_VALUE]  = { "", TRACE_ARG_COLUMN },
+    [EEPROM_TRACE_MSG_LINE_END]     = { "", TRACE_ARG_NONE },
+};
+
+/* UART interrupt */
+static const cy_stc_sysint_t traceIrqCfg =
+{
+    .intrSrc      = CYBSP_UART_IRQ,
+    .intrPriority = EEPROM_TRACE_INTR_PRIORITY
+};
+
+/* Ring buffer of messages. Only the main loop writes traceHead and only the
+ * UART interrupt writes traceTail, so neither side needs a lock. */
+static volatile eeprom_trace_msg_t traceRing[EEPROM_TRACE_DEPTH];
+static volatile uint32_t traceHead = 0UL;
+static volatile uint32_t traceTail = 0UL;
+
+/* Messages lost because the ring was full, and the part already reported */
+static volatile uint32_t traceDropped = 0UL;
+static uint32_t traceDroppedSent = 0UL;
+
+/* Line being sent: the message text, then the formatted argument */
+static const char *traceText = NULL;
+static char traceSuffix[TRACE_SUFFIX_SIZE];
+static uint8_t traceSuffixPos = 0u;
+static uint8_t traceSuffixLen = 0u;
+
+/*******************************************************************************
+* Function Name: TraceFormatArg
+********************************************************************************
+* Summary:
+*  This function formats the argument of a message and the line end into
+*  traceSuffix. A table column gets no line end: its value is right-aligned
+*  in EEPROM_TRACE_COLUMN_WIDTH characters, and a workload name, whose
+*  length is passed as arg, is padded to EEPROM_TRACE_NAME_WIDTH.
+*
+* Parameters:
+*  uint8_t format - TRACE_ARG_*
+*  uint32_t arg
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void TraceFormatArg(uint8_t format, uint32_t arg)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+    char digits[10];
+    uint8_t len = 0u;
+    uint8_t count = 0u;
+
+    if (format == TRACE_ARG_NAME)
+    {
+        do
+        {
+            traceSuffix[len++] = ' ';
+        } while ((arg + len) < EEPROM_TRACE_NAME_WIDTH);
+        traceSuffixPos = 0u;
+        traceSuffixLen = len;
+        return;
+    }
+
+    if (format == TRACE_ARG_HEX)
+    {
+        traceSuffix[len++] = ' ';
+        traceSuffix[len++] = '0';
+        traceSuffix[len++] = 'x';
+        for (int32_t shift = 28; shift >= 0; shift -= 4)
+        {
+            traceSuffix[len++] = hexDigits[(arg >> (uint32_t)shift) & 0xFu];
+        }
+    }
+    else if ((format == TRACE_ARG_DEC) || (format == TRACE_ARG_COLUMN))
+    {
+        do
+        {
+            digits[count++] = (char)('0' + (arg % 10UL));
+            arg /= 10UL;
+        } while (arg > 0UL);
+
+        do
+        {
+            traceSuffix[len++] = ' ';
+        } while ((format == TRACE_ARG_COLUMN) && ((len + count) < EEPROM_TRACE_COLUMN_WIDTH));
+        while (count > 0u)
+        {
+            traceSuffix[len++] = digits[--count];
+        }
+    }
+    else
+    {
+        /* Text only */
+    }
+
+    if (format != TRACE_ARG_COLUMN)
+    {
+        traceSuffix[len++] = '\r';
+        traceSuffix[len++] = '\n';
+    }
+    traceSuffixPos = 0u;
+    traceSuffixLen = len;
+}
+
+/*******************************************************************************
+* Function Name: TraceNextLine
+********************************************************************************
+* Summary:
+*  This function takes the oldest message from the ring and makes it the line
+*  being sent. Once the ring is empty, messages dropped since the last report
+*  are reported.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool - false if there is nothing left to send
+*
+*******************************************************************************/
+static bool TraceNextLine(void)
+{
+    uint32_t tail = traceTail;
+    uint8_t id;
+    uint32_t arg;
+
+    if (tail != traceHead)
+    {
+        id  = traceRing[tail].id;
+        arg = traceRing[tail].arg;
+        traceTail = (tail + 1UL) & (EEPROM_TRACE_DEPTH - 1UL);
+    }
+    else if (traceDropped != traceDroppedSent)
+    {
+        id  = EEPROM_TRACE_MSG_DROPPED;
+        arg = traceDropped - traceDroppedSent;
+        traceDroppedSent += arg;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (id == EEPROM_TRACE_MSG_BENCH_NAME)
+    {
+        traceText = eeprom_bench_name(arg);
+        TraceFormatArg(TRACE_ARG_NAME, (uint32_t)strlen(traceText));
+    }
+    else if (id < EEPROM_TRACE_MSG_COUNT)
+    {
+        traceText = traceFormats[id].text;
+        TraceFormatArg(traceFormats[id].format, arg);
+    }
+    else
+    {
+        /* Unknown message, sent as its number */
+        traceText = "Trace message";
+        TraceFormatArg(TRACE_ARG_DEC, id);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: TraceDrain
+********************************************************************************
+* Summary:
+*  This function fills the UART TX FIFO from the line being sent and the
+*  messages behind it. The TX interrupt is masked once everything is sent.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void TraceDrain(void)
+{
+    char c;
+
+    for (;;)
+    {
+        if ((traceText != NULL) && (*traceText != '\0'))
+        {
+            c = *traceText;
+        }
+        else if (traceSuffixPos < traceSuffixLen)
+        {
+            c = traceSuffix[traceSuffixPos];
+        }
+        else if (TraceNextLine())
+        {
+            continue;
+        }
+        else
+        {
+            Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+            break;
+        }
+
+        if (0UL == Cy_SCB_UART_Put(CYBSP_UART_HW, (uint32_t)c))
+        {
+            /* TX FIFO full, the level interrupt resumes */
+            break;
+        }
+
+        if ((traceText != NULL) && (*traceText != '\0'))
+        {
+            traceText++;
+        }
+        else
+        {
+            traceSuffixPos++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: TraceInterrupt
+********************************************************************************
+* Summary:
+*  UART interrupt handler, raised when the TX FIFO drops below half full.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void TraceInterrupt(void)
+{
+    TraceDrain();
+    Cy_SCB_ClearTxInterrupt(CYBSP_UART_HW, CY_SCB_TX_INTR_LEVEL);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_trace_init
+********************************************************************************
+* Summary:
+*  This function sets up the UART TX FIFO level and the UART interrupt. The
+*  UART must be initialized and enabled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_en_sysint_status_t
+*
+*******************************************************************************/
+cy_en_sysint_status_t eeprom_trace_init(void)
+{
+    cy_en_sysint_status_t status;
+
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+    Cy_SCB_SetTxFifoLevel(CYBSP_UART_HW, Cy_SCB_GetFifoSize(CYBSP_UART_HW) / 2UL);
+
+    status = Cy_SysInt_Init(&traceIrqCfg, &TraceInterrupt);
+    if (status == CY_SYSINT_SUCCESS)
+    {
+        NVIC_ClearPendingIRQ(traceIrqCfg.intrSrc);
+        NVIC_EnableIRQ(traceIrqCfg.intrSrc);
+    }
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_trace
+********************************************************************************
+* Summary:
+*  This function queues a message for the UART and returns at once; the text
+*  is formatted by the UART interrupt. A message is dropped and counted when
+*  the ring is full. The ring has a single producer: call this from the main
+*  loop only, not from interrupt handlers.
+*
+* Parameters:
+*  uint8_t id - EEPROM_TRACE_MSG_*
+*  uint32_t arg - printed if the message has an argument
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_trace(uint8_t id, uint32_t arg)
+{
+    uint32_t head = traceHead;
+    uint32_t next = (head + 1UL) & (EEPROM_TRACE_DEPTH - 1UL);
+
+    if (next == traceTail)
+    {
+        traceDropped++;
+        return;
+    }
+
+    traceRing[head].id  = id;
+    traceRing[head].arg = arg;
+
+    /* Publish the complete message */
+    traceHead = next;
+
+    /* The interrupt masks itself again once the ring is empty */
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_TX_INTR_LEVEL);
+}
+
+/*******************************************************************************
+* Function Name: eeprom_trace_space
+********************************************************************************
+* Summary:
+*  This function returns the number of messages that can be queued without
+*  one being dropped, so that a caller can wait for room for a group of
+*  messages such as a table row.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t - free entries of the ring
+*
+*******************************************************************************/
+uint32_t eeprom_trace_space(void)
+{
+    return (EEPROM_TRACE_DEPTH - 1UL) - ((traceHead - traceTail) & (EEPROM_TRACE_DEPTH - 1UL));
+}
+
+/*******************************************************************************
+* Function Name: eeprom_trace_flush
+********************************************************************************
+* Summary:
+*  This function waits until all queued messages have left the UART. It
+*  drains the ring itself, so it also works with interrupts disabled, for
+*  example ahead of an assert.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_trace_flush(void)
+{
+    uint32_t intState;
+    bool pending;
+
+    do
+    {
+        intState = Cy_SysLib_EnterCriticalSection();
+        TraceDrain();
+        pending = (traceTail != traceHead) || (traceDropped != traceDroppedSent) ||
+                  ((traceText != NULL) && (*traceText != '\0')) || (traceSuffixPos < traceSuffixLen);
+        Cy_SysLib_ExitCriticalSection(intState);
+    } while (pending);
+
+    while (!Cy_SCB_UART_IsTxComplete(CYBSP_UART_HW))
+    {
+        /* Wait for the last byte */
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_trace_dropped
+********************************************************************************
+* Summary:
+*  This function returns the number of messages lost because the ring was
+*  full. Drops are also reported on the UART once the ring has drained.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t eeprom_trace_dropped(void)
+{
+    return traceDropped;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/******************************************************************************
+* File Name:  eeprom_trace.h
+*
+* Description:  This file provides constants, data types and function
+*               prototypes of the interrupt-driven UART trace.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_TRACE_H_
+#define SOURCE_EEPROM_TRACE_H_
+
+#include "cy_pdl.h"
+#include "cybsp.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of queued messages, a power of two. One slot is kept free to tell a
+ * full ring from an empty one. */
+#define EEPROM_TRACE_DEPTH              (32UL)
+
+/* UART interrupt priority, the lowest like the I2C interrupt */
+#define EEPROM_TRACE_INTR_PRIORITY      (3u)
+
+/* Messages, the text of each is in eeprom_trace.c */
+#define EEPROM_TRACE_MSG_BANNER         (0u)
+#define EEPROM_TRACE_MSG_LOOP           (1u)
+#define EEPROM_TRACE_MSG_WRITE_START    (2u)
+#define EEPROM_TRACE_MSG_WRITE_FAIL     (3u)    /* arg: status */
+#define EEPROM_TRACE_MSG_READ_START     (4u)
+#define EEPROM_TRACE_MSG_READ_OK        (5u)
+#define EEPROM_TRACE_MSG_READ_FAIL      (6u)    /* arg: status */
+#define EEPROM_TRACE_MSG_INIT_FAIL      (7u)    /* arg: status */
+#define EEPROM_TRACE_MSG_BENCH_FAIL     (8u)    /* arg: status */
+#define EEPROM_TRACE_MSG_SYSINT_FAIL    (9u)    /* arg: status */
+#define EEPROM_TRACE_MSG_DROPPED        (10u)   /* arg: messages lost */
+#define EEPROM_TRACE_MSG_BENCH_HEADER   (11u)
+#define EEPROM_TRACE_MSG_BENCH_NAME     (12u)   /* arg: EEPROM_BENCH_* workload */
+#define EEPROM_TRACE_MSG_BENCH_VALUE    (13u)   /* arg: one column of the row */
+#define EEPROM_TRACE_MSG_LINE_END       (14u)
+#define EEPROM_TRACE_MSG_COUNT          (15u)
+
+/* Width of a benchmark table column, and of the workload names before them */
+#define EEPROM_TRACE_COLUMN_WIDTH       (10u)
+#define EEPROM_TRACE_NAME_WIDTH         (12u)
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Queued message, formatted only when the UART interrupt sends it */
+typedef struct
+{
+    uint8_t id;
+    uint32_t arg;
+} eeprom_trace_msg_t;
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_sysint_status_t eeprom_trace_init(void);
+void eeprom_trace(uint8_t id, uint32_t arg);
+void eeprom_trace_flush(void);
+uint32_t eeprom_trace_space(void);
+uint32_t eeprom_trace_dropped(void);
+
+#endif /* SOURCE_EEPROM_TRACE_H_ */
@@ -0,0 +1,703 @@
+/******************************************************************************
+* File Name:  eeprom_uart.c
+*
+* Description:  This file contains the UART program and dump protocol. Frames are
+*               received and sent from the UART interrupt, and the commands run
+*               in the main loop.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/* Header file includes */
+#include "eeprom_uart.h"
+#include "eeprom_power.h"
+#include <string.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Header fields, offsets from the byte after the sync byte */
+#define UART_OFS_CMD            (0UL)
+#define UART_OFS_STATUS         (1UL)
+#define UART_OFS_ADDR           (2UL)
+#define UART_OFS_LEN            (6UL)
+#define UART_OFS_DATA           (EEPROM_UART_HEADER_SIZE)
+
+/* Size of a frame from the host without its sync byte */
+#define UART_RX_FRAME_SIZE      (EEPROM_UART_FRAME_MAX - 1UL)
+
+/* Length of the INFO and VERIFY data */
+#define UART_INFO_SIZE          (8UL)
+#define UART_VERIFY_SIZE        (4UL)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* UART interrupt */
+static const cy_stc_sysint_t uartIrqCfg =
+{
+    .intrSrc      = CYBSP_UART_IRQ,
+    .intrPriority = EEPROM_UART_INTR_PRIORITY
+};
+
+/* Receive buffers, filled in turn by the UART interrupt and processed in the
+ * same order by the main loop. A buffer belongs to the interrupt while its
+ * ready flag is clear and to the main loop while it is set. */
+static uint8_t uartRxFrames[EEPROM_UART_RX_BUFFERS][UART_RX_FRAME_SIZE];
+static volatile bool uartRxReady[EEPROM_UART_RX_BUFFERS];
+static uint32_t uartRxProcess = 0UL;
+
+/* Receiver state, used by the UART interrupt only. uartRxSize is the size of
+ * the frame being received and 0 while waiting for a sync byte. */
+static uint32_t uartRxFill = 0UL;
+static uint32_t uartRxPos = 0UL;
+static uint32_t uartRxSize = 0UL;
+static uint32_t uartRxLastUs = 0UL;
+
+/* Transmit buffers. Only the main loop writes uartTxHead and only the UART
+ * interrupt writes uartTxTail; both count frames and wrap freely. */
+static uint8_t uartTxFrames[EEPROM_UART_TX_BUFFERS][EEPROM_UART_FRAME_MAX];
+static uint32_t uartTxSize[EEPROM_UART_TX_BUFFERS];
+static volatile uint32_t uartTxHead = 0UL;
+static volatile uint32_t uartTxTail = 0UL;
+static uint32_t uartTxPos = 0UL;
+
+/* Failed write cycle of the last WRITE frame, returned for the next frame */
+static uint8_t uartDeferredStatus = TRANSFER_CMPLT;
+
+static eeprom_uart_stats_t uartStats;
+
+/*******************************************************************************
+* Function Name: UartGetField
+********************************************************************************
+* Summary:
+*  This function reads a little-endian field of a frame.
+*
+* Parameters:
+*  const uint8_t *field
+*  uint32_t size - bytes in the field, up to 4
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t UartGetField(const uint8_t *field, uint32_t size)
+{
+    uint32_t value = 0UL;
+
+    while (size > 0UL)
+    {
+        size--;
+        value = (value << 8u) | field[size];
+    }
+    return value;
+}
+
+/*******************************************************************************
+* Function Name: UartPutField
+********************************************************************************
+* Summary:
+*  This function writes a little-endian field of a frame.
+*
+* Parameters:
+*  uint8_t *field
+*  uint32_t value
+*  uint32_t size - bytes in the field, up to 4
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartPutField(uint8_t *field, uint32_t value, uint32_t size)
+{
+    for (uint32_t i = 0UL; i < size; i++)
+    {
+        field[i] = (uint8_t)value;
+        value >>= 8u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: UartReceive
+********************************************************************************
+* Summary:
+*  This function adds a received byte to the frame being received. A complete
+*  frame is handed to the main loop and the next frame goes to the other
+*  buffer. A WRITE frame longer than a chunk cannot be stored and is handed
+*  over after its header, to be rejected.
+*
+* Parameters:
+*  uint8_t byte
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartReceive(uint8_t byte)
+{
+    uint8_t *frame = uartRxFrames[uartRxFill];
+    uint32_t nowUs = eeprom_time_us();
+    uint32_t len;
+
+    if ((uartRxSize != 0UL) && ((nowUs - uartRxLastUs) >= (EEPROM_UART_BYTE_TIMEOUT_MS * 1000UL)))
+    {
+        /* The host gave up on the frame */
+        uartRxSize = 0UL;
+    }
+    uartRxLastUs = nowUs;
+
+    if (uartRxSize == 0UL)
+    {
+        if (byte == EEPROM_UART_SYNC_REQUEST)
+        {
+            if (uartRxReady[uartRxFill])
+            {
+                /* More frames in flight than receive buffers */
+                uartStats.overruns++;
+            }
+            else
+            {
+                uartRxPos  = 0UL;
+                uartRxSize = EEPROM_UART_HEADER_SIZE + EEPROM_CRC32_SIZE;
+            }
+        }
+        return;
+    }
+
+    frame[uartRxPos++] = byte;
+
+    if ((uartRxPos == EEPROM_UART_HEADER_SIZE) && (frame[UART_OFS_CMD] == EEPROM_UART_CMD_WRITE))
+    {
+        len = UartGetField(&frame[UART_OFS_LEN], 2UL);
+        if (len > EEPROM_UART_CHUNK_SIZE)
+        {
+            uartRxPos = uartRxSize;
+        }
+        else
+        {
+            uartRxSize += len;
+        }
+    }
+
+    if (uartRxPos == uartRxSize)
+    {
+        uartRxReady[uartRxFill] = true;
+        uartRxFill = (uartRxFill + 1UL) % EEPROM_UART_RX_BUFFERS;
+        uartRxSize = 0UL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: UartDrain
+********************************************************************************
+* Summary:
+*  This function fills the UART TX FIFO from the queued frames. The TX
+*  interrupt is masked once everything is sent.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartDrain(void)
+{
+    uint32_t slot;
+
+    while (uartTxTail != uartTxHead)
+    {
+        slot = uartTxTail % EEPROM_UART_TX_BUFFERS;
+        uartTxPos += Cy_SCB_UART_PutArray(CYBSP_UART_HW, &uartTxFrames[slot][uartTxPos],
+                                          uartTxSize[slot] - uartTxPos);
+        if (uartTxPos < uartTxSize[slot])
+        {
+            /* TX FIFO full, the level interrupt resumes */
+            return;
+        }
+
+        uartTxPos = 0UL;
+        uartTxTail++;
+    }
+
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+}
+
+/*******************************************************************************
+* Function Name: UartInterrupt
+********************************************************************************
+* Summary:
+*  UART interrupt handler, raised when a byte is received and when the TX
+*  FIFO drops below half full.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartInterrupt(void)
+{
+    uint32_t rxStatus = Cy_SCB_GetRxInterruptStatusMasked(CYBSP_UART_HW);
+    uint32_t data;
+
+    if (0UL != (rxStatus & CY_SCB_RX_INTR_OVERFLOW))
+    {
+        uartStats.overruns++;
+    }
+
+    data = Cy_SCB_UART_Get(CYBSP_UART_HW);
+    while (data != CY_SCB_UART_RX_NO_DATA)
+    {
+        UartReceive((uint8_t)data);
+        data = Cy_SCB_UART_Get(CYBSP_UART_HW);
+    }
+    Cy_SCB_ClearRxInterrupt(CYBSP_UART_HW, rxStatus);
+
+    if (0UL != (Cy_SCB_GetTxInterruptStatusMasked(CYBSP_UART_HW) & CY_SCB_TX_INTR_LEVEL))
+    {
+        UartDrain();
+        Cy_SCB_ClearTxInterrupt(CYBSP_UART_HW, CY_SCB_TX_INTR_LEVEL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: UartTxAcquire
+********************************************************************************
+* Summary:
+*  This function waits for a free transmit buffer and returns where the data
+*  of the next response goes.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint8_t * - data area of the buffer
+*
+*******************************************************************************/
+static uint8_t *UartTxAcquire(void)
+{
+    while ((uartTxHead - uartTxTail) == EEPROM_UART_TX_BUFFERS)
+    {
+#if EEPROM_POWER_SLEEP_ENABLE
+        /* The interrupt cannot slip in between check and sleep */
+        uint32_t intState = Cy_SysLib_EnterCriticalSection();
+        if ((uartTxHead - uartTxTail) == EEPROM_UART_TX_BUFFERS)
+        {
+            eeprom_power_sleep();
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+#endif
+    }
+
+    return &uartTxFrames[uartTxHead % EEPROM_UART_TX_BUFFERS][1UL + UART_OFS_DATA];
+}
+
+/*******************************************************************************
+* Function Name: UartTxSend
+********************************************************************************
+* Summary:
+*  This function completes the frame in the buffer returned by
+*  UartTxAcquire() and queues it for the UART interrupt.
+*
+* Parameters:
+*  uint8_t cmd
+*  uint8_t status
+*  uint32_t addr
+*  uint32_t len - bytes of data already in the buffer
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartTxSend(uint8_t cmd, uint8_t status, uint32_t addr, uint32_t len)
+{
+    uint32_t slot = uartTxHead % EEPROM_UART_TX_BUFFERS;
+    uint8_t *frame = uartTxFrames[slot];
+    uint32_t crc;
+
+    frame[0] = EEPROM_UART_SYNC_RESPONSE;
+    frame[1UL + UART_OFS_CMD]    = cmd;
+    frame[1UL + UART_OFS_STATUS] = status;
+    UartPutField(&frame[1UL + UART_OFS_ADDR], addr, 4UL);
+    UartPutField(&frame[1UL + UART_OFS_LEN], len, 2UL);
+
+    crc = eeprom_crc32_update(EEPROM_CRC32_INIT, &frame[1], EEPROM_UART_HEADER_SIZE + len) ^ EEPROM_CRC32_INIT;
+    UartPutField(&frame[1UL + UART_OFS_DATA + len], crc, 4UL);
+    uartTxSize[slot] = 1UL + EEPROM_UART_HEADER_SIZE + len + EEPROM_CRC32_SIZE;
+
+    /* Publish the complete frame */
+    uartTxHead++;
+
+    /* The interrupt masks itself again once all frames are sent */
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_TX_INTR_LEVEL);
+}
+
+/*******************************************************************************
+* Function Name: UartRespond
+********************************************************************************
+* Summary:
+*  This function queues a response without data.
+*
+* Parameters:
+*  uint8_t cmd
+*  uint8_t status
+*  uint32_t addr
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartRespond(uint8_t cmd, uint8_t status, uint32_t addr)
+{
+    (void) UartTxAcquire();
+    UartTxSend(cmd, status, addr, 0UL);
+}
+
+/*******************************************************************************
+* Function Name: UartRelease
+********************************************************************************
+* Summary:
+*  This function returns the receive buffer being processed to the UART
+*  interrupt.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartRelease(void)
+{
+    uartRxReady[uartRxProcess] = false;
+    uartRxProcess = (uartRxProcess + 1UL) % EEPROM_UART_RX_BUFFERS;
+}
+
+/*******************************************************************************
+* Function Name: UartRead
+********************************************************************************
+* Summary:
+*  This function sends a range of the EEPROM as READ frames of up to a chunk.
+*  Each chunk is read while the one before it is sent. A failed read ends the
+*  range with a frame without data that carries the error status.
+*
+* Parameters:
+*  uint32_t addr
+*  uint32_t len
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartRead(uint32_t addr, uint32_t len)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t chunk;
+    uint8_t *data;
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        chunk = (len < EEPROM_UART_CHUNK_SIZE) ? len : EEPROM_UART_CHUNK_SIZE;
+
+        data = UartTxAcquire();
+        status = eeprom_read((eeprom_addr_t)addr, data, chunk);
+        UartTxSend(EEPROM_UART_CMD_READ, status, addr, (status == TRANSFER_CMPLT) ? chunk : 0UL);
+
+        addr += chunk;
+        len  -= chunk;
+    }
+}
+
+/*******************************************************************************
+* Function Name: UartErase
+********************************************************************************
+* Summary:
+*  This function fills a range of the EEPROM with 0xFF, one page at a time.
+*
+* Parameters:
+*  uint32_t addr
+*  uint32_t len
+*  uint8_t *pattern - scratch buffer of a chunk
+*
+* Return:
+*  uint8_t status
+*
+*******************************************************************************/
+static uint8_t UartErase(uint32_t addr, uint32_t len, uint8_t *pattern)
+{
+    uint8_t status = TRANSFER_CMPLT;
+    uint32_t chunk;
+
+    memset(pattern, 0xFF, EEPROM_UART_CHUNK_SIZE);
+
+    while ((len > 0UL) && (status == TRANSFER_CMPLT))
+    {
+        chunk = EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE);
+        if (chunk > len)
+        {
+            chunk = len;
+        }
+
+        status = eeprom_write((eeprom_addr_t)addr, pattern, chunk);
+        if (status == TRANSFER_CMPLT)
+        {
+            status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+        }
+
+        addr += chunk;
+        len  -= chunk;
+    }
+
+    return (status);
+}
+
+/*******************************************************************************
+* Function Name: UartProcess
+********************************************************************************
+* Summary:
+*  This function checks and runs the command of a received frame. A WRITE is
+*  answered as soon as the data is in the EEPROM, before its write cycle, and
+*  its receive buffer is released first so the host can send the next page
+*  during the write cycle. A write cycle that fails is reported for the next
+*  frame, which is not run.
+*
+* Parameters:
+*  uint8_t *frame - frame without its sync byte
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+static void UartProcess(uint8_t *frame)
+{
+    uint8_t cmd   = frame[UART_OFS_CMD];
+    uint32_t addr = UartGetField(&frame[UART_OFS_ADDR], 4UL);
+    uint32_t len  = UartGetField(&frame[UART_OFS_LEN], 2UL);
+    uint32_t dataLen = (cmd == EEPROM_UART_CMD_WRITE) ? len : 0UL;
+    uint32_t crc = 0UL;
+    uint8_t status = TRANSFER_CMPLT;
+    uint8_t *data;
+
+    uartStats.frames++;
+
+    if (dataLen > EEPROM_UART_CHUNK_SIZE)
+    {
+        status = INVALID_PARAM_ERROR;
+    }
+    else
+    {
+        crc = eeprom_crc32_update(EEPROM_CRC32_INIT, frame, EEPROM_UART_HEADER_SIZE + dataLen) ^ EEPROM_CRC32_INIT;
+        if (crc != UartGetField(&frame[UART_OFS_DATA + dataLen], 4UL))
+        {
+            status = INVALID_DATA_ERROR;
+        }
+    }
+
+    if (status != TRANSFER_CMPLT)
+    {
+        uartStats.badFrames++;
+    }
+    else if (uartDeferredStatus != TRANSFER_CMPLT)
+    {
+        status = uartDeferredStatus;
+        uartDeferredStatus = TRANSFER_CMPLT;
+    }
+    else if ((cmd != EEPROM_UART_CMD_INFO) &&
+             ((len == 0UL) || (addr >= EEPROM_SIZE) || (len > (EEPROM_SIZE - addr))))
+    {
+        status = INVALID_PARAM_ERROR;
+    }
+    else
+    {
+        /* Valid */
+    }
+
+    if (status != TRANSFER_CMPLT)
+    {
+        UartRelease();
+        UartRespond(cmd, status, addr);
+        return;
+    }
+
+    switch (cmd)
+    {
+        case EEPROM_UART_CMD_INFO:
+            UartRelease();
+            data = UartTxAcquire();
+            UartPutField(&data[0], EEPROM_SIZE, 4UL);
+            UartPutField(&data[4], EEPROM_PAGE_SIZE, 2UL);
+            UartPutField(&data[6], EEPROM_UART_CHUNK_SIZE, 2UL);
+            UartTxSend(cmd, TRANSFER_CMPLT, 0UL, UART_INFO_SIZE);
+            break;
+
+        case EEPROM_UART_CMD_READ:
+            UartRelease();
+            UartRead(addr, len);
+            break;
+
+        case EEPROM_UART_CMD_WRITE:
+            status = eeprom_write((eeprom_addr_t)addr, &frame[UART_OFS_DATA], len);
+            UartRelease();
+            UartRespond(cmd, status, addr);
+
+            if (status == TRANSFER_CMPLT)
+            {
+                uartStats.bytesWritten += len;
+
+                /* The next page is received meanwhile */
+                uartDeferredStatus = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+            }
+            break;
+
+        case EEPROM_UART_CMD_VERIFY:
+            UartRelease();
+            status = eeprom_crc_compute((eeprom_addr_t)addr, len, &crc);
+            data = UartTxAcquire();
+            UartPutField(data, crc, 4UL);
+            UartTxSend(cmd, status, addr, (status == TRANSFER_CMPLT) ? UART_VERIFY_SIZE : 0UL);
+            break;
+
+        case EEPROM_UART_CMD_ERASE:
+            status = UartErase(addr, len, &frame[UART_OFS_DATA]);
+            UartRelease();
+            UartRespond(cmd, status, addr);
+            break;
+
+        default:
+            UartRelease();
+            UartRespond(cmd, INVALID_PARAM_ERROR, addr);
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_uart_init
+********************************************************************************
+* Summary:
+*  This function sets up the UART FIFO levels and the UART interrupt. The UART
+*  must be initialized and enabled, and the UART must not be used for
+*  anything else.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_en_sysint_status_t
+*
+*******************************************************************************/
+cy_en_sysint_status_t eeprom_uart_init(void)
+{
+    cy_en_sysint_status_t status;
+
+    Cy_SCB_SetTxInterruptMask(CYBSP_UART_HW, CY_SCB_CLEAR_ALL_INTR_SRC);
+    Cy_SCB_SetTxFifoLevel(CYBSP_UART_HW, Cy_SCB_GetFifoSize(CYBSP_UART_HW) / 2UL);
+
+    Cy_SCB_ClearRxFifo(CYBSP_UART_HW);
+    Cy_SCB_SetRxInterruptMask(CYBSP_UART_HW, CY_SCB_RX_INTR_NOT_EMPTY | CY_SCB_RX_INTR_OVERFLOW);
+
+    status = Cy_SysInt_Init(&uartIrqCfg, &UartInterrupt);
+    if (status == CY_SYSINT_SUCCESS)
+    {
+        NVIC_ClearPendingIRQ(uartIrqCfg.intrSrc);
+        NVIC_EnableIRQ(uartIrqCfg.intrSrc);
+    }
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: eeprom_uart_poll
+********************************************************************************
+* Summary:
+*  This function runs the commands of all received frames. Call it from the
+*  main loop; it returns with the EEPROM idle.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_uart_poll(void)
+{
+    while (uartRxReady[uartRxProcess])
+    {
+        UartProcess(uartRxFrames[uartRxProcess]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: eeprom_uart_pending
+********************************************************************************
+* Summary:
+*  This function returns true if a received frame waits for
+*  eeprom_uart_poll().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool eeprom_uart_pending(void)
+{
+    return uartRxReady[uartRxProcess];
+}
+
+/*******************************************************************************
+* Function Name: eeprom_uart_get_stats
+********************************************************************************
+* Summary:
+*  This function returns a snapshot of the protocol statistics.
+*
+* Parameters:
+*  eeprom_uart_stats_t *stats
+*
+* Return:
+*  none
+*
+*******************************************************************************/
+void eeprom_uart_get_stats(eeprom_uart_stats_t *stats)
+{
+    uint32_t intState = Cy_SysLib_EnterCriticalSection();
+    *stats = uartStats;
+    Cy_SysLib_ExitCriticalSection(intState);
+}
+
+/* [] END OF FILE */
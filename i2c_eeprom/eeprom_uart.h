@@ -0,0 +1,107 @@
+/******************************************************************************
+* File Name:  eeprom_uart.h
+*
+* Description:  This file contains the declarations of the UART program and dump
+*               protocol.
+*
+* Related Document: See Readme.md
+*
+*******************************************************************************
+* Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+#ifndef SOURCE_EEPROM_UART_H_
+#define SOURCE_EEPROM_UART_H_
+
+#include "I2CMaster.h"
+#include "eeprom_crc.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Data bytes carried by one frame, a WRITE frame fills one page */
+#define EEPROM_UART_CHUNK_SIZE          (EEPROM_PAGE_SIZE)
+
+/* Receive buffers. The host may send this many WRITE frames ahead of their
+ * responses, so the next page arrives during the write cycle of the last. */
+#define EEPROM_UART_RX_BUFFERS          (2UL)
+
+/* Transmit buffers, the next READ chunk is read from the EEPROM while the
+ * last one is sent */
+#define EEPROM_UART_TX_BUFFERS          (2UL)
+
+/* A frame with a gap longer than this between two bytes is dropped, so a
+ * host that gave up mid-frame does not leave the receiver out of step */
+#define EEPROM_UART_BYTE_TIMEOUT_MS     (100UL)
+
+/* UART interrupt priority, the lowest like the I2C interrupt */
+#define EEPROM_UART_INTR_PRIORITY       (3u)
+
+/* First byte of a frame from the host and of a frame to the host */
+#define EEPROM_UART_SYNC_REQUEST        (0xA5u)
+#define EEPROM_UART_SYNC_RESPONSE       (0x5Au)
+
+/* Frame layout: sync byte, header, data, CRC-32 of header and data. The
+ * header holds the command, the status (0 from the host), the address
+ * (4 bytes) and the data length (2 bytes); multi-byte fields are little
+ * endian. */
+#define EEPROM_UART_HEADER_SIZE         (8UL)
+#define EEPROM_UART_FRAME_MAX           (1UL + EEPROM_UART_HEADER_SIZE + EEPROM_UART_CHUNK_SIZE + EEPROM_CRC32_SIZE)
+
+/* Commands. Only WRITE frames from the host carry data. Each command is
+ * answered with frames of the same command and a TRANSFER_CMPLT or error
+ * status; a bad CRC is answered with INVALID_DATA_ERROR. */
+#define EEPROM_UART_CMD_INFO            (0x00u) /* Data: size (4), page size (2), chunk size (2) */
+#define EEPROM_UART_CMD_READ            (0x01u) /* One data frame per chunk of the range */
+#define EEPROM_UART_CMD_WRITE           (0x02u) /* Answered once the data is in the EEPROM page buffer */
+#define EEPROM_UART_CMD_VERIFY          (0x03u) /* Data: CRC-32 of the range (4) */
+#define EEPROM_UART_CMD_ERASE           (0x04u) /* Fills the range with 0xFF */
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Protocol statistics */
+typedef struct
+{
+    uint32_t frames;        /* Frames received and processed */
+    uint32_t badFrames;     /* Frames with a bad CRC or length */
+    uint32_t overruns;      /* Frames lost, no free receive buffer or RX FIFO overflow */
+    uint32_t bytesWritten;  /* Data bytes of completed WRITE frames */
+} eeprom_uart_stats_t;
+
+cy_en_sysint_status_t eeprom_uart_init(void);
+void eeprom_uart_poll(void);
+bool eeprom_uart_pending(void);
+void eeprom_uart_get_stats(eeprom_uart_stats_t *stats);
+
+#endif /* SOURCE_EEPROM_UART_H_ */
@@ -45,27 +45,53 @@
 #include "cybsp.h"
 #include "cy_pdl.h"
 #include "I2CMaster.h"
-#include <inttypes.h>
-#include <stdio.h>
+#include "eeprom_bench.h"
+#include "eeprom_event.h"
+#include "eeprom_led.h"
+#include "eeprom_power.h"
+#include "eeprom_trace.h"
+#include "eeprom_uart.h"
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
 #define CY_ASSERT_FAILED          (0u)
 
-/* Debug print macro to enable UART print */
+/* Debug print macro to enable UART print, can be overridden from the
+ * Makefile DEFINES */
+#ifndef DEBUG_PRINT
 #define DEBUG_PRINT               (0u)
+#endif
 
-/*******************************************************************************
-* Global Variable
-*******************************************************************************/
-/* Clear the interrupt*/
-uint32_t interrupt_flag = 0u;
+/* Read back and verify the data after every write, 0u skips the read back,
+ * can be overridden from the Makefile DEFINES */
+#ifndef VERIFY_AFTER_WRITE
+#define VERIFY_AFTER_WRITE        (1u)
+#endif
+
+/* Run the EEPROM throughput benchmark once at startup, overwrites the
+ * benchmark region of the EEPROM, can be overridden from the Makefile
+ * DEFINES */
+#ifndef BENCHMARK_ENABLE
+#define BENCHMARK_ENABLE          (0u)
+#endif
+
+/* Program and dump the EEPROM from a host over the UART, see eeprom_uart.h.
+ * The protocol needs the UART to itself. Can be overridden from the Makefile
+ * DEFINES. */
+#ifndef UART_PROTOCOL_ENABLE
+#define UART_PROTOCOL_ENABLE      (0u)
+#endif
+
+#if (DEBUG_PRINT && UART_PROTOCOL_ENABLE)
+#error "DEBUG_PRINT and UART_PROTOCOL_ENABLE both use the UART"
+#endif
 
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 void Switch_IntHandler(void);
+void handle_event(const eeprom_event_t *event);
 
 /******************************************************************************
  * Switch interrupt configuration structure
@@ -76,10 +102,12 @@ const cy_stc_sysint_t switch_interrupt_config =
     .intrPriority = 3u,
 };
 
-#if DEBUG_PRINT
-
+#if (DEBUG_PRINT || UART_PROTOCOL_ENABLE)
 /* Structure for UART Context */
 cy_stc_scb_uart_context_t CYBSP_UART_context;
+#endif
+
+#if DEBUG_PRINT
 
 /* Variable used for tracking the print status */
 volatile bool ENTER_LOOP = true;
@@ -88,30 +116,96 @@ volatile bool ENTER_LOOP = true;
 * Function Name: check_status
 ********************************************************************************
 * Summary:
-*  Prints the error message.
+*  Prints the error message and waits until it has left the UART, so that it
+*  is seen before the assert that follows.
 *
 * Parameters:
-*  error_msg - message to print if any error encountered.
+*  message - EEPROM_TRACE_MSG_* of the failed API.
 *  status - status obtained after evaluation.
 *
 * Return:
 *  void
 *
 *******************************************************************************/
-void check_status(char *message, cy_rslt_t status)
+void check_status(uint8_t message, cy_rslt_t status)
 {
-    char error_msg[50];
+    eeprom_trace(message, status);
+    eeprom_trace_flush();
+}
 
-    sprintf(error_msg, "Error Code: 0x%08" PRIX32 "\n", status);
+#if BENCHMARK_ENABLE
+/*******************************************************************************
+* Function Name: wait_trace_space
+********************************************************************************
+* Summary:
+*  Sleeps until the UART trace ring has room for the given number of
+*  messages. The UART interrupt wakes the CPU as the ring drains.
+*
+* Parameters:
+*  messages - free ring entries needed.
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void wait_trace_space(uint32_t messages)
+{
+    uint32_t intState;
+    bool waiting;
 
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n=====================================================\r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\nFAIL: ");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, message);
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n");
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, error_msg);
-    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n=====================================================\r\n");
+    do
+    {
+        intState = Cy_SysLib_EnterCriticalSection();
+        waiting = (eeprom_trace_space() < messages);
+        if (waiting)
+        {
+            eeprom_power_sleep();
+        }
+        Cy_SysLib_ExitCriticalSection(intState);
+    } while (waiting);
+}
+
+/*******************************************************************************
+* Function Name: print_bench_results
+********************************************************************************
+* Summary:
+*  Prints the result of every benchmark workload through the UART trace, one
+*  row of messages at a time. Each row waits for room in the ring, and the
+*  function returns once the table has been handed to the UART interrupt, so
+*  neither the table nor the messages that follow it are dropped.
+*
+* Parameters:
+*  results - results filled by eeprom_bench_run().
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void print_bench_results(const eeprom_bench_result_t *results)
+{
+    /* Name, the columns, and the line end */
+    const uint32_t rowMessages = 11UL;
+
+    eeprom_trace(EEPROM_TRACE_MSG_BENCH_HEADER, 0UL);
+    for (uint32_t w = 0UL; w < EEPROM_BENCH_COUNT; w++)
+    {
+        wait_trace_space(rowMessages);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_NAME, w);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].bytesPerSec);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].eepromBytes);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].transactions);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].minUs);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].maxUs);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].totalUs);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].busUs);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].activeUsPerKB);
+        eeprom_trace(EEPROM_TRACE_MSG_BENCH_VALUE, results[w].isrPerKB);
+        eeprom_trace(EEPROM_TRACE_MSG_LINE_END, 0UL);
+    }
+    wait_trace_space(EEPROM_TRACE_DEPTH - 1UL);
 }
 #endif
+#endif
 
 /*******************************************************************************
 * Function Name: main
@@ -135,6 +229,7 @@ int main(void)
     cy_rslt_t result;
     cy_en_sysint_status_t intr_result;
     uint32_t status;
+    uint32_t intState;
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -151,13 +246,14 @@ int main(void)
      Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &CYBSP_UART_context);
      Cy_SCB_UART_Enable(CYBSP_UART_HW);
 
-     /* Sequence to clear screen */
-     Cy_SCB_UART_PutString(CYBSP_UART_HW, "\x1b[2J\x1b[;H");
+     /* Messages are sent from the UART interrupt */
+     if (eeprom_trace_init() != CY_SYSINT_SUCCESS)
+     {
+         CY_ASSERT(CY_ASSERT_FAILED);
+     }
 
-     /* Print "I2C Multi Master" */
-     Cy_SCB_UART_PutString(CYBSP_UART_HW, "**************************");
-     Cy_SCB_UART_PutString(CYBSP_UART_HW, "PMG1 MCU: I2C EEPROM");
-     Cy_SCB_UART_PutString(CYBSP_UART_HW, "**************************\r\n\n");
+     /* Clear screen and print the banner */
+     eeprom_trace(EEPROM_TRACE_MSG_BANNER, 0UL);
 
 #endif
 
@@ -169,17 +265,43 @@ int main(void)
     if(status != I2C_SUCCESS)
     {
 #if DEBUG_PRINT
-        check_status("API initI2CMaster failed with error code", status);
+        check_status(EEPROM_TRACE_MSG_INIT_FAIL, status);
 #endif
         CY_ASSERT(CY_ASSERT_FAILED);
     }
 
+#if UART_PROTOCOL_ENABLE
+    /* Configure and enable the UART peripheral for the host protocol */
+    Cy_SCB_UART_Init(CYBSP_UART_HW, &CYBSP_UART_config, &CYBSP_UART_context);
+    Cy_SCB_UART_Enable(CYBSP_UART_HW);
+
+    if (eeprom_uart_init() != CY_SYSINT_SUCCESS)
+    {
+        CY_ASSERT(CY_ASSERT_FAILED);
+    }
+#endif
+
+#if BENCHMARK_ENABLE
+    {
+        eeprom_bench_result_t bench_results[EEPROM_BENCH_COUNT];
+
+        status = eeprom_bench_run(bench_results);
+#if DEBUG_PRINT
+        if (status != TRANSFER_CMPLT)
+        {
+            check_status(EEPROM_TRACE_MSG_BENCH_FAIL, status);
+        }
+        print_bench_results(bench_results);
+#endif
+    }
+#endif
+
     /*User switch (CYBSP_USER_BTN) interrupt initialization*/
     intr_result = Cy_SysInt_Init(&switch_interrupt_config, &Switch_IntHandler);
     if (intr_result != CY_SYSINT_SUCCESS)
     {
 #if DEBUG_PRINT
-        check_status("API Cy_SysInt_Init failed with error code", intr_result);
+        check_status(EEPROM_TRACE_MSG_SYSINT_FAIL, intr_result);
 #endif
         CY_ASSERT(CY_ASSERT_FAILED);
     }
@@ -191,62 +313,133 @@ int main(void)
 
     for(;;)
     {
-        if (interrupt_flag == 1)
-        {
+        eeprom_event_t event;
+
+        /* Status indication advances between events and never blocks */
+        eeprom_led_tick();
+
+#if UART_PROTOCOL_ENABLE
+        /* Commands from the host, each runs to completion */
+        eeprom_uart_poll();
+#endif
 
+        if (eeprom_event_get(&event))
+        {
+            handle_event(&event);
+        }
+        else
+        {
 #if DEBUG_PRINT
-            Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n Start writing to EEPROM \r\n\n");
+            if (ENTER_LOOP)
+            {
+                eeprom_trace(EEPROM_TRACE_MSG_LOOP, 0UL);
+                ENTER_LOOP = false;
+            }
 #endif
 
-            /* Write WRITE_SIZE bytes to EEPROM memory starting from address 0x0000  */
-            if (TRANSFER_CMPLT == WriteToEEPROM(WRITE_SIZE))
+            /* Sleep until the button or UART interrupt or the next SysTick
+             * tick */
+            intState = Cy_SysLib_EnterCriticalSection();
+#if UART_PROTOCOL_ENABLE
+            if (!eeprom_event_pending() && !eeprom_uart_pending())
+#else
+            if (!eeprom_event_pending())
+#endif
             {
-                /*Delays for 5 milliseconds.*/
-                Cy_SysLib_Delay(5);
+                eeprom_power_sleep();
+            }
+            Cy_SysLib_ExitCriticalSection(intState);
+        }
+    }
+}
 
+/*******************************************************************************
+* Function Name: handle_event
+********************************************************************************
+* Summary:
+*  Runs one step of the EEPROM operation started by a button press. Each step
+*  posts the event of the next one, so the LED pattern engine and the button
+*  are serviced between the steps. Presses that arrive during an operation
+*  are queued and each starts its own operation.
+*
+* Parameters:
+*  event - event taken from the queue
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void handle_event(const eeprom_event_t *event)
+{
+    uint8_t status;
+
+    switch (event->id)
+    {
+        case EEPROM_EVENT_BUTTON:
 #if DEBUG_PRINT
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n\n Start reading back from EEPROM \r\n\n");
+            eeprom_trace(EEPROM_TRACE_MSG_WRITE_START, 0UL);
 #endif
 
-                /* Read back and verify written data from EEPROM*/
-                status = ReadFromEEPROM(READ_SIZE);
+            /* Write WRITE_SIZE bytes to EEPROM memory starting from address 0x0000
+             * and wait by acknowledge polling until the write cycle completes */
+            status = WriteToEEPROM(WRITE_SIZE);
+            if (status == TRANSFER_CMPLT)
+            {
+                status = eeprom_wait_ready(EEPROM_WRITE_CYCLE_TIMEOUT_MS);
+            }
 
-                if (status == TRANSFER_CMPLT)
-                {
+            if (status == TRANSFER_CMPLT)
+            {
+#if VERIFY_AFTER_WRITE
+                (void) eeprom_event_post(EEPROM_EVENT_VERIFY, 0u);
+#else
+                /* Read back skipped for write throughput */
+                (void) eeprom_event_post(EEPROM_EVENT_RESULT, 1u);
+#endif
+            }
+            else
+            {
 #if DEBUG_PRINT
-                    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n\n Read back successful \r\n");
+                eeprom_trace(EEPROM_TRACE_MSG_WRITE_FAIL, status);
 #endif
-                    /*Blink User LED (CYBSP_USER_LED) once if read back is successful*/
-                    BlinkUserLED(1);
-                }
-                else if(status == INVALID_DATA_ERROR)
-                {
+                /*Blink User LED (CYBSP_USER_LED) thrice if writing to EEPROM failed*/
+                (void) eeprom_event_post(EEPROM_EVENT_RESULT, 3u);
+            }
+            break;
+
+        case EEPROM_EVENT_VERIFY:
 #if DEBUG_PRINT
-                    Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n\n Mismatch between data written and read back \r\n");
+            eeprom_trace(EEPROM_TRACE_MSG_READ_START, 0UL);
 #endif
-                    /*Blink User LED (CYBSP_USER_LED) twice if read back returns invalid data*/
-                    BlinkUserLED(2);
-                }
+
+            /* Read back and verify written data from EEPROM*/
+            status = ReadFromEEPROM(READ_SIZE);
+            if (status == TRANSFER_CMPLT)
+            {
+#if DEBUG_PRINT
+                eeprom_trace(EEPROM_TRACE_MSG_READ_OK, 0UL);
+#endif
+                /*Blink User LED (CYBSP_USER_LED) once if read back is successful*/
+                (void) eeprom_event_post(EEPROM_EVENT_RESULT, 1u);
             }
             else
             {
-                /*Blink User LED (CYBSP_USER_LED) thrice if writing to EEPROM failed*/
-                BlinkUserLED(3);
 #if DEBUG_PRINT
-                Cy_SCB_UART_PutString(CYBSP_UART_HW, "\r\n\n Writing to EEPROM failed \r\n");
+                eeprom_trace(EEPROM_TRACE_MSG_READ_FAIL, status);
 #endif
+                /*Blink User LED (CYBSP_USER_LED) twice if read back fails or returns invalid data*/
+                (void) eeprom_event_post(EEPROM_EVENT_RESULT, 2u);
             }
+            break;
 
-            /* Clear the interrupt*/
-            interrupt_flag = 0u;
-        }
-#if DEBUG_PRINT
-        if (ENTER_LOOP)
-        {
-            Cy_SCB_UART_PutString(CYBSP_UART_HW, "Entered for loop\r\n");
-            ENTER_LOOP = false;
-        }
-#endif
+        case EEPROM_EVENT_RESULT:
+            /* Queued behind the pattern shown, if any. On a full queue the
+             * oldest waiting pattern makes room, so this result is shown. */
+            (void) eeprom_led_blink(event->arg);
+            break;
+
+        default:
+            break;
     }
 }
 
@@ -266,8 +459,8 @@ void Switch_IntHandler(void)
     Cy_GPIO_ClearInterrupt(CYBSP_USER_BTN_PORT, CYBSP_USER_BTN_NUM);
     NVIC_ClearPendingIRQ(switch_interrupt_config.intrSrc);
 
-    /* Set interrupt flag */
-    interrupt_flag = 1u;
+    /* Queue a debounced button press */
+    eeprom_event_button_isr();
 }
 
 /* [] END OF FILE */
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+################################################################################
+# File Name: eeprom_uart.py
+#
+# Description: Host tool of the UART program and dump protocol of the PMG1
+#              I2C EEPROM code example.
+#
+# Related Document: See README.md
+#
+################################################################################
+# Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+################################################################################
+
+"""Program, dump, verify and erase the EEPROM of the kit over its UART.
+
+The firmware must be built with UART_PROTOCOL_ENABLE set in main.c. Needs
+pyserial (pip install pyserial).
+
+Examples:
+    eeprom_uart.py --port /dev/ttyACM0 info
+    eeprom_uart.py --port COM5 program image.bin
+    eeprom_uart.py --port COM5 dump eeprom.bin
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+SYNC_REQUEST = 0xA5
+SYNC_RESPONSE = 0x5A
+
+CMD_INFO = 0x00
+CMD_READ = 0x01
+CMD_WRITE = 0x02
+CMD_VERIFY = 0x03
+CMD_ERASE = 0x04
+
+# Receive buffers of the firmware, EEPROM_UART_RX_BUFFERS in eeprom_uart.h
+WRITE_WINDOW = 2
+
+# Largest range of one READ, VERIFY or ERASE command, the length is 16 bits
+RANGE_MAX = 0x8000
+
+# Worst-case write cycle plus the page transfer, for the ERASE timeout
+PAGE_TIME_S = 0.01
+
+STATUS_NAMES = {
+    0x00: "TRANSFER_CMPLT",
+    0x0F: "INVALID_DATA_ERROR",
+    0xF0: "INVALID_PARAM_ERROR",
+    0xF1: "TRANSFER_BUSY",
+    0xF2: "ADDR_NAK_ERROR",
+    0xF3: "ARB_LOST_ERROR",
+    0xFF: "TRANSFER_ERROR",
+}
+
+
+class ProtocolError(Exception):
+    """Bad or missing response, or a command that failed on the device."""
+
+
+class Device:
+    """Frames of the protocol over an open serial port."""
+
+    def __init__(self, port, timeout=2.0):
+        self.port = port
+        self.timeout = timeout
+        self.size = 0
+        self.page = 0
+        self.chunk = 0
+
+    def send(self, cmd, addr=0, length=0, data=b""):
+        header = struct.pack("<BBIH", cmd, 0, addr, length)
+        crc = zlib.crc32(header + data)
+        self.port.write(bytes([SYNC_REQUEST]) + header + data + struct.pack("<I", crc))
+
+    def _read_exact(self, size, deadline):
+        buf = b""
+        while len(buf) < size:
+            if time.monotonic() > deadline:
+                raise ProtocolError("no response from the device")
+            buf += self.port.read(size - len(buf))
+        return buf
+
+    def receive(self, cmd, timeout=None):
+        """Returns (status, addr, data) of the next response to cmd."""
+        deadline = time.monotonic() + (timeout if timeout is not None else self.timeout)
+        while self._read_exact(1, deadline)[0] != SYNC_RESPONSE:
+            pass
+        header = self._read_exact(8, deadline)
+        rcmd, status, addr, length = struct.unpack("<BBIH", header)
+        data = self._read_exact(length, deadline)
+        (crc,) = struct.unpack("<I", self._read_exact(4, deadline))
+        if crc != zlib.crc32(header + data):
+            raise ProtocolError("bad CRC in response")
+        if rcmd != cmd:
+            raise ProtocolError("response to command 0x%02X, expected 0x%02X" % (rcmd, cmd))
+        return status, addr, data
+
+    def check(self, cmd, timeout=None):
+        status, addr, data = self.receive(cmd, timeout)
+        if status != 0:
+            raise ProtocolError("command 0x%02X at 0x%05X failed: %s"
+                                % (cmd, addr, STATUS_NAMES.get(status, "0x%02X" % status)))
+        return addr, data
+
+    def info(self):
+        self.port.reset_input_buffer()
+        self.send(CMD_INFO)
+        _, data = self.check(CMD_INFO)
+        self.size, self.page, self.chunk = struct.unpack("<IHH", data)
+
+    def _check_range(self, addr, length):
+        if addr < 0 or length <= 0 or addr + length > self.size:
+            raise ProtocolError("range 0x%X+0x%X outside the %d-byte EEPROM" % (addr, length, self.size))
+
+    def write(self, addr, image, progress=None):
+        """Writes image at addr with WRITE_WINDOW frames in flight, so the next
+        chunk is received while the last one is in its write cycle."""
+        self._check_range(addr, len(image))
+        chunks = []
+        offset = 0
+        while offset < len(image):
+            # The first chunk ends at a page boundary, the others fill a page
+            size = min(self.chunk - (addr + offset) % self.page, len(image) - offset)
+            chunks.append((addr + offset, image[offset:offset + size]))
+            offset += size
+
+        sent = 0
+        for done in range(len(chunks)):
+            while sent < len(chunks) and sent - done < WRITE_WINDOW:
+                self.send(CMD_WRITE, chunks[sent][0], len(chunks[sent][1]), chunks[sent][1])
+                sent += 1
+            ack_addr, _ = self.check(CMD_WRITE)
+            if ack_addr != chunks[done][0]:
+                raise ProtocolError("write of 0x%05X acknowledged out of order" % chunks[done][0])
+            if progress:
+                progress(chunks[done][0] + len(chunks[done][1]) - addr, len(image))
+
+    def read(self, addr, length, progress=None):
+        self._check_range(addr, length)
+        out = bytearray()
+        while len(out) < length:
+            start = addr + len(out)
+            size = min(RANGE_MAX, length - len(out))
+            self.send(CMD_READ, start, size)
+            while len(out) < start - addr + size:
+                chunk_addr, data = self.check(CMD_READ)
+                if chunk_addr != addr + len(out):
+                    raise ProtocolError("read data of 0x%05X out of order" % chunk_addr)
+                out += data
+                if progress:
+                    progress(len(out), length)
+        return bytes(out)
+
+    def verify(self, addr, image):
+        """Compares the CRC-32 computed by the device with that of image."""
+        self._check_range(addr, len(image))
+        for offset in range(0, len(image), RANGE_MAX):
+            part = image[offset:offset + RANGE_MAX]
+            self.send(CMD_VERIFY, addr + offset, len(part))
+            _, data = self.check(CMD_VERIFY)
+            if struct.unpack("<I", data)[0] != zlib.crc32(part):
+                return False
+        return True
+
+    def erase(self, addr, length):
+        self._check_range(addr, length)
+        offset = 0
+        while offset < length:
+            size = min(RANGE_MAX, length - offset)
+            self.send(CMD_ERASE, addr + offset, size)
+            self.check(CMD_ERASE, self.timeout + PAGE_TIME_S * (size // self.page + 2))
+            offset += size
+
+
+def report(what, size, seconds):
+    print("%s %d bytes in %.2f s (%.1f KB/s)" % (what, size, seconds, size / 1024.0 / seconds))
+
+
+def show_progress(done, total):
+    if not sys.stderr.isatty():
+        return
+    sys.stderr.write("\r%6d / %d" % (done, total))
+    if done == total:
+        sys.stderr.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--port", required=True, help="serial port of the kit")
+    parser.add_argument("--baud", type=int, default=115200, help="baud rate of the UART (default 115200)")
+    parser.add_argument("--addr", type=lambda v: int(v, 0), default=0, help="first EEPROM address (default 0)")
+    sub = parser.add_subparsers(dest="command", required=True)
+    sub.add_parser("info", help="print the EEPROM size and page size")
+    p = sub.add_parser("program", help="write an image and verify its CRC")
+    p.add_argument("image")
+    p.add_argument("--no-verify", action="store_true")
+    p = sub.add_parser("dump", help="read the EEPROM into a file")
+    p.add_argument("output")
+    p.add_argument("--len", type=lambda v: int(v, 0), help="bytes to read (default up to the end)")
+    p = sub.add_parser("verify", help="compare the CRC of the EEPROM with an image")
+    p.add_argument("image")
+    p = sub.add_parser("erase", help="fill the EEPROM with 0xFF")
+    p.add_argument("--len", type=lambda v: int(v, 0), help="bytes to erase (default up to the end)")
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+        dev = Device(port)
+        try:
+            dev.info()
+            start = time.monotonic()
+            if args.command == "info":
+                print("EEPROM %d bytes, page %d bytes, chunk %d bytes" % (dev.size, dev.page, dev.chunk))
+            elif args.command == "program":
+                with open(args.image, "rb") as f:
+                    image = f.read()
+                dev.write(args.addr, image, show_progress)
+                report("Programmed", len(image), time.monotonic() - start)
+                if not args.no_verify and not dev.verify(args.addr, image):
+                    raise ProtocolError("verify failed")
+            elif args.command == "dump":
+                length = args.len if args.len is not None else dev.size - args.addr
+                data = dev.read(args.addr, length, show_progress)
+                report("Read", length, time.monotonic() - start)
+                with open(args.output, "wb") as f:
+                    f.write(data)
+            elif args.command == "verify":
+                with open(args.image, "rb") as f:
+                    image = f.read()
+                if not dev.verify(args.addr, image):
+                    raise ProtocolError("verify failed")
+                print("Verify OK")
+            elif args.command == "erase":
+                length = args.len if args.len is not None else dev.size - args.addr
+                dev.erase(args.addr, length)
+                report("Erased", length, time.monotonic() - start)
+        except ProtocolError as err:
+            print("Error: %s" % err, file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
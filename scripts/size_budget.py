@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+################################################################################
+# File Name: size_budget.py
+#
+# Description: Footprint report of the PMG1 I2C EEPROM code example, checked
+#              against per-module budgets.
+#
+# Related Document: See README.md
+#
+################################################################################
+# Copyright 2022-2023, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related
+# materials ("Software") is owned by Cypress Semiconductor Corporation
+# or one of its affiliates ("Cypress") and is protected by and subject to
+# worldwide patent protection (United States and foreign),
+# United States copyright laws and international treaty provisions.
+# Therefore, you may use this Software only as provided in the license
+# agreement accompanying the software package from which you
+# obtained this Software ("EULA").
+# If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+# non-transferable license to copy, modify, and compile the Software
+# source code solely for use in connection with Cypress's
+# integrated circuit products.  Any reproduction, modification, translation,
+# compilation, or representation of this Software except as specified
+# above is prohibited without the express written permission of Cypress.
+#
+# Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+# reserves the right to make changes to the Software without notice. Cypress
+# does not assume any liability arising out of the application or use of the
+# Software or any product or circuit described in the Software. Cypress does
+# not authorize its products for use in any products where a malfunction or
+# failure of the Cypress product may reasonably be expected to result in
+# significant property damage, injury or death ("High Risk Product"). By
+# including Cypress's product in a High Risk Product, the manufacturer
+# of such system or application assumes all risk of such use and in doing
+# so agrees to indemnify Cypress against all liability.
+################################################################################
+
+"""Report the .text, .data and .bss of each module from a GNU linker map.
+
+Every object file of the link is a module; objects from a library are named
+library(object). Input sections are counted by name: .text and .rodata go to
+text, .data to data, and .bss and COMMON to bss. Flash holds text and data,
+RAM holds data and bss. Sections removed by --gc-sections are not counted, so
+a module that is not called does not appear.
+
+The budget file has one line per module: a name or a shell-style pattern, and
+the text, data and bss budgets in bytes, "-" for none. A pattern is checked
+against the sum of the modules it matches, and TOTAL against the whole image.
+Lines starting with # are comments.
+
+Examples:
+    size_budget.py --map build/PMG1-CY7110/Debug/app.map
+    size_budget.py --map app.map --budget scripts/size_budget.txt
+"""
+
+import argparse
+import fnmatch
+import os
+import re
+import sys
+
+KINDS = ("text", "data", "bss")
+
+# Input section name prefixes of each kind
+SECTION_KINDS = (
+    (".text", "text"),
+    (".rodata", "text"),
+    (".data", "data"),
+    (".bss", "bss"),
+    ("COMMON", "bss"),
+)
+
+# Input section: name, then address, size and object, on one line or two
+SECTION_RE = re.compile(r"^ (\S+)\s*$|^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def section_kind(name):
+    for prefix, kind in SECTION_KINDS:
+        if name == prefix or name.startswith(prefix + "."):
+            return kind
+    return None
+
+
+def module_name(path):
+    """Object file name without its directory, library(object) for members."""
+    path = path.strip()
+    member = re.match(r"^(.*)\((.*)\)$", path)
+    if member:
+        return "%s(%s)" % (os.path.basename(member.group(1)), member.group(2))
+    return os.path.basename(path)
+
+
+def parse_map(lines):
+    """Returns {module: {kind: bytes}} of the memory map part of a map file."""
+    modules = {}
+    in_map = False
+    pending = None
+    for line in lines:
+        line = line.rstrip("\n")
+        if line.startswith("Linker script and memory map"):
+            in_map = True
+            continue
+        if not in_map:
+            continue
+        match = SECTION_RE.match(line)
+        if not match:
+            pending = None
+            continue
+        if match.group(1):
+            # Long name, the address and size follow on the next line
+            pending = match.group(1)
+            continue
+        name = match.group(2) or pending
+        pending = None
+        size = int(match.group(4), 16)
+        kind = section_kind(name) if name else None
+        if kind is None or size == 0 or name.startswith("*"):
+            continue
+        module = modules.setdefault(module_name(match.group(5)), dict.fromkeys(KINDS, 0))
+        module[kind] += size
+    return modules
+
+
+def parse_budget(lines):
+    """Returns [(pattern, {kind: bytes or None})] in file order."""
+    budgets = []
+    for number, line in enumerate(lines, 1):
+        fields = line.split("#", 1)[0].split()
+        if not fields:
+            continue
+        if len(fields) != 4:
+            raise ValueError("line %d: expected a module and three budgets" % number)
+        limits = {}
+        for kind, value in zip(KINDS, fields[1:]):
+            limits[kind] = None if value == "-" else int(value, 0)
+        budgets.append((fields[0], limits))
+    return budgets
+
+
+def total(modules, names):
+    sums = dict.fromkeys(KINDS, 0)
+    for name in names:
+        for kind in KINDS:
+            sums[kind] += modules[name][kind]
+    return sums
+
+
+def print_report(modules):
+    names = sorted(modules, key=lambda n: -sum(modules[n].values()))
+    width = max([len(n) for n in names] + [len("TOTAL")])
+    print("%-*s %8s %8s %8s" % (width, "module", "text", "data", "bss"))
+    for name in names:
+        print("%-*s %8d %8d %8d" % ((width, name) + tuple(modules[name][k] for k in KINDS)))
+    sums = total(modules, names)
+    print("%-*s %8d %8d %8d" % ((width, "TOTAL") + tuple(sums[k] for k in KINDS)))
+    print("flash %d bytes, RAM %d bytes" % (sums["text"] + sums["data"], sums["data"] + sums["bss"]))
+
+
+def check_budgets(modules, budgets):
+    """Prints each budget check, returns the number exceeded."""
+    exceeded = 0
+    for pattern, limits in budgets:
+        if pattern == "TOTAL":
+            names = list(modules)
+        else:
+            names = [n for n in modules if fnmatch.fnmatchcase(n, pattern)]
+        sums = total(modules, names)
+        for kind in KINDS:
+            if limits[kind] is None:
+                continue
+            over = sums[kind] > limits[kind]
+            exceeded += over
+            print("%-4s %-24s .%-4s %7d / %7d" % ("OVER" if over else "ok", pattern, kind, sums[kind], limits[kind]))
+    return exceeded
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--map", required=True, help="linker map file of the build")
+    parser.add_argument("--budget", help="budget file, report only if omitted")
+    args = parser.parse_args()
+
+    try:
+        with open(args.map) as f:
+            modules = parse_map(f)
+        budgets = []
+        if args.budget:
+            with open(args.budget) as f:
+                budgets = parse_budget(f)
+    except (OSError, ValueError) as err:
+        print("Error: %s" % err, file=sys.stderr)
+        return 2
+    if not modules:
+        print("Error: no sections found in %s" % args.map, file=sys.stderr)
+        return 2
+
+    print_report(modules)
+    if budgets:
+        print()
+        exceeded = check_budgets(modules, budgets)
+        if exceeded:
+            print("Error: %d budget(s) exceeded" % exceeded, file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())